@@ -15,16 +15,22 @@
 #define GAC_H
 
 #include "gac_aoi_collection.h"
+#include "gac_aoi_scanpath_compare.h"
 #include "gac_filter_fixation.h"
 #include "gac_filter_gap.h"
 #include "gac_filter_noise.h"
 #include "gac_filter_saccade.h"
+#include "gac_heatmap_collection.h"
+#include "gac_ring.h"
+#include "gac_sample_pool.h"
 #include "gac_screen.h"
 
 /** ::gac_s */
 typedef struct gac_s gac_t;
 /** ::gac_filter_parameter_s */
 typedef struct gac_filter_parameter_s gac_filter_parameter_t;
+/** ::gac_sample_batch_s */
+typedef struct gac_sample_batch_s gac_sample_batch_t;
 
 /**
  * The filter parameter structure to initialise the gaze analysis handeler.
@@ -68,6 +74,45 @@ struct gac_filter_parameter_s
     } fixation;
 };
 
+/**
+ * A batch of gaze data samples in structure-of-arrays layout. Each array
+ * holds one value per sample. Optional arrays may be set to NULL.
+ */
+struct gac_sample_batch_s
+{
+    /** The number of samples in the batch. */
+    uint32_t count;
+    /** The x coordinates of the gaze origins. */
+    const float* origin_x;
+    /** The y coordinates of the gaze origins. */
+    const float* origin_y;
+    /** The z coordinates of the gaze origins. */
+    const float* origin_z;
+    /** The x coordinates of the gaze points. */
+    const float* point_x;
+    /** The y coordinates of the gaze points. */
+    const float* point_y;
+    /** The z coordinates of the gaze points. */
+    const float* point_z;
+    /**
+     * Optional x coordinates of the screen gaze points. If either screen
+     * coordinate array is NULL the screen points are computed from the gaze
+     * points if a screen is set, or set to zero otherwise.
+     */
+    const float* screen_x;
+    /** Optional y coordinates of the screen gaze points. */
+    const float* screen_y;
+    /** The sample timestamps. */
+    const double* timestamp;
+    /** Optional trial IDs. If NULL all samples have the trial ID 0. */
+    const uint32_t* trial_id;
+    /**
+     * Optional label IDs obtained from gac_get_label_id(). If NULL no labels
+     * are attached to the samples and the label onset is not reset.
+     */
+    const uint32_t* label_id;
+};
+
 /**
  * The gaze analysis handler structure.
  */
@@ -89,24 +134,40 @@ struct gac_s
     gac_filter_parameter_t parameter;
     /** The screen information. */
     gac_screen_t* screen;
+    /**
+     * The optional ingestion ring decoupling sample acquisition from the
+     * analysis. Set with gac_set_ring().
+     */
+    gac_ring_t* ring;
     /**
      * The last sample entered to the window. This remains even if the sample
      * window is cleared.
      */
-    gac_sample_t* last_sample;
+    gac_sample_t last_sample;
+    /** A flag indicating whether the last sample is set. */
+    bool has_last_sample;
     /** The timestamp of the last trial ID change. */
     double trial_timestamp;
     /** The timestamp of the last label change. */
     double label_timestamp;
     /** The AOI collection structure to handle AOIs. */
     gac_aoi_collection_t aoic;
+    /** The label intern table resolving the label IDs of samples. */
+    gac_label_table_t labels;
+    /** The pool providing all samples allocated by the handler. */
+    gac_sample_pool_t pool;
+    /**
+     * The fixation heatmaps. Detected fixations are added if the heatmaps are
+     * enabled with gac_set_heatmap().
+     */
+    gac_heatmap_collection_t heatmaps;
 };
 
 // HANDLER /////////////////////////////////////////////////////////////////////
 
 /**
  * Allows to add an AOI to the gaze analysis handler. This enables the AOI
- * analysis.
+ * analysis. Refer to gac_aoi_collection_add() for the ownership of the AOI.
  *
  * @param h
  *  A pointer to the gaze analysis handler.
@@ -137,6 +198,43 @@ gac_t* gac_create( gac_filter_parameter_t* parameter );
  */
 void gac_destroy( gac_t* h );
 
+/**
+ * Take the samples out of the ingestion ring and process them in a burst.
+ * This must only be called by the consumer thread of the ring. If the ring is
+ * empty, the function waits according to the wait mode of the ring.
+ *
+ * Detected events are written to the caller-provided output arrays as with
+ * gac_sample_window_update_batch(). If an output array is full, processing
+ * stops and the remaining samples stay in the ring for the next call. Pass
+ * an output array of length 0 (or NULL) to run the corresponding filter
+ * without collecting its events. The detected events must be freed with
+ * gac_fixation_destroy() and gac_saccade_destroy() respectively.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param timeout
+ *  The maximal time to wait for samples in milliseconds if the ring is empty.
+ *  Set to 0 to wait without limit. Ignored if the ring does not wait.
+ * @param fixations
+ *  An array where detected fixations are stored.
+ * @param fixation_length
+ *  The number of available spaces in the fixation array.
+ * @param fixation_count
+ *  A location to store the number of fixations written to the array.
+ * @param saccades
+ *  An array where detected saccades are stored.
+ * @param saccade_length
+ *  The number of available spaces in the saccade array.
+ * @param saccade_count
+ *  A location to store the number of saccades written to the array.
+ * @return
+ *  The number of samples taken out of the ring.
+ */
+uint32_t gac_drain( gac_t* h, uint32_t timeout, gac_fixation_t* fixations,
+        uint32_t fixation_length, uint32_t* fixation_count,
+        gac_saccade_t* saccades, uint32_t saccade_length,
+        uint32_t* saccade_count );
+
 /**
  * Finalise the AOI analysis.
  *
@@ -193,6 +291,183 @@ bool gac_get_filter_parameter( gac_t* h, gac_filter_parameter_t* parameter );
  */
 bool gac_get_filter_parameter_default( gac_filter_parameter_t* parameter );
 
+/**
+ * Get the fixation heatmap of a key. Read the blurred heatmap with
+ * gac_heatmap_get().
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param key
+ *  The trial ID or the label ID of the heatmap, depending on the key set
+ *  with gac_set_heatmap(), or 0 if the heatmaps are not split.
+ * @return
+ *  A pointer to the heatmap or NULL if no fixation was added to a heatmap of
+ *  this key. The heatmap remains valid until the heatmaps are reconfigured
+ *  or the handler is destroyed.
+ */
+gac_heatmap_t* gac_get_heatmap( gac_t* h, uint32_t key );
+
+/**
+ * Get the label string of a label ID. Use this to resolve the label of
+ * samples, fixations, and saccades.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param label_id
+ *  The label ID.
+ * @return
+ *  The label string or NULL if the ID is unknown. The string remains valid
+ *  until the handler is destroyed.
+ */
+const char* gac_get_label( gac_t* h, uint32_t label_id );
+
+/**
+ * Get the ID of a label string. Unknown labels are added to the label table
+ * of the handler.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param label
+ *  The label string. NULL and the empty string map to #GAC_LABEL_ID_NONE.
+ * @param label_id
+ *  A location to store the label ID. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_get_label_id( gac_t* h, const char* label, uint32_t* label_id );
+
+/**
+ * Get the usage statistics of the ingestion ring of the gaze analysis
+ * handler. This may be called from any thread.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param stats
+ *  A location to store the statistics.
+ * @return
+ *  True on success, false if no ring is set.
+ */
+bool gac_get_ring_stats( gac_t* h, gac_ring_stats_t* stats );
+
+/**
+ * Get the usage statistics of the sample pool of the gaze analysis handler.
+ * All samples allocated by the handler are acquired from this pool.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param stats
+ *  A location to store the statistics.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_get_sample_pool_stats( gac_t* h, gac_sample_pool_stats_t* stats );
+
+/**
+ * Push a sample to the ingestion ring. This is wait-free and is meant to be
+ * called from the acquisition thread (e.g. a tracker callback) while another
+ * thread calls gac_drain(). Only one thread may push samples. If the ring is
+ * full the sample is dropped and counted as overflow.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param screen_point
+ *  An optional 2d screen gaze point. If NULL the screen point is computed
+ *  from the gaze point when the sample is drained.
+ * @param origin
+ *  The gaze origin.
+ * @param point
+ *  The gaze point.
+ * @param timestamp
+ *  The timestamp of the sample.
+ * @param trial_id
+ *  The ID of the ongoing trial.
+ * @param label_id
+ *  The label ID obtained from gac_get_label_id() or #GAC_LABEL_ID_NONE. The
+ *  label table is owned by the consumer, hence, label IDs must be resolved
+ *  before the producer is started.
+ * @return
+ *  True on success, false if no ring is set or the sample was dropped.
+ */
+bool gac_push( gac_t* h, vec2* screen_point, vec3* origin, vec3* point,
+        double timestamp, uint32_t trial_id, uint32_t label_id );
+
+/**
+ * Enable or disable the AOI raster of the gaze analysis handler (see
+ * gac_aoi_collection_rasterise()). The raster is kept up to date when AOIs
+ * are added.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param width
+ *  The number of raster cells along the x axis, e.g. the horizontal screen
+ *  resolution. If set to 0 the raster is disabled.
+ * @param height
+ *  The number of raster cells along the y axis, e.g. the vertical screen
+ *  resolution. If set to 0 the raster is disabled.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_set_aoi_raster( gac_t* h, uint32_t width, uint32_t height );
+
+/**
+ * Enable or disable the sample-level AOI analysis of the gaze analysis
+ * handler. If enabled, each sample added to the sample window is classified
+ * with gac_aoi_collection_analyse_sample() such that the AOI analysis
+ * additionally reports the sample count and the sample-based dwell time of
+ * each AOI. The AOIs including the most recent sample are available through
+ * gac_aoi_collection_get_sample_hits().
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param is_enabled
+ *  True to enable the sample-level AOI analysis, false to disable it.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_set_aoi_sample_analysis( gac_t* h, bool is_enabled );
+
+/**
+ * Enable or disable the fixation heatmaps of the gaze analysis handler. If
+ * enabled, each detected fixation is added to the heatmap of its trial or
+ * label (see gac_heatmap_collection_add_fixation()). This removes all
+ * existing heatmaps.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param width
+ *  The number of heatmap cells along the x axis, e.g. the horizontal screen
+ *  resolution. If set to 0 the heatmaps are disabled.
+ * @param height
+ *  The number of heatmap cells along the y axis, e.g. the vertical screen
+ *  resolution. If set to 0 the heatmaps are disabled.
+ * @param sigma
+ *  The standard deviation of the Gaussian blur in cells.
+ * @param key
+ *  Defines whether a heatmap is kept per trial, per label, or for all
+ *  fixations.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_set_heatmap( gac_t* h, uint32_t width, uint32_t height, float sigma,
+        gac_heatmap_key_t key );
+
+/**
+ * Set up the ingestion ring of the gaze analysis handler. This replaces an
+ * existing ring, including its unprocessed samples, and must not be called
+ * while samples are pushed or drained.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param capacity
+ *  The minimal number of samples the ring can hold.
+ * @param mode
+ *  The behaviour of gac_drain() if the ring is empty.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_set_ring( gac_t* h, uint32_t capacity, gac_ring_wait_mode_t mode );
+
 /**
  * Configure the screen position in 3d space. This allows to compute normalized
  * 2d gaze point coordinates.
@@ -225,6 +500,19 @@ bool gac_set_screen( gac_t* h,
         float top_right_x, float top_right_y, float top_right_z,
         float bottom_left_x, float bottom_left_y, float bottom_left_z );
 
+/**
+ * Initialise a sample batch structure. All arrays are set to NULL and need to
+ * be assigned by the caller.
+ *
+ * @param batch
+ *  A pointer to the batch structure to initialise.
+ * @param count
+ *  The number of samples in the batch.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_batch_init( gac_sample_batch_t* batch, uint32_t count );
+
 /**
  * Cleanup the sample window. This removes all sample data from the sample
  * window which is no longer used for the gaze analysis.
@@ -236,6 +524,37 @@ bool gac_set_screen( gac_t* h,
  */
 bool gac_sample_window_cleanup( gac_t* h );
 
+/**
+ * Run the saccade and fixation filters on all new samples of the sample window
+ * and append the detected events to the output arrays. If all new samples
+ * were processed the sample window is cleaned up. If the length of an output
+ * array is 0 the corresponding filter still runs but its events are
+ * discarded, e.g. to only collect fixations.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param fixations
+ *  An array where detected fixations are stored.
+ * @param fixation_length
+ *  The number of available spaces in the fixation array.
+ * @param fixation_count
+ *  The number of fixations already in the array. This is updated with each
+ *  detected fixation.
+ * @param saccades
+ *  An array where detected saccades are stored.
+ * @param saccade_length
+ *  The number of available spaces in the saccade array.
+ * @param saccade_count
+ *  The number of saccades already in the array. This is updated with each
+ *  detected saccade.
+ * @return
+ *  True if all new samples were processed, false if an output array is full.
+ */
+bool gac_sample_window_collect( gac_t* h, gac_fixation_t* fixations,
+        uint32_t fixation_length, uint32_t* fixation_count,
+        gac_saccade_t* saccades, uint32_t saccade_length,
+        uint32_t* saccade_count );
+
 /**
  * The fixation detection algorithm I-DT. This acts on the sample window managed
  * by the functions gac_sample_window_update() and gac_sample_window_cleanup().
@@ -297,6 +616,46 @@ uint32_t gac_sample_window_update( gac_t* h, float ox, float oy, float oz,
         float px, float py, float pz, double timestamp, uint32_t trial_id,
         const char* label );
 
+/**
+ * Update the sample window with a batch of samples and run the saccade and
+ * fixation detection on all resulting samples. This is equivalent to calling
+ * gac_sample_window_update() for each sample, followed by the saccade and
+ * fixation filters for each new sample in the window and
+ * gac_sample_window_cleanup().
+ *
+ * Detected events are written to the caller-provided output arrays. If an
+ * output array is full, processing stops and the function returns the number
+ * of batch samples consumed so far. Pending samples are kept in the handler
+ * and are processed first on the next call, such that the remaining batch
+ * samples can be passed again once the outputs have been consumed. The
+ * detected events must be freed with gac_fixation_destroy() and
+ * gac_saccade_destroy() respectively. Pass an output array of length 0 (or
+ * NULL) to run the corresponding filter without collecting its events.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param batch
+ *  A pointer to the sample batch.
+ * @param fixations
+ *  An array where detected fixations are stored.
+ * @param fixation_length
+ *  The number of available spaces in the fixation array.
+ * @param fixation_count
+ *  A location to store the number of fixations written to the array.
+ * @param saccades
+ *  An array where detected saccades are stored.
+ * @param saccade_length
+ *  The number of available spaces in the saccade array.
+ * @param saccade_count
+ *  A location to store the number of saccades written to the array.
+ * @return
+ *  The number of batch samples consumed.
+ */
+uint32_t gac_sample_window_update_batch( gac_t* h, gac_sample_batch_t* batch,
+        gac_fixation_t* fixations, uint32_t fixation_length,
+        uint32_t* fixation_count, gac_saccade_t* saccades,
+        uint32_t saccade_length, uint32_t* saccade_count );
+
 /**
  * Update sample window with a new sample.
  *
@@ -313,13 +672,68 @@ uint32_t gac_sample_window_update( gac_t* h, float ox, float oy, float oz,
  * @param trial_id
  *  The ID of the ongoing trial.
  * @param label
- *  An optional arbitrary label annotating the sample.
+ *  An optional arbitrary label annotating the sample. A NULL label is not
+ *  considered a label change.
  * @return
  *  The number of new samples added to the window.
  */
 uint32_t gac_sample_window_update_vec( gac_t* h, vec2* screen_point, vec3* origin,
         vec3* point, double timestamp, uint32_t trial_id, const char* label );
 
+/**
+ * The same as gac_sample_window_update_vec() but with the label passed as
+ * label ID. A change of the label ID is considered a label change.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param screen_point
+ *  The 2d screen gaze point
+ * @param origin
+ *  The gaze origin.
+ * @param point
+ *  The gaze point.
+ * @param timestamp
+ *  The timestamp of the sample.
+ * @param trial_id
+ *  The ID of the ongoing trial.
+ * @param label_id
+ *  The label ID obtained from gac_get_label_id() or #GAC_LABEL_ID_NONE.
+ * @return
+ *  The number of new samples added to the window.
+ */
+uint32_t gac_sample_window_update_vec_id( gac_t* h, vec2* screen_point,
+        vec3* origin, vec3* point, double timestamp, uint32_t trial_id,
+        uint32_t label_id );
+
+/**
+ * The same as gac_sample_window_update_vec_id() but the sample may be
+ * unlabelled. An unlabelled sample is stored with #GAC_LABEL_ID_NONE but, as
+ * a NULL label passed to gac_sample_window_update_vec(), is not considered a
+ * label change.
+ *
+ * @param h
+ *  A pointer to the gaze analysis handler.
+ * @param screen_point
+ *  The 2d screen gaze point
+ * @param origin
+ *  The gaze origin.
+ * @param point
+ *  The gaze point.
+ * @param timestamp
+ *  The timestamp of the sample.
+ * @param trial_id
+ *  The ID of the ongoing trial.
+ * @param label_id
+ *  The label ID obtained from gac_get_label_id() or #GAC_LABEL_ID_NONE.
+ * @param has_label
+ *  False if the sample is unlabelled, in which case label_id is ignored.
+ * @return
+ *  The number of new samples added to the window.
+ */
+uint32_t gac_sample_window_update_vec_label( gac_t* h, vec2* screen_point,
+        vec3* origin, vec3* point, double timestamp, uint32_t trial_id,
+        uint32_t label_id, bool has_label );
+
 /**
  * Update the sample window with a new sample. If noise filtering is enabled
  * the filtered data is added to the sample window and the raw sample is
@@ -19,15 +19,34 @@
 #include <cglm/vec2.h>
 #include <cglm/vec3.h>
 
-/** The maximal allowed area of intersts to analyse. */
-#define GAC_AOI_MAX 100
-/** The maximal allowed points definig an area of interest. */
-#define GAC_AOI_MAX_POINTS 100
 /** The maximal label length */
 #define GAC_AOI_MAX_LABEL_LEN 100
+/**
+ * The number of points processed at once by gac_aoi_includes_points(). All
+ * edges of an AOI are applied to one block of points before moving on to the
+ * next block such that the block stays in the cache.
+ */
+#define GAC_AOI_BATCH_SIZE 512
+/**
+ * The number of points gac_aoi_includes_points() pads a block to. This must
+ * be a power of two and a divisor of #GAC_AOI_BATCH_SIZE.
+ */
+#define GAC_AOI_BATCH_LANES 8
+/**
+ * The tolerance used when compiling an AOI. Points closer than this are
+ * considered equal and turns smaller than this (relative to the edge lengths)
+ * are considered colinear.
+ */
+#define GAC_AOI_EPSILON 1e-6f
 
 /** ::gac_aoi_s */
 typedef struct gac_aoi_s gac_aoi_t;
+/** ::gac_aoi_edge_s */
+typedef struct gac_aoi_edge_s gac_aoi_edge_t;
+/** ::gac_aoi_interval_s */
+typedef struct gac_aoi_interval_s gac_aoi_interval_t;
+/** ::gac_aoi_keyframe_s */
+typedef struct gac_aoi_keyframe_s gac_aoi_keyframe_t;
 
 /**
  * The order of point triplets. This is used for checking
@@ -46,6 +65,70 @@ enum gac_aoi_orientation_e
 /** #gac_aoi_orientation_e */
 typedef enum gac_aoi_orientation_e gac_aoi_orientation_t;
 
+/**
+ * The shape of a compiled AOI. The shape defines which point test is used by
+ * gac_aoi_includes_point().
+ */
+enum gac_aoi_shape_e
+{
+    /** The AOI is not compiled. */
+    GAC_AOI_SHAPE_NONE,
+    /** An arbitrary polygon, tested with the crossing number of the edges. */
+    GAC_AOI_SHAPE_POLYGON,
+    /** A convex polygon, tested with a binary search over the hull. */
+    GAC_AOI_SHAPE_CONVEX,
+    /** An axis aligned rectangle, tested with the bounding box only. */
+    GAC_AOI_SHAPE_RECT,
+};
+
+/** #gac_aoi_shape_e */
+typedef enum gac_aoi_shape_e gac_aoi_shape_t;
+
+/**
+ * A non-horizontal AOI edge, prepared for the crossing number test.
+ */
+struct gac_aoi_edge_s
+{
+    /** The x coordinate of the start point of the edge. */
+    float x;
+    /** The y coordinate of the start point of the edge. */
+    float y;
+    /** The smaller y coordinate of the two edge points. */
+    float y_min;
+    /** The larger y coordinate of the two edge points. */
+    float y_max;
+    /** The change of x per change of y along the edge. */
+    float slope;
+};
+
+/**
+ * A time interval during which a dynamic AOI is visible.
+ */
+struct gac_aoi_interval_s
+{
+    /** The timestamp at which the AOI appears. */
+    double start;
+    /** The timestamp at which the AOI disappears. */
+    double end;
+};
+
+/**
+ * A keyframe of a dynamic AOI. The points of the keyframe are stored in the
+ * keyframe point list of the AOI.
+ */
+struct gac_aoi_keyframe_s
+{
+    /** The timestamp of the keyframe. */
+    double timestamp;
+    /** The axis aligned bounding box of the keyframe points. */
+    struct {
+        float x_min;
+        float x_max;
+        float y_min;
+        float y_max;
+    } bounding_box;
+};
+
 /**
  * An area of interest (AOI) structure.
  */
@@ -69,9 +152,11 @@ struct gac_aoi_s
      */
     struct {
         /** The point list. */
-        vec2 items[GAC_AOI_MAX_POINTS];
+        vec2* items;
         /** The number of points defining the AOI. */
         uint32_t count;
+        /** The number of available spaces in the point list. */
+        uint32_t length;
     } points;
     /**
      * A axis aligned bounding box to quickly do a coars check if a point is
@@ -83,10 +168,123 @@ struct gac_aoi_s
         float y_min;
         float y_max;
     } bounding_box;
+    /**
+     * The shape of the compiled AOI. Adding a point resets the shape to
+     * #GAC_AOI_SHAPE_NONE.
+     */
+    gac_aoi_shape_t shape;
+    /**
+     * The contour of a compiled AOI without repeated points. The buffers of
+     * the compiled AOI are kept and reused when the AOI is compiled again.
+     */
+    struct {
+        /** The contour point list. */
+        vec2* items;
+        /** The number of contour points. */
+        uint32_t count;
+        /** The number of available spaces in the contour point list. */
+        uint32_t length;
+    } contour;
+    /** The edge table of a compiled polygon AOI. */
+    struct {
+        /** The edge list. */
+        gac_aoi_edge_t* items;
+        /** The number of edges in the list. */
+        uint32_t count;
+        /** The number of available spaces in the edge list. */
+        uint32_t length;
+    } edges;
+    /** The hull of a compiled convex AOI in counter clockwise order. */
+    struct {
+        /** The hull point list. */
+        vec2* items;
+        /** The number of hull points. */
+        uint32_t count;
+        /** The number of available spaces in the hull point list. */
+        uint32_t length;
+    } hull;
+    /**
+     * The keyframes of a dynamic AOI in ascending temporal order. The points
+     * of a dynamic AOI are interpolated from the keyframes by
+     * gac_aoi_resolve().
+     */
+    struct {
+        /** The keyframe list. */
+        gac_aoi_keyframe_t* items;
+        /** The number of keyframes. */
+        uint32_t count;
+        /** The number of available spaces in the keyframe list. */
+        uint32_t length;
+        /**
+         * The points of all keyframes where the points of keyframe i start at
+         * `i * vertex_count`.
+         */
+        vec2* points;
+        /** The number of points per keyframe. */
+        uint32_t vertex_count;
+    } keyframes;
+    /**
+     * The ascending and non-overlapping visibility intervals of a dynamic
+     * AOI. If the list is empty the AOI is visible from the first to the last
+     * keyframe.
+     */
+    struct {
+        /** The interval list. */
+        gac_aoi_interval_t* items;
+        /** The number of intervals. */
+        uint32_t count;
+        /** The number of available spaces in the interval list. */
+        uint32_t length;
+    } intervals;
+    /**
+     * The timestamp at which the points of a dynamic AOI were interpolated or
+     * NAN if the points were not interpolated yet.
+     */
+    double timestamp;
     /** The analysis data of the AOI. */
     gac_aoi_analysis_t analysis;
 };
 
+/**
+ * Add a visibility interval to a dynamic AOI. Outside of its intervals the
+ * AOI does not include any point. Intervals must be added in ascending order
+ * and must not overlap.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param start
+ *  The timestamp at which the AOI appears.
+ * @param end
+ *  The timestamp at which the AOI disappears.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_add_interval( gac_aoi_t* aoi, double start, double end );
+
+/**
+ * Add a keyframe to a dynamic AOI. Between two keyframes the points of the
+ * AOI are linearly interpolated, before the first and after the last
+ * keyframe the AOI is not visible. Keyframes must be added in ascending
+ * temporal order and all keyframes of an AOI must have the same number of
+ * points. The first keyframe also defines the points of the AOI until the
+ * AOI is resolved at another timestamp (see gac_aoi_resolve()).
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param timestamp
+ *  The timestamp of the keyframe in the time base of the gaze samples.
+ * @param x
+ *  The list of normalised x coordinates of the keyframe points.
+ * @param y
+ *  The list of normalised y coordinates of the keyframe points.
+ * @param count
+ *  The number of keyframe points. At least 3 points are required.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_add_keyframe( gac_aoi_t* aoi, double timestamp, const float* x,
+        const float* y, uint32_t count );
+
 /**
  * Add a point the AOE definition. An AOE requires at least 3 points to be
  * valid. In addition to attaching the point to the internal array, this
@@ -139,6 +337,22 @@ bool gac_aoi_add_rect( gac_aoi_t* aoi, float x, float y, float width,
 bool gac_aoi_add_rect_res( gac_aoi_t* aoi, float x, float y, float width,
         float height );
 
+/**
+ * Compile the AOI points into the representation used by
+ * gac_aoi_includes_point(). Axis aligned rectangles and convex polygons are
+ * detected and get dedicated point tests, all other AOIs are compiled into an
+ * edge table. The contour is always closed by the edge from the last to the
+ * first point. If the AOI is not compiled explicitly, this is done by the
+ * first call of gac_aoi_includes_point(). The buffers of the compiled AOI are
+ * reused, hence compiling an AOI again only allocates if points were added.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_compile( gac_aoi_t* aoi );
+
 /**
  * Create a deep copy of an AOI.
  *
@@ -150,7 +364,8 @@ bool gac_aoi_add_rect_res( gac_aoi_t* aoi, float x, float y, float width,
 gac_aoi_t* gac_aoi_copy( gac_aoi_t* aoi );
 
 /**
- * Copy an AOI structure.
+ * Copy an AOI structure. The target is initialised by this function and must
+ * not hold any points.
  *
  * @param tgt
  *  A pointer to an AOI to copy to.
@@ -181,11 +396,32 @@ gac_aoi_t* gac_aoi_create( const char* label );
 void gac_aoi_destroy( gac_aoi_t* aoi );
 
 /**
- * Checks whether a point is inside of an AOI. This function uses the ray
- * casting method where a virtual ray is drawn from an arbitraty point outside
- * the AOI to the point. Then, every intersection with segments of the AOI
- * contour is counted.  If an even number of intersection is detected, the
- * point lies outside of the AOI, otherwise the point lies inside the AOI.
+ * Find the keyframes of a dynamic AOI enclosing a timestamp. Timestamps
+ * before the first or after the last keyframe are clamped to the respective
+ * keyframe.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param timestamp
+ *  The timestamp to look up.
+ * @param idx
+ *  A location to store the index of the last keyframe at or before the
+ *  timestamp.
+ * @param weight
+ *  A location to store the interpolation weight of the following keyframe.
+ *  This is 0 if the timestamp is clamped to a keyframe.
+ * @return
+ *  True on success, false on failure or if the AOI has no keyframes.
+ */
+bool gac_aoi_find_keyframe( gac_aoi_t* aoi, double timestamp, uint32_t* idx,
+        float* weight );
+
+/**
+ * Checks whether a point is inside of an AOI. Points outside of the bounding
+ * box are rejected immediately. Otherwise the point test of the compiled AOI
+ * shape is used (see gac_aoi_compile()), i.e. the bounding box test for
+ * rectangles, gac_aoi_includes_point_convex() for convex polygons, and
+ * gac_aoi_includes_point_polygon() for all other polygons.
  *
  * @param aoi
  *  A pointer to an AOI structure.
@@ -198,6 +434,84 @@ void gac_aoi_destroy( gac_aoi_t* aoi );
  */
 bool gac_aoi_includes_point( gac_aoi_t* aoi, float x, float y );
 
+/**
+ * Checks whether a point is inside of an AOI at a given time. For static AOIs
+ * this is the same as gac_aoi_includes_point(). A dynamic AOI must be visible
+ * at the timestamp and the point must be inside of the bounding box
+ * interpolated from the enclosing keyframes before the AOI points are
+ * interpolated with gac_aoi_resolve() and tested.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param x
+ *  The normalised x coordinate of the point to check.
+ * @param y
+ *  The normalised y coordinate of the point to check.
+ * @param timestamp
+ *  The timestamp of the point.
+ * @return
+ *  True if the point is inside the AOI, false otherwise.
+ */
+bool gac_aoi_includes_point_at( gac_aoi_t* aoi, float x, float y,
+        double timestamp );
+
+/**
+ * Checks whether a point is inside of a compiled convex AOI. The hull is
+ * split into triangles sharing the first hull point and the triangle
+ * containing the direction of the point is found with a binary search. Points
+ * on the contour are inside the AOI.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure compiled to #GAC_AOI_SHAPE_CONVEX.
+ * @param x
+ *  The normalised x coordinate of the point to check.
+ * @param y
+ *  The normalised y coordinate of the point to check.
+ * @return
+ *  True if the point is inside the AOI, false otherwise.
+ */
+bool gac_aoi_includes_point_convex( gac_aoi_t* aoi, float x, float y );
+
+/**
+ * Checks whether a point is inside of a compiled polygon AOI. A horizontal
+ * ray is cast from the point and every edge crossing the ray is counted.
+ * If an odd number of edges is crossed, the point lies inside the AOI.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure compiled to #GAC_AOI_SHAPE_POLYGON.
+ * @param x
+ *  The normalised x coordinate of the point to check.
+ * @param y
+ *  The normalised y coordinate of the point to check.
+ * @return
+ *  True if the point is inside the AOI, false otherwise.
+ */
+bool gac_aoi_includes_point_polygon( gac_aoi_t* aoi, float x, float y );
+
+/**
+ * Checks for a list of points whether they are inside of an AOI. The result
+ * of each point is the same as the result of gac_aoi_includes_point(). The
+ * points are processed in blocks of #GAC_AOI_BATCH_SIZE and only the points of
+ * a block inside the bounding box are tested further. For polygon AOIs the
+ * edge loop is the outer loop and the inner loop over the points is free of
+ * branches such that it is vectorised by the compiler.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param x
+ *  The list of normalised x coordinates of the points to check.
+ * @param y
+ *  The list of normalised y coordinates of the points to check.
+ * @param count
+ *  The number of points to check.
+ * @param inside
+ *  A list of length count where the result of each point is stored.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_includes_points( gac_aoi_t* aoi, const float* x, const float* y,
+        uint32_t count, bool* inside );
+
 /**
  * The same as gac_aoi_includes_point() but accepting the input coordinates in
  * pixels instead of normalized values. Note that this function will always
@@ -206,7 +520,8 @@ bool gac_aoi_includes_point( gac_aoi_t* aoi, float x, float y );
 bool gac_aoi_includes_point_res( gac_aoi_t* aoi, float x_res, float y_res );
 
 /**
- * Initialise the AOI structure.
+ * Initialise the AOI structure. The points of the AOI are stored on the heap,
+ * hence, an initialised AOI must be freed with gac_aoi_destroy().
  *
  * @param aoi
  *  A pointer to the aoi structure to initialise.
@@ -233,6 +548,30 @@ bool gac_aoi_init( gac_aoi_t* aoi, const char* label );
  */
 bool gac_aoi_intersect( vec2* p1, vec2* q1, vec2* p2, vec2* q2 );
 
+/**
+ * Checks whether an AOI is dynamic, i.e. whether the AOI has keyframes or
+ * visibility intervals.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @return
+ *  True if the AOI is dynamic, false otherwise.
+ */
+bool gac_aoi_is_dynamic( gac_aoi_t* aoi );
+
+/**
+ * Checks whether an AOI is visible at a given time. Static AOIs are always
+ * visible.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param timestamp
+ *  The timestamp to check.
+ * @return
+ *  True if the AOI is visible, false otherwise.
+ */
+bool gac_aoi_is_visible( gac_aoi_t* aoi, double timestamp );
+
 /**
  * Given three colinear points, this function checks if a point p lies on a
  * segment s1s2.
@@ -263,6 +602,21 @@ bool gac_aoi_point_on_segment( vec2* p, vec2* s1, vec2* s2 );
  */
 gac_aoi_orientation_t gac_aoi_orientation_triplet( vec2* p, vec2* q, vec2* r );
 
+/**
+ * Interpolate the points of a dynamic AOI at a given time. The points and the
+ * bounding box of the AOI are replaced and the AOI is compiled again on the
+ * next point test. Resolving the AOI at the timestamp of the current points
+ * has no effect. Static AOIs are not modified.
+ *
+ * @param aoi
+ *  A pointer to an AOI structure.
+ * @param timestamp
+ *  The timestamp at which the AOI points are interpolated.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_resolve( gac_aoi_t* aoi, double timestamp );
+
 /**
  * Set the screen resolution. This allows to use all functions with an `res`
  * suffix. These functions will act exactly like their counter part function
@@ -58,6 +58,22 @@ struct gac_aoi_analysis_s
      * corresponds to all samples with the same trial ID.
      */
     double dwell_time_relative;
+    /**
+     * The number of samples in this AOI. This is only available if the
+     * sample-level AOI analysis is enabled.
+     */
+    uint32_t sample_count;
+    /**
+     * The time spent on the AOI based on samples, i.e. the sum of the
+     * intervals between a sample in this AOI and the next sample. This is only
+     * available if the sample-level AOI analysis is enabled.
+     */
+    double sample_dwell_time;
+    /**
+     * The relative sample-based time spent on the AOI. `1` is the sum of all
+     * sample intervals within the trial interest period.
+     */
+    double sample_dwell_time_relative;
     /**
      * The first fixation on the AOI.
      */
@@ -16,10 +16,31 @@
 #define GAC_AOI_COLLECTION_H
 
 #include "gac_aoi_collection_analysis.h"
+#include "gac_aoi_grid.h"
+#include "gac_aoi_raster.h"
+#include "gac_aoi_timeline.h"
 #include <stdint.h>
 
+/** The number of recently classified samples of which the AOI hits are kept. */
+#define GAC_AOI_COLLECTION_SAMPLE_HISTORY 8
+
 /** ::gac_aoi_collection_s */
 typedef struct gac_aoi_collection_s gac_aoi_collection_t;
+/** ::gac_aoi_collection_sample_s */
+typedef struct gac_aoi_collection_sample_s gac_aoi_collection_sample_t;
+
+/**
+ * A sample classified by the sample-level AOI analysis.
+ */
+struct gac_aoi_collection_sample_s
+{
+    /** The timestamp of the sample. */
+    double timestamp;
+    /** The normalised 2d coordinates of the sample. */
+    vec2 screen_point;
+    /** The number of AOIs including the sample. */
+    uint32_t count;
+};
 
 /**
  * A collection of AOIs.
@@ -30,19 +51,108 @@ struct gac_aoi_collection_s
     void* _me;
     /** The collection of individual AOIs. */
     struct {
-        gac_aoi_t* ptrs[GAC_AOI_MAX];
         /** The aoi list. */
-        gac_aoi_t items[GAC_AOI_MAX];
+        gac_aoi_t* items;
         /** The number of AOIs in the list. */
         uint32_t count;
+        /** The number of available spaces in the aoi list. */
+        uint32_t length;
     } aois;
+    /**
+     * The spatial index over the AOI bounding boxes. This is rebuilt
+     * whenever an AOI is added.
+     */
+    gac_aoi_grid_t grid;
+    /**
+     * The optional raster of the AOIs. If enabled, this is rebuilt whenever
+     * an AOI is added.
+     */
+    gac_aoi_raster_t raster;
+    /**
+     * The temporal index over the visibility of the dynamic AOIs. This is
+     * rebuilt whenever an AOI is added. Dynamic AOIs are neither part of the
+     * grid nor of the raster.
+     */
+    gac_aoi_timeline_t timeline;
+    /**
+     * The sample-level AOI analysis. The sample counts and durations are
+     * accumulated per trial and are added to the AOI analysis once the trial
+     * changes or the analysis is finalised.
+     */
+    struct {
+        /** Whether the gaze analysis handler classifies each sample. */
+        bool is_enabled;
+        /** The trial ID of the accumulated samples. */
+        uint32_t trial_id;
+        /** The number of accumulated samples. */
+        uint32_t count;
+        /** The summed interval of the accumulated samples. */
+        double dwell_time;
+        /** The number of accumulated samples per AOI. */
+        uint32_t* counts;
+        /** The summed interval of the accumulated samples per AOI. */
+        double* dwell_times;
+        /** The recently classified samples. */
+        gac_aoi_collection_sample_t history[GAC_AOI_COLLECTION_SAMPLE_HISTORY];
+        /** The index of the most recently classified sample. */
+        uint32_t head;
+        /** The number of valid samples in the history. */
+        uint32_t history_count;
+        /**
+         * The ascending AOI indices including the samples of the history
+         * where the hits of history entry i start at `i * length`.
+         */
+        uint32_t* hits;
+        /** The number of available spaces in the AOI lists. */
+        uint32_t length;
+    } samples;
+    /**
+     * The AOIs with analysis data in the current trial. Only these AOIs are
+     * reported and cleared when the analysis is finalised.
+     */
+    struct {
+        /** The AOI index list in the order the AOIs were first hit. */
+        uint32_t* items;
+        /** The number of AOI indices in the list. */
+        uint32_t count;
+        /** Per AOI, whether the AOI is part of the index list. */
+        bool* flags;
+        /** The number of available spaces in the lists. */
+        uint32_t length;
+    } touched;
+    /** The AOIs including the last queried point. */
+    struct {
+        /** The AOI index list. */
+        uint32_t* items;
+        /** The number of available spaces in the AOI index list. */
+        uint32_t length;
+    } hits;
     /** The analysis data of the AOI collection. */
     gac_aoi_collection_analysis_t analysis;
+    /**
+     * The scanpath of the current trial. Fixations outside of all AOIs are
+     * not part of the scanpath and fixations hitting overlapping AOIs are
+     * assigned to the AOI with the smallest index.
+     */
+    gac_aoi_scanpath_t scanpath;
+    /** The storage of the analysis results handed out by the collection. */
+    struct {
+        /** The analysis result list. */
+        gac_aoi_collection_analysis_item_t* items;
+        /** The number of available spaces in the analysis result list. */
+        uint32_t length;
+        /** The scanpath of the last analysis result. */
+        gac_aoi_scanpath_t scanpath;
+    } results;
 };
 
 /**
- * Add an AOI to an AOI collection. Do **not** destroy an AOI which was added
- * to the collection. Memory management is taken care of by the collection.
+ * Add an AOI to an AOI collection. An AOI allocated on the stack is copied
+ * and must still be destroyed by the caller with gac_aoi_destroy(). An AOI
+ * allocated on the heap with gac_aoi_create() is taken over by the collection
+ * and must **not** be used or destroyed after this call, i.e. it is destroyed
+ * if it cannot be added. On failure the AOIs of the collection are left
+ * unchanged but the sample history may be cleared.
  *
  * @param aoic
  *  A pointer to the AOI collection
@@ -65,7 +175,9 @@ bool gac_aoi_collection_analyse_clear( gac_aoi_collection_t* aoic );
 
 /**
  * Finalise the AOI analysis. This function computes the relative values in
- * each AOI structure based on the collection analysis data.
+ * each AOI structure based on the collection analysis data. Only the AOIs hit
+ * during the trial are reported and cleared (see gac_aoi_collection_touch()).
+ * The scanpath of the trial is handed over to the result without copying it.
  *
  * @param aoic
  *  A pointer to the AOI collection.
@@ -79,7 +191,9 @@ bool gac_aoi_collection_analyse_finalise( gac_aoi_collection_t* aoic,
         gac_aoi_collection_analysis_result_t* analysis );
 
 /**
- * Add a fixation to the AOI collection and update the analysis.
+ * Add a fixation to the AOI collection and update the analysis. Dynamic AOIs
+ * are resolved at the middle of the fixation. The hit AOI is appended to the
+ * scanpath of the trial.
  *
  * @param aoic
  *  A pointer to an AOI collection.
@@ -98,6 +212,9 @@ bool gac_aoi_collection_analyse_fixation( gac_aoi_collection_t* aoic,
 /**
  * Add a saccade to the AOI collection and update the analysis. Note that this
  * only extends the AOI analysis but no AOI can happen based on saccades only.
+ * If the start or end sample of the saccade is still in the sample history
+ * (see gac_aoi_collection_analyse_sample()) its AOI hits are reused.
+ * Dynamic AOIs are resolved at the timestamp of the respective sample.
  * Always call this function bevore fixation analysis
  * (see gac_aoi_collection_analyse_fixation).
  *
@@ -111,6 +228,34 @@ bool gac_aoi_collection_analyse_fixation( gac_aoi_collection_t* aoic,
 bool gac_aoi_collection_analyse_saccade( gac_aoi_collection_t* aoic,
         gac_saccade_t* saccade );
 
+/**
+ * Classify a gaze sample and accumulate the sample-level AOI analysis. The
+ * interval from the previous sample to this sample is added to the AOIs
+ * including the previous sample. The AOIs including the sample are kept such
+ * that they can be retrieved with gac_aoi_collection_get_sample_hits() and
+ * are reused by gac_aoi_collection_analyse_saccade().
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param sample
+ *  The sample to classify. Samples must be passed in temporal order.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_collection_analyse_sample( gac_aoi_collection_t* aoic,
+        gac_sample_t* sample );
+
+/**
+ * Add the accumulated sample-level analysis to the analysis of each AOI and
+ * reset the accumulation.
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_collection_analyse_sample_flush( gac_aoi_collection_t* aoic );
+
 /**
  * Assign a new AOI to an AOI collection. This function acts similar to
  * gac_aoi_collection_add() but only creates a copy if the AOI to assign is
@@ -143,6 +288,89 @@ gac_aoi_collection_t* gac_aoi_collection_create();
  */
 void gac_aoi_collection_destroy( gac_aoi_collection_t* aoic );
 
+/**
+ * Find a recently classified sample in the sample history of an AOI
+ * collection. A sample matches if the timestamp and the screen point are
+ * equal.
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param sample
+ *  The sample to find.
+ * @param hits
+ *  A location to store a pointer to the ascending indices of the AOIs
+ *  including the sample. The list is valid until the next sample is
+ *  classified.
+ * @param count
+ *  A location to store the number of AOIs including the sample.
+ * @return
+ *  True if the sample was found, false otherwise.
+ */
+bool gac_aoi_collection_find_sample_hits( gac_aoi_collection_t* aoic,
+        gac_sample_t* sample, uint32_t** hits, uint32_t* count );
+
+/**
+ * Get the AOIs including the most recently classified sample.
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param hits
+ *  A location to store a pointer to the ascending indices of the AOIs
+ *  including the sample. The list is valid until the next sample is
+ *  classified.
+ * @return
+ *  The number of AOIs including the sample or 0 if no sample was classified.
+ */
+uint32_t gac_aoi_collection_get_sample_hits( gac_aoi_collection_t* aoic,
+        uint32_t** hits );
+
+/**
+ * Get the AOIs of an AOI collection which include a point. If the AOI raster
+ * is enabled (see gac_aoi_collection_rasterise()) and covers the point the
+ * raster is used, otherwise the AOI grid is used. Dynamic AOIs are looked up
+ * in the AOI timeline and only the candidates visible at the timestamp are
+ * resolved and tested (see gac_aoi_includes_point_at()).
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param x
+ *  The x coordinate of the point.
+ * @param y
+ *  The y coordinate of the point.
+ * @param timestamp
+ *  The timestamp of the point.
+ * @param hits
+ *  A location to store a pointer to the ascending indices of the AOIs
+ *  including the point. The list is owned by the collection and only valid
+ *  until the next call of this function.
+ * @return
+ *  The number of AOIs including the point.
+ */
+uint32_t gac_aoi_collection_hits( gac_aoi_collection_t* aoic, float x,
+        float y, double timestamp, uint32_t** hits );
+
+/**
+ * Checks for a list of points which AOIs of an AOI collection include them.
+ * This calls gac_aoi_includes_points() for each AOI of the collection.
+ * Dynamic AOIs are tested with their current points (see gac_aoi_resolve()).
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param x
+ *  The list of normalised x coordinates of the points to check.
+ * @param y
+ *  The list of normalised y coordinates of the points to check.
+ * @param count
+ *  The number of points to check.
+ * @param inside
+ *  A list of length `aoic->aois.count * count` where the results are stored.
+ *  The result of point j and AOI i is stored at index `i * count + j`.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_collection_includes_points( gac_aoi_collection_t* aoic,
+        const float* x, const float* y, uint32_t count, bool* inside );
+
 /**
  * Initialise an AOI collection.
  *
@@ -153,4 +381,37 @@ void gac_aoi_collection_destroy( gac_aoi_collection_t* aoic );
  */
 bool gac_aoi_collection_init( gac_aoi_collection_t* aoic );
 
+/**
+ * Enable or disable the AOI raster of an AOI collection. The raster covers
+ * the normalised screen area and trades memory (four bytes per cell) for
+ * point queries which are independent of the AOI shapes. A resolution
+ * matching the screen resolution is a good choice.
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param width
+ *  The number of raster cells along the x axis. If set to 0 the raster is
+ *  disabled.
+ * @param height
+ *  The number of raster cells along the y axis. If set to 0 the raster is
+ *  disabled.
+ * @return
+ *  True on success, false otherwise.
+ */
+bool gac_aoi_collection_rasterise( gac_aoi_collection_t* aoic, uint32_t width,
+        uint32_t height );
+
+/**
+ * Mark an AOI as hit during the current trial such that its analysis is
+ * reported and cleared by gac_aoi_collection_analyse_finalise().
+ *
+ * @param aoic
+ *  A pointer to an AOI collection.
+ * @param idx
+ *  The index of the AOI.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_collection_touch( gac_aoi_collection_t* aoic, uint32_t idx );
+
 #endif
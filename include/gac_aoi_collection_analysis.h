@@ -15,11 +15,14 @@
 #define GAC_AOI_COLLECTION_ANALYSIS_H
 
 #include "gac_aoi.h"
+#include "gac_aoi_scanpath.h"
 #include <stdint.h>
 #include <stdbool.h>
 
 /** ::gac_aoi_collection_analysis_s */
 typedef struct gac_aoi_collection_analysis_s gac_aoi_collection_analysis_t;
+/** ::gac_aoi_collection_analysis_item_s */
+typedef struct gac_aoi_collection_analysis_item_s gac_aoi_collection_analysis_item_t;
 /** ::gac_aoi_collection_analysis_result_s */
 typedef struct gac_aoi_collection_analysis_result_s gac_aoi_collection_analysis_result_t;
 
@@ -38,6 +41,23 @@ struct gac_aoi_collection_analysis_s
     uint32_t trial_id;
     /** The summed duration of all fixations. */
     double dwell_time;
+    /** The total number of classified samples. */
+    uint32_t sample_count;
+    /** The summed interval of all classified samples. */
+    double sample_dwell_time;
+};
+
+/**
+ * The analysis result of a single AOI.
+ */
+struct gac_aoi_collection_analysis_item_s
+{
+    /** The index of the AOI in the AOI collection. */
+    uint32_t aoi_id;
+    /** A copy of the label of the AOI. */
+    char label[GAC_AOI_MAX_LABEL_LEN];
+    /** The analysis data of the AOI. */
+    gac_aoi_analysis_t analysis;
 };
 
 /**
@@ -49,14 +69,23 @@ struct gac_aoi_collection_analysis_result_s
     void* _me;
     /** The collection of individual AOIs. */
     struct {
-        /** The aoi analysis list. */
-        struct {
-            char label[GAC_AOI_MAX_LABEL_LEN];
-            gac_aoi_analysis_t analysis;
-        } items[GAC_AOI_MAX];
+        /**
+         * The aoi analysis list in ascending AOI order. Only AOIs which were
+         * hit by a fixation, a saccade, or a sample are listed. The list is
+         * owned by the AOI collection and remains valid until the next
+         * analysis result is produced by the collection or the collection is
+         * destroyed.
+         */
+        gac_aoi_collection_analysis_item_t* items;
         /** The number of AOIs in the list. */
         uint32_t count;
     } aois;
+    /**
+     * The scanpath of the trial, i.e. the AOI hit by each fixation and the
+     * transition counts between these AOIs. The scanpath is owned by the AOI
+     * collection and remains valid as long as the AOI list.
+     */
+    gac_aoi_scanpath_t* scanpath;
     /** The trial ID associated to the analysis. */
     uint32_t trial_id;
 };
@@ -0,0 +1,167 @@
+/**
+ * A uniform grid index over the bounding boxes of AOIs. A point query returns
+ * the AOIs whose bounding boxes overlap the grid cell of the point, such that
+ * only these candidates need to be tested with gac_aoi_includes_point().
+ *
+ * @file
+ *  gac_aoi_grid.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_AOI_GRID_H
+#define GAC_AOI_GRID_H
+
+#include "gac_aoi.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The maximal number of grid cells per axis. */
+#define GAC_AOI_GRID_MAX_DIM 64
+
+/** ::gac_aoi_grid_s */
+typedef struct gac_aoi_grid_s gac_aoi_grid_t;
+
+/**
+ * The AOI grid structure. The AOI indices of all cells are stored in one
+ * array where the indices of each cell are sorted in ascending order.
+ */
+struct gac_aoi_grid_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The smallest x coordinate covered by the grid. */
+    float x_min;
+    /** The smallest y coordinate covered by the grid. */
+    float y_min;
+    /** The largest x coordinate covered by the grid. */
+    float x_max;
+    /** The largest y coordinate covered by the grid. */
+    float y_max;
+    /** The width of a grid cell. */
+    float cell_width;
+    /** The height of a grid cell. */
+    float cell_height;
+    /** The number of grid columns. */
+    uint32_t cols;
+    /** The number of grid rows. */
+    uint32_t rows;
+    /**
+     * The start offsets of the cells in the index list. The indices of cell i
+     * are located at [offsets[i], offsets[i + 1]).
+     */
+    struct {
+        /** The offset list. */
+        uint32_t* items;
+        /** The number of available spaces in the offset list. */
+        uint32_t length;
+    } offsets;
+    /** The AOI indices of all cells. */
+    struct {
+        /** The index list. */
+        uint32_t* items;
+        /** The number of indices in the list. */
+        uint32_t count;
+        /** The number of available spaces in the index list. */
+        uint32_t length;
+    } indices;
+};
+
+/**
+ * Build the grid index over a list of AOIs. This replaces the previous index.
+ * AOIs without points and dynamic AOIs (see gac_aoi_is_dynamic()) are not
+ * indexed.
+ *
+ * @param grid
+ *  A pointer to the AOI grid.
+ * @param aois
+ *  The AOI list to index.
+ * @param count
+ *  The number of AOIs in the list.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_grid_build( gac_aoi_grid_t* grid, gac_aoi_t* aois,
+        uint32_t count );
+
+/**
+ * Get the grid cell range covered by an interval along one axis.
+ *
+ * @param min
+ *  The lower interval bound.
+ * @param max
+ *  The upper interval bound.
+ * @param origin
+ *  The smallest coordinate covered by the grid along the axis.
+ * @param size
+ *  The cell size along the axis.
+ * @param dim
+ *  The number of cells along the axis.
+ * @param first
+ *  A location to store the first covered cell.
+ * @param last
+ *  A location to store the last covered cell.
+ */
+void gac_aoi_grid_cell_range( float min, float max, float origin, float size,
+        uint32_t dim, uint32_t* first, uint32_t* last );
+
+/**
+ * Clear the grid index.
+ *
+ * @param grid
+ *  A pointer to the AOI grid.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_grid_clear( gac_aoi_grid_t* grid );
+
+/**
+ * Allocate a new AOI grid structure on the heap. This needs to be freed with
+ * gac_aoi_grid_destroy().
+ *
+ * @return
+ *  A pointer to the allocated grid or NULL on failure.
+ */
+gac_aoi_grid_t* gac_aoi_grid_create();
+
+/**
+ * Destroy an AOI grid.
+ *
+ * @param grid
+ *  A pointer to the AOI grid to destroy.
+ */
+void gac_aoi_grid_destroy( gac_aoi_grid_t* grid );
+
+/**
+ * Initialise an empty AOI grid structure.
+ *
+ * @param grid
+ *  A pointer to the AOI grid to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_grid_init( gac_aoi_grid_t* grid );
+
+/**
+ * Get the candidate AOIs which may include a point.
+ *
+ * @param grid
+ *  A pointer to the AOI grid.
+ * @param x
+ *  The x coordinate of the point.
+ * @param y
+ *  The y coordinate of the point.
+ * @param candidates
+ *  A location to store a pointer to the ascending list of candidate AOI
+ *  indices. The list is valid until the grid is rebuilt.
+ * @return
+ *  The number of candidate AOIs.
+ */
+uint32_t gac_aoi_grid_query( gac_aoi_grid_t* grid, float x, float y,
+        uint32_t** candidates );
+
+#endif
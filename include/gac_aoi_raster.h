@@ -0,0 +1,243 @@
+/**
+ * A rasterised AOI lookup map. The normalised screen area [0, 1] x [0, 1] is
+ * divided into cells (e.g. one cell per screen pixel) and each cell refers to
+ * the set of AOIs covering it. An AOI either covers a cell completely or the
+ * AOI contour passes through the cell. Only in the latter case an exact
+ * polygon test is required to classify a point.
+ *
+ * Cells with the same AOI set share one set entry such that the memory
+ * consumption is dominated by one set ID per cell.
+ *
+ * @file
+ *  gac_aoi_raster.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_AOI_RASTER_H
+#define GAC_AOI_RASTER_H
+
+#include "gac_aoi.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Flags a set entry where the AOI contour passes through the cell. */
+#define GAC_AOI_RASTER_BOUNDARY 0x80000000u
+/** The tolerance in cells used to mark the cells touched by an AOI edge. */
+#define GAC_AOI_RASTER_EPSILON 1e-4f
+
+/** ::gac_aoi_raster_s */
+typedef struct gac_aoi_raster_s gac_aoi_raster_t;
+
+/**
+ * The AOI raster structure.
+ */
+struct gac_aoi_raster_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The number of cells along the x axis. */
+    uint32_t width;
+    /** The number of cells along the y axis. */
+    uint32_t height;
+    /** The set ID of each cell in row-major order. */
+    uint32_t* cells;
+    /**
+     * The start offsets of the sets in the entry list. The entries of set i
+     * are located at [offsets[i], offsets[i + 1]).
+     */
+    struct {
+        /** The offset list. */
+        uint32_t* items;
+        /** The number of sets. */
+        uint32_t count;
+    } offsets;
+    /**
+     * The AOI indices of all sets in ascending order, flagged with
+     * #GAC_AOI_RASTER_BOUNDARY if an exact test is required.
+     */
+    struct {
+        /** The entry list. */
+        uint32_t* items;
+        /** The number of entries. */
+        uint32_t count;
+    } entries;
+    /**
+     * The sets created while building the raster. Each set is stored as its
+     * parent set plus one entry.
+     */
+    struct {
+        /** The parent set of each set. */
+        uint32_t* parents;
+        /** The last entry of each set. */
+        uint32_t* entries;
+        /** The number of sets. */
+        uint32_t count;
+        /** The number of available spaces in the set lists. */
+        uint32_t length;
+        /** The hash buckets mapping a parent set and an entry to a set. */
+        uint32_t* buckets;
+        /** The number of hash buckets, a power of two. */
+        uint32_t bucket_count;
+    } sets;
+    /** The boundary marks of the cell window of the AOI being rasterised. */
+    struct {
+        /** The mark list in row-major order. */
+        uint8_t* items;
+        /** The number of available spaces in the mark list. */
+        uint32_t length;
+        /** The first column of the window. */
+        uint32_t x;
+        /** The first row of the window. */
+        uint32_t y;
+        /** The number of columns of the window. */
+        uint32_t width;
+        /** The number of rows of the window. */
+        uint32_t height;
+    } marks;
+};
+
+/**
+ * Add an AOI to all cells of the raster it covers. AOIs must be added in
+ * ascending index order. Dynamic AOIs (see gac_aoi_is_dynamic()) are not
+ * added.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @param aoi
+ *  A pointer to the AOI to add.
+ * @param idx
+ *  The index of the AOI in the AOI list.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_raster_add( gac_aoi_raster_t* raster, gac_aoi_t* aoi,
+        uint32_t idx );
+
+/**
+ * Build the raster of a list of AOIs. This replaces the previous raster.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @param aois
+ *  The AOI list to rasterise.
+ * @param count
+ *  The number of AOIs in the list.
+ * @param width
+ *  The number of cells along the x axis.
+ * @param height
+ *  The number of cells along the y axis.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_raster_build( gac_aoi_raster_t* raster, gac_aoi_t* aois,
+        uint32_t count, uint32_t width, uint32_t height );
+
+/**
+ * Free the raster data and reset the raster to an empty raster.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_raster_clear( gac_aoi_raster_t* raster );
+
+/**
+ * Allocate a new AOI raster structure on the heap. This needs to be freed with
+ * gac_aoi_raster_destroy().
+ *
+ * @return
+ *  A pointer to the allocated raster or NULL on failure.
+ */
+gac_aoi_raster_t* gac_aoi_raster_create();
+
+/**
+ * Destroy an AOI raster.
+ *
+ * @param raster
+ *  A pointer to the AOI raster to destroy.
+ */
+void gac_aoi_raster_destroy( gac_aoi_raster_t* raster );
+
+/**
+ * Convert the sets created while building the raster to the compact entry
+ * list and free the build data.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_raster_flatten( gac_aoi_raster_t* raster );
+
+/**
+ * Initialise an empty AOI raster structure.
+ *
+ * @param raster
+ *  A pointer to the AOI raster to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_raster_init( gac_aoi_raster_t* raster );
+
+/**
+ * Mark all cells of the current window touched by an AOI edge.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @param p
+ *  The start point of the edge.
+ * @param q
+ *  The end point of the edge.
+ */
+void gac_aoi_raster_mark_edge( gac_aoi_raster_t* raster, vec2* p, vec2* q );
+
+/**
+ * Get the AOIs including a point.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @param aois
+ *  The AOI list the raster was built from.
+ * @param x
+ *  The x coordinate of the point.
+ * @param y
+ *  The y coordinate of the point.
+ * @param hits
+ *  An array where the ascending indices of the AOIs including the point are
+ *  stored.
+ * @param length
+ *  The number of available spaces in the hit array.
+ * @param count
+ *  A location to store the number of hits written to the array.
+ * @return
+ *  True if the point is covered by the raster, false otherwise. In the latter
+ *  case the point has to be classified without the raster.
+ */
+bool gac_aoi_raster_query( gac_aoi_raster_t* raster, gac_aoi_t* aois,
+        float x, float y, uint32_t* hits, uint32_t length, uint32_t* count );
+
+/**
+ * Get the set which extends a set by one entry. The set is created if it does
+ * not exist yet.
+ *
+ * @param raster
+ *  A pointer to the AOI raster.
+ * @param parent
+ *  The set to extend.
+ * @param entry
+ *  The entry to add.
+ * @param set
+ *  A location to store the extended set.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_raster_set_add( gac_aoi_raster_t* raster, uint32_t parent,
+        uint32_t entry, uint32_t* set );
+
+#endif
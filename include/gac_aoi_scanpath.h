@@ -0,0 +1,170 @@
+/**
+ * The AOI scanpath of a trial, i.e. the sequence of AOIs hit by consecutive
+ * fixations, and the sparse matrix of transition counts between these AOIs.
+ * Both are updated in constant time per fixation.
+ *
+ * @file
+ *  gac_aoi_scanpath.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_AOI_SCANPATH_H
+#define GAC_AOI_SCANPATH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** ::gac_aoi_scanpath_s */
+typedef struct gac_aoi_scanpath_s gac_aoi_scanpath_t;
+/** ::gac_aoi_transition_s */
+typedef struct gac_aoi_transition_s gac_aoi_transition_t;
+
+/**
+ * A non-zero entry of the AOI transition matrix.
+ */
+struct gac_aoi_transition_s
+{
+    /** The index of the AOI the transition starts in. */
+    uint32_t from;
+    /** The index of the AOI the transition ends in. */
+    uint32_t to;
+    /** The number of transitions from the AOI `from` to the AOI `to`. */
+    uint32_t count;
+};
+
+/**
+ * The AOI scanpath structure.
+ */
+struct gac_aoi_scanpath_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The sequence of AOI indices. */
+    struct {
+        /** The AOI index list. */
+        uint32_t* items;
+        /** The fixation duration in milliseconds of each AOI visit. */
+        double* durations;
+        /** The number of AOI indices in the sequence. */
+        uint32_t count;
+        /** The number of available spaces in the AOI index list. */
+        uint32_t length;
+    } aois;
+    /**
+     * The non-zero entries of the transition matrix in the order the
+     * transitions first occurred.
+     */
+    struct {
+        /** The transition list. */
+        gac_aoi_transition_t* items;
+        /** The number of transitions in the list. */
+        uint32_t count;
+        /** The number of available spaces in the transition list. */
+        uint32_t length;
+    } transitions;
+    /**
+     * The hash table of the transitions. A bucket holds the index of a
+     * transition plus one or 0 if the bucket is empty.
+     */
+    struct {
+        /** The bucket list. */
+        uint32_t* items;
+        /** The number of buckets, a power of two. */
+        uint32_t length;
+    } buckets;
+};
+
+/**
+ * Append an AOI to the scanpath and count the transition from the previous
+ * AOI of the scanpath.
+ *
+ * @param scanpath
+ *  A pointer to the AOI scanpath.
+ * @param aoi_id
+ *  The index of the AOI.
+ * @param duration
+ *  The duration of the fixation hitting the AOI in milliseconds.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_add( gac_aoi_scanpath_t* scanpath, uint32_t aoi_id,
+        double duration );
+
+/**
+ * Clear the AOI scanpath. This only touches the buckets of the recorded
+ * transitions.
+ *
+ * @param scanpath
+ *  A pointer to the AOI scanpath.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_clear( gac_aoi_scanpath_t* scanpath );
+
+/**
+ * Allocate a new AOI scanpath structure on the heap. This needs to be freed
+ * with gac_aoi_scanpath_destroy().
+ *
+ * @return
+ *  A pointer to the allocated scanpath or NULL on failure.
+ */
+gac_aoi_scanpath_t* gac_aoi_scanpath_create();
+
+/**
+ * Destroy an AOI scanpath.
+ *
+ * @param scanpath
+ *  A pointer to the AOI scanpath to destroy.
+ */
+void gac_aoi_scanpath_destroy( gac_aoi_scanpath_t* scanpath );
+
+/**
+ * Find a transition in the AOI scanpath.
+ *
+ * @param scanpath
+ *  A pointer to the AOI scanpath.
+ * @param from
+ *  The index of the AOI the transition starts in.
+ * @param to
+ *  The index of the AOI the transition ends in.
+ * @param idx
+ *  A location to store the index of the transition in the transition list.
+ *  If the transition is not found, this is the bucket where the transition
+ *  would be inserted.
+ * @return
+ *  True if the transition was found, false otherwise.
+ */
+bool gac_aoi_scanpath_find_transition( gac_aoi_scanpath_t* scanpath,
+        uint32_t from, uint32_t to, uint32_t* idx );
+
+/**
+ * Get the number of transitions between two AOIs.
+ *
+ * @param scanpath
+ *  A pointer to the AOI scanpath.
+ * @param from
+ *  The index of the AOI the transitions start in.
+ * @param to
+ *  The index of the AOI the transitions end in.
+ * @return
+ *  The number of transitions.
+ */
+uint32_t gac_aoi_scanpath_get_transition_count( gac_aoi_scanpath_t* scanpath,
+        uint32_t from, uint32_t to );
+
+/**
+ * Initialise an empty AOI scanpath structure.
+ *
+ * @param scanpath
+ *  A pointer to the AOI scanpath to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_init( gac_aoi_scanpath_t* scanpath );
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * Similarity measures of AOI scanpaths, i.e. the Levenshtein distance of two
+ * AOI sequences and the ScanMatch score of two fixation sequences. The
+ * comparison structure keeps its work buffers between comparisons such that
+ * comparing many pairs of scanpaths does not require heap allocations.
+ *
+ * @file
+ *  gac_aoi_scanpath_compare.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_AOI_SCANPATH_COMPARE_H
+#define GAC_AOI_SCANPATH_COMPARE_H
+
+#include "gac_aoi.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** ::gac_aoi_scanpath_compare_s */
+typedef struct gac_aoi_scanpath_compare_s gac_aoi_scanpath_compare_t;
+
+/**
+ * The scanpath comparison structure.
+ */
+struct gac_aoi_scanpath_compare_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /**
+     * The match masks of the Levenshtein distance. For each AOI the mask
+     * holds one bit per position of the pattern sequence.
+     */
+    struct {
+        /** The mask list of all AOIs, one block of words per AOI. */
+        uint64_t* items;
+        /** The number of available words in the mask list. */
+        uint32_t length;
+    } peq;
+    /** The vertical delta vectors of the Levenshtein distance. */
+    struct {
+        /** The positive and the negative delta of each word. */
+        uint64_t* items;
+        /** The number of available words in the delta list. */
+        uint32_t length;
+    } deltas;
+    /** The ScanMatch parameters. */
+    struct {
+        /**
+         * The row-major substitution matrix of size `aoi_count` x
+         * `aoi_count`.
+         */
+        double* substitution;
+        /** The number of AOIs covered by the substitution matrix. */
+        uint32_t aoi_count;
+        /** The largest value of the substitution matrix. */
+        double max_substitution;
+        /** The score of a gap in the alignment. */
+        double gap;
+        /** The duration of a temporal bin in milliseconds. */
+        double bin_width;
+    } scanmatch;
+    /** The temporally binned sequences of the ScanMatch alignment. */
+    struct {
+        /** The AOI indices of the first sequence followed by the second. */
+        uint32_t* items;
+        /** The number of available spaces in the sequence list. */
+        uint32_t length;
+    } bins;
+    /** The row of the ScanMatch alignment matrix. */
+    struct {
+        /** The score list. */
+        double* items;
+        /** The number of available spaces in the score list. */
+        uint32_t length;
+    } scores;
+};
+
+/**
+ * Get the number of temporal bins of a fixation in the ScanMatch alignment,
+ * i.e. the fixation duration divided by the bin width, rounded to the
+ * nearest integer. Each fixation occupies at least one bin.
+ *
+ * @param cmp
+ *  A pointer to the scanpath comparison structure.
+ * @param duration
+ *  The fixation duration in milliseconds.
+ * @return
+ *  The number of bins.
+ */
+uint32_t gac_aoi_scanpath_compare_bin_count( gac_aoi_scanpath_compare_t* cmp,
+        double duration );
+
+/**
+ * Allocate a new scanpath comparison structure on the heap. This needs to be
+ * freed with gac_aoi_scanpath_compare_destroy().
+ *
+ * @return
+ *  A pointer to the allocated structure or NULL on failure.
+ */
+gac_aoi_scanpath_compare_t* gac_aoi_scanpath_compare_create();
+
+/**
+ * Destroy a scanpath comparison structure.
+ *
+ * @param cmp
+ *  A pointer to the structure to destroy.
+ */
+void gac_aoi_scanpath_compare_destroy( gac_aoi_scanpath_compare_t* cmp );
+
+/**
+ * Initialise a scanpath comparison structure. The ScanMatch alignment
+ * requires a substitution matrix, see gac_aoi_scanpath_compare_set_aois()
+ * and gac_aoi_scanpath_compare_set_substitution().
+ *
+ * @param cmp
+ *  A pointer to the structure to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_compare_init( gac_aoi_scanpath_compare_t* cmp );
+
+/**
+ * Compute the Levenshtein distance of two AOI sequences, i.e. the minimal
+ * number of insertions, deletions, and substitutions of AOIs to transform
+ * one sequence into the other. The distance is computed with the
+ * bit-parallel algorithm of Myers (1999) in blocks of 64 AOIs of the shorter
+ * sequence, hence, in O(ceil(m/64) * n) time.
+ *
+ * @param cmp
+ *  A pointer to the scanpath comparison structure.
+ * @param a
+ *  The AOI indices of the first sequence.
+ * @param a_count
+ *  The number of AOIs in the first sequence.
+ * @param b
+ *  The AOI indices of the second sequence.
+ * @param b_count
+ *  The number of AOIs in the second sequence.
+ * @param distance
+ *  A location to store the distance.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_compare_levenshtein( gac_aoi_scanpath_compare_t* cmp,
+        const uint32_t* a, uint32_t a_count, const uint32_t* b,
+        uint32_t b_count, uint32_t* distance );
+
+/**
+ * Compute the ScanMatch score of two fixation sequences (Cristino et al.
+ * 2010). Each fixation is repeated once per temporal bin of its duration and
+ * the binned sequences are aligned with the Needleman-Wunsch algorithm. The
+ * score is normalised by the largest substitution value times the length of
+ * the longer binned sequence such that identical sequences score 1. Two
+ * empty sequences score 0.
+ *
+ * @param cmp
+ *  A pointer to the scanpath comparison structure.
+ * @param a
+ *  The AOI indices of the first sequence.
+ * @param a_durations
+ *  The fixation durations of the first sequence in milliseconds.
+ * @param a_count
+ *  The number of fixations in the first sequence.
+ * @param b
+ *  The AOI indices of the second sequence.
+ * @param b_durations
+ *  The fixation durations of the second sequence in milliseconds.
+ * @param b_count
+ *  The number of fixations in the second sequence.
+ * @param score
+ *  A location to store the normalised score.
+ * @return
+ *  True on success, false on failure or if an AOI index is not covered by
+ *  the substitution matrix.
+ */
+bool gac_aoi_scanpath_compare_scanmatch( gac_aoi_scanpath_compare_t* cmp,
+        const uint32_t* a, const double* a_durations, uint32_t a_count,
+        const uint32_t* b, const double* b_durations, uint32_t b_count,
+        double* score );
+
+/**
+ * Compute the ScanMatch substitution matrix from the distances between the
+ * bounding box centers of AOIs. The substitution value of two AOIs is
+ * `1 - distance / threshold`, i.e. 1 for the same AOI, positive for AOIs
+ * closer than the threshold and negative otherwise.
+ *
+ * @param cmp
+ *  A pointer to the scanpath comparison structure.
+ * @param aois
+ *  The AOI list, e.g. the AOIs of an AOI collection.
+ * @param count
+ *  The number of AOIs in the list.
+ * @param threshold
+ *  The distance at which the substitution value becomes 0, e.g. two
+ *  standard deviations of the saccade amplitude.
+ * @param gap
+ *  The score of a gap in the alignment.
+ * @param bin_width
+ *  The duration of a temporal bin in milliseconds. If set to 0 the
+ *  fixation durations are ignored.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_compare_set_aois( gac_aoi_scanpath_compare_t* cmp,
+        gac_aoi_t* aois, uint32_t count, double threshold, double gap,
+        double bin_width );
+
+/**
+ * Set the ScanMatch substitution matrix. The matrix is copied and its
+ * largest value must be positive.
+ *
+ * @param cmp
+ *  A pointer to the scanpath comparison structure.
+ * @param substitution
+ *  The row-major substitution matrix of size `aoi_count` x `aoi_count`. If
+ *  set to NULL the matrix is allocated but not initialised, the largest
+ *  value is then assumed to be 1.
+ * @param aoi_count
+ *  The number of AOIs covered by the substitution matrix.
+ * @param gap
+ *  The score of a gap in the alignment.
+ * @param bin_width
+ *  The duration of a temporal bin in milliseconds. If set to 0 the
+ *  fixation durations are ignored.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_scanpath_compare_set_substitution(
+        gac_aoi_scanpath_compare_t* cmp, const double* substitution,
+        uint32_t aoi_count, double gap, double bin_width );
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * A uniform bin index over the visibility intervals of dynamic AOIs. A time
+ * query returns the dynamic AOIs which are visible at some point within the
+ * bin of the timestamp, such that only these candidates need to be tested
+ * with gac_aoi_includes_point_at().
+ *
+ * @file
+ *  gac_aoi_timeline.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_AOI_TIMELINE_H
+#define GAC_AOI_TIMELINE_H
+
+#include "gac_aoi.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The maximal number of timeline bins. */
+#define GAC_AOI_TIMELINE_MAX_BINS 4096
+
+/** ::gac_aoi_timeline_s */
+typedef struct gac_aoi_timeline_s gac_aoi_timeline_t;
+
+/**
+ * The AOI timeline structure. The AOI indices of all bins are stored in one
+ * array where the indices of each bin are sorted in ascending order.
+ */
+struct gac_aoi_timeline_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The smallest timestamp covered by the timeline. */
+    double t_min;
+    /** The largest timestamp covered by the timeline. */
+    double t_max;
+    /** The duration of a timeline bin. */
+    double bin_width;
+    /** The number of timeline bins. */
+    uint32_t bin_count;
+    /**
+     * The start offsets of the bins in the index list. The indices of bin i
+     * are located at [offsets[i], offsets[i + 1]).
+     */
+    struct {
+        /** The offset list. */
+        uint32_t* items;
+        /** The number of available spaces in the offset list. */
+        uint32_t length;
+    } offsets;
+    /** The AOI indices of all bins. */
+    struct {
+        /** The index list. */
+        uint32_t* items;
+        /** The number of indices in the list. */
+        uint32_t count;
+        /** The number of available spaces in the index list. */
+        uint32_t length;
+    } indices;
+};
+
+/**
+ * Get the timeline bin range covered by a time interval.
+ *
+ * @param start
+ *  The lower interval bound.
+ * @param end
+ *  The upper interval bound.
+ * @param origin
+ *  The smallest timestamp covered by the timeline.
+ * @param width
+ *  The duration of a bin.
+ * @param count
+ *  The number of bins.
+ * @param first
+ *  A location to store the first covered bin.
+ * @param last
+ *  A location to store the last covered bin.
+ */
+void gac_aoi_timeline_bin_range( double start, double end, double origin,
+        double width, uint32_t count, uint32_t* first, uint32_t* last );
+
+/**
+ * Build the timeline index over a list of AOIs. This replaces the previous
+ * index. Only dynamic AOIs (see gac_aoi_is_dynamic()) are indexed.
+ *
+ * @param timeline
+ *  A pointer to the AOI timeline.
+ * @param aois
+ *  The AOI list to index.
+ * @param count
+ *  The number of AOIs in the list.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_timeline_build( gac_aoi_timeline_t* timeline, gac_aoi_t* aois,
+        uint32_t count );
+
+/**
+ * Clear the timeline index.
+ *
+ * @param timeline
+ *  A pointer to the AOI timeline.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_timeline_clear( gac_aoi_timeline_t* timeline );
+
+/**
+ * Allocate a new AOI timeline structure on the heap. This needs to be freed
+ * with gac_aoi_timeline_destroy().
+ *
+ * @return
+ *  A pointer to the allocated timeline or NULL on failure.
+ */
+gac_aoi_timeline_t* gac_aoi_timeline_create();
+
+/**
+ * Destroy an AOI timeline.
+ *
+ * @param timeline
+ *  A pointer to the AOI timeline to destroy.
+ */
+void gac_aoi_timeline_destroy( gac_aoi_timeline_t* timeline );
+
+/**
+ * Initialise an empty AOI timeline structure.
+ *
+ * @param timeline
+ *  A pointer to the AOI timeline to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_aoi_timeline_init( gac_aoi_timeline_t* timeline );
+
+/**
+ * Get the candidate AOIs which may be visible at a timestamp.
+ *
+ * @param timeline
+ *  A pointer to the AOI timeline.
+ * @param timestamp
+ *  The timestamp to look up.
+ * @param candidates
+ *  A location to store a pointer to the ascending list of candidate AOI
+ *  indices. The list is valid until the timeline is rebuilt.
+ * @return
+ *  The number of candidate AOIs.
+ */
+uint32_t gac_aoi_timeline_query( gac_aoi_timeline_t* timeline,
+        double timestamp, uint32_t** candidates );
+
+/**
+ * Get a visibility span of a dynamic AOI. The span is the visibility
+ * interval limited to the time range of the keyframes. An AOI without
+ * visibility intervals has a single span.
+ *
+ * @param aoi
+ *  A pointer to a dynamic AOI.
+ * @param idx
+ *  The index of the visibility interval.
+ * @param start
+ *  A location to store the start of the span.
+ * @param end
+ *  A location to store the end of the span.
+ * @return
+ *  True if the span is not empty, false otherwise.
+ */
+bool gac_aoi_timeline_span( gac_aoi_t* aoi, uint32_t idx, double* start,
+        double* end );
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * A parallel reader for large CSV sample files. The file is mapped into
+ * memory and split at line boundaries into chunks which are parsed by a pool
+ * of worker threads. The batches of the chunks are returned in the order of
+ * the file such that they can be passed to gac_sample_window_update_batch()
+ * while the workers parse the following chunks.
+ *
+ * @file
+ *  gac_csv_parallel.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_CSV_PARALLEL_H
+#define GAC_CSV_PARALLEL_H
+
+#include "gac.h"
+#include "gac_csv_reader.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/** The default chunk size in bytes. */
+#define GAC_CSV_PARALLEL_CHUNK_SIZE 4194304
+
+/** ::gac_csv_parallel_s */
+typedef struct gac_csv_parallel_s gac_csv_parallel_t;
+/** ::gac_csv_parallel_worker_s */
+typedef struct gac_csv_parallel_worker_s gac_csv_parallel_worker_t;
+
+/**
+ * A worker thread of the parallel reader. Worker `i` parses the chunks
+ * `i`, `i + n`, `i + 2n`, ... where `n` is the number of workers.
+ */
+struct gac_csv_parallel_worker_s
+{
+    /** The parallel reader the worker belongs to. */
+    gac_csv_parallel_t* parallel;
+    /** The index of the worker. */
+    uint32_t idx;
+    /** The worker thread. */
+    pthread_t thread;
+    /** A flag indicating whether the thread was started. */
+    bool is_started;
+    /**
+     * The CSV reader of the worker. The file buffer holds a copy of the
+     * current chunk and the samples hold the current batch.
+     */
+    gac_csv_reader_t reader;
+    /** The label table of the worker. */
+    gac_label_table_t labels;
+    /**
+     * The label IDs of the worker labels in the label table of the parallel
+     * reader, indexed by worker label ID.
+     */
+    struct {
+        /** The label ID list. */
+        uint32_t* items;
+        /** The number of mapped label IDs. */
+        uint32_t count;
+        /** The number of available spaces in the label ID list. */
+        uint32_t length;
+    } label_ids;
+    /** The lock protecting the batch handover. */
+    pthread_mutex_t lock;
+    /** Signals a batch ready to be consumed. */
+    pthread_cond_t ready;
+    /** Signals the consumption of the batch. */
+    pthread_cond_t consumed;
+    /** A flag indicating whether a batch is ready to be consumed. */
+    bool is_ready;
+    /** A flag indicating whether the batch is the last batch of a chunk. */
+    bool is_last;
+    /** A flag indicating whether a chunk could not be parsed. */
+    bool is_error;
+    /** A flag requesting the worker to stop. */
+    bool stop;
+};
+
+/**
+ * The parallel CSV reader structure.
+ */
+struct gac_csv_parallel_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The mapped file. */
+    const char* data;
+    /** The size of the mapped file in bytes. */
+    uint64_t size;
+    /**
+     * The size of a chunk in bytes. A chunk ends at the first line break
+     * after its size, hence, chunks hold complete lines. This may be changed
+     * until the first batch is read.
+     */
+    uint32_t chunk_size;
+    /**
+     * The configuration of the workers. The delimiter, the number of lines
+     * to skip, and the column layout of this reader are used by all
+     * workers and may be changed until the first batch is read. The
+     * statistics of this reader hold the sum of all consumed chunks.
+     */
+    gac_csv_reader_t reader;
+    /** A flag indicating whether the workers were started. */
+    bool is_started;
+    /** The index of the chunk of the next batch. */
+    uint64_t chunk_idx;
+    /** The number of chunks. */
+    uint64_t chunk_count;
+    /** The worker holding the batch currently consumed, or NULL. */
+    gac_csv_parallel_worker_t* current;
+    /** The worker pool of the reader. */
+    struct {
+        /** The worker list. */
+        gac_csv_parallel_worker_t* items;
+        /** The number of workers. */
+        uint32_t count;
+    } workers;
+};
+
+/**
+ * Allocate a new parallel CSV reader structure on the heap. This needs to
+ * be freed with gac_csv_parallel_destroy().
+ *
+ * @param fp
+ *  The CSV file to map. The file may be closed once the reader is created.
+ * @param labels
+ *  The label table to intern the sample labels or NULL to ignore labels.
+ * @param worker_count
+ *  The number of worker threads. If set to 0 one worker per online
+ *  processor is used.
+ * @return
+ *  A pointer to the allocated reader or NULL on failure.
+ */
+gac_csv_parallel_t* gac_csv_parallel_create( FILE* fp,
+        gac_label_table_t* labels, uint32_t worker_count );
+
+/**
+ * Stop the workers and destroy the parallel CSV reader structure.
+ *
+ * @param cp
+ *  A pointer to the reader to destroy.
+ */
+void gac_csv_parallel_destroy( gac_csv_parallel_t* cp );
+
+/**
+ * Initialise a parallel CSV reader structure by mapping the file into
+ * memory. The workers are started when the first batch is read. The column
+ * layout is configured with gac_csv_reader_set_column() on the reader
+ * member.
+ *
+ * @param cp
+ *  A pointer to the reader to initialise.
+ * @param fp
+ *  The CSV file to map. The file may be closed once the reader is
+ *  initialised.
+ * @param labels
+ *  The label table to intern the sample labels or NULL to ignore labels.
+ * @param worker_count
+ *  The number of worker threads. If set to 0 one worker per online
+ *  processor is used.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_csv_parallel_init( gac_csv_parallel_t* cp, FILE* fp,
+        gac_label_table_t* labels, uint32_t worker_count );
+
+/**
+ * Read the next batch of samples in the order of the file. This blocks
+ * until the worker parsing the batch is done. The batch refers to the
+ * sample arrays of a worker which remain valid until the next batch is
+ * read.
+ *
+ * @param cp
+ *  A pointer to the parallel CSV reader.
+ * @param batch
+ *  A location to store the batch.
+ * @return
+ *  True if the batch holds at least one sample, false at the end of the
+ *  file or on failure.
+ */
+bool gac_csv_parallel_read( gac_csv_parallel_t* cp,
+        gac_sample_batch_t* batch );
+
+/**
+ * Start the worker threads. This is called by gac_csv_parallel_read() when
+ * the first batch is read and applies the configuration of the reader member
+ * to all workers.
+ *
+ * @param cp
+ *  A pointer to the parallel CSV reader.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_csv_parallel_start( gac_csv_parallel_t* cp );
+
+/**
+ * The worker thread function. The worker copies its chunks from the mapped
+ * file, parses them into batches, and hands each batch over to
+ * gac_csv_parallel_read().
+ *
+ * @param arg
+ *  A pointer to the worker structure.
+ * @return
+ *  Always NULL.
+ */
+void* gac_csv_parallel_worker_run( void* arg );
+
+#endif
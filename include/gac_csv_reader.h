@@ -0,0 +1,348 @@
+/**
+ * A reader for gaze data samples stored in CSV files. The reader parses the
+ * file in place in large chunks without allocating memory per field and
+ * provides the samples as batches which can be passed to
+ * gac_sample_window_update_batch(). Numbers are parsed independently of the
+ * locale.
+ *
+ * @file
+ *  gac_csv_reader.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_CSV_READER_H
+#define GAC_CSV_READER_H
+
+#include "gac.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/** The default number of samples per batch. */
+#define GAC_CSV_READER_BATCH_LENGTH 4096
+/** The default size of the file buffer in bytes. */
+#define GAC_CSV_READER_BUFFER_LENGTH 65536
+/** The column index of fields which are not part of the CSV file. */
+#define GAC_CSV_COLUMN_NONE UINT32_MAX
+
+/** ::gac_csv_reader_s */
+typedef struct gac_csv_reader_s gac_csv_reader_t;
+/** ::gac_csv_reader_stats_s */
+typedef struct gac_csv_reader_stats_s gac_csv_reader_stats_t;
+
+/**
+ * The sample fields which can be read from a CSV file.
+ */
+enum gac_csv_field_e
+{
+    /** The normalised x coordinate of the screen gaze point. */
+    GAC_CSV_FIELD_SCREEN_X,
+    /** The normalised y coordinate of the screen gaze point. */
+    GAC_CSV_FIELD_SCREEN_Y,
+    /** The x coordinate of the gaze point. */
+    GAC_CSV_FIELD_POINT_X,
+    /** The y coordinate of the gaze point. */
+    GAC_CSV_FIELD_POINT_Y,
+    /** The z coordinate of the gaze point. */
+    GAC_CSV_FIELD_POINT_Z,
+    /** The x coordinate of the gaze origin. */
+    GAC_CSV_FIELD_ORIGIN_X,
+    /** The y coordinate of the gaze origin. */
+    GAC_CSV_FIELD_ORIGIN_Y,
+    /** The z coordinate of the gaze origin. */
+    GAC_CSV_FIELD_ORIGIN_Z,
+    /** The sample timestamp in milliseconds. */
+    GAC_CSV_FIELD_TIMESTAMP,
+    /** The trial ID. */
+    GAC_CSV_FIELD_TRIAL_ID,
+    /** The label string. */
+    GAC_CSV_FIELD_LABEL,
+    /** The validity flag of the screen gaze point. */
+    GAC_CSV_FIELD_SCREEN_VALID,
+    /** The validity flag of the gaze point. */
+    GAC_CSV_FIELD_POINT_VALID,
+    /** The validity flag of the gaze origin. */
+    GAC_CSV_FIELD_ORIGIN_VALID,
+    /** The number of fields. */
+    GAC_CSV_FIELD_COUNT,
+};
+
+/** #gac_csv_field_e */
+typedef enum gac_csv_field_e gac_csv_field_t;
+
+/**
+ * The line statistics of a CSV reader.
+ */
+struct gac_csv_reader_stats_s
+{
+    /** The number of lines read, including skipped lines. */
+    uint64_t line_count;
+    /** The number of samples read. */
+    uint64_t sample_count;
+    /** The number of lines skipped because a validity flag was false. */
+    uint64_t invalid_count;
+    /** The number of lines skipped because a field could not be parsed. */
+    uint64_t error_count;
+};
+
+/**
+ * The CSV reader structure.
+ */
+struct gac_csv_reader_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The file to read from. The file is not owned by the reader. */
+    FILE* fp;
+    /**
+     * The label table to intern the labels of the samples, e.g. the label
+     * table of the gaze analysis handler. If NULL labels are ignored.
+     */
+    gac_label_table_t* labels;
+    /** The field delimiter. */
+    char delimiter;
+    /** The number of lines to skip before the first sample, e.g. a header. */
+    uint32_t skip_lines;
+    /**
+     * The column index of each field (see #gac_csv_field_e) or
+     * #GAC_CSV_COLUMN_NONE if the field is not part of the file.
+     */
+    uint32_t columns[GAC_CSV_FIELD_COUNT];
+    /** The field of each column or #GAC_CSV_FIELD_COUNT if unused. */
+    struct {
+        /** The field list, indexed by column. */
+        uint8_t* items;
+        /** The number of columns up to the last used column. */
+        uint32_t count;
+    } fields;
+    /** The file buffer holding the not yet parsed bytes. */
+    struct {
+        /** The byte buffer. */
+        char* items;
+        /** The position of the first byte not yet parsed. */
+        uint32_t pos;
+        /** The number of bytes in the buffer. */
+        uint32_t count;
+        /** The size of the buffer in bytes. */
+        uint32_t length;
+    } buffer;
+    /** A flag indicating whether the end of the file was reached. */
+    bool is_eof;
+    /**
+     * A flag indicating whether reading failed, i.e. the file could not be
+     * read or the buffer could not be grown.
+     */
+    bool is_error;
+    /** The samples of the current batch in structure-of-arrays layout. */
+    struct {
+        /** The x coordinates of the screen gaze points. */
+        float* screen_x;
+        /** The y coordinates of the screen gaze points. */
+        float* screen_y;
+        /** The x coordinates of the gaze points. */
+        float* point_x;
+        /** The y coordinates of the gaze points. */
+        float* point_y;
+        /** The z coordinates of the gaze points. */
+        float* point_z;
+        /** The x coordinates of the gaze origins. */
+        float* origin_x;
+        /** The y coordinates of the gaze origins. */
+        float* origin_y;
+        /** The z coordinates of the gaze origins. */
+        float* origin_z;
+        /** The sample timestamps. */
+        double* timestamp;
+        /** The trial IDs. */
+        uint32_t* trial_id;
+        /** The label IDs. */
+        uint32_t* label_id;
+        /** The number of samples in the batch. */
+        uint32_t count;
+        /** The maximal number of samples per batch. */
+        uint32_t length;
+    } samples;
+    /** The line statistics. */
+    gac_csv_reader_stats_t stats;
+};
+
+/**
+ * Allocate a new CSV reader structure on the heap. This needs to be freed
+ * with gac_csv_reader_destroy().
+ *
+ * @param fp
+ *  The file to read from. The file must remain open as long as samples are
+ *  read.
+ * @param labels
+ *  The label table to intern the sample labels or NULL to ignore labels.
+ * @param batch_length
+ *  The maximal number of samples per batch. If set to 0 the default
+ *  #GAC_CSV_READER_BATCH_LENGTH is used.
+ * @return
+ *  A pointer to the allocated reader or NULL on failure.
+ */
+gac_csv_reader_t* gac_csv_reader_create( FILE* fp, gac_label_table_t* labels,
+        uint32_t batch_length );
+
+/**
+ * Destroy a CSV reader structure. This does not close the file.
+ *
+ * @param reader
+ *  A pointer to the reader to destroy.
+ */
+void gac_csv_reader_destroy( gac_csv_reader_t* reader );
+
+/**
+ * Get the samples of the reader as batch. Fields which are not part of the
+ * file are set to NULL in the batch.
+ *
+ * @param reader
+ *  A pointer to the CSV reader.
+ * @param batch
+ *  A location to store the batch.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_csv_reader_get_batch( gac_csv_reader_t* reader,
+        gac_sample_batch_t* batch );
+
+/**
+ * Initialise a CSV reader structure. By default the reader expects the
+ * column layout of the tracker export, i.e. `sx,sy,px,py,pz,ox,oy,oz,
+ * timestamp,trial_id,label,svalid,pvalid,ovalid` with one header line.
+ * Change the layout with gac_csv_reader_set_column().
+ *
+ * @param reader
+ *  A pointer to the reader to initialise.
+ * @param fp
+ *  The file to read from. The file must remain open as long as samples are
+ *  read.
+ * @param labels
+ *  The label table to intern the sample labels or NULL to ignore labels.
+ * @param batch_length
+ *  The maximal number of samples per batch. If set to 0 the default
+ *  #GAC_CSV_READER_BATCH_LENGTH is used.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_csv_reader_init( gac_csv_reader_t* reader, FILE* fp,
+        gac_label_table_t* labels, uint32_t batch_length );
+
+/**
+ * Parse a boolean field. The values `True`, `true`, `TRUE`, and `1` are
+ * true, all other values are false.
+ *
+ * @param str
+ *  The first character of the field.
+ * @param end
+ *  The character after the last character of the field.
+ * @return
+ *  The boolean value.
+ */
+bool gac_csv_reader_parse_bool( const char* str, const char* end );
+
+/**
+ * Parse the lines of the file buffer starting at the current buffer
+ * position and append the samples to the batch until the batch is full. If
+ * the end of the file is reached, the last line is parsed even if it has no
+ * line break. This allows to parse a chunk of a file held in memory by
+ * filling the buffer and setting the end of file flag.
+ *
+ * @param reader
+ *  A pointer to the CSV reader.
+ * @return
+ *  True if the buffer holds no complete line anymore and more data needs to
+ *  be read from the file, false if the batch is full, the end of the file
+ *  was reached, or on failure.
+ */
+bool gac_csv_reader_parse_buffer( gac_csv_reader_t* reader );
+
+/**
+ * Parse a decimal floating point number independent of the locale, e.g.
+ * `-12.5`, `1e-3`, `NaN`, or `inf`. Numbers with up to 19 significant
+ * digits and a decimal exponent up to 22 whose mantissa fits into a double
+ * are converted exactly rounded, other numbers are scaled with pow().
+ *
+ * @param str
+ *  The first character of the field.
+ * @param end
+ *  The character after the last character of the field.
+ * @param value
+ *  A location to store the parsed value.
+ * @return
+ *  True on success, false if the field is not a number.
+ */
+bool gac_csv_reader_parse_double( const char* str, const char* end,
+        double* value );
+
+/**
+ * Parse one line of the CSV file and append the sample to the batch. Lines
+ * which are skipped, empty, invalid, or malformed are not added.
+ *
+ * @param reader
+ *  A pointer to the CSV reader.
+ * @param line
+ *  The first character of the line. The line is modified in place.
+ * @param end
+ *  The character after the last character of the line, excluding the line
+ *  break.
+ * @return
+ *  True if a sample was added, false otherwise.
+ */
+bool gac_csv_reader_parse_line( gac_csv_reader_t* reader, char* line,
+        char* end );
+
+/**
+ * Parse an unsigned decimal integer.
+ *
+ * @param str
+ *  The first character of the field.
+ * @param end
+ *  The character after the last character of the field.
+ * @param value
+ *  A location to store the parsed value.
+ * @return
+ *  True on success, false if the field is not an unsigned integer.
+ */
+bool gac_csv_reader_parse_uint( const char* str, const char* end,
+        uint32_t* value );
+
+/**
+ * Read the next batch of samples. The batch refers to the sample arrays of
+ * the reader which remain valid until the next batch is read. Fields which
+ * are not part of the file are set to NULL in the batch (see
+ * gac_csv_reader_get_batch()).
+ *
+ * @param reader
+ *  A pointer to the CSV reader.
+ * @param batch
+ *  A location to store the batch.
+ * @return
+ *  True if the batch holds at least one sample, false at the end of the
+ *  file or on failure. On failure the flag `is_error` of the reader is set.
+ */
+bool gac_csv_reader_read( gac_csv_reader_t* reader,
+        gac_sample_batch_t* batch );
+
+/**
+ * Set the column of a field.
+ *
+ * @param reader
+ *  A pointer to the CSV reader.
+ * @param field
+ *  The field to set.
+ * @param column
+ *  The zero-based column index of the field or #GAC_CSV_COLUMN_NONE if the
+ *  field is not part of the file.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_csv_reader_set_column( gac_csv_reader_t* reader,
+        gac_csv_field_t field, uint32_t column );
+
+#endif
@@ -0,0 +1,389 @@
+/**
+ * A multi-stream gaze analysis engine. The engine owns one gaze analysis
+ * handler per stream (e.g. per participant or tracker channel) and processes
+ * the samples of all streams on a fixed pool of worker threads. Each stream is
+ * assigned to exactly one worker such that the samples of a stream are
+ * processed in the order they were pushed.
+ *
+ * Samples are pushed with gac_engine_push() and are processed asynchronously.
+ * Detected fixations and saccades are queued per stream and are retrieved with
+ * gac_engine_get_fixation() and gac_engine_get_saccade().
+ *
+ * @file
+ *  gac_engine.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_ENGINE_H
+#define GAC_ENGINE_H
+
+#include "gac.h"
+#include <pthread.h>
+
+/** The number of events collected per batch by a worker. */
+#define GAC_ENGINE_EVENT_BATCH_SIZE 32
+
+/** ::gac_engine_s */
+typedef struct gac_engine_s gac_engine_t;
+/** ::gac_engine_buffer_s */
+typedef struct gac_engine_buffer_s gac_engine_buffer_t;
+/** ::gac_engine_stream_s */
+typedef struct gac_engine_stream_s gac_engine_stream_t;
+/** ::gac_engine_stream_stats_s */
+typedef struct gac_engine_stream_stats_s gac_engine_stream_stats_t;
+/** ::gac_engine_worker_s */
+typedef struct gac_engine_worker_s gac_engine_worker_t;
+
+/**
+ * A growable sample buffer in structure-of-arrays layout.
+ */
+struct gac_engine_buffer_s
+{
+    /** The x coordinates of the gaze origins. */
+    float* origin_x;
+    /** The y coordinates of the gaze origins. */
+    float* origin_y;
+    /** The z coordinates of the gaze origins. */
+    float* origin_z;
+    /** The x coordinates of the gaze points. */
+    float* point_x;
+    /** The y coordinates of the gaze points. */
+    float* point_y;
+    /** The z coordinates of the gaze points. */
+    float* point_z;
+    /** The x coordinates of the screen gaze points. */
+    float* screen_x;
+    /** The y coordinates of the screen gaze points. */
+    float* screen_y;
+    /** The sample timestamps. */
+    double* timestamp;
+    /** The trial IDs. */
+    uint32_t* trial_id;
+    /** The label IDs. */
+    uint32_t* label_id;
+    /** The number of samples in the buffer. */
+    uint32_t count;
+    /** The number of available spaces in the buffer. */
+    uint32_t length;
+};
+
+/**
+ * Processing statistics of a stream.
+ */
+struct gac_engine_stream_stats_s
+{
+    /** The number of samples pushed to the stream. */
+    uint64_t pushed_count;
+    /** The number of samples processed by the worker. */
+    uint64_t processed_count;
+    /** The number of detected fixations. */
+    uint64_t fixation_count;
+    /** The number of detected saccades. */
+    uint64_t saccade_count;
+    /** The time in milliseconds the worker spent processing the stream. */
+    double busy_time;
+    /** The processing throughput in samples per second of busy time. */
+    double throughput;
+};
+
+/**
+ * A stream of the engine.
+ */
+struct gac_engine_stream_s
+{
+    /** The gaze analysis handler of the stream. */
+    gac_t h;
+    /** The worker the stream is assigned to. */
+    gac_engine_worker_t* worker;
+    /** The samples pushed but not yet taken by the worker. */
+    gac_engine_buffer_t pending;
+    /** The samples currently processed by the worker. */
+    gac_engine_buffer_t processing;
+    /** The queue of detected fixations. */
+    gac_queue_t fixations;
+    /** The queue of detected saccades. */
+    gac_queue_t saccades;
+    /** The processing statistics. */
+    gac_engine_stream_stats_t stats;
+};
+
+/**
+ * A worker thread of the engine.
+ */
+struct gac_engine_worker_s
+{
+    /** The engine the worker belongs to. */
+    gac_engine_t* engine;
+    /** The index of the worker. */
+    uint32_t idx;
+    /** The worker thread. */
+    pthread_t thread;
+    /** A flag indicating whether the thread was started. */
+    bool is_started;
+    /** The lock protecting the shared state of all streams of the worker. */
+    pthread_mutex_t lock;
+    /** Signals new samples or a stop request to the worker. */
+    pthread_cond_t work;
+    /** Signals the completion of a processing round. */
+    pthread_cond_t idle;
+    /** The number of streams of the worker with pending samples. */
+    uint32_t pending_count;
+    /** A flag indicating whether the worker is processing samples. */
+    bool is_busy;
+    /** A flag requesting the worker to stop. */
+    bool stop;
+};
+
+/**
+ * The engine structure.
+ */
+struct gac_engine_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The streams of the engine. */
+    struct {
+        /** The stream list. */
+        gac_engine_stream_t* items;
+        /** The number of streams. */
+        uint32_t count;
+    } streams;
+    /** The worker pool of the engine. */
+    struct {
+        /** The worker list. */
+        gac_engine_worker_t* items;
+        /** The number of workers. */
+        uint32_t count;
+    } workers;
+};
+
+/**
+ * Append a sample to a sample buffer.
+ *
+ * @param buffer
+ *  A pointer to the sample buffer.
+ * @param screen_point
+ *  The 2d screen gaze point.
+ * @param origin
+ *  The gaze origin.
+ * @param point
+ *  The gaze point.
+ * @param timestamp
+ *  The timestamp of the sample.
+ * @param trial_id
+ *  The ID of the ongoing trial.
+ * @param label_id
+ *  The label ID of the sample.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_engine_buffer_add( gac_engine_buffer_t* buffer, vec2* screen_point,
+        vec3* origin, vec3* point, double timestamp, uint32_t trial_id,
+        uint32_t label_id );
+
+/**
+ * Free the memory of a sample buffer.
+ *
+ * @param buffer
+ *  A pointer to the sample buffer.
+ */
+void gac_engine_buffer_destroy( gac_engine_buffer_t* buffer );
+
+/**
+ * Initialise an empty sample buffer.
+ *
+ * @param buffer
+ *  A pointer to the sample buffer.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_engine_buffer_init( gac_engine_buffer_t* buffer );
+
+/**
+ * Allocate a new engine structure on the heap and start its workers. This
+ * needs to be freed with gac_engine_destroy().
+ *
+ * @param stream_count
+ *  The number of streams.
+ * @param worker_count
+ *  The number of worker threads. If set to 0 one worker per stream is used.
+ *  The number is limited to the number of streams.
+ * @param parameter
+ *  The filter parameters used for the handlers of all streams. If set to NULL
+ *  the default parameters are used.
+ * @return
+ *  A pointer to the allocated engine or NULL on failure.
+ */
+gac_engine_t* gac_engine_create( uint32_t stream_count, uint32_t worker_count,
+        gac_filter_parameter_t* parameter );
+
+/**
+ * Stop the workers and destroy the engine. Samples which were not yet
+ * processed and events which were not yet retrieved are discarded.
+ *
+ * @param engine
+ *  A pointer to the engine to destroy.
+ */
+void gac_engine_destroy( gac_engine_t* engine );
+
+/**
+ * Wait until all samples pushed to the engine are processed.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_engine_flush( gac_engine_t* engine );
+
+/**
+ * Get the next detected fixation of a stream.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @param stream_id
+ *  The ID of the stream.
+ * @param fixation
+ *  A location to store the fixation. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True if a fixation was retrieved, false otherwise.
+ */
+bool gac_engine_get_fixation( gac_engine_t* engine, uint32_t stream_id,
+        gac_fixation_t* fixation );
+
+/**
+ * Get the gaze analysis handler of a stream. The handler may be used to
+ * configure the screen and AOIs of the stream before samples are pushed, and
+ * to perform the AOI analysis of retrieved events. The sample window of the
+ * handler must not be accessed while the engine is running.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @param stream_id
+ *  The ID of the stream.
+ * @return
+ *  A pointer to the handler or NULL if the stream does not exist.
+ */
+gac_t* gac_engine_get_handler( gac_engine_t* engine, uint32_t stream_id );
+
+/**
+ * Get the label string of a label ID of a stream.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @param stream_id
+ *  The ID of the stream.
+ * @param label_id
+ *  The label ID.
+ * @return
+ *  The label string or NULL if the stream or the ID is unknown.
+ */
+const char* gac_engine_get_label( gac_engine_t* engine, uint32_t stream_id,
+        uint32_t label_id );
+
+/**
+ * Get the next detected saccade of a stream.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @param stream_id
+ *  The ID of the stream.
+ * @param saccade
+ *  A location to store the saccade. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True if a saccade was retrieved, false otherwise.
+ */
+bool gac_engine_get_saccade( gac_engine_t* engine, uint32_t stream_id,
+        gac_saccade_t* saccade );
+
+/**
+ * Get the processing statistics of a stream.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @param stream_id
+ *  The ID of the stream.
+ * @param stats
+ *  A location to store the statistics.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_engine_get_stream_stats( gac_engine_t* engine, uint32_t stream_id,
+        gac_engine_stream_stats_t* stats );
+
+/**
+ * Initialise an engine structure and start its workers.
+ *
+ * @param engine
+ *  A pointer to the engine to initialise.
+ * @param stream_count
+ *  The number of streams.
+ * @param worker_count
+ *  The number of worker threads. If set to 0 one worker per stream is used.
+ *  The number is limited to the number of streams.
+ * @param parameter
+ *  The filter parameters used for the handlers of all streams. If set to NULL
+ *  the default parameters are used.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_engine_init( gac_engine_t* engine, uint32_t stream_count,
+        uint32_t worker_count, gac_filter_parameter_t* parameter );
+
+/**
+ * Push a sample to a stream. The sample is processed asynchronously by the
+ * worker of the stream.
+ *
+ * @param engine
+ *  A pointer to the engine.
+ * @param stream_id
+ *  The ID of the stream.
+ * @param screen_point
+ *  An optional 2d screen gaze point. If NULL the screen point is computed
+ *  from the gaze point if a screen is set for the stream handler.
+ * @param origin
+ *  The gaze origin.
+ * @param point
+ *  The gaze point.
+ * @param timestamp
+ *  The timestamp of the sample.
+ * @param trial_id
+ *  The ID of the ongoing trial.
+ * @param label
+ *  An optional arbitrary label annotating the sample.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_engine_push( gac_engine_t* engine, uint32_t stream_id,
+        vec2* screen_point, vec3* origin, vec3* point, double timestamp,
+        uint32_t trial_id, const char* label );
+
+/**
+ * Process all pending samples of a stream. This is called by the worker of
+ * the stream.
+ *
+ * @param stream
+ *  A pointer to the stream.
+ * @return
+ *  True if samples were processed, false otherwise.
+ */
+bool gac_engine_stream_process( gac_engine_stream_t* stream );
+
+/**
+ * The main loop of a worker thread.
+ *
+ * @param data
+ *  A pointer to the worker structure.
+ * @return
+ *  Always NULL.
+ */
+void* gac_engine_worker_run( void* data );
+
+#endif
@@ -0,0 +1,396 @@
+/**
+ * Buffered writers for detected fixations, saccades, and AOI analysis
+ * results. Events are written as CSV or as newline-delimited JSON (NDJSON)
+ * into a large memory buffer which is written to the file once it is full,
+ * optionally by a background thread. Numbers are formatted with the
+ * shortest representation which reads back to the same value.
+ *
+ * @file
+ *  gac_event_writer.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_EVENT_WRITER_H
+#define GAC_EVENT_WRITER_H
+
+#include "gac.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/** The buffer size in bytes at which the buffer is written to the file. */
+#define GAC_EVENT_WRITER_BUFFER_LENGTH 1048576
+/** The maximal length of a formatted number, excluding the terminator. */
+#define GAC_EVENT_WRITER_NUMBER_LENGTH 32
+
+/** ::gac_event_writer_s */
+typedef struct gac_event_writer_s gac_event_writer_t;
+
+/**
+ * The output formats of an event writer.
+ */
+enum gac_event_writer_format_e
+{
+    /** Comma-separated values, one event per line. */
+    GAC_EVENT_WRITER_FORMAT_CSV,
+    /** Newline-delimited JSON, one JSON object per line. */
+    GAC_EVENT_WRITER_FORMAT_NDJSON,
+};
+
+/** #gac_event_writer_format_e */
+typedef enum gac_event_writer_format_e gac_event_writer_format_t;
+
+/**
+ * The event types of an event writer.
+ */
+enum gac_event_type_e
+{
+    /** A fixation. */
+    GAC_EVENT_TYPE_FIXATION,
+    /** A saccade. */
+    GAC_EVENT_TYPE_SACCADE,
+    /** The analysis result of an AOI. */
+    GAC_EVENT_TYPE_AOI,
+};
+
+/** #gac_event_type_e */
+typedef enum gac_event_type_e gac_event_type_t;
+
+/**
+ * The event writer structure.
+ */
+struct gac_event_writer_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The file to write to. The file is not owned by the writer. */
+    FILE* fp;
+    /** The output format. */
+    gac_event_writer_format_t format;
+    /** The label table resolving the label IDs of the events or NULL. */
+    gac_label_table_t* labels;
+    /** The number of fields of the event currently written. */
+    uint32_t field_count;
+    /** The buffer collecting the formatted events. */
+    struct {
+        /** The byte buffer. */
+        char* items;
+        /** The number of bytes in the buffer. */
+        uint32_t count;
+        /** The size of the buffer in bytes. */
+        uint32_t length;
+    } buffer;
+    /** The buffer handed over to the background thread. */
+    struct {
+        /** The byte buffer. */
+        char* items;
+        /** The number of bytes in the buffer. */
+        uint32_t count;
+        /** The size of the buffer in bytes. */
+        uint32_t length;
+    } pending;
+    /** A flag indicating whether a background thread writes the file. */
+    bool is_async;
+    /** The background thread. */
+    pthread_t thread;
+    /** The lock protecting the pending buffer. */
+    pthread_mutex_t lock;
+    /** Signals a pending buffer or a stop request to the thread. */
+    pthread_cond_t work;
+    /** Signals that the pending buffer was written. */
+    pthread_cond_t idle;
+    /** A flag indicating whether the file could not be written. */
+    bool is_error;
+    /** A flag requesting the background thread to stop. */
+    bool stop;
+};
+
+/**
+ * Append bytes to the buffer. If the buffer is full it is handed over to be
+ * written first.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param str
+ *  The bytes to append.
+ * @param length
+ *  The number of bytes to append.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_append( gac_event_writer_t* writer, const char* str,
+        uint32_t length );
+
+/**
+ * Start a new event, i.e. a new CSV line or JSON object.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param type
+ *  The type name of the event, which is only written as JSON member `type`.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_begin( gac_event_writer_t* writer, const char* type );
+
+/**
+ * Allocate a new event writer structure on the heap. This needs to be freed
+ * with gac_event_writer_destroy().
+ *
+ * @param fp
+ *  The file to write to.
+ * @param format
+ *  The output format.
+ * @param labels
+ *  The label table resolving the label IDs of the events, e.g. the label
+ *  table of the gaze analysis handler, or NULL to write empty labels.
+ * @param is_async
+ *  True to write the file on a background thread, false to write the file
+ *  on the calling thread.
+ * @return
+ *  A pointer to the allocated writer or NULL on failure.
+ */
+gac_event_writer_t* gac_event_writer_create( FILE* fp,
+        gac_event_writer_format_t format, gac_label_table_t* labels,
+        bool is_async );
+
+/**
+ * Flush all buffered events, stop the background thread, and destroy the
+ * event writer structure. This does not close the file.
+ *
+ * @param writer
+ *  A pointer to the writer to destroy.
+ */
+void gac_event_writer_destroy( gac_event_writer_t* writer );
+
+/**
+ * End the current event and hand the buffer over to be written once it is
+ * full.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_end( gac_event_writer_t* writer );
+
+/**
+ * Start a field of the current event, i.e. append the field separator and,
+ * in JSON, the member name.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param name
+ *  The name of the field.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_field_name( gac_event_writer_t* writer,
+        const char* name );
+
+/**
+ * Add a number field to the current event. NaN and infinite values are
+ * written as `NaN`, `inf`, and `-inf` in CSV and as `null` in JSON.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param name
+ *  The name of the field, which is only written as JSON member name.
+ * @param value
+ *  The value of the field.
+ * @param is_float
+ *  True if the value is a single precision value such that the shortest
+ *  representation of the float is written.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_field_number( gac_event_writer_t* writer,
+        const char* name, double value, bool is_float );
+
+/**
+ * Add a string field to the current event. The string is quoted in CSV if
+ * necessary and escaped in JSON.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param name
+ *  The name of the field, which is only written as JSON member name.
+ * @param value
+ *  The value of the field. NULL is written as empty string.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_field_string( gac_event_writer_t* writer,
+        const char* name, const char* value );
+
+/**
+ * Add an unsigned integer field to the current event.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param name
+ *  The name of the field, which is only written as JSON member name.
+ * @param value
+ *  The value of the field.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_field_uint( gac_event_writer_t* writer,
+        const char* name, uint64_t value );
+
+/**
+ * Write all buffered events to the file. If the writer is asynchronous,
+ * this waits until the background thread has written the events.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @return
+ *  True on success, false if the file could not be written.
+ */
+bool gac_event_writer_flush( gac_event_writer_t* writer );
+
+/**
+ * Format a number with the shortest representation which reads back to the
+ * same value, e.g. `0.1` instead of `0.100000`. Numbers are formatted in
+ * fixed notation if their decimal exponent is between -6 and 20 and in
+ * exponential notation otherwise, e.g. `1e-7` or `1.5e+21`. Numbers whose
+ * shortest representation has more than 15 significant digits (9 for single
+ * precision values) or whose digits cannot be scaled exactly, i.e. very
+ * large or very small numbers such as `1e300`, are formatted with 17
+ * significant digits (9 for single precision values).
+ *
+ * @param str
+ *  A buffer to store the formatted number. The buffer must hold at least
+ *  #GAC_EVENT_WRITER_NUMBER_LENGTH + 1 bytes. The number is terminated.
+ * @param value
+ *  The number to format.
+ * @param is_float
+ *  True to find the shortest representation of the value as single
+ *  precision value.
+ * @return
+ *  The length of the formatted number.
+ */
+uint32_t gac_event_writer_format_number( char* str, double value,
+        bool is_float );
+
+/**
+ * Initialise an event writer structure.
+ *
+ * @param writer
+ *  A pointer to the writer to initialise.
+ * @param fp
+ *  The file to write to.
+ * @param format
+ *  The output format.
+ * @param labels
+ *  The label table resolving the label IDs of the events, e.g. the label
+ *  table of the gaze analysis handler, or NULL to write empty labels.
+ * @param is_async
+ *  True to write the file on a background thread, false to write the file
+ *  on the calling thread.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_init( gac_event_writer_t* writer, FILE* fp,
+        gac_event_writer_format_t format, gac_label_table_t* labels,
+        bool is_async );
+
+/**
+ * Make sure the buffer has space for a number of bytes. If the bytes do not
+ * fit, the buffer is handed over to be written first and only grows if the
+ * bytes do not fit into an empty buffer.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param size
+ *  The number of bytes to add to the buffer.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_reserve( gac_event_writer_t* writer, uint32_t size );
+
+/**
+ * The background thread function. The thread writes each pending buffer to
+ * the file.
+ *
+ * @param arg
+ *  A pointer to the event writer structure.
+ * @return
+ *  Always NULL.
+ */
+void* gac_event_writer_run( void* arg );
+
+/**
+ * Hand the buffer over to be written. If the writer is asynchronous the
+ * buffer is swapped with the pending buffer once the background thread has
+ * written the previous pending buffer, otherwise the buffer is written
+ * directly.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @return
+ *  True on success, false if the file could not be written.
+ */
+bool gac_event_writer_submit( gac_event_writer_t* writer );
+
+/**
+ * Write the analysis results of all fixated AOIs of a trial, one event per
+ * AOI.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param result
+ *  The AOI analysis result to write.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_write_aoi( gac_event_writer_t* writer,
+        gac_aoi_collection_analysis_result_t* result );
+
+/**
+ * Write a fixation.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param fixation
+ *  The fixation to write.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_write_fixation( gac_event_writer_t* writer,
+        gac_fixation_t* fixation );
+
+/**
+ * Write the CSV header line of an event type. This does nothing if the
+ * format is not CSV.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param type
+ *  The event type.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_write_header( gac_event_writer_t* writer,
+        gac_event_type_t type );
+
+/**
+ * Write a saccade.
+ *
+ * @param writer
+ *  A pointer to the event writer.
+ * @param saccade
+ *  The saccade to write.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_event_writer_write_saccade( gac_event_writer_t* writer,
+        gac_saccade_t* saccade );
+
+#endif
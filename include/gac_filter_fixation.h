@@ -15,6 +15,7 @@
 #define GAC_FILTER_FIXATION_H
 
 #include "gac_fixation.h"
+#include "gac_minmax.h"
 
 /** ::gac_filter_fixation_s */
 typedef struct gac_filter_fixation_s gac_filter_fixation_t;
@@ -38,10 +39,22 @@ struct gac_filter_fixation_s
     uint32_t new_samples;
     /** The fixation duration */
     double duration;
-    /** The fixation screen point */
+    /** The number of window samples belonging to the ongoing fixation. */
+    uint32_t count;
+    /** The fixation screen point, computed when the fixation ends. */
     vec2 screen_point;
-    /** The fixation point */
+    /** The fixation point, computed when the fixation ends. */
     vec3 point;
+    /** The running sums of the samples in the window. */
+    gac_sample_sum_t sum;
+    /**
+     * The sum of the largest absolute gaze point or origin component of each
+     * finite sample in the window, bounding the rounding error of the window
+     * averages.
+     */
+    double magnitude;
+    /** The sliding extrema of the gaze point coordinates in the window. */
+    gac_minmax_t extrema[3];
 };
 
 /**
@@ -60,6 +73,19 @@ struct gac_filter_fixation_s
 bool gac_filter_fixation( gac_filter_fixation_t* filter, gac_sample_t* sample,
         gac_fixation_t* fixation );
 
+/**
+ * Compute the fixation point and screen point of the ongoing fixation from
+ * the oldest samples of the window. The samples are summed newest first in
+ * single precision such that the result is identical to
+ * gac_samples_average_point() on the window at the end of the fixation.
+ *
+ * @param filter
+ *  A pointer to the fixation filter structure.
+ * @return
+ *  True on success, false if no fixation is ongoing.
+ */
+bool gac_filter_fixation_centroid( gac_filter_fixation_t* filter );
+
 /**
  * Allocate a new fixation filter structure on the heap. This structure must be
  * freed.
@@ -97,4 +123,63 @@ void gac_filter_fixation_destroy( gac_filter_fixation_t* filter );
 bool gac_filter_fixation_init( gac_filter_fixation_t* filter,
         float dispersion_threshold, double duration_threshold );
 
+/**
+ * Compute the largest absolute gaze point or origin component of a sample.
+ *
+ * @param sample
+ *  A pointer to the sample.
+ * @return
+ *  The largest absolute component.
+ */
+double gac_filter_fixation_magnitude( gac_sample_t* sample );
+
+/**
+ * Remove all samples from the fixation window and reset the window
+ * statistics.
+ *
+ * @param filter
+ *  A pointer to the fixation filter structure.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_fixation_window_clear( gac_filter_fixation_t* filter );
+
+/**
+ * Decide whether the dispersion of the window is within the dispersion
+ * threshold. The decision is made with the running sums and the sliding
+ * extrema of the window. Only if the dispersion is within the rounding error
+ * bound of the threshold, or if the window holds non-finite samples, the
+ * window is scanned to decide exactly as with single precision averages.
+ *
+ * @param filter
+ *  A pointer to the fixation filter structure.
+ * @return
+ *  True if the window is a fixation candidate, false otherwise.
+ */
+bool gac_filter_fixation_window_is_fixation( gac_filter_fixation_t* filter );
+
+/**
+ * Add a sample to the fixation window and update the window statistics.
+ *
+ * @param filter
+ *  A pointer to the fixation filter structure.
+ * @param sample
+ *  The sample to add.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_fixation_window_push( gac_filter_fixation_t* filter,
+        gac_sample_t* sample );
+
+/**
+ * Remove the oldest sample from the fixation window and update the window
+ * statistics.
+ *
+ * @param filter
+ *  A pointer to the fixation filter structure.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_fixation_window_remove( gac_filter_fixation_t* filter );
+
 #endif
@@ -32,6 +32,8 @@ struct gac_filter_gap_s
     double max_gap_length;
     /** The sample period to compute the number of required fill-in samples */
     double sample_period;
+    /** An optional sample pool to acquire fill-in samples from. */
+    gac_sample_pool_t* pool;
 };
 
 /**
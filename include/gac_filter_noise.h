@@ -14,8 +14,20 @@
 #ifndef GAC_FILTER_NOISE_H
 #define GAC_FILTER_NOISE_H
 
+#include "gac_median.h"
 #include "gac_sample.h"
 
+/**
+ * The minimal window length for which the moving average is computed from
+ * running sums. Shorter windows are summed up sample by sample.
+ */
+#define GAC_FILTER_NOISE_SUM_MIN_LENGTH 16
+/**
+ * The number of samples after which the running sums are recomputed from the
+ * filter window to discard accumulated rounding errors.
+ */
+#define GAC_FILTER_NOISE_SUM_REBASE 1024
+
 /** ::gac_filter_noise_s */
 typedef struct gac_filter_noise_s gac_filter_noise_t;
 
@@ -26,7 +38,7 @@ enum gac_filter_noise_type_e
 {
     /** Moving average filtering */
     GAC_FILTER_NOISE_TYPE_AVERAGE,
-    /** [not implemented] Moving median filtering */
+    /** Moving median filtering */
     GAC_FILTER_NOISE_TYPE_MEDIAN,
 };
 
@@ -48,6 +60,24 @@ struct gac_filter_noise_s
     uint32_t mid;
     /** The noise filter type */
     gac_filter_noise_type_t type;
+    /** An optional sample pool to acquire filtered samples from. */
+    gac_sample_pool_t* pool;
+    /**
+     * The sliding medians of the sample components in the window, in the
+     * order screen point x and y, point x, y, and z, origin x, y, and z.
+     * These are only initialised for #GAC_FILTER_NOISE_TYPE_MEDIAN.
+     */
+    gac_median_t medians[8];
+    /**
+     * A flag indicating whether the moving average is computed from running
+     * sums, i.e. the window is at least #GAC_FILTER_NOISE_SUM_MIN_LENGTH
+     * samples long.
+     */
+    bool is_summing;
+    /** The running sums of the samples in the window for average filtering. */
+    gac_sample_sum_t sum;
+    /** The number of samples added since the running sums were recomputed. */
+    uint32_t sum_count;
 };
 
 /**
@@ -108,14 +138,93 @@ bool gac_filter_noise_init( gac_filter_noise_t* filter,
  * A moving average noise filter. It computes the average sample point and
  * origin from all samples in the filter window and assigns the timestamp of
  * the median sample (the sample in the middle of the window) to the averaged
- * sample.
+ * sample. For windows of at least #GAC_FILTER_NOISE_SUM_MIN_LENGTH samples
+ * the averages are computed from running sums which are updated as samples
+ * enter and leave the filter window and which are recomputed every
+ * #GAC_FILTER_NOISE_SUM_REBASE samples. Shorter windows are summed up in
+ * single precision.
  *
  * @param filter
  *  The filter parameters
  * @return
- *  A new averaged sample if the filter window is full or the sample passed to
- *  the function otherwise.
+ *  A new averaged sample, acquired from the sample pool of the filter if set,
+ *  or NULL on failure.
  */
 gac_sample_t* gac_filter_noise_average( gac_filter_noise_t* filter );
 
+/**
+ * The same as gac_filter_noise_average() but the averaged sample is written
+ * to caller-provided storage.
+ *
+ * @param filter
+ *  The filter parameters
+ * @param sample
+ *  A location to store the averaged sample. Only the sample data and the
+ *  annotations are written, the memory management fields remain untouched.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_noise_average_to( gac_filter_noise_t* filter,
+        gac_sample_t* sample );
+
+/**
+ * A moving median noise filter. It computes the per-component median of the
+ * sample points, screen points, and origins of all samples in the filter
+ * window and assigns the timestamp of the sample in the middle of the window
+ * to the filtered sample.
+ *
+ * @param filter
+ *  The filter parameters
+ * @return
+ *  A new filtered sample, acquired from the sample pool of the filter if set,
+ *  or NULL on failure.
+ */
+gac_sample_t* gac_filter_noise_median( gac_filter_noise_t* filter );
+
+/**
+ * The same as gac_filter_noise_median() but the filtered sample is written to
+ * caller-provided storage.
+ *
+ * @param filter
+ *  The filter parameters
+ * @param sample
+ *  A location to store the filtered sample. Only the sample data and the
+ *  annotations are written, the memory management fields remain untouched.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_noise_median_to( gac_filter_noise_t* filter,
+        gac_sample_t* sample );
+
+/**
+ * Recompute the running sums of the moving average from the samples in the
+ * filter window.
+ *
+ * @param filter
+ *  The filter parameters
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_noise_rebase( gac_filter_noise_t* filter );
+
+/**
+ * Write filtered sample data to a sample and copy the annotations of the
+ * sample in the middle of the filter window.
+ *
+ * @param sample
+ *  The sample to write to.
+ * @param sample_mid
+ *  The sample in the middle of the filter window.
+ * @param screen_point
+ *  The filtered 2d screen gaze point.
+ * @param origin
+ *  The filtered gaze origin.
+ * @param point
+ *  The filtered gaze point.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_filter_noise_sample_to( gac_sample_t* sample, gac_sample_t* sample_mid,
+        vec2* screen_point, vec3* origin, vec3* point );
+
 #endif
@@ -0,0 +1,183 @@
+/**
+ * A fixation density heatmap. Fixations are accumulated into a grid of
+ * cells weighted by their duration and the Gaussian blur is only applied
+ * when the heatmap is read. As the blur is linear this is equivalent to
+ * splatting a Gaussian kernel per fixation but adding a fixation only costs
+ * one cell update.
+ *
+ * @file
+ *  gac_heatmap.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_HEATMAP_H
+#define GAC_HEATMAP_H
+
+#include "gac_fixation.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** ::gac_heatmap_s */
+typedef struct gac_heatmap_s gac_heatmap_t;
+
+/**
+ * The heatmap structure.
+ */
+struct gac_heatmap_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The number of cells along the x axis. */
+    uint32_t width;
+    /** The number of cells along the y axis. */
+    uint32_t height;
+    /** The standard deviation of the Gaussian blur in cells. */
+    float sigma;
+    /** The key of the heatmap, i.e. a trial ID or a label ID. */
+    uint32_t key;
+    /** The number of fixations added to the heatmap. */
+    uint32_t fixation_count;
+    /** The sum of the durations of all fixations added to the heatmap. */
+    double duration;
+    /** The row-major grid of accumulated fixation durations. */
+    float* points;
+    /** The row-major blurred heatmap, allocated on the first read. */
+    float* map;
+    /** The zero-padded row buffer of the horizontal blur pass. */
+    float* row;
+    /** The Gaussian kernel. */
+    struct {
+        /** The kernel weights from `-radius` to `radius`. */
+        float* items;
+        /** The radius of the kernel, i.e. three times sigma. */
+        uint32_t radius;
+    } kernel;
+    /** A flag indicating whether the blurred heatmap is out of date. */
+    bool is_dirty;
+};
+
+/**
+ * Add a weighted point to the heatmap. The point is accumulated into the
+ * cell it falls into.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap.
+ * @param x
+ *  The normalised x coordinate of the point.
+ * @param y
+ *  The normalised y coordinate of the point.
+ * @param weight
+ *  The weight of the point, e.g. the fixation duration.
+ * @return
+ *  True on success, false on failure or if the point is outside of the
+ *  heatmap.
+ */
+bool gac_heatmap_add( gac_heatmap_t* heatmap, float x, float y,
+        float weight );
+
+/**
+ * Add a fixation to the heatmap. The fixation screen point is weighted by
+ * the fixation duration.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap.
+ * @param fixation
+ *  A pointer to the fixation to add.
+ * @return
+ *  True on success, false on failure or if the fixation is outside of the
+ *  heatmap.
+ */
+bool gac_heatmap_add_fixation( gac_heatmap_t* heatmap,
+        gac_fixation_t* fixation );
+
+/**
+ * Blur the accumulated fixation durations with a separable Gaussian kernel,
+ * i.e. a vertical and a horizontal pass. Both passes process whole rows
+ * such that the compiler vectorises the inner loops. The heatmap is zero
+ * outside of the grid.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_blur( gac_heatmap_t* heatmap );
+
+/**
+ * Clear the heatmap.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap to clear.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_clear( gac_heatmap_t* heatmap );
+
+/**
+ * Allocate a new heatmap structure on the heap. This needs to be freed
+ * with gac_heatmap_destroy().
+ *
+ * @param width
+ *  The number of cells along the x axis, e.g. the horizontal screen
+ *  resolution.
+ * @param height
+ *  The number of cells along the y axis, e.g. the vertical screen
+ *  resolution.
+ * @param sigma
+ *  The standard deviation of the Gaussian blur in cells. If set to 0 the
+ *  heatmap is not blurred.
+ * @return
+ *  A pointer to the allocated heatmap or NULL on failure.
+ */
+gac_heatmap_t* gac_heatmap_create( uint32_t width, uint32_t height,
+        float sigma );
+
+/**
+ * Destroy a heatmap structure.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap to destroy.
+ */
+void gac_heatmap_destroy( gac_heatmap_t* heatmap );
+
+/**
+ * Get the blurred heatmap. The blur is only computed if fixations were added
+ * since the last read.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap.
+ * @param map
+ *  A location to store a pointer to the row-major heatmap of size `width` x
+ *  `height`. The heatmap is owned by the heatmap structure and remains
+ *  valid until the next fixation is added.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_get( gac_heatmap_t* heatmap, const float** map );
+
+/**
+ * Initialise a heatmap structure.
+ *
+ * @param heatmap
+ *  A pointer to the heatmap to initialise.
+ * @param width
+ *  The number of cells along the x axis, e.g. the horizontal screen
+ *  resolution.
+ * @param height
+ *  The number of cells along the y axis, e.g. the vertical screen
+ *  resolution.
+ * @param sigma
+ *  The standard deviation of the Gaussian blur in cells. If set to 0 the
+ *  heatmap is not blurred.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_init( gac_heatmap_t* heatmap, uint32_t width,
+        uint32_t height, float sigma );
+
+#endif
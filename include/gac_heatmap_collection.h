@@ -0,0 +1,160 @@
+/**
+ * A collection of fixation density heatmaps, one heatmap per trial or per
+ * label. The heatmap of a fixation is created on demand.
+ *
+ * @file
+ *  gac_heatmap_collection.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_HEATMAP_COLLECTION_H
+#define GAC_HEATMAP_COLLECTION_H
+
+#include "gac_heatmap.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** ::gac_heatmap_collection_s */
+typedef struct gac_heatmap_collection_s gac_heatmap_collection_t;
+
+/**
+ * The available heatmap keys, i.e. how fixations are split into heatmaps.
+ */
+enum gac_heatmap_key_e
+{
+    /** All fixations are added to one heatmap with the key 0. */
+    GAC_HEATMAP_KEY_NONE,
+    /** One heatmap per trial ID. */
+    GAC_HEATMAP_KEY_TRIAL,
+    /** One heatmap per label ID. */
+    GAC_HEATMAP_KEY_LABEL,
+};
+
+/** #gac_heatmap_key_e */
+typedef enum gac_heatmap_key_e gac_heatmap_key_t;
+
+/**
+ * The heatmap collection structure.
+ */
+struct gac_heatmap_collection_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** A flag indicating whether fixations are added to the heatmaps. */
+    bool is_enabled;
+    /** The key splitting the fixations into heatmaps. */
+    gac_heatmap_key_t key;
+    /** The number of cells along the x axis of each heatmap. */
+    uint32_t width;
+    /** The number of cells along the y axis of each heatmap. */
+    uint32_t height;
+    /** The standard deviation of the Gaussian blur in cells. */
+    float sigma;
+    /** The heatmaps, sorted in ascending order of their key. */
+    struct {
+        /** The heatmap list. */
+        gac_heatmap_t** items;
+        /** The number of heatmaps in the list. */
+        uint32_t count;
+        /** The number of available spaces in the heatmap list. */
+        uint32_t length;
+    } heatmaps;
+};
+
+/**
+ * Add a fixation to the heatmap of its key. If no such heatmap exists yet
+ * it is created.
+ *
+ * @param hc
+ *  A pointer to the heatmap collection.
+ * @param fixation
+ *  A pointer to the fixation to add.
+ * @return
+ *  True on success, false on failure, if the collection is disabled, or if
+ *  the fixation is outside of the heatmap.
+ */
+bool gac_heatmap_collection_add_fixation( gac_heatmap_collection_t* hc,
+        gac_fixation_t* fixation );
+
+/**
+ * Remove all heatmaps of the collection.
+ *
+ * @param hc
+ *  A pointer to the heatmap collection.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_collection_clear( gac_heatmap_collection_t* hc );
+
+/**
+ * Allocate a new heatmap collection structure on the heap. This needs to be
+ * freed with gac_heatmap_collection_destroy().
+ *
+ * @return
+ *  A pointer to the allocated heatmap collection or NULL on failure.
+ */
+gac_heatmap_collection_t* gac_heatmap_collection_create();
+
+/**
+ * Destroy a heatmap collection structure including all its heatmaps.
+ *
+ * @param hc
+ *  A pointer to the heatmap collection to destroy.
+ */
+void gac_heatmap_collection_destroy( gac_heatmap_collection_t* hc );
+
+/**
+ * Find the heatmap of a key.
+ *
+ * @param hc
+ *  A pointer to the heatmap collection.
+ * @param key
+ *  The trial ID or label ID of the heatmap, or 0 if the heatmaps are not
+ *  split.
+ * @param idx
+ *  A location to store the index of the heatmap. If the heatmap does not
+ *  exist, the index where the heatmap would be inserted is stored.
+ * @return
+ *  True if the heatmap exists, false otherwise.
+ */
+bool gac_heatmap_collection_find( gac_heatmap_collection_t* hc, uint32_t key,
+        uint32_t* idx );
+
+/**
+ * Initialise a heatmap collection structure. The collection is disabled
+ * until it is configured with gac_heatmap_collection_set().
+ *
+ * @param hc
+ *  A pointer to the heatmap collection to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_collection_init( gac_heatmap_collection_t* hc );
+
+/**
+ * Configure the heatmap collection. This removes all existing heatmaps.
+ *
+ * @param hc
+ *  A pointer to the heatmap collection.
+ * @param width
+ *  The number of cells along the x axis, e.g. the horizontal screen
+ *  resolution. If set to 0 the collection is disabled.
+ * @param height
+ *  The number of cells along the y axis, e.g. the vertical screen
+ *  resolution. If set to 0 the collection is disabled.
+ * @param sigma
+ *  The standard deviation of the Gaussian blur in cells.
+ * @param key
+ *  The key splitting the fixations into heatmaps.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_heatmap_collection_set( gac_heatmap_collection_t* hc,
+        uint32_t width, uint32_t height, float sigma, gac_heatmap_key_t key );
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * A label intern table. Each distinct label string is stored once and is
+ * assigned a 32-bit ID such that samples and events can carry the ID instead
+ * of a copy of the string. Label changes are detected by comparing IDs.
+ *
+ * @file
+ *  gac_label_table.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_LABEL_TABLE_H
+#define GAC_LABEL_TABLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** The label ID of the empty label. */
+#define GAC_LABEL_ID_NONE 0
+
+/** ::gac_label_table_s */
+typedef struct gac_label_table_s gac_label_table_t;
+
+/**
+ * The label table structure.
+ */
+struct gac_label_table_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The interned label strings indexed by label ID. */
+    struct {
+        /** The label list. The first entry is reserved for the empty label. */
+        char** items;
+        /** The number of labels in the list. */
+        uint32_t count;
+        /** The number of available spaces in the label list. */
+        uint32_t length;
+    } labels;
+    /** The hash index mapping label strings to label IDs. */
+    struct {
+        /** Open addressing buckets holding label IDs, 0 marks empty buckets. */
+        uint32_t* items;
+        /** The number of buckets. This is always a power of two. */
+        uint32_t length;
+    } buckets;
+};
+
+/**
+ * Allocate a new label table structure on the heap. This needs to be freed
+ * with gac_label_table_destroy().
+ *
+ * @return
+ *  A pointer to the allocated label table or NULL on failure.
+ */
+gac_label_table_t* gac_label_table_create();
+
+/**
+ * Destroy a label table. This frees all interned label strings.
+ *
+ * @param table
+ *  A pointer to the label table to destroy.
+ */
+void gac_label_table_destroy( gac_label_table_t* table );
+
+/**
+ * Get the label string of a label ID.
+ *
+ * @param table
+ *  A pointer to the label table.
+ * @param id
+ *  The label ID.
+ * @return
+ *  The label string or NULL if the ID is unknown. The empty string is
+ *  returned for #GAC_LABEL_ID_NONE.
+ */
+const char* gac_label_table_get( gac_label_table_t* table, uint32_t id );
+
+/**
+ * Compute the hash of a label string (FNV-1a).
+ *
+ * @param label
+ *  The label string.
+ * @return
+ *  The 32-bit hash value.
+ */
+uint32_t gac_label_table_hash( const char* label );
+
+/**
+ * Initialise a label table structure.
+ *
+ * @param table
+ *  A pointer to the label table to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_label_table_init( gac_label_table_t* table );
+
+/**
+ * Get the ID of a label string. If the label is not yet known, a copy of the
+ * string is added to the table and a new ID is assigned.
+ *
+ * @param table
+ *  A pointer to the label table.
+ * @param label
+ *  The label string. NULL and the empty string map to #GAC_LABEL_ID_NONE.
+ * @param id
+ *  A location to store the label ID. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_label_table_intern( gac_label_table_t* table, const char* label,
+        uint32_t* id );
+
+/**
+ * Rebuild the hash index of a label table with a new number of buckets.
+ *
+ * @param table
+ *  A pointer to the label table.
+ * @param length
+ *  The new number of buckets. This must be a power of two and larger than
+ *  the number of labels in the table.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_label_table_rehash( gac_label_table_t* table, uint32_t length );
+
+#endif
@@ -0,0 +1,179 @@
+/**
+ * Sliding window median of a stream of scalar values. The window holds up to
+ * a fixed number of values. Once the window is full, each new value replaces
+ * the oldest value. The values are kept in two indexed heaps (a max-heap with
+ * the lower half and a min-heap with the upper half of the values) such that
+ * an update takes O(log w) and the median is available in O(1).
+ *
+ * NaN values are ordered after all other values.
+ *
+ * @file
+ *  gac_median.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_MEDIAN_H
+#define GAC_MEDIAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Flag marking a heap position in the upper heap. */
+#define GAC_MEDIAN_HI 0x80000000u
+
+/** ::gac_median_s */
+typedef struct gac_median_s gac_median_t;
+
+/**
+ * The sliding window median structure.
+ */
+struct gac_median_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The maximal number of values in the window. */
+    uint32_t length;
+    /** The number of values in the window. */
+    uint32_t count;
+    /** The slot of the oldest value in the window. */
+    uint32_t oldest;
+    /** The values of the window indexed by slot, in insertion order. */
+    float* values;
+    /**
+     * The heap position of each slot. Positions in the upper heap are marked
+     * with #GAC_MEDIAN_HI.
+     */
+    uint32_t* pos;
+    /** The max-heap holding the slots of the lower half of the values. */
+    struct {
+        /** The heap items (slots). */
+        uint32_t* items;
+        /** The number of items in the heap. */
+        uint32_t count;
+    } lo;
+    /** The min-heap holding the slots of the upper half of the values. */
+    struct {
+        /** The heap items (slots). */
+        uint32_t* items;
+        /** The number of items in the heap. */
+        uint32_t count;
+    } hi;
+};
+
+/**
+ * Remove all values from the window.
+ *
+ * @param median
+ *  A pointer to the median structure.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_median_clear( gac_median_t* median );
+
+/**
+ * Allocate a new median structure on the heap. This needs to be freed with
+ * gac_median_destroy().
+ *
+ * @param length
+ *  The maximal number of values in the window.
+ * @return
+ *  A pointer to the allocated structure or NULL on failure.
+ */
+gac_median_t* gac_median_create( uint32_t length );
+
+/**
+ * Destroy a median structure.
+ *
+ * @param median
+ *  A pointer to the structure to destroy.
+ */
+void gac_median_destroy( gac_median_t* median );
+
+/**
+ * Get the median of the values in the window. If the window holds an even
+ * number of values the mean of the two middle values is returned.
+ *
+ * @param median
+ *  A pointer to the median structure.
+ * @param value
+ *  A location to store the median. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True on success, false if the window is empty.
+ */
+bool gac_median_get( gac_median_t* median, float* value );
+
+/**
+ * Initialise a median structure.
+ *
+ * @param median
+ *  A pointer to the structure to initialise.
+ * @param length
+ *  The maximal number of values in the window. Must be larger than 0.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_median_init( gac_median_t* median, uint32_t length );
+
+/**
+ * Compare two values where NaN values are ordered after all other values.
+ *
+ * @param a
+ *  The first value.
+ * @param b
+ *  The second value.
+ * @return
+ *  True if a is ordered before b, false otherwise.
+ */
+bool gac_median_less( float a, float b );
+
+/**
+ * Add a value to the window. If the window is full, the oldest value is
+ * replaced.
+ *
+ * @param median
+ *  A pointer to the median structure.
+ * @param value
+ *  The value to add.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_median_push( gac_median_t* median, float value );
+
+/**
+ * Move a slot towards the leaves of its heap until the heap order holds.
+ *
+ * @param median
+ *  A pointer to the median structure.
+ * @param slot
+ *  The slot to move.
+ */
+void gac_median_sift_down( gac_median_t* median, uint32_t slot );
+
+/**
+ * Move a slot towards the root of its heap until the heap order holds.
+ *
+ * @param median
+ *  A pointer to the median structure.
+ * @param slot
+ *  The slot to move.
+ */
+void gac_median_sift_up( gac_median_t* median, uint32_t slot );
+
+/**
+ * Move the root of one heap to the other heap.
+ *
+ * @param median
+ *  A pointer to the median structure.
+ * @param to_hi
+ *  True to move the root of the lower heap to the upper heap, false to move
+ *  the root of the upper heap to the lower heap.
+ */
+void gac_median_transfer( gac_median_t* median, bool to_hi );
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * Sliding window minimum and maximum of a stream of scalar values. Values are
+ * added to the back of the window and removed from the front of the window.
+ * Both operations are amortised constant time as the extrema are tracked
+ * with monotonic double-ended queues.
+ *
+ * @file
+ *  gac_minmax.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_MINMAX_H
+#define GAC_MINMAX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** ::gac_minmax_s */
+typedef struct gac_minmax_s gac_minmax_t;
+/** ::gac_minmax_deque_s */
+typedef struct gac_minmax_deque_s gac_minmax_deque_t;
+/** ::gac_minmax_item_s */
+typedef struct gac_minmax_item_s gac_minmax_item_t;
+
+/**
+ * An entry of a monotonic deque.
+ */
+struct gac_minmax_item_s
+{
+    /** The sequence number of the value in the window. */
+    uint32_t seq;
+    /** The value. */
+    float value;
+};
+
+/**
+ * A monotonic double-ended queue backed by a ring buffer.
+ */
+struct gac_minmax_deque_s
+{
+    /** The ring buffer holding the deque entries. */
+    gac_minmax_item_t* items;
+    /** The index of the front entry. */
+    uint32_t head;
+    /** The number of entries in the deque. */
+    uint32_t count;
+    /** The number of allocated entries. This is always a power of two. */
+    uint32_t capacity;
+};
+
+/**
+ * The sliding window extrema structure.
+ */
+struct gac_minmax_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** Deque with increasing values, the front holds the minimum. */
+    gac_minmax_deque_t min;
+    /** Deque with decreasing values, the front holds the maximum. */
+    gac_minmax_deque_t max;
+    /** The sequence number of the oldest value in the window. */
+    uint32_t first;
+    /** The sequence number assigned to the next value added. */
+    uint32_t next;
+};
+
+/**
+ * Remove all values from the window.
+ *
+ * @param minmax
+ *  A pointer to the extrema structure.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_minmax_clear( gac_minmax_t* minmax );
+
+/**
+ * Allocate a new extrema structure on the heap. This needs to be freed with
+ * gac_minmax_destroy().
+ *
+ * @return
+ *  A pointer to the allocated structure or NULL on failure.
+ */
+gac_minmax_t* gac_minmax_create();
+
+/**
+ * Add a value to the back of a monotonic deque. All entries which can no
+ * longer become the extremum of the window are dropped from the back first.
+ *
+ * @param deque
+ *  A pointer to the deque.
+ * @param seq
+ *  The sequence number of the value.
+ * @param value
+ *  The value to add.
+ * @param is_max
+ *  True if the deque tracks the maximum, false if it tracks the minimum.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_minmax_deque_push( gac_minmax_deque_t* deque, uint32_t seq,
+        float value, bool is_max );
+
+/**
+ * Destroy an extrema structure.
+ *
+ * @param minmax
+ *  A pointer to the structure to destroy.
+ */
+void gac_minmax_destroy( gac_minmax_t* minmax );
+
+/**
+ * Initialise an extrema structure.
+ *
+ * @param minmax
+ *  A pointer to the structure to initialise.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_minmax_init( gac_minmax_t* minmax );
+
+/**
+ * Get the maximal value in the window.
+ *
+ * @param minmax
+ *  A pointer to the extrema structure.
+ * @param max
+ *  A location to store the maximum. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True on success, false if the window is empty.
+ */
+bool gac_minmax_max( gac_minmax_t* minmax, float* max );
+
+/**
+ * Get the minimal value in the window.
+ *
+ * @param minmax
+ *  A pointer to the extrema structure.
+ * @param min
+ *  A location to store the minimum. This is only valid if the function
+ *  returns true.
+ * @return
+ *  True on success, false if the window is empty.
+ */
+bool gac_minmax_min( gac_minmax_t* minmax, float* min );
+
+/**
+ * Remove the oldest value from the window.
+ *
+ * @param minmax
+ *  A pointer to the extrema structure.
+ * @return
+ *  True on success, false if the window is empty.
+ */
+bool gac_minmax_pop( gac_minmax_t* minmax );
+
+/**
+ * Add a new value to the window.
+ *
+ * @param minmax
+ *  A pointer to the extrema structure.
+ * @param value
+ *  The value to add.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_minmax_push( gac_minmax_t* minmax, float value );
+
+#endif
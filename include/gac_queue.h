@@ -19,41 +19,63 @@
 
 /** ::gac_queue_s */
 typedef struct gac_queue_s gac_queue_t;
-/** ::gac_queue_item_s */
-typedef struct gac_queue_item_s gac_queue_item_t;
+/** ::gac_queue_iter_s */
+typedef struct gac_queue_iter_s gac_queue_iter_t;
 
 /**
- * A generic queue item.
- */
-struct gac_queue_item_s
-{
-    /** A pointer to the next queue item (towards the head). */
-    gac_queue_item_t* next;
-    /** A pointer to the previous queue item (towards the tail). */
-    gac_queue_item_t* prev;
-    /** A pointer to the arbitrary data structure */
-    void* data;
-};
-
-/**
- * A generic queue structure.
+ * A generic queue structure. The queue is backed by a contiguous ring buffer
+ * of data pointers. The ring buffer capacity is always a power of two and is
+ * doubled whenever more space is required.
  */
 struct gac_queue_s
 {
     /** Self-pointer to allocated structure for memory management. */ 
     void* _me;
-    /** A pointer to the head of the queue to read from. */
-    gac_queue_item_t* tail;
-    /** A pointer to the tail to write to */
-    gac_queue_item_t* head;
+    /** The ring buffer holding the data pointers. */
+    void** items;
+    /** The index of the oldest item (the head of the queue to read from). */
+    uint32_t head;
     /** The number of occupied spaces. */
     uint32_t count;
     /** The number of total available spaces */
     uint32_t length;
+    /** The number of allocated slots in the ring buffer. */
+    uint32_t capacity;
     /** The handler to remove data items */
     void ( *rm )( void* );
 };
 
+/**
+ * A sequential iterator over the items of a queue.
+ */
+struct gac_queue_iter_s
+{
+    /** The ring buffer of the iterated queue. */
+    void** items;
+    /** The ring buffer index mask of the iterated queue. */
+    uint32_t mask;
+    /** The ring buffer index of the next item to visit. */
+    uint32_t pos;
+    /** The number of items left to visit. */
+    uint32_t remaining;
+    /** A flag indicating whether the iterator walks from tail to head. */
+    bool reverse;
+};
+
+/**
+ * Get the data item at a given position in the queue. Position 0 refers to
+ * the oldest item (the head of the queue) and position `count - 1` to the
+ * newest item (the tail of the queue).
+ *
+ * @param queue
+ *  A pointer to the queue.
+ * @param idx
+ *  The position of the item, counted from the head of the queue.
+ * @return
+ *  The data item or NULL if the position is out of range.
+ */
+void* gac_queue_at( gac_queue_t* queue, uint32_t idx );
+
 /**
  * Remove all data items from the queue. The queue remove handler is used to
  * free the data.
@@ -84,7 +106,8 @@ gac_queue_t* gac_queue_create( uint32_t length );
 void gac_queue_destroy( gac_queue_t* queue );
 
 /**
- * Grow the queue.
+ * Grow the queue. The ring buffer is reallocated only if the new length
+ * exceeds the allocated capacity.
  *
  * @param queue
  *  A pointer to the queue to grow.
@@ -108,8 +131,35 @@ bool gac_queue_grow( gac_queue_t* queue, uint32_t count );
 bool gac_queue_init( gac_queue_t* queue, uint32_t length );
 
 /**
- * Remove a the data from the head of the queue and link the the now free space
- * to the tail of the queue.
+ * Initialise an iterator over all items of a queue. The iterator is
+ * invalidated by any operation which modifies the queue.
+ *
+ * @param iter
+ *  A pointer to the iterator to initialise.
+ * @param queue
+ *  A pointer to the queue to iterate over.
+ * @param reverse
+ *  If false, the items are visited from the head to the tail (oldest first),
+ *  otherwise from the tail to the head (newest first).
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_queue_iter_init( gac_queue_iter_t* iter, gac_queue_t* queue,
+        bool reverse );
+
+/**
+ * Get the next item of a queue iterator.
+ *
+ * @param iter
+ *  A pointer to an initialised iterator.
+ * @return
+ *  The next data item or NULL if all items were visited.
+ */
+void* gac_queue_iter_next( gac_queue_iter_t* iter );
+
+/**
+ * Remove the data from the head of the queue. The freed space remains
+ * available for subsequent pushes.
  *
  * @param queue
  *  A pointer to the queue.
@@ -122,7 +172,8 @@ bool gac_queue_pop( gac_queue_t* queue, void** data );
 
 /**
  * Add a new item to the tail of the queue. If no more space is available, the
- * queue is grown by one.
+ * queue is grown by one. The underlying ring buffer capacity is doubled if
+ * required such that pushing is amortised constant time.
  *
  * @param queue
  *  A pointer to the queue.
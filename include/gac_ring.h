@@ -0,0 +1,240 @@
+/**
+ * A wait-free single-producer/single-consumer ring of raw gaze samples. The
+ * ring decouples the sample acquisition (e.g. the callback thread of a
+ * tracker SDK) from the sample analysis: the producer only copies a compact
+ * raw sample into the ring and never blocks, while the consumer takes samples
+ * out of the ring in bursts.
+ *
+ * Exactly one thread may push samples and exactly one thread may pop
+ * samples at the same time.
+ *
+ * @file
+ *  gac_ring.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_RING_H
+#define GAC_RING_H
+
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/** The size of a cache line used to separate producer and consumer data. */
+#define GAC_RING_CACHE_LINE 64
+/** The number of spin iterations before a spinning consumer yields. */
+#define GAC_RING_SPIN_COUNT 1024
+
+/** ::gac_ring_s */
+typedef struct gac_ring_s gac_ring_t;
+/** ::gac_ring_sample_s */
+typedef struct gac_ring_sample_s gac_ring_sample_t;
+/** ::gac_ring_stats_s */
+typedef struct gac_ring_stats_s gac_ring_stats_t;
+/** ::gac_ring_wait_mode_e */
+typedef enum gac_ring_wait_mode_e gac_ring_wait_mode_t;
+
+/**
+ * The behaviour of the consumer if the ring is empty.
+ */
+enum gac_ring_wait_mode_e
+{
+    /** Return immediately. */
+    GAC_RING_WAIT_NONE,
+    /** Busy-wait for new samples (lowest latency, occupies a core). */
+    GAC_RING_WAIT_SPIN,
+    /** Sleep until the producer signals new samples. */
+    GAC_RING_WAIT_BLOCK
+};
+
+/**
+ * A compact raw gaze sample as pushed by the producer.
+ */
+struct gac_ring_sample_s
+{
+    /** The 2d screen gaze point. Only valid if has_screen_point is set. */
+    float screen_point[2];
+    /** The gaze origin. */
+    float origin[3];
+    /** The gaze point. */
+    float point[3];
+    /** The timestamp of the sample. */
+    double timestamp;
+    /** The ID of the ongoing trial. */
+    uint32_t trial_id;
+    /** The label ID of the sample. */
+    uint32_t label_id;
+    /** A flag indicating whether the screen point is set. */
+    bool has_screen_point;
+};
+
+/**
+ * Usage statistics of a ring.
+ */
+struct gac_ring_stats_s
+{
+    /** The number of samples the ring can hold. */
+    uint32_t capacity;
+    /** The number of samples currently in the ring. */
+    uint32_t count;
+    /** The maximal number of samples in the ring observed by the producer. */
+    uint32_t peak_count;
+    /** The number of samples pushed to the ring. */
+    uint64_t push_count;
+    /** The number of samples popped from the ring. */
+    uint64_t pop_count;
+    /** The number of samples dropped because the ring was full. */
+    uint64_t overflow_count;
+};
+
+/**
+ * The ring structure. Producer and consumer data are placed on separate
+ * cache lines.
+ */
+struct gac_ring_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The sample slots. */
+    gac_ring_sample_t* items;
+    /** The number of sample slots, a power of two. */
+    uint32_t capacity;
+    /** The consumer wait mode. */
+    gac_ring_wait_mode_t mode;
+    /** Signals new samples to a blocked consumer. */
+    sem_t signal;
+    /** Separates the shared configuration from the producer data. */
+    char _pad0[GAC_RING_CACHE_LINE];
+    /** The producer position, written by the producer only. */
+    _Atomic uint32_t tail;
+    /** The last consumer position seen by the producer. */
+    uint32_t head_cache;
+    /** The maximal number of samples observed by the producer. */
+    _Atomic uint32_t peak_count;
+    /** The number of samples pushed to the ring. */
+    _Atomic uint64_t push_count;
+    /** The number of samples dropped because the ring was full. */
+    _Atomic uint64_t overflow_count;
+    /** Separates the producer data from the consumer data. */
+    char _pad1[GAC_RING_CACHE_LINE];
+    /** The consumer position, written by the consumer only. */
+    _Atomic uint32_t head;
+    /** The last producer position seen by the consumer. */
+    uint32_t tail_cache;
+    /** The number of samples popped from the ring. */
+    _Atomic uint64_t pop_count;
+    /** A flag indicating whether the consumer waits for the signal. */
+    _Atomic bool waiting;
+    /** Separates the consumer data from the following data. */
+    char _pad2[GAC_RING_CACHE_LINE];
+};
+
+/**
+ * Get the number of samples in the ring.
+ *
+ * @param ring
+ *  A pointer to the ring.
+ * @return
+ *  The number of samples in the ring.
+ */
+uint32_t gac_ring_count( gac_ring_t* ring );
+
+/**
+ * Allocate a new ring structure on the heap. This needs to be freed with
+ * gac_ring_destroy().
+ *
+ * @param capacity
+ *  The minimal number of samples the ring can hold. This is rounded up to the
+ *  next power of two.
+ * @param mode
+ *  The consumer wait mode.
+ * @return
+ *  A pointer to the allocated ring or NULL on failure.
+ */
+gac_ring_t* gac_ring_create( uint32_t capacity, gac_ring_wait_mode_t mode );
+
+/**
+ * Destroy a ring. Neither the producer nor the consumer may use the ring
+ * during or after this call.
+ *
+ * @param ring
+ *  A pointer to the ring to destroy.
+ */
+void gac_ring_destroy( gac_ring_t* ring );
+
+/**
+ * Get the usage statistics of a ring.
+ *
+ * @param ring
+ *  A pointer to the ring.
+ * @param stats
+ *  A location to store the statistics.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_ring_get_stats( gac_ring_t* ring, gac_ring_stats_t* stats );
+
+/**
+ * Initialise a ring structure.
+ *
+ * @param ring
+ *  A pointer to the ring to initialise.
+ * @param capacity
+ *  The minimal number of samples the ring can hold. This is rounded up to the
+ *  next power of two.
+ * @param mode
+ *  The consumer wait mode.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_ring_init( gac_ring_t* ring, uint32_t capacity,
+        gac_ring_wait_mode_t mode );
+
+/**
+ * Take the oldest sample out of the ring. This must only be called by the
+ * consumer. This function does not wait, see gac_ring_wait().
+ *
+ * @param ring
+ *  A pointer to the ring.
+ * @param sample
+ *  A location to store the sample.
+ * @return
+ *  True if a sample was taken, false if the ring is empty.
+ */
+bool gac_ring_pop( gac_ring_t* ring, gac_ring_sample_t* sample );
+
+/**
+ * Copy a sample into the ring. This must only be called by the producer and
+ * never blocks. If the ring is full the sample is dropped and the overflow
+ * counter is incremented.
+ *
+ * @param ring
+ *  A pointer to the ring.
+ * @param sample
+ *  A pointer to the sample to copy into the ring.
+ * @return
+ *  True on success, false if the sample was dropped.
+ */
+bool gac_ring_push( gac_ring_t* ring, gac_ring_sample_t* sample );
+
+/**
+ * Wait until the ring holds at least one sample according to the wait mode
+ * of the ring. This must only be called by the consumer.
+ *
+ * @param ring
+ *  A pointer to the ring.
+ * @param timeout
+ *  The maximal time to wait in milliseconds. Set to 0 to wait without limit.
+ *  Ignored by #GAC_RING_WAIT_NONE.
+ * @return
+ *  True if the ring holds samples, false otherwise.
+ */
+bool gac_ring_wait( gac_ring_t* ring, uint32_t timeout );
+
+#endif
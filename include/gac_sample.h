@@ -14,15 +14,17 @@
 #ifndef GAC_SAMPLE_H
 #define GAC_SAMPLE_H
 
+#include "gac_label_table.h"
 #include "gac_queue.h"
 #include <cglm/vec2.h>
 #include <cglm/vec3.h>
 
-/** The maximal label length */
-#define GAC_SAMPLE_MAX_LABEL_LEN 100
-
 /** ::gac_sample_s */
 typedef struct gac_sample_s gac_sample_t;
+/** ::gac_sample_pool_s */
+typedef struct gac_sample_pool_s gac_sample_pool_t;
+/** ::gac_sample_sum_s */
+typedef struct gac_sample_sum_s gac_sample_sum_t;
 
 /**
  * The gaze data sample.
@@ -31,8 +33,12 @@ struct gac_sample_s
 {
     /** Self-pointer to allocated structure for memory management. */ 
     void* _me;
+    /** The pool the sample was acquired from or NULL. */
+    gac_sample_pool_t* pool;
     /** The ID of a ongoing trial. */
     uint32_t trial_id;
+    /** The ID of an arbitrary label annotating the sample. */
+    uint32_t label_id;
     /** The 2d gaze point on the screen. */
     vec2 screen_point;
     /** The gaze point. */
@@ -45,8 +51,26 @@ struct gac_sample_s
     double trial_onset;
     /** The time in milliseconds since the last change of label. */
     double label_onset;
-    /** Arbitrary label to annotate the sample. */
-    char label[GAC_SAMPLE_MAX_LABEL_LEN];
+};
+
+/**
+ * Running sums over the gaze vectors of a sample window. Samples are added
+ * and subtracted as they enter and leave the window such that the window
+ * averages can be computed in constant time. The sums are accumulated in
+ * double precision to limit the drift caused by repeated subtractions.
+ */
+struct gac_sample_sum_s
+{
+    /** The number of samples in the sums. */
+    uint32_t count;
+    /** The number of samples with non-finite values, excluded from the sums. */
+    uint32_t invalid;
+    /** The sum of the 2d gaze points on the screen. */
+    double screen_point[2];
+    /** The sum of the gaze points. */
+    double point[3];
+    /** The sum of the gaze origins. */
+    double origin[3];
 };
 
 // SAMPLE //////////////////////////////////////////////////////////////////////
@@ -64,13 +88,39 @@ struct gac_sample_s
  *  The timestamp of the sample.
  * @param trial_id
  *  The ID of the ongoing trial.
- * @param label
- *  An optional arbitrary label annotating the sample.
+ * @param label_id
+ *  The ID of the label annotating the sample or #GAC_LABEL_ID_NONE.
  * @return
  *  The allocated sample structure or NULL on failure.
  */
 gac_sample_t* gac_sample_create( vec2* screen_point, vec3* origin, vec3* point,
-        double timestamp, uint32_t trial_id, const char* label );
+        double timestamp, uint32_t trial_id, uint32_t label_id );
+
+/**
+ * The same as gac_sample_create() but acquiring the sample from a sample pool.
+ * The sample is returned to the pool with gac_sample_destroy(). If no pool is
+ * provided the sample is allocated on the heap.
+ *
+ * @param pool
+ *  An optional pointer to the sample pool.
+ * @param screen_point
+ *  The 2d screen gaze point vector.
+ * @param origin
+ *  The gaze origin vector.
+ * @param point
+ *  The gaze point vector.
+ * @param timestamp
+ *  The timestamp of the sample.
+ * @param trial_id
+ *  The ID of the ongoing trial.
+ * @param label_id
+ *  The ID of the label annotating the sample or #GAC_LABEL_ID_NONE.
+ * @return
+ *  The sample structure or NULL on failure.
+ */
+gac_sample_t* gac_sample_create_pooled( gac_sample_pool_t* pool,
+        vec2* screen_point, vec3* origin, vec3* point, double timestamp,
+        uint32_t trial_id, uint32_t label_id );
 
 /**
  * Create a deep copy of a sample. This needs to be freed with
@@ -97,7 +147,8 @@ gac_sample_t* gac_sample_copy( gac_sample_t* sample );
 bool gac_sample_copy_to( gac_sample_t* dest, gac_sample_t* sample );
 
 /**
- * Destroy a sample structure.
+ * Destroy a sample structure. Samples acquired from a sample pool are
+ * returned to the pool.
  *
  * @param sample
  *  A pointer to the structure to be destroyed.
@@ -151,13 +202,81 @@ double gac_sample_get_trial_timestamp( gac_sample_t* sample );
  *  The timestamp of the sample.
  * @param trial_id
  *  The ID of the ongoing trial.
- * @param label
- *  An optional arbitrary label annotating the sample.
+ * @param label_id
+ *  The ID of the label annotating the sample or #GAC_LABEL_ID_NONE.
  * @return
  *  True on success, false on failure.
  */
 bool gac_sample_init( gac_sample_t* sample, vec2* screen_point, vec3* origin,
-        vec3* point, double timestamp, uint32_t trial_id, const char* label );
+        vec3* point, double timestamp, uint32_t trial_id, uint32_t label_id );
+
+/**
+ * Check whether all gaze vectors of a sample hold finite values.
+ *
+ * @param sample
+ *  A pointer to a sample.
+ * @return
+ *  True if all values are finite, false otherwise.
+ */
+bool gac_sample_is_finite( gac_sample_t* sample );
+
+// SAMPLE SUM //////////////////////////////////////////////////////////////////
+
+/**
+ * Add a sample to the running sums.
+ *
+ * @param sum
+ *  A pointer to the running sums.
+ * @param sample
+ *  The sample to add.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_sum_add( gac_sample_sum_t* sum, gac_sample_t* sample );
+
+/**
+ * Compute the averages of the running sums.
+ *
+ * @param sum
+ *  A pointer to the running sums.
+ * @param screen_point
+ *  An optional location to store the average screen gaze point.
+ * @param origin
+ *  An optional location to store the average gaze origin.
+ * @param point
+ *  An optional location to store the average gaze point.
+ * @return
+ *  True on success, false if the sums are empty or include non-finite
+ *  samples. In the latter case the averages need to be computed from the
+ *  sample window.
+ */
+bool gac_sample_sum_average( gac_sample_sum_t* sum, vec2* screen_point,
+        vec3* origin, vec3* point );
+
+/**
+ * Reset the running sums.
+ *
+ * @param sum
+ *  A pointer to the running sums.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_sum_clear( gac_sample_sum_t* sum );
+
+/**
+ * Subtract a sample, previously added with gac_sample_sum_add(), from the
+ * running sums.
+ *
+ * @param sum
+ *  A pointer to the running sums.
+ * @param sample
+ *  The sample to subtract.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_sum_sub( gac_sample_sum_t* sum, gac_sample_t* sample );
+
+// SAMPLES /////////////////////////////////////////////////////////////////////
 
 /**
  * Compute the average gaze point of samples in the sample window.
@@ -0,0 +1,265 @@
+/**
+ * A compact binary columnar file format for gaze data samples. The samples
+ * are stored in blocks of a fixed number of samples where each block holds
+ * one float column per coordinate and the delta-coded timestamps. Trial IDs
+ * and labels are stored as an index of sample ranges and the labels are
+ * interned. Sample files are created from CSV files with
+ * gac_sample_file_convert() and are read by mapping the file into memory
+ * such that the coordinate columns are passed to
+ * gac_sample_window_update_batch() without copying.
+ *
+ * @file
+ *  gac_sample_file.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_SAMPLE_FILE_H
+#define GAC_SAMPLE_FILE_H
+
+#include "gac.h"
+#include "gac_csv_reader.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/** The magic bytes at the start of a sample file. */
+#define GAC_SAMPLE_FILE_MAGIC "GACSMPL"
+/** The version of the sample file format. */
+#define GAC_SAMPLE_FILE_VERSION 1
+/** The marker to detect files written with a different byte order. */
+#define GAC_SAMPLE_FILE_BYTE_ORDER 0x01020304
+/** The file flag indicating that the file holds screen gaze points. */
+#define GAC_SAMPLE_FILE_FLAG_SCREEN 0x1
+/** The default timestamp resolution in ticks per millisecond. */
+#define GAC_SAMPLE_FILE_TICKS_PER_MS 1000
+/** The number of float columns of a block. */
+#define GAC_SAMPLE_FILE_COLUMN_COUNT 8
+
+/** ::gac_sample_file_s */
+typedef struct gac_sample_file_s gac_sample_file_t;
+/** ::gac_sample_file_block_s */
+typedef struct gac_sample_file_block_s gac_sample_file_block_t;
+/** ::gac_sample_file_header_s */
+typedef struct gac_sample_file_header_s gac_sample_file_header_t;
+/** ::gac_sample_file_segment_s */
+typedef struct gac_sample_file_segment_s gac_sample_file_segment_t;
+
+/**
+ * The header at the start of a sample file. All offsets are in bytes from
+ * the start of the file. The blocks follow the header immediately.
+ */
+struct gac_sample_file_header_s
+{
+    /** The magic bytes #GAC_SAMPLE_FILE_MAGIC. */
+    char magic[8];
+    /** The file format version #GAC_SAMPLE_FILE_VERSION. */
+    uint32_t version;
+    /** The byte order marker #GAC_SAMPLE_FILE_BYTE_ORDER. */
+    uint32_t byte_order;
+    /** The file flags, e.g. #GAC_SAMPLE_FILE_FLAG_SCREEN. */
+    uint32_t flags;
+    /** The number of samples of each block except the last. */
+    uint32_t block_length;
+    /** The timestamp resolution in ticks per millisecond. */
+    uint32_t ticks_per_ms;
+    /** The number of interned labels. */
+    uint32_t label_count;
+    /** The total number of samples. */
+    uint64_t sample_count;
+    /** The offset of the segment index. */
+    uint64_t segment_offset;
+    /** The number of segments in the segment index. */
+    uint64_t segment_count;
+    /** The offset of the label strings. */
+    uint64_t label_offset;
+    /** The size of the label strings in bytes. */
+    uint64_t label_size;
+};
+
+/**
+ * The header of a sample block. The header is followed by the float columns
+ * in the order screen x, screen y, point x, y, z, and origin x, y, z, each
+ * holding one value per sample, and the int32 timestamp deltas in ticks.
+ * Blocks are padded to a multiple of 8 bytes.
+ */
+struct gac_sample_file_block_s
+{
+    /** The number of samples in the block. */
+    uint32_t count;
+    /** Reserved, always zero. */
+    uint32_t reserved;
+    /** The timestamp of the first sample of the block in ticks. */
+    int64_t ticks;
+};
+
+/**
+ * An entry of the segment index. A segment is a range of consecutive samples
+ * with the same trial ID and label. The segments are sorted by their first
+ * sample and a segment ends where the next segment starts.
+ */
+struct gac_sample_file_segment_s
+{
+    /** The index of the first sample of the segment. */
+    uint64_t first;
+    /** The trial ID of the samples. */
+    uint32_t trial_id;
+    /**
+     * The label ID of the samples. Label IDs refer to the label strings of
+     * the file, starting with 1. #GAC_LABEL_ID_NONE marks samples without a
+     * label.
+     */
+    uint32_t label_id;
+};
+
+/**
+ * The sample file reader structure.
+ */
+struct gac_sample_file_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The mapped file. */
+    const uint8_t* data;
+    /** The size of the mapped file in bytes. */
+    uint64_t size;
+    /** The file header, pointing into the mapped file. */
+    const gac_sample_file_header_t* header;
+    /** The segment index, pointing into the mapped file. */
+    const gac_sample_file_segment_t* segments;
+    /** The size of each block except the last in bytes. */
+    uint64_t block_size;
+    /** The index of the next sample to read. */
+    uint64_t pos;
+    /** The index of the segment holding the next sample to read. */
+    uint64_t segment_idx;
+    /**
+     * The label IDs of the file labels in the label table of the reader,
+     * indexed by file label ID.
+     */
+    uint32_t* label_ids;
+    /** The decoded columns of the current batch. */
+    struct {
+        /** The sample timestamps. */
+        double* timestamp;
+        /** The trial IDs. */
+        uint32_t* trial_id;
+        /** The label IDs. */
+        uint32_t* label_id;
+    } samples;
+};
+
+/**
+ * Convert a CSV file into a sample file. Each batch of the CSV reader is
+ * stored as one block, hence, the batch length of the reader defines the
+ * block length of the file. The labels are taken from the label table of
+ * the reader. If the reader has no label table, no labels are stored.
+ *
+ * @param reader
+ *  A pointer to the CSV reader to read the samples from.
+ * @param fp
+ *  The file to write the sample file to. The file must be opened in binary
+ *  mode and must be seekable.
+ * @param ticks_per_ms
+ *  The timestamp resolution in ticks per millisecond. Timestamps are rounded
+ *  to this resolution. If set to 0 the default #GAC_SAMPLE_FILE_TICKS_PER_MS
+ *  is used.
+ * @return
+ *  True on success, false on failure, e.g. if the CSV file cannot be read, a
+ *  timestamp is not finite or two consecutive timestamps are too far apart
+ *  to be stored as delta.
+ */
+bool gac_sample_file_convert( gac_csv_reader_t* reader, FILE* fp,
+        uint32_t ticks_per_ms );
+
+/**
+ * Allocate a new sample file reader structure on the heap. This needs to be
+ * freed with gac_sample_file_destroy().
+ *
+ * @param fp
+ *  The sample file to map. The file may be closed once the reader is
+ *  created.
+ * @param labels
+ *  The label table to intern the labels of the file or NULL to ignore
+ *  labels.
+ * @return
+ *  A pointer to the allocated reader or NULL on failure.
+ */
+gac_sample_file_t* gac_sample_file_create( FILE* fp,
+        gac_label_table_t* labels );
+
+/**
+ * Destroy a sample file reader structure and unmap the file.
+ *
+ * @param file
+ *  A pointer to the reader to destroy.
+ */
+void gac_sample_file_destroy( gac_sample_file_t* file );
+
+/**
+ * Initialise a sample file reader structure by mapping the file into memory
+ * and validating its layout.
+ *
+ * @param file
+ *  A pointer to the reader to initialise.
+ * @param fp
+ *  The sample file to map. The file may be closed once the reader is
+ *  initialised.
+ * @param labels
+ *  The label table to intern the labels of the file or NULL to ignore
+ *  labels.
+ * @return
+ *  True on success, false on failure or if the file is not a valid sample
+ *  file.
+ */
+bool gac_sample_file_init( gac_sample_file_t* file, FILE* fp,
+        gac_label_table_t* labels );
+
+/**
+ * Read the next batch of samples, i.e. the remaining samples of the current
+ * block. The coordinate arrays of the batch point into the mapped file, the
+ * timestamps, trial IDs, and label IDs are decoded into buffers of the
+ * reader. The batch remains valid until the next batch is read.
+ *
+ * @param file
+ *  A pointer to the sample file reader.
+ * @param batch
+ *  A location to store the batch.
+ * @return
+ *  True if the batch holds at least one sample, false at the end of the
+ *  file or on failure.
+ */
+bool gac_sample_file_read( gac_sample_file_t* file,
+        gac_sample_batch_t* batch );
+
+/**
+ * Set the position of the next sample to read.
+ *
+ * @param file
+ *  A pointer to the sample file reader.
+ * @param pos
+ *  The index of the next sample to read.
+ * @return
+ *  True on success, false if the position is beyond the last sample.
+ */
+bool gac_sample_file_seek( gac_sample_file_t* file, uint64_t pos );
+
+/**
+ * Set the position of the next sample to read to the first sample of a
+ * trial by looking up the segment index.
+ *
+ * @param file
+ *  A pointer to the sample file reader.
+ * @param trial_id
+ *  The trial ID to seek to.
+ * @return
+ *  True on success, false if no sample of the trial exists.
+ */
+bool gac_sample_file_seek_trial( gac_sample_file_t* file,
+        uint32_t trial_id );
+
+#endif
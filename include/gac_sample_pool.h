@@ -0,0 +1,151 @@
+/**
+ * A pool allocator for gaze data samples. The pool allocates samples in slabs
+ * and recycles released samples through a free list such that steady-state
+ * sample processing does not require any heap allocations.
+ *
+ * @file
+ *  gac_sample_pool.h
+ * @author
+ *  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GAC_SAMPLE_POOL_H
+#define GAC_SAMPLE_POOL_H
+
+#include "gac_sample.h"
+
+/** The default number of samples allocated at once by a sample pool. */
+#define GAC_SAMPLE_POOL_SLAB_SIZE 64
+
+/** ::gac_sample_pool_stats_s */
+typedef struct gac_sample_pool_stats_s gac_sample_pool_stats_t;
+
+/**
+ * Usage statistics of a sample pool.
+ */
+struct gac_sample_pool_stats_s
+{
+    /** The number of samples owned by the pool. */
+    uint32_t capacity;
+    /** The number of samples currently handed out by the pool. */
+    uint32_t in_use;
+    /** The maximal number of samples handed out at the same time. */
+    uint32_t peak_in_use;
+    /** The number of slabs allocated on the heap. */
+    uint32_t slab_count;
+    /** The total number of samples handed out by the pool. */
+    uint64_t acquire_count;
+    /** The total number of samples returned to the pool. */
+    uint64_t release_count;
+};
+
+/**
+ * The sample pool structure.
+ */
+struct gac_sample_pool_s
+{
+    /** Self-pointer to allocated structure for memory management. */
+    void* _me;
+    /** The number of samples to allocate per slab. */
+    uint32_t slab_size;
+    /** The slabs allocated by the pool. */
+    struct {
+        /** The slab list. */
+        gac_sample_t** items;
+        /** The number of allocated slabs. */
+        uint32_t count;
+        /** The number of available spaces in the slab list. */
+        uint32_t length;
+    } slabs;
+    /** The stack of free samples. */
+    struct {
+        /** The free sample list. */
+        gac_sample_t** items;
+        /** The number of free samples. */
+        uint32_t count;
+        /** The number of available spaces in the free sample list. */
+        uint32_t length;
+    } free;
+    /** The pool usage statistics. */
+    gac_sample_pool_stats_t stats;
+};
+
+/**
+ * Get a sample from the pool. If no free sample is available a new slab is
+ * allocated. The sample is not initialised except for the pool reference.
+ * Samples acquired from a pool are returned to the pool by
+ * gac_sample_destroy().
+ *
+ * @param pool
+ *  A pointer to the sample pool.
+ * @return
+ *  A pointer to the sample or NULL on failure.
+ */
+gac_sample_t* gac_sample_pool_acquire( gac_sample_pool_t* pool );
+
+/**
+ * Allocate a new sample pool structure on the heap. This needs to be freed
+ * with gac_sample_pool_destroy().
+ *
+ * @param slab_size
+ *  The number of samples to allocate at once. If set to 0 the default
+ *  #GAC_SAMPLE_POOL_SLAB_SIZE is used.
+ * @return
+ *  A pointer to the allocated pool or NULL on failure.
+ */
+gac_sample_pool_t* gac_sample_pool_create( uint32_t slab_size );
+
+/**
+ * Destroy a sample pool. This frees all slabs of the pool. Samples which
+ * were acquired from the pool and were not yet released become invalid.
+ *
+ * @param pool
+ *  A pointer to the sample pool to destroy.
+ */
+void gac_sample_pool_destroy( gac_sample_pool_t* pool );
+
+/**
+ * Get the usage statistics of a sample pool.
+ *
+ * @param pool
+ *  A pointer to the sample pool.
+ * @param stats
+ *  A location to store the statistics.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_pool_get_stats( gac_sample_pool_t* pool,
+        gac_sample_pool_stats_t* stats );
+
+/**
+ * Initialise a sample pool structure. No samples are allocated until the
+ * first sample is acquired.
+ *
+ * @param pool
+ *  A pointer to the sample pool to initialise.
+ * @param slab_size
+ *  The number of samples to allocate at once. If set to 0 the default
+ *  #GAC_SAMPLE_POOL_SLAB_SIZE is used.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_pool_init( gac_sample_pool_t* pool, uint32_t slab_size );
+
+/**
+ * Return a sample to the pool it was acquired from. Prefer
+ * gac_sample_destroy() which calls this function for pooled samples.
+ *
+ * @param pool
+ *  A pointer to the sample pool.
+ * @param sample
+ *  A pointer to the sample to release.
+ * @return
+ *  True on success, false on failure.
+ */
+bool gac_sample_pool_release( gac_sample_pool_t* pool, gac_sample_t* sample );
+
+#endif
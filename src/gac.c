@@ -53,8 +53,12 @@ void gac_destroy( gac_t* h )
     gac_filter_gap_destroy( &h->gap );
     gac_filter_noise_destroy( &h->noise );
     gac_screen_destroy( h->screen );
-    gac_sample_destroy( h->last_sample );
+    gac_ring_destroy( h->ring );
+    gac_sample_destroy( &h->last_sample );
     gac_aoi_collection_destroy( &h->aoic );
+    gac_label_table_destroy( &h->labels );
+    gac_sample_pool_destroy( &h->pool );
+    gac_heatmap_collection_destroy( &h->heatmaps );
 
     if( h->_me != NULL )
     {
@@ -62,6 +66,78 @@ void gac_destroy( gac_t* h )
     }
 }
 
+/******************************************************************************/
+uint32_t gac_drain( gac_t* h, uint32_t timeout, gac_fixation_t* fixations,
+        uint32_t fixation_length, uint32_t* fixation_count,
+        gac_saccade_t* saccades, uint32_t saccade_length,
+        uint32_t* saccade_count )
+{
+    uint32_t count = 0;
+    uint32_t n_fixations = 0;
+    uint32_t n_saccades = 0;
+    vec2 screen_point;
+    vec3 origin;
+    vec3 point;
+    gac_ring_sample_t sample;
+
+    if( h == NULL || h->ring == NULL
+            || ( fixations == NULL && fixation_length > 0 )
+            || ( saccades == NULL && saccade_length > 0 ) )
+    {
+        goto drain_end;
+    }
+
+    // drain new samples of a previous call before taking more samples
+    if( !gac_sample_window_collect( h, fixations, fixation_length,
+                &n_fixations, saccades, saccade_length, &n_saccades ) )
+    {
+        goto drain_end;
+    }
+
+    gac_ring_wait( h->ring, timeout );
+
+    while( gac_ring_pop( h->ring, &sample ) )
+    {
+        glm_vec3_copy( sample.origin, origin );
+        glm_vec3_copy( sample.point, point );
+        if( sample.has_screen_point )
+        {
+            glm_vec2_copy( sample.screen_point, screen_point );
+        }
+        else if( h->screen != NULL )
+        {
+            gac_screen_point( h->screen, &point, &screen_point );
+        }
+        else
+        {
+            glm_vec2_zero( screen_point );
+        }
+
+        gac_sample_window_update_vec_id( h, &screen_point, &origin, &point,
+                sample.timestamp, sample.trial_id, sample.label_id );
+        count++;
+
+        if( !gac_sample_window_collect( h, fixations, fixation_length,
+                    &n_fixations, saccades, saccade_length, &n_saccades ) )
+        {
+            // an output array is full
+            break;
+        }
+    }
+
+drain_end:
+    if( fixation_count != NULL )
+    {
+        *fixation_count = n_fixations;
+    }
+    if( saccade_count != NULL )
+    {
+        *saccade_count = n_saccades;
+    }
+
+    return count;
+}
+
 /******************************************************************************/
 bool gac_finalise( gac_t* h, gac_aoi_collection_analysis_result_t* analysis )
 {
@@ -75,17 +151,28 @@ bool gac_finalise( gac_t* h, gac_aoi_collection_analysis_result_t* analysis )
 /******************************************************************************/
 bool gac_init( gac_t* h, gac_filter_parameter_t* parameter )
 {
+    vec2 v2d;
+    vec3 v3d;
+
     if( h == NULL )
     {
         return false;
     }
 
+    glm_vec2_zero( v2d );
+    glm_vec3_zero( v3d );
+
     h->screen = NULL;
+    h->ring = NULL;
     h->_me = NULL;
-    h->last_sample = NULL;
+    h->has_last_sample = false;
+    gac_sample_init( &h->last_sample, &v2d, &v3d, &v3d, 0, 0,
+            GAC_LABEL_ID_NONE );
     h->trial_timestamp = 0;
     h->label_timestamp = 0;
     gac_get_filter_parameter_default( &h->parameter );
+    gac_label_table_init( &h->labels );
+    gac_sample_pool_init( &h->pool, 0 );
 
     if( parameter != NULL )
     {
@@ -110,9 +197,12 @@ bool gac_init( gac_t* h, gac_filter_parameter_t* parameter )
     gac_queue_set_rm_handler( &h->saccade.window, NULL );
     gac_filter_noise_init( &h->noise, h->parameter.noise.type,
             h->parameter.noise.mid_idx );
+    h->noise.pool = &h->pool;
     gac_filter_gap_init( &h->gap, h->parameter.gap.max_gap_length,
             h->parameter.gap.sample_period );
+    h->gap.pool = &h->pool;
     gac_aoi_collection_init( &h->aoic );
+    gac_heatmap_collection_init( &h->heatmaps );
 
     gac_queue_init( &h->samples, 0 );
     gac_queue_set_rm_handler( &h->samples, gac_sample_destroy );
@@ -161,6 +251,147 @@ bool gac_get_filter_parameter_default( gac_filter_parameter_t* parameter )
     return true;
 }
 
+/******************************************************************************/
+gac_heatmap_t* gac_get_heatmap( gac_t* h, uint32_t key )
+{
+    uint32_t idx;
+
+    if( h == NULL || !gac_heatmap_collection_find( &h->heatmaps, key, &idx ) )
+    {
+        return NULL;
+    }
+
+    return h->heatmaps.heatmaps.items[idx];
+}
+
+/******************************************************************************/
+const char* gac_get_label( gac_t* h, uint32_t label_id )
+{
+    if( h == NULL )
+    {
+        return NULL;
+    }
+
+    return gac_label_table_get( &h->labels, label_id );
+}
+
+/******************************************************************************/
+bool gac_get_label_id( gac_t* h, const char* label, uint32_t* label_id )
+{
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    return gac_label_table_intern( &h->labels, label, label_id );
+}
+
+/******************************************************************************/
+bool gac_get_ring_stats( gac_t* h, gac_ring_stats_t* stats )
+{
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    return gac_ring_get_stats( h->ring, stats );
+}
+
+/******************************************************************************/
+bool gac_get_sample_pool_stats( gac_t* h, gac_sample_pool_stats_t* stats )
+{
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    return gac_sample_pool_get_stats( &h->pool, stats );
+}
+
+/******************************************************************************/
+bool gac_push( gac_t* h, vec2* screen_point, vec3* origin, vec3* point,
+        double timestamp, uint32_t trial_id, uint32_t label_id )
+{
+    gac_ring_sample_t sample;
+
+    if( h == NULL || origin == NULL || point == NULL )
+    {
+        return false;
+    }
+
+    sample.has_screen_point = screen_point != NULL;
+    if( sample.has_screen_point )
+    {
+        glm_vec2_copy( *screen_point, sample.screen_point );
+    }
+    glm_vec3_copy( *origin, sample.origin );
+    glm_vec3_copy( *point, sample.point );
+    sample.timestamp = timestamp;
+    sample.trial_id = trial_id;
+    sample.label_id = label_id;
+
+    return gac_ring_push( h->ring, &sample );
+}
+
+/******************************************************************************/
+bool gac_set_aoi_raster( gac_t* h, uint32_t width, uint32_t height )
+{
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    return gac_aoi_collection_rasterise( &h->aoic, width, height );
+}
+
+/******************************************************************************/
+bool gac_set_aoi_sample_analysis( gac_t* h, bool is_enabled )
+{
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    h->aoic.samples.is_enabled = is_enabled;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_set_heatmap( gac_t* h, uint32_t width, uint32_t height, float sigma,
+        gac_heatmap_key_t key )
+{
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    return gac_heatmap_collection_set( &h->heatmaps, width, height, sigma,
+            key );
+}
+
+/******************************************************************************/
+bool gac_set_ring( gac_t* h, uint32_t capacity, gac_ring_wait_mode_t mode )
+{
+    gac_ring_t* ring;
+
+    if( h == NULL )
+    {
+        return false;
+    }
+
+    ring = gac_ring_create( capacity, mode );
+    if( ring == NULL )
+    {
+        return false;
+    }
+
+    gac_ring_destroy( h->ring );
+    h->ring = ring;
+
+    return true;
+}
+
 /******************************************************************************/
 bool gac_set_screen( gac_t* h,
         float top_left_x, float top_left_y, float top_left_z,
@@ -189,6 +420,30 @@ bool gac_set_screen( gac_t* h,
     return true;
 }
 
+/******************************************************************************/
+bool gac_sample_batch_init( gac_sample_batch_t* batch, uint32_t count )
+{
+    if( batch == NULL )
+    {
+        return false;
+    }
+
+    batch->count = count;
+    batch->origin_x = NULL;
+    batch->origin_y = NULL;
+    batch->origin_z = NULL;
+    batch->point_x = NULL;
+    batch->point_y = NULL;
+    batch->point_z = NULL;
+    batch->screen_x = NULL;
+    batch->screen_y = NULL;
+    batch->timestamp = NULL;
+    batch->trial_id = NULL;
+    batch->label_id = NULL;
+
+    return true;
+}
+
 /******************************************************************************/
 bool gac_sample_window_cleanup( gac_t* h )
 {
@@ -201,47 +456,98 @@ bool gac_sample_window_cleanup( gac_t* h )
     return true;
 }
 
+/******************************************************************************/
+bool gac_sample_window_collect( gac_t* h, gac_fixation_t* fixations,
+        uint32_t fixation_length, uint32_t* fixation_count,
+        gac_saccade_t* saccades, uint32_t saccade_length,
+        uint32_t* saccade_count )
+{
+    gac_fixation_t fixation;
+    gac_saccade_t saccade;
+
+    // without an output array the filters run and the events are discarded
+    while( h->saccade.new_samples > 0
+            && ( saccade_length == 0 || *saccade_count < saccade_length ) )
+    {
+        if( saccade_length == 0 )
+        {
+            if( gac_sample_window_saccade_filter( h, &saccade ) )
+            {
+                gac_saccade_destroy( &saccade );
+            }
+        }
+        else if( gac_sample_window_saccade_filter( h,
+                    &saccades[*saccade_count] ) )
+        {
+            ( *saccade_count )++;
+        }
+    }
+    while( h->fixation.new_samples > 0
+            && ( fixation_length == 0 || *fixation_count < fixation_length ) )
+    {
+        if( fixation_length == 0 )
+        {
+            if( gac_sample_window_fixation_filter( h, &fixation ) )
+            {
+                gac_fixation_destroy( &fixation );
+            }
+        }
+        else if( gac_sample_window_fixation_filter( h,
+                    &fixations[*fixation_count] ) )
+        {
+            ( *fixation_count )++;
+        }
+    }
+    if( h->saccade.new_samples > 0 || h->fixation.new_samples > 0 )
+    {
+        return false;
+    }
+    gac_sample_window_cleanup( h );
+
+    return true;
+}
+
 /******************************************************************************/
 bool gac_sample_window_fixation_filter( gac_t* h, gac_fixation_t* fixation )
 {
-    uint32_t i;
-    gac_queue_item_t* current;
     gac_sample_t* sample;
 
-    if( fixation == NULL || h == NULL || h->samples.count == 0 )
+    if( fixation == NULL || h == NULL || h->samples.count == 0
+            || h->fixation.new_samples == 0 )
     {
         return false;
     }
 
-    current = h->samples.tail;
-    for( i = 0; i < h->fixation.new_samples - 1; i++ )
+    sample = gac_queue_at( &h->samples,
+            h->samples.count - h->fixation.new_samples );
+    h->fixation.new_samples--;
+
+    if( !gac_filter_fixation( &h->fixation, sample, fixation ) )
     {
-        current = current->next;
+        return false;
+    }
+
+    if( h->heatmaps.is_enabled )
+    {
+        gac_heatmap_collection_add_fixation( &h->heatmaps, fixation );
     }
-    sample = current->data;
-    h->fixation.new_samples--;
 
-    return gac_filter_fixation( &h->fixation, sample, fixation );
+    return true;
 }
 
 /******************************************************************************/
 bool gac_sample_window_saccade_filter( gac_t* h, gac_saccade_t* saccade )
 {
-    uint32_t i;
-    gac_queue_item_t* current;
     gac_sample_t* sample;
 
-    if( h == NULL || saccade == NULL || h->samples.count == 0 )
+    if( h == NULL || saccade == NULL || h->samples.count == 0
+            || h->saccade.new_samples == 0 )
     {
         return false;
     }
 
-    current = h->samples.tail;
-    for( i = 0; i < h->saccade.new_samples - 1; i++ )
-    {
-        current = current->next;
-    }
-    sample = current->data;
+    sample = gac_queue_at( &h->samples,
+            h->samples.count - h->saccade.new_samples );
     h->saccade.new_samples--;
 
     return gac_filter_saccade( &h->saccade, sample, saccade );
@@ -276,28 +582,133 @@ uint32_t gac_sample_window_update( gac_t* h, float ox, float oy, float oz,
             timestamp, trial_id, label );
 }
 
+/******************************************************************************/
+uint32_t gac_sample_window_update_batch( gac_t* h, gac_sample_batch_t* batch,
+        gac_fixation_t* fixations, uint32_t fixation_length,
+        uint32_t* fixation_count, gac_saccade_t* saccades,
+        uint32_t saccade_length, uint32_t* saccade_count )
+{
+    uint32_t i = 0;
+    uint32_t n_fixations = 0;
+    uint32_t n_saccades = 0;
+    vec2 screen_point;
+    vec3 origin;
+    vec3 point;
+
+    if( h == NULL || batch == NULL || batch->origin_x == NULL
+            || batch->origin_y == NULL || batch->origin_z == NULL
+            || batch->point_x == NULL || batch->point_y == NULL
+            || batch->point_z == NULL || batch->timestamp == NULL
+            || ( fixations == NULL && fixation_length > 0 )
+            || ( saccades == NULL && saccade_length > 0 ) )
+    {
+        goto batch_end;
+    }
+
+    while( true )
+    {
+        // drain new samples of the previous update before adding more
+        if( !gac_sample_window_collect( h, fixations, fixation_length,
+                    &n_fixations, saccades, saccade_length, &n_saccades ) )
+        {
+            // an output array is full
+            break;
+        }
+
+        if( i == batch->count )
+        {
+            break;
+        }
+
+        origin[0] = batch->origin_x[i];
+        origin[1] = batch->origin_y[i];
+        origin[2] = batch->origin_z[i];
+        point[0] = batch->point_x[i];
+        point[1] = batch->point_y[i];
+        point[2] = batch->point_z[i];
+        if( batch->screen_x != NULL && batch->screen_y != NULL )
+        {
+            screen_point[0] = batch->screen_x[i];
+            screen_point[1] = batch->screen_y[i];
+        }
+        else if( h->screen != NULL )
+        {
+            gac_screen_point( h->screen, &point, &screen_point );
+        }
+        else
+        {
+            glm_vec2_zero( screen_point );
+        }
+
+        gac_sample_window_update_vec_label( h, &screen_point, &origin,
+                &point, batch->timestamp[i],
+                batch->trial_id == NULL ? 0 : batch->trial_id[i],
+                batch->label_id == NULL ? GAC_LABEL_ID_NONE
+                    : batch->label_id[i], batch->label_id != NULL );
+        i++;
+    }
+
+batch_end:
+    if( fixation_count != NULL )
+    {
+        *fixation_count = n_fixations;
+    }
+    if( saccade_count != NULL )
+    {
+        *saccade_count = n_saccades;
+    }
+
+    return i;
+}
+
 /******************************************************************************/
 uint32_t gac_sample_window_update_vec( gac_t* h, vec2* screen_point, vec3* origin,
         vec3* point, double timestamp, uint32_t trial_id, const char* label )
 {
+    uint32_t label_id = GAC_LABEL_ID_NONE;
+
+    if( h == NULL || !gac_label_table_intern( &h->labels, label, &label_id ) )
+    {
+        return 0;
+    }
+
+    return gac_sample_window_update_vec_label( h, screen_point, origin, point,
+            timestamp, trial_id, label_id, label != NULL );
+}
+
+/******************************************************************************/
+uint32_t gac_sample_window_update_vec_id( gac_t* h, vec2* screen_point,
+        vec3* origin, vec3* point, double timestamp, uint32_t trial_id,
+        uint32_t label_id )
+{
+    return gac_sample_window_update_vec_label( h, screen_point, origin, point,
+            timestamp, trial_id, label_id, true );
+}
+
+/******************************************************************************/
+uint32_t gac_sample_window_update_vec_label( gac_t* h, vec2* screen_point,
+        vec3* origin, vec3* point, double timestamp, uint32_t trial_id,
+        uint32_t label_id, bool has_label )
+{
+    uint32_t i;
     uint32_t count;
     gac_sample_t* sample;
 
-    sample = gac_sample_create( screen_point, origin, point, timestamp,
-            trial_id, label );
+    sample = gac_sample_create_pooled( &h->pool, screen_point, origin, point,
+            timestamp, trial_id, has_label ? label_id : GAC_LABEL_ID_NONE );
 
-    if( h->last_sample == NULL )
+    if( !h->has_last_sample )
     {
         h->label_timestamp = sample->timestamp;
         h->trial_timestamp = sample->timestamp;
     }
     else
     {
-        if( trial_id != h->last_sample->trial_id )
+        if( trial_id != h->last_sample.trial_id )
         {
             h->trial_timestamp = sample->timestamp;
         }
-        if( label != NULL && strcmp( label, h->last_sample->label ) != 0 )
+        if( has_label && label_id != h->last_sample.label_id )
         {
             h->label_timestamp = sample->timestamp;
         }
@@ -307,12 +718,21 @@ uint32_t gac_sample_window_update_vec( gac_t* h, vec2* screen_point, vec3* origi
     sample->label_onset =  sample->timestamp - h->label_timestamp;
     sample = gac_filter_noise( &h->noise, sample );
     count = gac_filter_gap( &h->gap, &h->samples, sample );
+    if( h->aoic.samples.is_enabled )
+    {
+        for( i = h->samples.count - count; i < h->samples.count; i++ )
+        {
+            gac_aoi_collection_analyse_sample( &h->aoic,
+                    gac_queue_at( &h->samples, i ) );
+        }
+    }
     h->fixation.new_samples = count;
     h->saccade.new_samples = count;
-    if( h->samples.tail != NULL )
+    if( h->samples.count > 0 )
     {
-        gac_sample_destroy( h->last_sample );
-        h->last_sample = gac_sample_copy( h->samples.tail->data );
+        gac_sample_copy_to( &h->last_sample,
+                gac_queue_at( &h->samples, h->samples.count - 1 ) );
+        h->has_last_sample = true;
     }
 
     return count;
@@ -7,20 +7,153 @@
  */
 
 #include "gac_aoi.h"
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
+/******************************************************************************/
+bool gac_aoi_add_interval( gac_aoi_t* aoi, double start, double end )
+{
+    uint32_t length;
+    void* items;
+
+    if( aoi == NULL || !isfinite( start ) || !isfinite( end ) || end < start )
+    {
+        return false;
+    }
+
+    if( aoi->intervals.count > 0
+            && start < aoi->intervals.items[aoi->intervals.count - 1].end )
+    {
+        // intervals must be ascending and must not overlap
+        return false;
+    }
+
+    if( aoi->intervals.count == aoi->intervals.length )
+    {
+        length = aoi->intervals.length == 0 ? 4 : aoi->intervals.length * 2;
+        items = realloc( aoi->intervals.items,
+                sizeof( gac_aoi_interval_t ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->intervals.items = items;
+        aoi->intervals.length = length;
+    }
+
+    aoi->intervals.items[aoi->intervals.count].start = start;
+    aoi->intervals.items[aoi->intervals.count].end = end;
+    aoi->intervals.count++;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_add_keyframe( gac_aoi_t* aoi, double timestamp, const float* x,
+        const float* y, uint32_t count )
+{
+    uint32_t i;
+    uint32_t length;
+    void* items;
+    vec2* points;
+    gac_aoi_keyframe_t* keyframe;
+
+    if( aoi == NULL || x == NULL || y == NULL || count < 3
+            || !isfinite( timestamp ) )
+    {
+        return false;
+    }
+
+    if( aoi->keyframes.count > 0 && ( count != aoi->keyframes.vertex_count
+                || !( timestamp > aoi->keyframes.items[
+                    aoi->keyframes.count - 1].timestamp ) ) )
+    {
+        // keyframes must be ascending and share the number of points
+        return false;
+    }
+
+    if( aoi->keyframes.count == aoi->keyframes.length )
+    {
+        length = aoi->keyframes.length == 0 ? 4 : aoi->keyframes.length * 2;
+        items = realloc( aoi->keyframes.items,
+                sizeof( gac_aoi_keyframe_t ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->keyframes.items = items;
+        items = realloc( aoi->keyframes.points,
+                sizeof( vec2 ) * length * count );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->keyframes.points = items;
+        aoi->keyframes.length = length;
+    }
+
+    keyframe = &aoi->keyframes.items[aoi->keyframes.count];
+    points = &aoi->keyframes.points[aoi->keyframes.count * count];
+    keyframe->timestamp = timestamp;
+    keyframe->bounding_box.x_min = INFINITY;
+    keyframe->bounding_box.x_max = -INFINITY;
+    keyframe->bounding_box.y_min = INFINITY;
+    keyframe->bounding_box.y_max = -INFINITY;
+    for( i = 0; i < count; i++ )
+    {
+        points[i][0] = x[i];
+        points[i][1] = y[i];
+        keyframe->bounding_box.x_min = fminf( keyframe->bounding_box.x_min,
+                x[i] );
+        keyframe->bounding_box.x_max = fmaxf( keyframe->bounding_box.x_max,
+                x[i] );
+        keyframe->bounding_box.y_min = fminf( keyframe->bounding_box.y_min,
+                y[i] );
+        keyframe->bounding_box.y_max = fmaxf( keyframe->bounding_box.y_max,
+                y[i] );
+    }
+    aoi->keyframes.vertex_count = count;
+    aoi->keyframes.count++;
+
+    if( aoi->keyframes.count == 1 )
+    {
+        // the first keyframe defines the points until the AOI is resolved
+        return gac_aoi_resolve( aoi, timestamp );
+    }
+    // the interpolated points may change with the new keyframe
+    aoi->timestamp = NAN;
+
+    return true;
+}
+
 /******************************************************************************/
 bool gac_aoi_add_point( gac_aoi_t* aoi, float x, float y )
 {
     float distance;
+    uint32_t length;
+    vec2* items;
 
-    if( aoi == NULL || aoi->points.count == GAC_AOI_MAX_POINTS )
+    if( aoi == NULL )
     {
         return false;
     }
 
+    if( aoi->points.count == aoi->points.length )
+    {
+        length = aoi->points.length == 0 ? 4 : aoi->points.length * 2;
+        items = realloc( aoi->points.items, sizeof( vec2 ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->points.items = items;
+        aoi->points.length = length;
+    }
+
     aoi->points.items[aoi->points.count][0] = x;
     aoi->points.items[aoi->points.count][1] = y;
+    aoi->shape = GAC_AOI_SHAPE_NONE;
 
     if( x < aoi->bounding_box.x_min )
     {
@@ -104,6 +237,175 @@ bool gac_aoi_add_rect_res( gac_aoi_t* aoi, float x, float y, float width,
     return true;
 }
 
+/******************************************************************************/
+bool gac_aoi_compile( gac_aoi_t* aoi )
+{
+    uint32_t i;
+    uint32_t count = 0;
+    uint32_t convex_count = 0;
+    uint32_t length;
+    int positive_count = 0;
+    int negative_count = 0;
+    float cross;
+    float angle = 0;
+    vec2* points;
+    vec2* hull;
+    vec2* p;
+    vec2* q;
+    vec2* r;
+    vec2 tmp;
+    void* items;
+    bool is_axis_aligned = true;
+
+    if( aoi == NULL )
+    {
+        return false;
+    }
+
+    aoi->edges.count = 0;
+    aoi->hull.count = 0;
+    aoi->contour.count = 0;
+    aoi->shape = GAC_AOI_SHAPE_NONE;
+
+    // the buffers are only grown, such that an AOI which is compiled again,
+    // e.g. a dynamic AOI at each new timestamp, does not allocate
+    length = aoi->points.count + 1;
+    if( length > aoi->contour.length )
+    {
+        items = realloc( aoi->contour.items, sizeof( vec2 ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->contour.items = items;
+        aoi->contour.length = length;
+    }
+    if( length > aoi->hull.length )
+    {
+        items = realloc( aoi->hull.items, sizeof( vec2 ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->hull.items = items;
+        aoi->hull.length = length;
+    }
+    if( length > aoi->edges.length )
+    {
+        items = realloc( aoi->edges.items, sizeof( gac_aoi_edge_t ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->edges.items = items;
+        aoi->edges.length = length;
+    }
+    points = aoi->contour.items;
+    hull = aoi->hull.items;
+
+    // drop repeated points, including a closing point equal to the first one
+    for( i = 0; i < aoi->points.count; i++ )
+    {
+        if( count == 0 || glm_vec2_distance( points[count - 1],
+                    aoi->points.items[i] ) > GAC_AOI_EPSILON )
+        {
+            glm_vec2_copy( aoi->points.items[i], points[count] );
+            count++;
+        }
+    }
+    while( count > 1 && glm_vec2_distance( points[count - 1], points[0] )
+            <= GAC_AOI_EPSILON )
+    {
+        count--;
+    }
+
+    // the edge table of the closed contour, horizontal edges never cross a
+    // horizontal ray
+    for( i = 0; i < count; i++ )
+    {
+        p = &points[i];
+        q = &points[( i + 1 ) % count];
+        if( ( *p )[1] == ( *q )[1] )
+        {
+            continue;
+        }
+        aoi->edges.items[aoi->edges.count].x = ( *p )[0];
+        aoi->edges.items[aoi->edges.count].y = ( *p )[1];
+        aoi->edges.items[aoi->edges.count].y_min = fminf( ( *p )[1], ( *q )[1] );
+        aoi->edges.items[aoi->edges.count].y_max = fmaxf( ( *p )[1], ( *q )[1] );
+        aoi->edges.items[aoi->edges.count].slope =
+            ( ( *q )[0] - ( *p )[0] ) / ( ( *q )[1] - ( *p )[1] );
+        aoi->edges.count++;
+    }
+
+    // a polygon is convex if it turns in one direction only and the turns
+    // add up to exactly one revolution
+    for( i = 0; i < count && count >= 3; i++ )
+    {
+        p = &points[( i + count - 1 ) % count];
+        q = &points[i];
+        r = &points[( i + 1 ) % count];
+        cross = ( ( *q )[0] - ( *p )[0] ) * ( ( *r )[1] - ( *q )[1] )
+            - ( ( *q )[1] - ( *p )[1] ) * ( ( *r )[0] - ( *q )[0] );
+        angle += atan2f( cross,
+                ( ( *q )[0] - ( *p )[0] ) * ( ( *r )[0] - ( *q )[0] )
+                + ( ( *q )[1] - ( *p )[1] ) * ( ( *r )[1] - ( *q )[1] ) );
+        if( fabsf( cross ) <= GAC_AOI_EPSILON * glm_vec2_distance( *p, *q )
+                * glm_vec2_distance( *q, *r ) )
+        {
+            // colinear points are not part of the hull
+            continue;
+        }
+        else if( cross > 0 )
+        {
+            positive_count++;
+        }
+        else
+        {
+            negative_count++;
+        }
+        glm_vec2_copy( *q, hull[convex_count] );
+        convex_count++;
+    }
+    aoi->contour.count = count;
+
+    if( convex_count < 3 || ( positive_count > 0 && negative_count > 0 )
+            || fabs( fabs( angle ) - 2 * M_PI ) > 1e-3 )
+    {
+        aoi->shape = GAC_AOI_SHAPE_POLYGON;
+        return true;
+    }
+
+    if( negative_count > 0 )
+    {
+        // reorder the hull counter clockwise
+        for( i = 0; i < convex_count / 2; i++ )
+        {
+            glm_vec2_copy( hull[i], tmp );
+            glm_vec2_copy( hull[convex_count - 1 - i], hull[i] );
+            glm_vec2_copy( tmp, hull[convex_count - 1 - i] );
+        }
+    }
+
+    for( i = 0; i < convex_count; i++ )
+    {
+        is_axis_aligned &= hull[i][0] == hull[( i + 1 ) % convex_count][0]
+            || hull[i][1] == hull[( i + 1 ) % convex_count][1];
+    }
+
+    aoi->edges.count = 0;
+    if( convex_count == 4 && is_axis_aligned )
+    {
+        aoi->shape = GAC_AOI_SHAPE_RECT;
+        return true;
+    }
+
+    aoi->hull.count = convex_count;
+    aoi->shape = GAC_AOI_SHAPE_CONVEX;
+
+    return true;
+}
+
 /******************************************************************************/
 gac_aoi_t* gac_aoi_copy( gac_aoi_t* aoi )
 {
@@ -123,8 +425,10 @@ gac_aoi_t* gac_aoi_copy( gac_aoi_t* aoi )
     if( !gac_aoi_copy_to( aoi_copy, aoi ) )
     {
         gac_aoi_destroy( aoi_copy );
+        free( aoi_copy );
         return NULL;
     }
+    aoi_copy->_me = aoi_copy;
 
     return aoi_copy;
 }
@@ -148,6 +452,32 @@ bool gac_aoi_copy_to( gac_aoi_t* tgt, gac_aoi_t* src )
                 src->points.items[i][1] );
     }
     res &= gac_aoi_set_resolution( tgt, src->resolution_x, src->resolution_y );
+    for( i = 0; i < src->intervals.count; i++ )
+    {
+        res &= gac_aoi_add_interval( tgt, src->intervals.items[i].start,
+                src->intervals.items[i].end );
+    }
+
+    if( src->keyframes.count > 0 )
+    {
+        tgt->keyframes.items = malloc( sizeof( gac_aoi_keyframe_t )
+                * src->keyframes.count );
+        tgt->keyframes.points = malloc( sizeof( vec2 ) * src->keyframes.count
+                * src->keyframes.vertex_count );
+        if( tgt->keyframes.items == NULL || tgt->keyframes.points == NULL )
+        {
+            return false;
+        }
+        memcpy( tgt->keyframes.items, src->keyframes.items,
+                sizeof( gac_aoi_keyframe_t ) * src->keyframes.count );
+        memcpy( tgt->keyframes.points, src->keyframes.points,
+                sizeof( vec2 ) * src->keyframes.count
+                    * src->keyframes.vertex_count );
+        tgt->keyframes.count = src->keyframes.count;
+        tgt->keyframes.length = src->keyframes.count;
+        tgt->keyframes.vertex_count = src->keyframes.vertex_count;
+    }
+    tgt->timestamp = src->timestamp;
 
     return res;
 }
@@ -175,6 +505,33 @@ void gac_aoi_destroy( gac_aoi_t* aoi )
     }
 
     gac_aoi_analysis_destroy( &aoi->analysis );
+    free( aoi->points.items );
+    aoi->points.items = NULL;
+    aoi->points.count = 0;
+    aoi->points.length = 0;
+    free( aoi->edges.items );
+    aoi->edges.items = NULL;
+    aoi->edges.count = 0;
+    aoi->edges.length = 0;
+    free( aoi->hull.items );
+    aoi->hull.items = NULL;
+    aoi->hull.count = 0;
+    aoi->hull.length = 0;
+    free( aoi->contour.items );
+    aoi->contour.items = NULL;
+    aoi->contour.count = 0;
+    aoi->contour.length = 0;
+    aoi->shape = GAC_AOI_SHAPE_NONE;
+    free( aoi->keyframes.items );
+    free( aoi->keyframes.points );
+    aoi->keyframes.items = NULL;
+    aoi->keyframes.points = NULL;
+    aoi->keyframes.count = 0;
+    aoi->keyframes.length = 0;
+    free( aoi->intervals.items );
+    aoi->intervals.items = NULL;
+    aoi->intervals.count = 0;
+    aoi->intervals.length = 0;
 
     if( aoi->_me != NULL )
     {
@@ -183,13 +540,58 @@ void gac_aoi_destroy( gac_aoi_t* aoi )
 }
 
 /******************************************************************************/
-bool gac_aoi_includes_point( gac_aoi_t* aoi, float x, float y )
+bool gac_aoi_find_keyframe( gac_aoi_t* aoi, double timestamp, uint32_t* idx,
+        float* weight )
 {
-    uint32_t i;
-    uint32_t count = 0;
-    vec2 point = { x, y };
+    uint32_t lo = 0;
+    uint32_t hi;
+    uint32_t mid;
+    gac_aoi_keyframe_t* items;
 
-    if( aoi == NULL && aoi->points.count < 3 )
+    if( aoi == NULL || idx == NULL || weight == NULL
+            || aoi->keyframes.count == 0 || isnan( timestamp ) )
+    {
+        return false;
+    }
+
+    items = aoi->keyframes.items;
+    hi = aoi->keyframes.count - 1;
+    *weight = 0;
+    if( timestamp <= items[0].timestamp )
+    {
+        *idx = 0;
+        return true;
+    }
+    if( timestamp >= items[hi].timestamp )
+    {
+        *idx = hi;
+        return true;
+    }
+
+    // keep items[lo].timestamp <= timestamp < items[hi].timestamp
+    while( hi - lo > 1 )
+    {
+        mid = lo + ( hi - lo ) / 2;
+        if( items[mid].timestamp <= timestamp )
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    *idx = lo;
+    *weight = ( timestamp - items[lo].timestamp )
+        / ( items[lo + 1].timestamp - items[lo].timestamp );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_includes_point( gac_aoi_t* aoi, float x, float y )
+{
+    if( aoi == NULL || aoi->points.count < 3 )
     {
         return false;
     }
@@ -201,23 +603,250 @@ bool gac_aoi_includes_point( gac_aoi_t* aoi, float x, float y )
         return false;
     }
 
-    for( i = 1; i < aoi->points.count; i++ )
+    if( aoi->shape == GAC_AOI_SHAPE_NONE && !gac_aoi_compile( aoi ) )
     {
-        if( gac_aoi_intersect( &aoi->ray_origin, &point,
-                    &aoi->points.items[i - 1], &aoi->points.items[i] ) )
+        return false;
+    }
+
+    switch( aoi->shape )
+    {
+        case GAC_AOI_SHAPE_RECT:
+            return true;
+        case GAC_AOI_SHAPE_CONVEX:
+            return gac_aoi_includes_point_convex( aoi, x, y );
+        default:
+            return gac_aoi_includes_point_polygon( aoi, x, y );
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_includes_point_at( gac_aoi_t* aoi, float x, float y,
+        double timestamp )
+{
+    uint32_t idx;
+    float weight;
+    gac_aoi_keyframe_t* a;
+    gac_aoi_keyframe_t* b;
+
+    if( aoi == NULL || !gac_aoi_is_visible( aoi, timestamp ) )
+    {
+        return false;
+    }
+
+    if( aoi->keyframes.count > 0 && aoi->timestamp != timestamp )
+    {
+        if( !gac_aoi_find_keyframe( aoi, timestamp, &idx, &weight ) )
         {
-            count++;
+            return false;
+        }
+        a = &aoi->keyframes.items[idx];
+        b = weight > 0 ? &aoi->keyframes.items[idx + 1] : a;
+        // the interpolated points lie inside of the interpolated bounding
+        // box, hence, only interpolate the points if the point is inside
+        if( x < a->bounding_box.x_min
+                + ( b->bounding_box.x_min - a->bounding_box.x_min ) * weight
+            || x > a->bounding_box.x_max
+                + ( b->bounding_box.x_max - a->bounding_box.x_max ) * weight
+            || y < a->bounding_box.y_min
+                + ( b->bounding_box.y_min - a->bounding_box.y_min ) * weight
+            || y > a->bounding_box.y_max
+                + ( b->bounding_box.y_max - a->bounding_box.y_max ) * weight )
+        {
+            return false;
         }
+        if( !gac_aoi_resolve( aoi, timestamp ) )
+        {
+            return false;
+        }
+    }
+
+    return gac_aoi_includes_point( aoi, x, y );
+}
+
+/******************************************************************************/
+bool gac_aoi_includes_point_convex( gac_aoi_t* aoi, float x, float y )
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    vec2* o;
+    vec2* a;
+    vec2* b;
+
+    if( aoi == NULL || aoi->hull.count < 3 )
+    {
+        return false;
     }
 
-    if( count % 2 == 0 )
+    o = &aoi->hull.items[0];
+    a = &aoi->hull.items[1];
+    b = &aoi->hull.items[aoi->hull.count - 1];
+    if( ( ( *a )[0] - ( *o )[0] ) * ( y - ( *o )[1] )
+            - ( ( *a )[1] - ( *o )[1] ) * ( x - ( *o )[0] ) < 0
+        || ( ( *b )[0] - ( *o )[0] ) * ( y - ( *o )[1] )
+            - ( ( *b )[1] - ( *o )[1] ) * ( x - ( *o )[0] ) > 0 )
     {
+        // the point is outside of the fan spanned by the hull
         return false;
     }
-    else
+
+    lo = 1;
+    hi = aoi->hull.count - 1;
+    while( hi - lo > 1 )
+    {
+        mid = ( lo + hi ) / 2;
+        a = &aoi->hull.items[mid];
+        if( ( ( *a )[0] - ( *o )[0] ) * ( y - ( *o )[1] )
+                - ( ( *a )[1] - ( *o )[1] ) * ( x - ( *o )[0] ) >= 0 )
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    a = &aoi->hull.items[lo];
+    b = &aoi->hull.items[hi];
+
+    return ( ( *b )[0] - ( *a )[0] ) * ( y - ( *a )[1] )
+        - ( ( *b )[1] - ( *a )[1] ) * ( x - ( *a )[0] ) >= 0;
+}
+
+/******************************************************************************/
+bool gac_aoi_includes_point_polygon( gac_aoi_t* aoi, float x, float y )
+{
+    uint32_t i;
+    bool is_inside = false;
+    gac_aoi_edge_t* edge;
+
+    if( aoi == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < aoi->edges.count; i++ )
+    {
+        edge = &aoi->edges.items[i];
+        // edges are half-open in y such that a shared point is counted once
+        is_inside ^= ( y >= edge->y_min ) & ( y < edge->y_max )
+            & ( x < edge->x + ( y - edge->y ) * edge->slope );
+    }
+
+    return is_inside;
+}
+
+/******************************************************************************/
+bool gac_aoi_includes_points( gac_aoi_t* aoi, const float* x, const float* y,
+        uint32_t count, bool* inside )
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t first;
+    uint32_t last;
+    uint32_t length;
+    uint32_t padded_length;
+    uint32_t idx[GAC_AOI_BATCH_SIZE];
+    uint32_t parity[GAC_AOI_BATCH_SIZE];
+    uint32_t is_in_range;
+    uint32_t is_left;
+    float block_x[GAC_AOI_BATCH_SIZE];
+    float block_y[GAC_AOI_BATCH_SIZE];
+    float edge_x, edge_y, edge_y_min, edge_y_max, edge_slope;
+
+    if( aoi == NULL || x == NULL || y == NULL || inside == NULL )
+    {
+        return false;
+    }
+
+    memset( inside, 0, sizeof( bool ) * count );
+
+    if( aoi->points.count < 3 )
     {
         return true;
     }
+
+    if( aoi->shape == GAC_AOI_SHAPE_NONE && !gac_aoi_compile( aoi ) )
+    {
+        return false;
+    }
+
+    for( first = 0; first < count; first += GAC_AOI_BATCH_SIZE )
+    {
+        last = first + GAC_AOI_BATCH_SIZE;
+        if( last > count )
+        {
+            last = count;
+        }
+
+        // collect the points inside the bounding box without branches
+        length = 0;
+        for( j = first; j < last; j++ )
+        {
+            idx[length] = j;
+            block_x[length] = x[j];
+            block_y[length] = y[j];
+            length += ( x[j] >= aoi->bounding_box.x_min )
+                & ( x[j] <= aoi->bounding_box.x_max )
+                & ( y[j] >= aoi->bounding_box.y_min )
+                & ( y[j] <= aoi->bounding_box.y_max );
+        }
+
+        if( aoi->shape == GAC_AOI_SHAPE_RECT )
+        {
+            for( j = 0; j < length; j++ )
+            {
+                inside[idx[j]] = true;
+            }
+        }
+        else if( aoi->shape == GAC_AOI_SHAPE_CONVEX )
+        {
+            // the binary search over the hull is cheaper than all edges
+            for( j = 0; j < length; j++ )
+            {
+                inside[idx[j]] = gac_aoi_includes_point_convex( aoi,
+                        block_x[j], block_y[j] );
+            }
+        }
+        else
+        {
+            // pad the block to a multiple of the lane count with a point no
+            // edge crosses such that the edge loop does not need a scalar
+            // remainder, this allows vectorisation with the default -O2
+            // cost model
+            padded_length = ( length + GAC_AOI_BATCH_LANES - 1 )
+                & ~( GAC_AOI_BATCH_LANES - 1 );
+            for( j = length; j < padded_length; j++ )
+            {
+                block_x[j] = INFINITY;
+                block_y[j] = INFINITY;
+            }
+            memset( parity, 0, sizeof( uint32_t ) * padded_length );
+            for( i = 0; i < aoi->edges.count; i++ )
+            {
+                edge_x = aoi->edges.items[i].x;
+                edge_y = aoi->edges.items[i].y;
+                edge_y_min = aoi->edges.items[i].y_min;
+                edge_y_max = aoi->edges.items[i].y_max;
+                edge_slope = aoi->edges.items[i].slope;
+                for( j = 0; j < padded_length; j++ )
+                {
+                    is_in_range = ( block_y[j] >= edge_y_min )
+                        & ( block_y[j] < edge_y_max );
+                    is_left = block_x[j] < edge_x
+                        + ( block_y[j] - edge_y ) * edge_slope;
+                    parity[j] ^= is_in_range & is_left;
+                }
+            }
+            for( j = 0; j < length; j++ )
+            {
+                inside[idx[j]] = parity[j];
+            }
+        }
+    }
+
+    return true;
 }
 
 /******************************************************************************/
@@ -239,8 +868,6 @@ bool gac_aoi_includes_point_res( gac_aoi_t* aoi, float x_res, float y_res )
 /******************************************************************************/
 bool gac_aoi_init( gac_aoi_t* aoi, const char* label )
 {
-    uint32_t i;
-
     if( aoi == NULL )
     {
         return false;
@@ -254,8 +881,29 @@ bool gac_aoi_init( gac_aoi_t* aoi, const char* label )
     aoi->bounding_box.y_min = INFINITY;
     aoi->resolution_x = 0;
     aoi->resolution_y = 0;
+    aoi->points.items = NULL;
     aoi->points.count = 0;
+    aoi->points.length = 0;
     aoi->avg_edge_len = 0;
+    aoi->shape = GAC_AOI_SHAPE_NONE;
+    aoi->contour.items = NULL;
+    aoi->contour.count = 0;
+    aoi->contour.length = 0;
+    aoi->edges.items = NULL;
+    aoi->edges.count = 0;
+    aoi->edges.length = 0;
+    aoi->hull.items = NULL;
+    aoi->hull.count = 0;
+    aoi->hull.length = 0;
+    aoi->keyframes.items = NULL;
+    aoi->keyframes.count = 0;
+    aoi->keyframes.length = 0;
+    aoi->keyframes.points = NULL;
+    aoi->keyframes.vertex_count = 0;
+    aoi->intervals.items = NULL;
+    aoi->intervals.count = 0;
+    aoi->intervals.length = 0;
+    aoi->timestamp = NAN;
     aoi->_me = NULL;
     memset( aoi->label, '\0', sizeof( aoi->label ) );
     if( label != NULL )
@@ -264,11 +912,6 @@ bool gac_aoi_init( gac_aoi_t* aoi, const char* label )
     }
     gac_aoi_analysis_init( &aoi->analysis );
 
-    for( i = 0; i < GAC_AOI_MAX_POINTS; i++ )
-    {
-        glm_vec2_zero( aoi->points.items[i] );
-    }
-
     return true;
 }
 
@@ -318,6 +961,67 @@ bool gac_aoi_intersect( vec2* p1, vec2* q1, vec2* p2, vec2* q2 )
     return false;
 }
 
+/******************************************************************************/
+bool gac_aoi_is_dynamic( gac_aoi_t* aoi )
+{
+    if( aoi == NULL )
+    {
+        return false;
+    }
+
+    return aoi->keyframes.count > 0 || aoi->intervals.count > 0;
+}
+
+/******************************************************************************/
+bool gac_aoi_is_visible( gac_aoi_t* aoi, double timestamp )
+{
+    uint32_t lo = 0;
+    uint32_t hi;
+    uint32_t mid;
+    gac_aoi_interval_t* items;
+
+    if( aoi == NULL || isnan( timestamp ) )
+    {
+        return false;
+    }
+
+    if( aoi->keyframes.count > 0
+            && ( timestamp < aoi->keyframes.items[0].timestamp
+                || timestamp > aoi->keyframes.items[
+                    aoi->keyframes.count - 1].timestamp ) )
+    {
+        return false;
+    }
+
+    if( aoi->intervals.count == 0 )
+    {
+        return true;
+    }
+
+    items = aoi->intervals.items;
+    if( timestamp < items[0].start )
+    {
+        return false;
+    }
+
+    // find the last interval starting at or before the timestamp
+    hi = aoi->intervals.count;
+    while( hi - lo > 1 )
+    {
+        mid = lo + ( hi - lo ) / 2;
+        if( items[mid].start <= timestamp )
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return timestamp <= items[lo].end;
+}
+
 /******************************************************************************/
 bool gac_aoi_point_on_segment( vec2* p, vec2* s1, vec2* s2 )
 {
@@ -335,7 +1039,7 @@ bool gac_aoi_point_on_segment( vec2* p, vec2* s1, vec2* s2 )
 /******************************************************************************/
 gac_aoi_orientation_t gac_aoi_orientation_triplet( vec2* p, vec2* q, vec2* r )
 {
-    uint32_t val = ( ( *q )[1] - ( *p )[1] ) * ( ( *r )[0] - ( *q )[0] ) -
+    float val = ( ( *q )[1] - ( *p )[1] ) * ( ( *r )[0] - ( *q )[0] ) -
             ( ( *q )[0] - ( *p )[0]) * ( ( *r )[1] - ( *q )[1] );
 
     if( val == 0 )
@@ -352,6 +1056,68 @@ gac_aoi_orientation_t gac_aoi_orientation_triplet( vec2* p, vec2* q, vec2* r )
     }
 }
 
+/******************************************************************************/
+bool gac_aoi_resolve( gac_aoi_t* aoi, double timestamp )
+{
+    uint32_t i;
+    uint32_t idx;
+    uint32_t count;
+    float weight;
+    vec2* a;
+    vec2* b;
+    vec2* p;
+    void* items;
+
+    if( aoi == NULL )
+    {
+        return false;
+    }
+
+    if( aoi->keyframes.count == 0 || aoi->timestamp == timestamp )
+    {
+        return true;
+    }
+
+    if( !gac_aoi_find_keyframe( aoi, timestamp, &idx, &weight ) )
+    {
+        return false;
+    }
+
+    count = aoi->keyframes.vertex_count;
+    if( count > aoi->points.length )
+    {
+        items = realloc( aoi->points.items, sizeof( vec2 ) * count );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoi->points.items = items;
+        aoi->points.length = count;
+    }
+
+    a = &aoi->keyframes.points[idx * count];
+    b = weight > 0 ? &aoi->keyframes.points[( idx + 1 ) * count] : a;
+    aoi->bounding_box.x_min = INFINITY;
+    aoi->bounding_box.x_max = -INFINITY;
+    aoi->bounding_box.y_min = INFINITY;
+    aoi->bounding_box.y_max = -INFINITY;
+    for( i = 0; i < count; i++ )
+    {
+        p = &aoi->points.items[i];
+        ( *p )[0] = a[i][0] + ( b[i][0] - a[i][0] ) * weight;
+        ( *p )[1] = a[i][1] + ( b[i][1] - a[i][1] ) * weight;
+        aoi->bounding_box.x_min = fminf( aoi->bounding_box.x_min, ( *p )[0] );
+        aoi->bounding_box.x_max = fmaxf( aoi->bounding_box.x_max, ( *p )[0] );
+        aoi->bounding_box.y_min = fminf( aoi->bounding_box.y_min, ( *p )[1] );
+        aoi->bounding_box.y_max = fmaxf( aoi->bounding_box.y_max, ( *p )[1] );
+    }
+    aoi->points.count = count;
+    aoi->shape = GAC_AOI_SHAPE_NONE;
+    aoi->timestamp = timestamp;
+
+    return true;
+}
+
 /******************************************************************************/
 bool gac_aoi_set_resolution( gac_aoi_t* aoi, float resolution_x,
         float resolution_y )
@@ -29,7 +29,10 @@ bool gac_aoi_analysis_clear( gac_aoi_analysis_t* analysis )
     analysis->aoi_visited_before_count = 0;
     analysis->dwell_time = 0;
     analysis->dwell_time_relative = 0;
-    gac_sample_init( &sample, &v2d, &v3d, &v3d, 0, 0, NULL );
+    analysis->sample_count = 0;
+    analysis->sample_dwell_time = 0;
+    analysis->sample_dwell_time_relative = 0;
+    gac_sample_init( &sample, &v2d, &v3d, &v3d, 0, 0, GAC_LABEL_ID_NONE );
     gac_fixation_init( &analysis->first_fixation, &v2d, &v3d, 0, &sample );
     gac_saccade_init( &analysis->first_saccade, &sample, &sample );
 
@@ -81,6 +84,9 @@ bool gac_aoi_analysis_copy_to( gac_aoi_analysis_t* tgt,
     tgt->fixation_count = src->fixation_count;
     tgt->enter_saccade_count = src->enter_saccade_count;
     tgt->fixation_count_relative = src->fixation_count_relative;
+    tgt->sample_count = src->sample_count;
+    tgt->sample_dwell_time = src->sample_dwell_time;
+    tgt->sample_dwell_time_relative = src->sample_dwell_time_relative;
 
     return res;
 }
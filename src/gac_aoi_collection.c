@@ -7,26 +7,158 @@
  */
 
 #include "gac_aoi_collection.h"
+#include <stdlib.h>
 #include <string.h>
 
 /******************************************************************************/
 bool gac_aoi_collection_add( gac_aoi_collection_t* aoic, gac_aoi_t* aoi )
 {
-    gac_aoi_t* aoi_ptr = aoi;
+    uint32_t i;
+    uint32_t length;
+    uint32_t width;
+    uint32_t height;
+    void* items;
+
     if( aoic == NULL || aoi == NULL )
     {
         return false;
     }
 
+    // the buffers are grown before the AOI is taken over such that a
+    // failure leaves the AOIs of the collection untouched
+    if( aoic->aois.count == aoic->aois.length )
+    {
+        length = aoic->aois.length == 0 ? 4 : aoic->aois.length * 2;
+        items = realloc( aoic->aois.items, sizeof( gac_aoi_t ) * length );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->aois.items = items;
+        aoic->aois.length = length;
+    }
+
+    if( aoic->aois.length > aoic->hits.length )
+    {
+        items = realloc( aoic->hits.items,
+                sizeof( uint32_t ) * aoic->aois.length );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->hits.items = items;
+        aoic->hits.length = aoic->aois.length;
+    }
+
+    if( aoic->aois.length > aoic->touched.length )
+    {
+        items = realloc( aoic->touched.items,
+                sizeof( uint32_t ) * aoic->aois.length );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->touched.items = items;
+        items = realloc( aoic->touched.flags,
+                sizeof( bool ) * aoic->aois.length );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->touched.flags = items;
+        for( i = aoic->touched.length; i < aoic->aois.length; i++ )
+        {
+            aoic->touched.flags[i] = false;
+        }
+        aoic->touched.length = aoic->aois.length;
+    }
+
+    if( aoic->aois.length > aoic->samples.length )
+    {
+        items = realloc( aoic->samples.counts,
+                sizeof( uint32_t ) * aoic->aois.length );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->samples.counts = items;
+        items = realloc( aoic->samples.dwell_times,
+                sizeof( double ) * aoic->aois.length );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->samples.dwell_times = items;
+        items = realloc( aoic->samples.hits, sizeof( uint32_t )
+                * aoic->aois.length * GAC_AOI_COLLECTION_SAMPLE_HISTORY );
+        if( items == NULL )
+        {
+            goto add_error;
+        }
+        aoic->samples.hits = items;
+        for( i = aoic->samples.length; i < aoic->aois.length; i++ )
+        {
+            aoic->samples.counts[i] = 0;
+            aoic->samples.dwell_times[i] = 0;
+        }
+        aoic->samples.length = aoic->aois.length;
+        // the hits of the history were stored with the previous length
+        aoic->samples.history_count = 0;
+    }
+
+    width = aoic->raster.width;
+    height = aoic->raster.height;
     if( aoi->_me == NULL )
     {
-        gac_aoi_copy_to( &aoic->aois.items[aoic->aois.count], aoi );
-        aoi_ptr = &aoic->aois.items[aoic->aois.count];
+        if( !gac_aoi_copy_to( &aoic->aois.items[aoic->aois.count], aoi ) )
+        {
+            gac_aoi_destroy( &aoic->aois.items[aoic->aois.count] );
+            return false;
+        }
     }
-    aoic->aois.ptrs[aoic->aois.count] = aoi_ptr;
+    else
+    {
+        // take over the heap allocated AOI including its point list
+        aoic->aois.items[aoic->aois.count] = *aoi;
+        aoic->aois.items[aoic->aois.count]._me = NULL;
+        free( aoi->_me );
+    }
+    gac_aoi_compile( &aoic->aois.items[aoic->aois.count] );
     aoic->aois.count++;
 
+    if( ( width > 0 && !gac_aoi_raster_build( &aoic->raster,
+                    aoic->aois.items, aoic->aois.count, width, height ) )
+            || !gac_aoi_timeline_build( &aoic->timeline, aoic->aois.items,
+                aoic->aois.count )
+            || !gac_aoi_grid_build( &aoic->grid, aoic->aois.items,
+                aoic->aois.count ) )
+    {
+        // drop the AOI again and restore the indices of the other AOIs
+        aoic->aois.count--;
+        gac_aoi_destroy( &aoic->aois.items[aoic->aois.count] );
+        if( width > 0 )
+        {
+            gac_aoi_raster_build( &aoic->raster, aoic->aois.items,
+                    aoic->aois.count, width, height );
+        }
+        gac_aoi_timeline_build( &aoic->timeline, aoic->aois.items,
+                aoic->aois.count );
+        gac_aoi_grid_build( &aoic->grid, aoic->aois.items,
+                aoic->aois.count );
+        return false;
+    }
+
+    // the hits of the history do not consider the new AOI
+    aoic->samples.history_count = 0;
+
     return true;
+
+add_error:
+    if( aoi->_me != NULL )
+    {
+        gac_aoi_destroy( aoi );
+    }
+    return false;
 }
 
 /******************************************************************************/
@@ -40,10 +172,13 @@ bool gac_aoi_collection_analyse_clear( gac_aoi_collection_t* aoic )
     }
 
     gac_aoi_collection_analysis_clear( &aoic->analysis );
+    gac_aoi_scanpath_clear( &aoic->scanpath );
     for( i = 0; i < aoic->aois.count; i++ )
     {
         gac_aoi_analysis_clear( &aoic->aois.items[i].analysis );
+        aoic->touched.flags[i] = false;
     }
+    aoic->touched.count = 0;
 
     return true;
 }
@@ -53,46 +188,89 @@ bool gac_aoi_collection_analyse_finalise( gac_aoi_collection_t* aoic,
         gac_aoi_collection_analysis_result_t* analysis )
 {
     uint32_t i;
+    uint32_t j;
+    uint32_t idx;
     gac_aoi_t* aoi;
-    gac_aoi_analysis_t* res;
-    char* label;
+    gac_aoi_collection_analysis_item_t* item;
+    gac_aoi_scanpath_t scanpath;
+    void* items;
     if( aoic == NULL || analysis == NULL )
     {
         return false;
     }
 
+    if( aoic->aois.count > aoic->results.length )
+    {
+        items = realloc( aoic->results.items,
+                sizeof( gac_aoi_collection_analysis_item_t )
+                    * aoic->aois.length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        aoic->results.items = items;
+        aoic->results.length = aoic->aois.length;
+    }
+
+    if( aoic->samples.trial_id == aoic->analysis.trial_id )
+    {
+        gac_aoi_collection_analyse_sample_flush( aoic );
+    }
+
+    // hand the scanpath over to the result and reuse the previous one
+    scanpath = aoic->results.scanpath;
+    aoic->results.scanpath = aoic->scanpath;
+    aoic->scanpath = scanpath;
+    gac_aoi_scanpath_clear( &aoic->scanpath );
+
+    analysis->aois.items = aoic->results.items;
     analysis->aois.count = 0;
+    analysis->scanpath = &aoic->results.scanpath;
     analysis->trial_id = aoic->analysis.trial_id;
-    for( i = 0; i < GAC_AOI_MAX; i++ )
+
+    // report the hit AOIs in ascending order, usually only a few AOIs are hit
+    // per trial
+    for( i = 1; i < aoic->touched.count; i++ )
     {
-        gac_aoi_analysis_init( &analysis->aois.items[i].analysis );
-        memset( &analysis->aois.items[i].label, '\0',
-                sizeof( analysis->aois.items[i].label ) );
+        idx = aoic->touched.items[i];
+        for( j = i; j > 0 && aoic->touched.items[j - 1] > idx; j-- )
+        {
+            aoic->touched.items[j] = aoic->touched.items[j - 1];
+        }
+        aoic->touched.items[j] = idx;
     }
 
-    for( i = 0; i < aoic->aois.count; i++ )
+    for( i = 0; i < aoic->touched.count
+            && aoic->analysis.fixation_count > 0; i++ )
     {
-        if( aoic->analysis.fixation_count > 0 )
+        aoi = &aoic->aois.items[aoic->touched.items[i]];
+        aoi->analysis.fixation_count_relative =
+            ( double )aoi->analysis.fixation_count /
+                ( double )aoic->analysis.fixation_count;
+        aoi->analysis.dwell_time_relative =
+            aoi->analysis.dwell_time / aoic->analysis.dwell_time;
+        if( aoic->analysis.sample_dwell_time > 0 )
         {
-            aoi = &aoic->aois.items[i];
-            aoi->analysis.fixation_count_relative =
-                ( double )aoi->analysis.fixation_count /
-                    ( double )aoic->analysis.fixation_count;
-            aoi->analysis.dwell_time_relative =
-                aoi->analysis.dwell_time / aoic->analysis.dwell_time;
-            res = &analysis->aois.items[analysis->aois.count].analysis;
-            label = analysis->aois.items[analysis->aois.count].label;
-            gac_aoi_analysis_copy_to( res, &aoi->analysis );
-            strncpy( label, aoi->label, GAC_AOI_MAX_LABEL_LEN - 1 );
-            analysis->aois.count++;
+            aoi->analysis.sample_dwell_time_relative =
+                aoi->analysis.sample_dwell_time
+                    / aoic->analysis.sample_dwell_time;
         }
+        item = &analysis->aois.items[analysis->aois.count];
+        item->aoi_id = aoic->touched.items[i];
+        memcpy( item->label, aoi->label, sizeof( item->label ) );
+        gac_aoi_analysis_copy_to( &item->analysis, &aoi->analysis );
+        analysis->aois.count++;
     }
 
+    // AOIs which were not hit are still clear
     gac_aoi_collection_analysis_clear( &aoic->analysis );
-    for( i = 0; i < aoic->aois.count; i++ )
+    for( i = 0; i < aoic->touched.count; i++ )
     {
-        gac_aoi_analysis_clear( &aoic->aois.items[i].analysis );
+        idx = aoic->touched.items[i];
+        gac_aoi_analysis_clear( &aoic->aois.items[idx].analysis );
+        aoic->touched.flags[idx] = false;
     }
+    aoic->touched.count = 0;
 
     return true;
 }
@@ -104,6 +282,8 @@ bool gac_aoi_collection_analyse_fixation( gac_aoi_collection_t* aoic,
 {
     bool res = false;
     uint32_t i;
+    uint32_t count;
+    uint32_t* hits;
     gac_aoi_t* aoi;
     if( aoic == NULL || fixation == NULL )
     {
@@ -119,25 +299,130 @@ bool gac_aoi_collection_analyse_fixation( gac_aoi_collection_t* aoic,
     aoic->analysis.dwell_time += fixation->duration;
     aoic->analysis.fixation_count++;
 
-    for( i = 0; i < aoic->aois.count; i++ )
+    count = gac_aoi_collection_hits( aoic, fixation->screen_point[0],
+            fixation->screen_point[1],
+            fixation->first_sample.timestamp + fixation->duration / 2, &hits );
+    if( count > 0 )
     {
-        aoi = &aoic->aois.items[i];
-        if( gac_aoi_includes_point( aoi, fixation->screen_point[0],
-                    fixation->screen_point[1] ) )
+        gac_aoi_scanpath_add( &aoic->scanpath, hits[0], fixation->duration );
+    }
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aoic->aois.items[hits[i]];
+        gac_aoi_collection_touch( aoic, hits[i] );
+        if( aoi->analysis.fixation_count == 0 )
         {
-            if( aoi->analysis.fixation_count == 0 )
+            gac_fixation_copy_to( &aoi->analysis.first_fixation, fixation );
+            aoi->analysis.aoi_visited_before_count =
+                aoic->analysis.aoi_visited_count;
+            aoic->analysis.aoi_visited_count++;
+        }
+        aoi->analysis.fixation_count++;
+        aoi->analysis.dwell_time += fixation->duration;
+    }
+
+    return res;
+}
+
+/******************************************************************************/
+bool gac_aoi_collection_analyse_sample( gac_aoi_collection_t* aoic,
+        gac_sample_t* sample )
+{
+    uint32_t i;
+    uint32_t count;
+    uint32_t* hits;
+    uint32_t* history_hits;
+    double duration;
+    gac_aoi_collection_sample_t* last;
+
+    if( aoic == NULL || sample == NULL )
+    {
+        return false;
+    }
+
+    if( aoic->samples.length == 0 )
+    {
+        // there are no AOIs
+        return true;
+    }
+
+    if( aoic->samples.history_count > 0 )
+    {
+        last = &aoic->samples.history[aoic->samples.head];
+        if( sample->trial_id != aoic->samples.trial_id )
+        {
+            // the interval between two trials is not part of any trial
+            gac_aoi_collection_analyse_sample_flush( aoic );
+        }
+        else if( sample->timestamp > last->timestamp )
+        {
+            duration = sample->timestamp - last->timestamp;
+            history_hits = &aoic->samples.hits[aoic->samples.head
+                * aoic->samples.length];
+            for( i = 0; i < last->count; i++ )
             {
-                gac_fixation_copy_to( &aoi->analysis.first_fixation, fixation );
-                aoi->analysis.aoi_visited_before_count =
-                    aoic->analysis.aoi_visited_count;
-                aoic->analysis.aoi_visited_count++;
+                aoic->samples.dwell_times[history_hits[i]] += duration;
             }
-            aoi->analysis.fixation_count++;
-            aoi->analysis.dwell_time += fixation->duration;
+            aoic->samples.dwell_time += duration;
         }
     }
+    aoic->samples.trial_id = sample->trial_id;
 
-    return res;
+    count = gac_aoi_collection_hits( aoic, sample->screen_point[0],
+            sample->screen_point[1], sample->timestamp, &hits );
+
+    aoic->samples.head = ( aoic->samples.head + 1 )
+        % GAC_AOI_COLLECTION_SAMPLE_HISTORY;
+    if( aoic->samples.history_count < GAC_AOI_COLLECTION_SAMPLE_HISTORY )
+    {
+        aoic->samples.history_count++;
+    }
+    last = &aoic->samples.history[aoic->samples.head];
+    last->timestamp = sample->timestamp;
+    glm_vec2_copy( sample->screen_point, last->screen_point );
+    last->count = count;
+    history_hits = &aoic->samples.hits[aoic->samples.head
+        * aoic->samples.length];
+    for( i = 0; i < count; i++ )
+    {
+        history_hits[i] = hits[i];
+        aoic->samples.counts[hits[i]]++;
+    }
+    aoic->samples.count++;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_collection_analyse_sample_flush( gac_aoi_collection_t* aoic )
+{
+    uint32_t i;
+    gac_aoi_t* aoi;
+
+    if( aoic == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < aoic->aois.count; i++ )
+    {
+        if( aoic->samples.counts[i] == 0 )
+        {
+            continue;
+        }
+        aoi = &aoic->aois.items[i];
+        gac_aoi_collection_touch( aoic, i );
+        aoi->analysis.sample_count += aoic->samples.counts[i];
+        aoi->analysis.sample_dwell_time += aoic->samples.dwell_times[i];
+        aoic->samples.counts[i] = 0;
+        aoic->samples.dwell_times[i] = 0;
+    }
+    aoic->analysis.sample_count += aoic->samples.count;
+    aoic->analysis.sample_dwell_time += aoic->samples.dwell_time;
+    aoic->samples.count = 0;
+    aoic->samples.dwell_time = 0;
+
+    return true;
 }
 
 /******************************************************************************/
@@ -145,26 +430,58 @@ bool gac_aoi_collection_analyse_saccade( gac_aoi_collection_t* aoic,
         gac_saccade_t* saccade )
 {
     uint32_t i;
+    uint32_t j = 0;
+    uint32_t count;
+    uint32_t first_count;
+    uint32_t* hits;
+    uint32_t* first_hits;
+    bool has_first_hits;
+    bool is_first_hit;
     gac_aoi_t* aoi;
     if( aoic == NULL || saccade == NULL )
     {
         return false;
     }
 
-    for( i = 0; i < aoic->aois.count; i++ )
+    // only AOIs including the saccade end point can be entered
+    if( !gac_aoi_collection_find_sample_hits( aoic, &saccade->last_sample,
+                &hits, &count ) )
     {
-        aoi = &aoic->aois.items[i];
-        if( !gac_aoi_includes_point( aoi, saccade->first_sample.screen_point[0],
-                    saccade->first_sample.screen_point[1] )
-                && gac_aoi_includes_point( aoi,
-                    saccade->last_sample.screen_point[0],
-                    saccade->last_sample.screen_point[1] ) )
+        count = gac_aoi_collection_hits( aoic,
+                saccade->last_sample.screen_point[0],
+                saccade->last_sample.screen_point[1],
+                saccade->last_sample.timestamp, &hits );
+    }
+    has_first_hits = gac_aoi_collection_find_sample_hits( aoic,
+            &saccade->first_sample, &first_hits, &first_count );
+
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aoic->aois.items[hits[i]];
+        if( has_first_hits )
+        {
+            // both hit lists are in ascending order
+            while( j < first_count && first_hits[j] < hits[i] )
+            {
+                j++;
+            }
+            is_first_hit = j < first_count && first_hits[j] == hits[i];
+        }
+        else
+        {
+            is_first_hit = gac_aoi_includes_point_at( aoi,
+                    saccade->first_sample.screen_point[0],
+                    saccade->first_sample.screen_point[1],
+                    saccade->first_sample.timestamp );
+        }
+        if( !is_first_hit )
         {
             if( aoi->analysis.enter_saccade_count == 0 )
             {
                 gac_saccade_copy_to( &aoi->analysis.first_saccade, saccade );
             }
             aoi->analysis.enter_saccade_count++;
+            gac_aoi_collection_touch( aoic, hits[i] );
         }
     }
 
@@ -203,11 +520,40 @@ void gac_aoi_collection_destroy( gac_aoi_collection_t* aoic )
     }
 
     gac_aoi_collection_analysis_destroy( &aoic->analysis );
+    gac_aoi_grid_destroy( &aoic->grid );
+    gac_aoi_raster_destroy( &aoic->raster );
+    gac_aoi_timeline_destroy( &aoic->timeline );
+    gac_aoi_scanpath_destroy( &aoic->scanpath );
+    gac_aoi_scanpath_destroy( &aoic->results.scanpath );
 
     for( i = 0; i < aoic->aois.count; i++ )
     {
         gac_aoi_destroy( &aoic->aois.items[i] );
     }
+    free( aoic->aois.items );
+    aoic->aois.items = NULL;
+    aoic->aois.count = 0;
+    aoic->aois.length = 0;
+    free( aoic->results.items );
+    aoic->results.items = NULL;
+    aoic->results.length = 0;
+    free( aoic->hits.items );
+    aoic->hits.items = NULL;
+    aoic->hits.length = 0;
+    free( aoic->touched.items );
+    free( aoic->touched.flags );
+    aoic->touched.items = NULL;
+    aoic->touched.flags = NULL;
+    aoic->touched.count = 0;
+    aoic->touched.length = 0;
+    free( aoic->samples.counts );
+    free( aoic->samples.dwell_times );
+    free( aoic->samples.hits );
+    aoic->samples.counts = NULL;
+    aoic->samples.dwell_times = NULL;
+    aoic->samples.hits = NULL;
+    aoic->samples.length = 0;
+    aoic->samples.history_count = 0;
 
     if( aoic->_me != NULL )
     {
@@ -216,10 +562,131 @@ void gac_aoi_collection_destroy( gac_aoi_collection_t* aoic )
 }
 
 /******************************************************************************/
-bool gac_aoi_collection_init( gac_aoi_collection_t* aoic )
+bool gac_aoi_collection_find_sample_hits( gac_aoi_collection_t* aoic,
+        gac_sample_t* sample, uint32_t** hits, uint32_t* count )
+{
+    uint32_t i;
+    uint32_t idx;
+    gac_aoi_collection_sample_t* item;
+
+    if( aoic == NULL || sample == NULL || hits == NULL || count == NULL )
+    {
+        return false;
+    }
+
+    // search from the most recent sample backwards
+    for( i = 0; i < aoic->samples.history_count; i++ )
+    {
+        idx = ( aoic->samples.head + GAC_AOI_COLLECTION_SAMPLE_HISTORY - i )
+            % GAC_AOI_COLLECTION_SAMPLE_HISTORY;
+        item = &aoic->samples.history[idx];
+        if( item->timestamp == sample->timestamp
+                && item->screen_point[0] == sample->screen_point[0]
+                && item->screen_point[1] == sample->screen_point[1] )
+        {
+            *hits = &aoic->samples.hits[idx * aoic->samples.length];
+            *count = item->count;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+uint32_t gac_aoi_collection_get_sample_hits( gac_aoi_collection_t* aoic,
+        uint32_t** hits )
+{
+    if( aoic == NULL || hits == NULL || aoic->samples.history_count == 0 )
+    {
+        return 0;
+    }
+
+    *hits = &aoic->samples.hits[aoic->samples.head * aoic->samples.length];
+
+    return aoic->samples.history[aoic->samples.head].count;
+}
+
+/******************************************************************************/
+uint32_t gac_aoi_collection_hits( gac_aoi_collection_t* aoic, float x,
+        float y, double timestamp, uint32_t** hits )
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t count = 0;
+    uint32_t candidate_count;
+    uint32_t* candidates;
+
+    if( aoic == NULL || hits == NULL )
+    {
+        return 0;
+    }
+
+    *hits = aoic->hits.items;
+
+    if( !gac_aoi_raster_query( &aoic->raster, aoic->aois.items, x, y,
+                aoic->hits.items, aoic->hits.length, &count ) )
+    {
+        candidate_count = gac_aoi_grid_query( &aoic->grid, x, y,
+                &candidates );
+        for( i = 0; i < candidate_count; i++ )
+        {
+            if( gac_aoi_includes_point( &aoic->aois.items[candidates[i]], x,
+                        y ) )
+            {
+                aoic->hits.items[count] = candidates[i];
+                count++;
+            }
+        }
+    }
+
+    candidate_count = gac_aoi_timeline_query( &aoic->timeline, timestamp,
+            &candidates );
+    for( i = 0; i < candidate_count; i++ )
+    {
+        if( gac_aoi_includes_point_at( &aoic->aois.items[candidates[i]], x, y,
+                    timestamp ) )
+        {
+            // insert the dynamic AOI such that the hits stay ascending
+            for( j = count; j > 0 && aoic->hits.items[j - 1] > candidates[i];
+                    j-- )
+            {
+                aoic->hits.items[j] = aoic->hits.items[j - 1];
+            }
+            aoic->hits.items[j] = candidates[i];
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/******************************************************************************/
+bool gac_aoi_collection_includes_points( gac_aoi_collection_t* aoic,
+        const float* x, const float* y, uint32_t count, bool* inside )
 {
     uint32_t i;
 
+    if( aoic == NULL || inside == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < aoic->aois.count; i++ )
+    {
+        if( !gac_aoi_includes_points( &aoic->aois.items[i], x, y, count,
+                    &inside[( size_t )i * count] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_collection_init( gac_aoi_collection_t* aoic )
+{
     if( aoic == NULL )
     {
         return false;
@@ -227,10 +694,67 @@ bool gac_aoi_collection_init( gac_aoi_collection_t* aoic )
 
     aoic->_me = NULL;
     gac_aoi_collection_analysis_init( &aoic->analysis );
+    gac_aoi_grid_init( &aoic->grid );
+    gac_aoi_raster_init( &aoic->raster );
+    gac_aoi_timeline_init( &aoic->timeline );
+    gac_aoi_scanpath_init( &aoic->scanpath );
+    gac_aoi_scanpath_init( &aoic->results.scanpath );
+    aoic->aois.items = NULL;
     aoic->aois.count = 0;
-    for( i = 0; i < GAC_AOI_MAX; i++ )
+    aoic->aois.length = 0;
+    aoic->results.items = NULL;
+    aoic->results.length = 0;
+    aoic->hits.items = NULL;
+    aoic->hits.length = 0;
+    aoic->touched.items = NULL;
+    aoic->touched.count = 0;
+    aoic->touched.flags = NULL;
+    aoic->touched.length = 0;
+    aoic->samples.is_enabled = false;
+    aoic->samples.trial_id = 0;
+    aoic->samples.count = 0;
+    aoic->samples.dwell_time = 0;
+    aoic->samples.counts = NULL;
+    aoic->samples.dwell_times = NULL;
+    aoic->samples.head = 0;
+    aoic->samples.history_count = 0;
+    aoic->samples.hits = NULL;
+    aoic->samples.length = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_collection_rasterise( gac_aoi_collection_t* aoic, uint32_t width,
+        uint32_t height )
+{
+    if( aoic == NULL )
+    {
+        return false;
+    }
+
+    if( width == 0 || height == 0 )
+    {
+        return gac_aoi_raster_clear( &aoic->raster );
+    }
+
+    return gac_aoi_raster_build( &aoic->raster, aoic->aois.items,
+            aoic->aois.count, width, height );
+}
+
+/******************************************************************************/
+bool gac_aoi_collection_touch( gac_aoi_collection_t* aoic, uint32_t idx )
+{
+    if( aoic == NULL || idx >= aoic->aois.count )
+    {
+        return false;
+    }
+
+    if( !aoic->touched.flags[idx] )
     {
-        gac_aoi_init( &aoic->aois.items[i], NULL );
+        aoic->touched.flags[idx] = true;
+        aoic->touched.items[aoic->touched.count] = idx;
+        aoic->touched.count++;
     }
 
     return true;
@@ -20,6 +20,8 @@ bool gac_aoi_collection_analysis_clear( gac_aoi_collection_analysis_t* analysis
     analysis->aoi_visited_count = 0;
     analysis->dwell_time = 0;
     analysis->fixation_count = 0;
+    analysis->sample_count = 0;
+    analysis->sample_dwell_time = 0;
 
     return true;
 }
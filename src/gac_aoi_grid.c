@@ -0,0 +1,287 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_aoi_grid.h"
+#include <math.h>
+#include <stdlib.h>
+
+/******************************************************************************/
+bool gac_aoi_grid_build( gac_aoi_grid_t* grid, gac_aoi_t* aois,
+        uint32_t count )
+{
+    uint32_t i;
+    uint32_t row;
+    uint32_t col;
+    uint32_t row_first, row_last, col_first, col_last;
+    uint32_t indexed = 0;
+    uint32_t cell_count;
+    uint32_t length;
+    void* items;
+    gac_aoi_t* aoi;
+
+    if( grid == NULL || ( aois == NULL && count > 0 ) )
+    {
+        return false;
+    }
+
+    gac_aoi_grid_clear( grid );
+
+    grid->x_min = INFINITY;
+    grid->y_min = INFINITY;
+    grid->x_max = -INFINITY;
+    grid->y_max = -INFINITY;
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aois[i];
+        if( aoi->points.count == 0 || gac_aoi_is_dynamic( aoi ) )
+        {
+            continue;
+        }
+        grid->x_min = fminf( grid->x_min, aoi->bounding_box.x_min );
+        grid->y_min = fminf( grid->y_min, aoi->bounding_box.y_min );
+        grid->x_max = fmaxf( grid->x_max, aoi->bounding_box.x_max );
+        grid->y_max = fmaxf( grid->y_max, aoi->bounding_box.y_max );
+        indexed++;
+    }
+
+    if( indexed == 0 )
+    {
+        return true;
+    }
+
+    // aim at roughly one AOI per cell
+    grid->cols = ceil( sqrt( indexed ) );
+    if( grid->cols > GAC_AOI_GRID_MAX_DIM )
+    {
+        grid->cols = GAC_AOI_GRID_MAX_DIM;
+    }
+    grid->rows = grid->cols;
+    grid->cell_width = ( grid->x_max - grid->x_min ) / grid->cols;
+    grid->cell_height = ( grid->y_max - grid->y_min ) / grid->rows;
+    if( !( grid->cell_width > 0 ) )
+    {
+        grid->cols = 1;
+        grid->cell_width = 1;
+    }
+    if( !( grid->cell_height > 0 ) )
+    {
+        grid->rows = 1;
+        grid->cell_height = 1;
+    }
+
+    cell_count = grid->cols * grid->rows;
+    if( cell_count + 1 > grid->offsets.length )
+    {
+        items = realloc( grid->offsets.items,
+                sizeof( uint32_t ) * ( cell_count + 1 ) );
+        if( items == NULL )
+        {
+            gac_aoi_grid_clear( grid );
+            return false;
+        }
+        grid->offsets.items = items;
+        grid->offsets.length = cell_count + 1;
+    }
+    for( i = 0; i <= cell_count; i++ )
+    {
+        grid->offsets.items[i] = 0;
+    }
+
+    // count the AOIs per cell
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aois[i];
+        if( aoi->points.count == 0 || gac_aoi_is_dynamic( aoi ) )
+        {
+            continue;
+        }
+        gac_aoi_grid_cell_range( aoi->bounding_box.x_min,
+                aoi->bounding_box.x_max, grid->x_min, grid->cell_width,
+                grid->cols, &col_first, &col_last );
+        gac_aoi_grid_cell_range( aoi->bounding_box.y_min,
+                aoi->bounding_box.y_max, grid->y_min, grid->cell_height,
+                grid->rows, &row_first, &row_last );
+        for( row = row_first; row <= row_last; row++ )
+        {
+            for( col = col_first; col <= col_last; col++ )
+            {
+                grid->offsets.items[row * grid->cols + col + 1]++;
+            }
+        }
+    }
+
+    for( i = 0; i < cell_count; i++ )
+    {
+        grid->offsets.items[i + 1] += grid->offsets.items[i];
+    }
+
+    length = grid->offsets.items[cell_count];
+    if( length > grid->indices.length )
+    {
+        items = realloc( grid->indices.items, sizeof( uint32_t ) * length );
+        if( items == NULL )
+        {
+            gac_aoi_grid_clear( grid );
+            return false;
+        }
+        grid->indices.items = items;
+        grid->indices.length = length;
+    }
+    grid->indices.count = length;
+
+    // fill the cells in ascending AOI order, using the start offsets as
+    // insert positions and restoring them afterwards
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aois[i];
+        if( aoi->points.count == 0 || gac_aoi_is_dynamic( aoi ) )
+        {
+            continue;
+        }
+        gac_aoi_grid_cell_range( aoi->bounding_box.x_min,
+                aoi->bounding_box.x_max, grid->x_min, grid->cell_width,
+                grid->cols, &col_first, &col_last );
+        gac_aoi_grid_cell_range( aoi->bounding_box.y_min,
+                aoi->bounding_box.y_max, grid->y_min, grid->cell_height,
+                grid->rows, &row_first, &row_last );
+        for( row = row_first; row <= row_last; row++ )
+        {
+            for( col = col_first; col <= col_last; col++ )
+            {
+                grid->indices.items[
+                    grid->offsets.items[row * grid->cols + col]++] = i;
+            }
+        }
+    }
+    for( i = cell_count; i > 0; i-- )
+    {
+        grid->offsets.items[i] = grid->offsets.items[i - 1];
+    }
+    grid->offsets.items[0] = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+void gac_aoi_grid_cell_range( float min, float max, float origin, float size,
+        uint32_t dim, uint32_t* first, uint32_t* last )
+{
+    float cell;
+
+    cell = floorf( ( min - origin ) / size );
+    *first = cell < 0 ? 0 : ( cell >= dim ? dim - 1 : ( uint32_t )cell );
+    cell = floorf( ( max - origin ) / size );
+    *last = cell < 0 ? 0 : ( cell >= dim ? dim - 1 : ( uint32_t )cell );
+}
+
+/******************************************************************************/
+bool gac_aoi_grid_clear( gac_aoi_grid_t* grid )
+{
+    if( grid == NULL )
+    {
+        return false;
+    }
+
+    grid->x_min = 0;
+    grid->y_min = 0;
+    grid->x_max = 0;
+    grid->y_max = 0;
+    grid->cell_width = 1;
+    grid->cell_height = 1;
+    grid->cols = 0;
+    grid->rows = 0;
+    grid->indices.count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_aoi_grid_t* gac_aoi_grid_create()
+{
+    gac_aoi_grid_t* grid = malloc( sizeof( gac_aoi_grid_t ) );
+
+    if( grid == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_aoi_grid_init( grid ) )
+    {
+        free( grid );
+        return NULL;
+    }
+
+    grid->_me = grid;
+
+    return grid;
+}
+
+/******************************************************************************/
+void gac_aoi_grid_destroy( gac_aoi_grid_t* grid )
+{
+    if( grid == NULL )
+    {
+        return;
+    }
+
+    free( grid->offsets.items );
+    free( grid->indices.items );
+    grid->offsets.items = NULL;
+    grid->offsets.length = 0;
+    grid->indices.items = NULL;
+    grid->indices.length = 0;
+    gac_aoi_grid_clear( grid );
+
+    if( grid->_me != NULL )
+    {
+        free( grid->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_grid_init( gac_aoi_grid_t* grid )
+{
+    if( grid == NULL )
+    {
+        return false;
+    }
+
+    grid->_me = NULL;
+    grid->offsets.items = NULL;
+    grid->offsets.length = 0;
+    grid->indices.items = NULL;
+    grid->indices.length = 0;
+
+    return gac_aoi_grid_clear( grid );
+}
+
+/******************************************************************************/
+uint32_t gac_aoi_grid_query( gac_aoi_grid_t* grid, float x, float y,
+        uint32_t** candidates )
+{
+    uint32_t col;
+    uint32_t row;
+    uint32_t cell;
+
+    if( grid == NULL || candidates == NULL || grid->cols == 0
+            || !( x >= grid->x_min && x <= grid->x_max
+                && y >= grid->y_min && y <= grid->y_max ) )
+    {
+        // the point is outside of all AOI bounding boxes
+        return 0;
+    }
+
+    gac_aoi_grid_cell_range( x, x, grid->x_min, grid->cell_width, grid->cols,
+            &col, &col );
+    gac_aoi_grid_cell_range( y, y, grid->y_min, grid->cell_height, grid->rows,
+            &row, &row );
+    cell = row * grid->cols + col;
+    *candidates = &grid->indices.items[grid->offsets.items[cell]];
+
+    return grid->offsets.items[cell + 1] - grid->offsets.items[cell];
+}
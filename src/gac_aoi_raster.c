@@ -0,0 +1,533 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_aoi_raster.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+bool gac_aoi_raster_add( gac_aoi_raster_t* raster, gac_aoi_t* aoi,
+        uint32_t idx )
+{
+    uint32_t i;
+    uint32_t x;
+    uint32_t y;
+    uint32_t cell;
+    uint32_t entry;
+    uint32_t parent = 0;
+    uint32_t set = 0;
+    uint32_t length;
+    float x_min, x_max, y_min, y_max;
+    bool is_inside = false;
+    void* items;
+
+    if( raster == NULL || aoi == NULL || raster->cells == NULL )
+    {
+        return false;
+    }
+
+    if( aoi->points.count == 0 || gac_aoi_is_dynamic( aoi )
+            || aoi->bounding_box.x_max < 0
+            || aoi->bounding_box.x_min > 1 || aoi->bounding_box.y_max < 0
+            || aoi->bounding_box.y_min > 1 )
+    {
+        // the AOI does not cover any cell or depends on the time
+        return true;
+    }
+
+    // the cell window covered by the bounding box of the AOI
+    x_min = fmaxf( floorf( aoi->bounding_box.x_min * raster->width
+                - GAC_AOI_RASTER_EPSILON ), 0 );
+    x_max = fminf( floorf( aoi->bounding_box.x_max * raster->width
+                + GAC_AOI_RASTER_EPSILON ), raster->width - 1 );
+    y_min = fmaxf( floorf( aoi->bounding_box.y_min * raster->height
+                - GAC_AOI_RASTER_EPSILON ), 0 );
+    y_max = fminf( floorf( aoi->bounding_box.y_max * raster->height
+                + GAC_AOI_RASTER_EPSILON ), raster->height - 1 );
+    raster->marks.x = x_min;
+    raster->marks.y = y_min;
+    raster->marks.width = x_max - x_min + 1;
+    raster->marks.height = y_max - y_min + 1;
+
+    length = raster->marks.width * raster->marks.height;
+    if( length > raster->marks.length )
+    {
+        items = realloc( raster->marks.items, length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        raster->marks.items = items;
+        raster->marks.length = length;
+    }
+    memset( raster->marks.items, 0, length );
+
+    // the closing edge is marked as well such that a missing closing point
+    // only leads to additional exact tests
+    for( i = 1; i < aoi->points.count; i++ )
+    {
+        gac_aoi_raster_mark_edge( raster, &aoi->points.items[i - 1],
+                &aoi->points.items[i] );
+    }
+    gac_aoi_raster_mark_edge( raster,
+            &aoi->points.items[aoi->points.count - 1], &aoi->points.items[0] );
+
+    for( y = 0; y < raster->marks.height; y++ )
+    {
+        for( x = 0; x < raster->marks.width; x++ )
+        {
+            if( raster->marks.items[y * raster->marks.width + x] )
+            {
+                entry = idx | GAC_AOI_RASTER_BOUNDARY;
+            }
+            else
+            {
+                if( x == 0
+                        || raster->marks.items[y * raster->marks.width + x - 1] )
+                {
+                    // no edge passes through a run of unmarked cells, hence,
+                    // the center of the first cell classifies the whole run
+                    is_inside = gac_aoi_includes_point( aoi,
+                            ( raster->marks.x + x + 0.5f ) / raster->width,
+                            ( raster->marks.y + y + 0.5f ) / raster->height );
+                }
+                if( !is_inside )
+                {
+                    continue;
+                }
+                entry = idx;
+            }
+
+            cell = ( raster->marks.y + y ) * raster->width
+                + raster->marks.x + x;
+            // neighbouring cells mostly share the same set
+            if( raster->cells[cell] != parent || set == 0
+                    || raster->sets.entries[set] != entry )
+            {
+                parent = raster->cells[cell];
+                if( !gac_aoi_raster_set_add( raster, parent, entry, &set ) )
+                {
+                    return false;
+                }
+            }
+            raster->cells[cell] = set;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_raster_build( gac_aoi_raster_t* raster, gac_aoi_t* aois,
+        uint32_t count, uint32_t width, uint32_t height )
+{
+    uint32_t i;
+
+    if( raster == NULL || ( aois == NULL && count > 0 ) || width == 0
+            || height == 0 || ( uint64_t )width * height > 0x10000000u )
+    {
+        return false;
+    }
+
+    gac_aoi_raster_clear( raster );
+
+    raster->cells = calloc( ( size_t )width * height, sizeof( uint32_t ) );
+    raster->sets.length = 64;
+    raster->sets.parents = malloc( sizeof( uint32_t ) * raster->sets.length );
+    raster->sets.entries = malloc( sizeof( uint32_t ) * raster->sets.length );
+    raster->sets.bucket_count = 128;
+    raster->sets.buckets = calloc( raster->sets.bucket_count,
+            sizeof( uint32_t ) );
+    if( raster->cells == NULL || raster->sets.parents == NULL
+            || raster->sets.entries == NULL || raster->sets.buckets == NULL )
+    {
+        gac_aoi_raster_clear( raster );
+        return false;
+    }
+    raster->width = width;
+    raster->height = height;
+
+    // the empty set
+    raster->sets.parents[0] = 0;
+    raster->sets.entries[0] = 0;
+    raster->sets.count = 1;
+
+    for( i = 0; i < count; i++ )
+    {
+        if( !gac_aoi_raster_add( raster, &aois[i], i ) )
+        {
+            gac_aoi_raster_clear( raster );
+            return false;
+        }
+    }
+
+    if( !gac_aoi_raster_flatten( raster ) )
+    {
+        gac_aoi_raster_clear( raster );
+        return false;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_raster_clear( gac_aoi_raster_t* raster )
+{
+    if( raster == NULL )
+    {
+        return false;
+    }
+
+    free( raster->cells );
+    free( raster->offsets.items );
+    free( raster->entries.items );
+    free( raster->sets.parents );
+    free( raster->sets.entries );
+    free( raster->sets.buckets );
+    free( raster->marks.items );
+
+    raster->width = 0;
+    raster->height = 0;
+    raster->cells = NULL;
+    raster->offsets.items = NULL;
+    raster->offsets.count = 0;
+    raster->entries.items = NULL;
+    raster->entries.count = 0;
+    raster->sets.parents = NULL;
+    raster->sets.entries = NULL;
+    raster->sets.count = 0;
+    raster->sets.length = 0;
+    raster->sets.buckets = NULL;
+    raster->sets.bucket_count = 0;
+    raster->marks.items = NULL;
+    raster->marks.length = 0;
+    raster->marks.x = 0;
+    raster->marks.y = 0;
+    raster->marks.width = 0;
+    raster->marks.height = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_aoi_raster_t* gac_aoi_raster_create()
+{
+    gac_aoi_raster_t* raster = malloc( sizeof( gac_aoi_raster_t ) );
+
+    if( raster == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_aoi_raster_init( raster ) )
+    {
+        free( raster );
+        return NULL;
+    }
+
+    raster->_me = raster;
+
+    return raster;
+}
+
+/******************************************************************************/
+void gac_aoi_raster_destroy( gac_aoi_raster_t* raster )
+{
+    if( raster == NULL )
+    {
+        return;
+    }
+
+    gac_aoi_raster_clear( raster );
+
+    if( raster->_me != NULL )
+    {
+        free( raster->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_raster_flatten( gac_aoi_raster_t* raster )
+{
+    uint32_t i;
+    uint32_t parent;
+    uint32_t size;
+
+    if( raster == NULL )
+    {
+        return false;
+    }
+
+    raster->offsets.items = malloc( sizeof( uint32_t )
+            * ( raster->sets.count + 1 ) );
+    if( raster->offsets.items == NULL )
+    {
+        return false;
+    }
+    raster->offsets.count = raster->sets.count;
+
+    // a set is always created after its parent set
+    raster->offsets.items[0] = 0;
+    raster->offsets.items[1] = 0;
+    for( i = 1; i < raster->sets.count; i++ )
+    {
+        parent = raster->sets.parents[i];
+        size = raster->offsets.items[parent + 1]
+            - raster->offsets.items[parent] + 1;
+        raster->offsets.items[i + 1] = raster->offsets.items[i] + size;
+    }
+
+    raster->entries.count = raster->offsets.items[raster->sets.count];
+    raster->entries.items = malloc( sizeof( uint32_t )
+            * ( raster->entries.count + 1 ) );
+    if( raster->entries.items == NULL )
+    {
+        return false;
+    }
+
+    for( i = 1; i < raster->sets.count; i++ )
+    {
+        parent = raster->sets.parents[i];
+        size = raster->offsets.items[parent + 1]
+            - raster->offsets.items[parent];
+        memcpy( &raster->entries.items[raster->offsets.items[i]],
+                &raster->entries.items[raster->offsets.items[parent]],
+                sizeof( uint32_t ) * size );
+        raster->entries.items[raster->offsets.items[i] + size] =
+            raster->sets.entries[i];
+    }
+
+    free( raster->sets.parents );
+    free( raster->sets.entries );
+    free( raster->sets.buckets );
+    free( raster->marks.items );
+    raster->sets.parents = NULL;
+    raster->sets.entries = NULL;
+    raster->sets.buckets = NULL;
+    raster->sets.count = 0;
+    raster->sets.length = 0;
+    raster->sets.bucket_count = 0;
+    raster->marks.items = NULL;
+    raster->marks.length = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_raster_init( gac_aoi_raster_t* raster )
+{
+    if( raster == NULL )
+    {
+        return false;
+    }
+
+    raster->_me = NULL;
+    raster->cells = NULL;
+    raster->offsets.items = NULL;
+    raster->entries.items = NULL;
+    raster->sets.parents = NULL;
+    raster->sets.entries = NULL;
+    raster->sets.buckets = NULL;
+    raster->marks.items = NULL;
+
+    return gac_aoi_raster_clear( raster );
+}
+
+/******************************************************************************/
+void gac_aoi_raster_mark_edge( gac_aoi_raster_t* raster, vec2* p, vec2* q )
+{
+    int64_t row;
+    int64_t col;
+    int64_t row_first, row_last, col_first, col_last;
+    float x0, y0, x1, y1;
+    float y_lo, y_hi, y_a, y_b, x_a, x_b, tmp;
+
+    // edge coordinates in cells
+    x0 = ( *p )[0] * raster->width;
+    y0 = ( *p )[1] * raster->height;
+    x1 = ( *q )[0] * raster->width;
+    y1 = ( *q )[1] * raster->height;
+    y_lo = fminf( y0, y1 );
+    y_hi = fmaxf( y0, y1 );
+
+    row_first = floorf( y_lo - GAC_AOI_RASTER_EPSILON );
+    row_last = floorf( y_hi + GAC_AOI_RASTER_EPSILON );
+    if( row_first < raster->marks.y )
+    {
+        row_first = raster->marks.y;
+    }
+    if( row_last > raster->marks.y + raster->marks.height - 1 )
+    {
+        row_last = raster->marks.y + raster->marks.height - 1;
+    }
+
+    for( row = row_first; row <= row_last; row++ )
+    {
+        // the part of the edge within the row
+        y_a = fminf( fmaxf( row, y_lo ), y_hi );
+        y_b = fminf( fmaxf( row + 1, y_lo ), y_hi );
+        if( y_hi - y_lo > 0 )
+        {
+            x_a = x0 + ( y_a - y0 ) * ( x1 - x0 ) / ( y1 - y0 );
+            x_b = x0 + ( y_b - y0 ) * ( x1 - x0 ) / ( y1 - y0 );
+        }
+        else
+        {
+            x_a = x0;
+            x_b = x1;
+        }
+        if( x_a > x_b )
+        {
+            tmp = x_a;
+            x_a = x_b;
+            x_b = tmp;
+        }
+
+        col_first = floorf( x_a - GAC_AOI_RASTER_EPSILON );
+        col_last = floorf( x_b + GAC_AOI_RASTER_EPSILON );
+        if( col_first < raster->marks.x )
+        {
+            col_first = raster->marks.x;
+        }
+        if( col_last > raster->marks.x + raster->marks.width - 1 )
+        {
+            col_last = raster->marks.x + raster->marks.width - 1;
+        }
+        for( col = col_first; col <= col_last; col++ )
+        {
+            raster->marks.items[( row - raster->marks.y ) * raster->marks.width
+                + col - raster->marks.x] = 1;
+        }
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_raster_query( gac_aoi_raster_t* raster, gac_aoi_t* aois,
+        float x, float y, uint32_t* hits, uint32_t length, uint32_t* count )
+{
+    uint32_t i;
+    uint32_t col;
+    uint32_t row;
+    uint32_t set;
+    uint32_t entry;
+    uint32_t n_hits = 0;
+
+    if( raster == NULL || raster->cells == NULL || count == NULL
+            || !( x >= 0 && x <= 1 && y >= 0 && y <= 1 ) )
+    {
+        return false;
+    }
+
+    col = x * raster->width;
+    row = y * raster->height;
+    if( col == raster->width )
+    {
+        col--;
+    }
+    if( row == raster->height )
+    {
+        row--;
+    }
+
+    set = raster->cells[row * raster->width + col];
+    for( i = raster->offsets.items[set];
+            i < raster->offsets.items[set + 1] && n_hits < length; i++ )
+    {
+        entry = raster->entries.items[i];
+        if( entry & GAC_AOI_RASTER_BOUNDARY )
+        {
+            entry &= ~GAC_AOI_RASTER_BOUNDARY;
+            if( !gac_aoi_includes_point( &aois[entry], x, y ) )
+            {
+                continue;
+            }
+        }
+        hits[n_hits] = entry;
+        n_hits++;
+    }
+    *count = n_hits;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_raster_set_add( gac_aoi_raster_t* raster, uint32_t parent,
+        uint32_t entry, uint32_t* set )
+{
+    uint32_t i;
+    uint32_t mask;
+    uint32_t bucket;
+    uint32_t* buckets;
+    void* items;
+
+    mask = raster->sets.bucket_count - 1;
+    bucket = ( parent * 0x9e3779b1u ^ entry * 0x85ebca6bu ) & mask;
+    while( raster->sets.buckets[bucket] != 0 )
+    {
+        i = raster->sets.buckets[bucket];
+        if( raster->sets.parents[i] == parent
+                && raster->sets.entries[i] == entry )
+        {
+            *set = i;
+            return true;
+        }
+        bucket = ( bucket + 1 ) & mask;
+    }
+
+    if( raster->sets.count == raster->sets.length )
+    {
+        items = realloc( raster->sets.parents,
+                sizeof( uint32_t ) * raster->sets.length * 2 );
+        if( items == NULL )
+        {
+            return false;
+        }
+        raster->sets.parents = items;
+        items = realloc( raster->sets.entries,
+                sizeof( uint32_t ) * raster->sets.length * 2 );
+        if( items == NULL )
+        {
+            return false;
+        }
+        raster->sets.entries = items;
+        raster->sets.length *= 2;
+    }
+
+    *set = raster->sets.count;
+    raster->sets.parents[*set] = parent;
+    raster->sets.entries[*set] = entry;
+    raster->sets.buckets[bucket] = *set;
+    raster->sets.count++;
+
+    if( raster->sets.count * 2 > raster->sets.bucket_count )
+    {
+        // grow the hash table and reinsert all sets except the empty set
+        buckets = calloc( raster->sets.bucket_count * 2, sizeof( uint32_t ) );
+        if( buckets == NULL )
+        {
+            return false;
+        }
+        free( raster->sets.buckets );
+        raster->sets.buckets = buckets;
+        raster->sets.bucket_count *= 2;
+        mask = raster->sets.bucket_count - 1;
+        for( i = 1; i < raster->sets.count; i++ )
+        {
+            bucket = ( raster->sets.parents[i] * 0x9e3779b1u
+                    ^ raster->sets.entries[i] * 0x85ebca6bu ) & mask;
+            while( raster->sets.buckets[bucket] != 0 )
+            {
+                bucket = ( bucket + 1 ) & mask;
+            }
+            raster->sets.buckets[bucket] = i;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,270 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_aoi_scanpath.h"
+#include <stdlib.h>
+
+/******************************************************************************/
+bool gac_aoi_scanpath_add( gac_aoi_scanpath_t* scanpath, uint32_t aoi_id,
+        double duration )
+{
+    uint32_t i;
+    uint32_t idx;
+    uint32_t from;
+    uint32_t mask;
+    uint32_t length;
+    uint32_t bucket;
+    uint32_t* buckets;
+    gac_aoi_transition_t* transition;
+    void* items;
+
+    if( scanpath == NULL )
+    {
+        return false;
+    }
+
+    if( scanpath->aois.count == scanpath->aois.length )
+    {
+        length = scanpath->aois.length == 0 ? 16 : scanpath->aois.length * 2;
+        items = realloc( scanpath->aois.items, sizeof( uint32_t ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        scanpath->aois.items = items;
+        items = realloc( scanpath->aois.durations, sizeof( double ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        scanpath->aois.durations = items;
+        scanpath->aois.length = length;
+    }
+    scanpath->aois.items[scanpath->aois.count] = aoi_id;
+    scanpath->aois.durations[scanpath->aois.count] = duration;
+    scanpath->aois.count++;
+
+    if( scanpath->aois.count == 1 )
+    {
+        // the first AOI of the scanpath has no transition
+        return true;
+    }
+    from = scanpath->aois.items[scanpath->aois.count - 2];
+
+    if( scanpath->buckets.length == 0 )
+    {
+        scanpath->buckets.items = calloc( 16, sizeof( uint32_t ) );
+        if( scanpath->buckets.items == NULL )
+        {
+            return false;
+        }
+        scanpath->buckets.length = 16;
+    }
+
+    if( gac_aoi_scanpath_find_transition( scanpath, from, aoi_id, &idx ) )
+    {
+        scanpath->transitions.items[idx].count++;
+        return true;
+    }
+
+    if( scanpath->transitions.count == scanpath->transitions.length )
+    {
+        length = scanpath->transitions.length == 0 ? 16
+            : scanpath->transitions.length * 2;
+        items = realloc( scanpath->transitions.items,
+                sizeof( gac_aoi_transition_t ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        scanpath->transitions.items = items;
+        scanpath->transitions.length = length;
+    }
+    transition = &scanpath->transitions.items[scanpath->transitions.count];
+    transition->from = from;
+    transition->to = aoi_id;
+    transition->count = 1;
+    scanpath->transitions.count++;
+    scanpath->buckets.items[idx] = scanpath->transitions.count;
+
+    if( scanpath->transitions.count * 2 > scanpath->buckets.length )
+    {
+        // grow the hash table and reinsert all transitions
+        buckets = calloc( scanpath->buckets.length * 2, sizeof( uint32_t ) );
+        if( buckets == NULL )
+        {
+            return false;
+        }
+        free( scanpath->buckets.items );
+        scanpath->buckets.items = buckets;
+        scanpath->buckets.length *= 2;
+        mask = scanpath->buckets.length - 1;
+        for( i = 0; i < scanpath->transitions.count; i++ )
+        {
+            transition = &scanpath->transitions.items[i];
+            bucket = ( transition->from * 0x9e3779b1u
+                    ^ transition->to * 0x85ebca6bu ) & mask;
+            while( buckets[bucket] != 0 )
+            {
+                bucket = ( bucket + 1 ) & mask;
+            }
+            buckets[bucket] = i + 1;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_clear( gac_aoi_scanpath_t* scanpath )
+{
+    uint32_t i;
+    uint32_t mask;
+    uint32_t bucket;
+    gac_aoi_transition_t* transition;
+
+    if( scanpath == NULL )
+    {
+        return false;
+    }
+
+    // every transition occupies exactly one bucket, search it regardless of
+    // the buckets which were already cleared
+    mask = scanpath->buckets.length - 1;
+    for( i = 0; i < scanpath->transitions.count; i++ )
+    {
+        transition = &scanpath->transitions.items[i];
+        bucket = ( transition->from * 0x9e3779b1u
+                ^ transition->to * 0x85ebca6bu ) & mask;
+        while( scanpath->buckets.items[bucket] != i + 1 )
+        {
+            bucket = ( bucket + 1 ) & mask;
+        }
+        scanpath->buckets.items[bucket] = 0;
+    }
+    scanpath->transitions.count = 0;
+    scanpath->aois.count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_aoi_scanpath_t* gac_aoi_scanpath_create()
+{
+    gac_aoi_scanpath_t* scanpath = malloc( sizeof( gac_aoi_scanpath_t ) );
+
+    if( scanpath == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_aoi_scanpath_init( scanpath ) )
+    {
+        free( scanpath );
+        return NULL;
+    }
+
+    scanpath->_me = scanpath;
+
+    return scanpath;
+}
+
+/******************************************************************************/
+void gac_aoi_scanpath_destroy( gac_aoi_scanpath_t* scanpath )
+{
+    if( scanpath == NULL )
+    {
+        return;
+    }
+
+    free( scanpath->aois.items );
+    free( scanpath->aois.durations );
+    free( scanpath->transitions.items );
+    free( scanpath->buckets.items );
+    scanpath->aois.items = NULL;
+    scanpath->aois.durations = NULL;
+    scanpath->aois.count = 0;
+    scanpath->aois.length = 0;
+    scanpath->transitions.items = NULL;
+    scanpath->transitions.count = 0;
+    scanpath->transitions.length = 0;
+    scanpath->buckets.items = NULL;
+    scanpath->buckets.length = 0;
+
+    if( scanpath->_me != NULL )
+    {
+        free( scanpath->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_find_transition( gac_aoi_scanpath_t* scanpath,
+        uint32_t from, uint32_t to, uint32_t* idx )
+{
+    uint32_t i;
+    uint32_t mask;
+    uint32_t bucket;
+
+    if( scanpath == NULL || idx == NULL || scanpath->buckets.length == 0 )
+    {
+        return false;
+    }
+
+    mask = scanpath->buckets.length - 1;
+    bucket = ( from * 0x9e3779b1u ^ to * 0x85ebca6bu ) & mask;
+    while( scanpath->buckets.items[bucket] != 0 )
+    {
+        i = scanpath->buckets.items[bucket] - 1;
+        if( scanpath->transitions.items[i].from == from
+                && scanpath->transitions.items[i].to == to )
+        {
+            *idx = i;
+            return true;
+        }
+        bucket = ( bucket + 1 ) & mask;
+    }
+    *idx = bucket;
+
+    return false;
+}
+
+/******************************************************************************/
+uint32_t gac_aoi_scanpath_get_transition_count( gac_aoi_scanpath_t* scanpath,
+        uint32_t from, uint32_t to )
+{
+    uint32_t idx;
+
+    if( !gac_aoi_scanpath_find_transition( scanpath, from, to, &idx ) )
+    {
+        return 0;
+    }
+
+    return scanpath->transitions.items[idx].count;
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_init( gac_aoi_scanpath_t* scanpath )
+{
+    if( scanpath == NULL )
+    {
+        return false;
+    }
+
+    scanpath->_me = NULL;
+    scanpath->aois.items = NULL;
+    scanpath->aois.durations = NULL;
+    scanpath->aois.count = 0;
+    scanpath->aois.length = 0;
+    scanpath->transitions.items = NULL;
+    scanpath->transitions.count = 0;
+    scanpath->transitions.length = 0;
+    scanpath->buckets.items = NULL;
+    scanpath->buckets.length = 0;
+
+    return true;
+}
@@ -0,0 +1,519 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_aoi_scanpath_compare.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+uint32_t gac_aoi_scanpath_compare_bin_count( gac_aoi_scanpath_compare_t* cmp,
+        double duration )
+{
+    double count;
+
+    if( cmp == NULL || !( cmp->scanmatch.bin_width > 0 )
+            || !( duration > 0 ) )
+    {
+        return 1;
+    }
+
+    count = floor( duration / cmp->scanmatch.bin_width + 0.5 );
+    if( count < 1 )
+    {
+        return 1;
+    }
+    if( count > UINT32_MAX / 4 )
+    {
+        return UINT32_MAX / 4;
+    }
+
+    return ( uint32_t )count;
+}
+
+/******************************************************************************/
+gac_aoi_scanpath_compare_t* gac_aoi_scanpath_compare_create()
+{
+    gac_aoi_scanpath_compare_t* cmp =
+        malloc( sizeof( gac_aoi_scanpath_compare_t ) );
+
+    if( cmp == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_aoi_scanpath_compare_init( cmp ) )
+    {
+        free( cmp );
+        return NULL;
+    }
+
+    cmp->_me = cmp;
+
+    return cmp;
+}
+
+/******************************************************************************/
+void gac_aoi_scanpath_compare_destroy( gac_aoi_scanpath_compare_t* cmp )
+{
+    if( cmp == NULL )
+    {
+        return;
+    }
+
+    free( cmp->peq.items );
+    free( cmp->deltas.items );
+    free( cmp->scanmatch.substitution );
+    free( cmp->bins.items );
+    free( cmp->scores.items );
+    cmp->peq.items = NULL;
+    cmp->peq.length = 0;
+    cmp->deltas.items = NULL;
+    cmp->deltas.length = 0;
+    cmp->scanmatch.substitution = NULL;
+    cmp->scanmatch.aoi_count = 0;
+    cmp->bins.items = NULL;
+    cmp->bins.length = 0;
+    cmp->scores.items = NULL;
+    cmp->scores.length = 0;
+
+    if( cmp->_me != NULL )
+    {
+        free( cmp->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_compare_init( gac_aoi_scanpath_compare_t* cmp )
+{
+    if( cmp == NULL )
+    {
+        return false;
+    }
+
+    cmp->_me = NULL;
+    cmp->peq.items = NULL;
+    cmp->peq.length = 0;
+    cmp->deltas.items = NULL;
+    cmp->deltas.length = 0;
+    cmp->scanmatch.substitution = NULL;
+    cmp->scanmatch.aoi_count = 0;
+    cmp->scanmatch.max_substitution = 0;
+    cmp->scanmatch.gap = 0;
+    cmp->scanmatch.bin_width = 0;
+    cmp->bins.items = NULL;
+    cmp->bins.length = 0;
+    cmp->scores.items = NULL;
+    cmp->scores.length = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_compare_levenshtein( gac_aoi_scanpath_compare_t* cmp,
+        const uint32_t* a, uint32_t a_count, const uint32_t* b,
+        uint32_t b_count, uint32_t* distance )
+{
+    uint32_t i, j, w;
+    uint32_t words;
+    uint32_t length;
+    uint32_t symbol_count;
+    uint32_t count;
+    const uint32_t* seq;
+    const uint64_t* peq;
+    uint64_t eq, pv, mv, xv, xh, ph, mh;
+    uint64_t high;
+    uint64_t last;
+    int hin, hout;
+    uint32_t score;
+    void* items;
+
+    if( cmp == NULL || distance == NULL || ( a == NULL && a_count > 0 )
+            || ( b == NULL && b_count > 0 ) )
+    {
+        return false;
+    }
+
+    // the shorter sequence is the pattern encoded in the bit vectors
+    if( a_count > b_count )
+    {
+        seq = a;
+        a = b;
+        b = seq;
+        count = a_count;
+        a_count = b_count;
+        b_count = count;
+    }
+
+    if( a_count == 0 )
+    {
+        *distance = b_count;
+        return true;
+    }
+
+    words = ( a_count + 63 ) / 64;
+    symbol_count = 0;
+    for( i = 0; i < a_count; i++ )
+    {
+        if( a[i] >= symbol_count )
+        {
+            symbol_count = a[i] + 1;
+        }
+    }
+
+    if( ( uint64_t )symbol_count * words > UINT32_MAX )
+    {
+        return false;
+    }
+    length = symbol_count * words;
+    if( length > cmp->peq.length )
+    {
+        // the masks are kept zeroed between two comparisons
+        items = calloc( length, sizeof( uint64_t ) );
+        if( items == NULL )
+        {
+            return false;
+        }
+        free( cmp->peq.items );
+        cmp->peq.items = items;
+        cmp->peq.length = length;
+    }
+    if( 2 * words > cmp->deltas.length )
+    {
+        items = realloc( cmp->deltas.items, sizeof( uint64_t ) * 2 * words );
+        if( items == NULL )
+        {
+            return false;
+        }
+        cmp->deltas.items = items;
+        cmp->deltas.length = 2 * words;
+    }
+
+    for( i = 0; i < a_count; i++ )
+    {
+        cmp->peq.items[a[i] * words + i / 64] |= ( uint64_t )1 << ( i % 64 );
+    }
+    for( w = 0; w < words; w++ )
+    {
+        cmp->deltas.items[2 * w] = ~( uint64_t )0;
+        cmp->deltas.items[2 * w + 1] = 0;
+    }
+
+    // one column of the edit distance matrix per AOI of the text sequence,
+    // the score tracks the last row of the matrix
+    score = a_count;
+    last = ( uint64_t )1 << ( ( a_count - 1 ) % 64 );
+    for( j = 0; j < b_count; j++ )
+    {
+        peq = NULL;
+        if( b[j] < symbol_count )
+        {
+            peq = &cmp->peq.items[b[j] * words];
+        }
+        hin = 1;
+        for( w = 0; w < words; w++ )
+        {
+            eq = peq == NULL ? 0 : peq[w];
+            pv = cmp->deltas.items[2 * w];
+            mv = cmp->deltas.items[2 * w + 1];
+            xv = eq | mv;
+            if( hin < 0 )
+            {
+                eq |= 1;
+            }
+            xh = ( ( ( eq & pv ) + pv ) ^ pv ) | eq;
+            ph = mv | ~( xh | pv );
+            mh = pv & xh;
+            high = w == words - 1 ? last : ( uint64_t )1 << 63;
+            hout = 0;
+            if( ph & high )
+            {
+                hout = 1;
+            }
+            else if( mh & high )
+            {
+                hout = -1;
+            }
+            ph <<= 1;
+            mh <<= 1;
+            if( hin < 0 )
+            {
+                mh |= 1;
+            }
+            else if( hin > 0 )
+            {
+                ph |= 1;
+            }
+            cmp->deltas.items[2 * w] = mh | ~( xv | ph );
+            cmp->deltas.items[2 * w + 1] = ph & xv;
+            hin = hout;
+        }
+        score += hin;
+    }
+
+    for( i = 0; i < a_count; i++ )
+    {
+        cmp->peq.items[a[i] * words + i / 64] = 0;
+    }
+
+    *distance = score;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_compare_scanmatch( gac_aoi_scanpath_compare_t* cmp,
+        const uint32_t* a, const double* a_durations, uint32_t a_count,
+        const uint32_t* b, const double* b_durations, uint32_t b_count,
+        double* score )
+{
+    uint32_t i, j, k;
+    uint32_t a_bins, b_bins;
+    uint32_t reps;
+    uint64_t length;
+    uint32_t* a_seq;
+    uint32_t* b_seq;
+    double* row;
+    double* scores;
+    double diag, up, best, gap;
+    void* items;
+
+    if( cmp == NULL || score == NULL || cmp->scanmatch.substitution == NULL
+            || ( a_count > 0 && ( a == NULL || a_durations == NULL ) )
+            || ( b_count > 0 && ( b == NULL || b_durations == NULL ) ) )
+    {
+        return false;
+    }
+
+    // count the temporal bins of both sequences
+    a_bins = 0;
+    b_bins = 0;
+    for( k = 0; k < 2; k++ )
+    {
+        length = 0;
+        for( i = 0; i < ( k == 0 ? a_count : b_count ); i++ )
+        {
+            if( ( k == 0 ? a[i] : b[i] ) >= cmp->scanmatch.aoi_count )
+            {
+                return false;
+            }
+            reps = gac_aoi_scanpath_compare_bin_count( cmp,
+                    k == 0 ? a_durations[i] : b_durations[i] );
+            length += reps;
+        }
+        if( length > UINT32_MAX / 4 )
+        {
+            return false;
+        }
+        if( k == 0 )
+        {
+            a_bins = length;
+        }
+        else
+        {
+            b_bins = length;
+        }
+    }
+
+    if( a_bins == 0 && b_bins == 0 )
+    {
+        *score = 0;
+        return true;
+    }
+
+    if( a_bins + b_bins > cmp->bins.length )
+    {
+        items = realloc( cmp->bins.items,
+                sizeof( uint32_t ) * ( a_bins + b_bins ) );
+        if( items == NULL )
+        {
+            return false;
+        }
+        cmp->bins.items = items;
+        cmp->bins.length = a_bins + b_bins;
+    }
+    if( b_bins + 1 > cmp->scores.length )
+    {
+        items = realloc( cmp->scores.items,
+                sizeof( double ) * ( b_bins + 1 ) );
+        if( items == NULL )
+        {
+            return false;
+        }
+        cmp->scores.items = items;
+        cmp->scores.length = b_bins + 1;
+    }
+
+    a_seq = cmp->bins.items;
+    b_seq = &cmp->bins.items[a_bins];
+    k = 0;
+    for( i = 0; i < a_count; i++ )
+    {
+        reps = gac_aoi_scanpath_compare_bin_count( cmp, a_durations[i] );
+        for( j = 0; j < reps; j++ )
+        {
+            a_seq[k++] = a[i];
+        }
+    }
+    k = 0;
+    for( i = 0; i < b_count; i++ )
+    {
+        reps = gac_aoi_scanpath_compare_bin_count( cmp, b_durations[i] );
+        for( j = 0; j < reps; j++ )
+        {
+            b_seq[k++] = b[i];
+        }
+    }
+
+    // Needleman-Wunsch alignment, only one row of the matrix is kept
+    gap = cmp->scanmatch.gap;
+    scores = cmp->scores.items;
+    for( j = 0; j <= b_bins; j++ )
+    {
+        scores[j] = j * gap;
+    }
+    for( i = 0; i < a_bins; i++ )
+    {
+        row = &cmp->scanmatch.substitution[( uint64_t )a_seq[i]
+            * cmp->scanmatch.aoi_count];
+        diag = scores[0];
+        scores[0] = ( i + 1 ) * gap;
+        for( j = 0; j < b_bins; j++ )
+        {
+            up = scores[j + 1];
+            best = diag + row[b_seq[j]];
+            if( up + gap > best )
+            {
+                best = up + gap;
+            }
+            if( scores[j] + gap > best )
+            {
+                best = scores[j] + gap;
+            }
+            diag = up;
+            scores[j + 1] = best;
+        }
+    }
+
+    *score = scores[b_bins] / ( cmp->scanmatch.max_substitution
+            * ( a_bins > b_bins ? a_bins : b_bins ) );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_compare_set_aois( gac_aoi_scanpath_compare_t* cmp,
+        gac_aoi_t* aois, uint32_t count, double threshold, double gap,
+        double bin_width )
+{
+    uint32_t i, j;
+    double dx, dy;
+    double* centers;
+
+    if( cmp == NULL || aois == NULL || count == 0 || !( threshold > 0 ) )
+    {
+        return false;
+    }
+
+    centers = malloc( sizeof( double ) * 2 * count );
+    if( centers == NULL )
+    {
+        return false;
+    }
+    for( i = 0; i < count; i++ )
+    {
+        centers[2 * i] = ( aois[i].bounding_box.x_min
+                + aois[i].bounding_box.x_max ) / 2.0;
+        centers[2 * i + 1] = ( aois[i].bounding_box.y_min
+                + aois[i].bounding_box.y_max ) / 2.0;
+    }
+
+    // fill the matrix in place, the diagonal holds the largest value 1
+    if( !gac_aoi_scanpath_compare_set_substitution( cmp, NULL, count, gap,
+                bin_width ) )
+    {
+        free( centers );
+        return false;
+    }
+    for( i = 0; i < count; i++ )
+    {
+        for( j = 0; j < count; j++ )
+        {
+            dx = centers[2 * i] - centers[2 * j];
+            dy = centers[2 * i + 1] - centers[2 * j + 1];
+            cmp->scanmatch.substitution[( uint64_t )i * count + j] =
+                1 - sqrt( dx * dx + dy * dy ) / threshold;
+        }
+    }
+    free( centers );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_scanpath_compare_set_substitution(
+        gac_aoi_scanpath_compare_t* cmp, const double* substitution,
+        uint32_t aoi_count, double gap, double bin_width )
+{
+    uint64_t i;
+    uint64_t length;
+    double max_substitution;
+    void* items;
+
+    if( cmp == NULL || aoi_count == 0 )
+    {
+        return false;
+    }
+
+    length = ( uint64_t )aoi_count * aoi_count;
+    if( length > SIZE_MAX / sizeof( double ) )
+    {
+        return false;
+    }
+
+    max_substitution = 1;
+    if( substitution != NULL )
+    {
+        max_substitution = substitution[0];
+        for( i = 0; i < length; i++ )
+        {
+            if( substitution[i] > max_substitution )
+            {
+                max_substitution = substitution[i];
+            }
+        }
+        if( !( max_substitution > 0 ) )
+        {
+            return false;
+        }
+    }
+
+    if( aoi_count != cmp->scanmatch.aoi_count )
+    {
+        items = realloc( cmp->scanmatch.substitution,
+                sizeof( double ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        cmp->scanmatch.substitution = items;
+        cmp->scanmatch.aoi_count = aoi_count;
+    }
+    cmp->scanmatch.max_substitution = max_substitution;
+    cmp->scanmatch.gap = gap;
+    cmp->scanmatch.bin_width = bin_width;
+
+    // without a matrix the caller fills in the matrix
+    if( substitution != NULL )
+    {
+        memcpy( cmp->scanmatch.substitution, substitution,
+                sizeof( double ) * length );
+    }
+
+    return true;
+}
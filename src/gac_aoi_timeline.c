@@ -0,0 +1,328 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_aoi_timeline.h"
+#include <math.h>
+#include <stdlib.h>
+
+/******************************************************************************/
+void gac_aoi_timeline_bin_range( double start, double end, double origin,
+        double width, uint32_t count, uint32_t* first, uint32_t* last )
+{
+    double bin;
+
+    bin = floor( ( start - origin ) / width );
+    *first = bin < 0 ? 0 : ( bin >= count ? count - 1 : ( uint32_t )bin );
+    bin = floor( ( end - origin ) / width );
+    *last = bin < 0 ? 0 : ( bin >= count ? count - 1 : ( uint32_t )bin );
+}
+
+/******************************************************************************/
+bool gac_aoi_timeline_build( gac_aoi_timeline_t* timeline, gac_aoi_t* aois,
+        uint32_t count )
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t bin;
+    uint32_t first, last;
+    uint32_t prev;
+    uint32_t span_count = 0;
+    uint32_t interval_count;
+    uint32_t length;
+    double start, end;
+    bool has_prev;
+    void* items;
+    gac_aoi_t* aoi;
+
+    if( timeline == NULL || ( aois == NULL && count > 0 ) )
+    {
+        return false;
+    }
+
+    gac_aoi_timeline_clear( timeline );
+
+    timeline->t_min = INFINITY;
+    timeline->t_max = -INFINITY;
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aois[i];
+        if( !gac_aoi_is_dynamic( aoi ) )
+        {
+            continue;
+        }
+        interval_count = aoi->intervals.count > 0 ? aoi->intervals.count : 1;
+        for( j = 0; j < interval_count; j++ )
+        {
+            if( gac_aoi_timeline_span( aoi, j, &start, &end ) )
+            {
+                timeline->t_min = fmin( timeline->t_min, start );
+                timeline->t_max = fmax( timeline->t_max, end );
+                span_count++;
+            }
+        }
+    }
+
+    if( span_count == 0 )
+    {
+        return true;
+    }
+
+    // aim at roughly one span per bin
+    timeline->bin_count = span_count;
+    if( timeline->bin_count > GAC_AOI_TIMELINE_MAX_BINS )
+    {
+        timeline->bin_count = GAC_AOI_TIMELINE_MAX_BINS;
+    }
+    timeline->bin_width = ( timeline->t_max - timeline->t_min )
+        / timeline->bin_count;
+    if( !( timeline->bin_width > 0 ) )
+    {
+        timeline->bin_count = 1;
+        timeline->bin_width = 1;
+    }
+
+    if( timeline->bin_count + 1 > timeline->offsets.length )
+    {
+        items = realloc( timeline->offsets.items,
+                sizeof( uint32_t ) * ( timeline->bin_count + 1 ) );
+        if( items == NULL )
+        {
+            gac_aoi_timeline_clear( timeline );
+            return false;
+        }
+        timeline->offsets.items = items;
+        timeline->offsets.length = timeline->bin_count + 1;
+    }
+    for( i = 0; i <= timeline->bin_count; i++ )
+    {
+        timeline->offsets.items[i] = 0;
+    }
+
+    // count the AOIs per bin, the spans of an AOI are ascending, hence, only
+    // the first bin of a span may already hold the AOI
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aois[i];
+        if( !gac_aoi_is_dynamic( aoi ) )
+        {
+            continue;
+        }
+        has_prev = false;
+        prev = 0;
+        interval_count = aoi->intervals.count > 0 ? aoi->intervals.count : 1;
+        for( j = 0; j < interval_count; j++ )
+        {
+            if( !gac_aoi_timeline_span( aoi, j, &start, &end ) )
+            {
+                continue;
+            }
+            gac_aoi_timeline_bin_range( start, end, timeline->t_min,
+                    timeline->bin_width, timeline->bin_count, &first, &last );
+            if( has_prev && first <= prev )
+            {
+                first = prev + 1;
+            }
+            for( bin = first; bin <= last; bin++ )
+            {
+                timeline->offsets.items[bin + 1]++;
+            }
+            if( last >= first )
+            {
+                prev = last;
+                has_prev = true;
+            }
+        }
+    }
+
+    for( i = 0; i < timeline->bin_count; i++ )
+    {
+        timeline->offsets.items[i + 1] += timeline->offsets.items[i];
+    }
+
+    length = timeline->offsets.items[timeline->bin_count];
+    if( length > timeline->indices.length )
+    {
+        items = realloc( timeline->indices.items,
+                sizeof( uint32_t ) * length );
+        if( items == NULL )
+        {
+            gac_aoi_timeline_clear( timeline );
+            return false;
+        }
+        timeline->indices.items = items;
+        timeline->indices.length = length;
+    }
+    timeline->indices.count = length;
+
+    // fill the bins in ascending AOI order, using the start offsets as insert
+    // positions and restoring them afterwards
+    for( i = 0; i < count; i++ )
+    {
+        aoi = &aois[i];
+        if( !gac_aoi_is_dynamic( aoi ) )
+        {
+            continue;
+        }
+        has_prev = false;
+        prev = 0;
+        interval_count = aoi->intervals.count > 0 ? aoi->intervals.count : 1;
+        for( j = 0; j < interval_count; j++ )
+        {
+            if( !gac_aoi_timeline_span( aoi, j, &start, &end ) )
+            {
+                continue;
+            }
+            gac_aoi_timeline_bin_range( start, end, timeline->t_min,
+                    timeline->bin_width, timeline->bin_count, &first, &last );
+            if( has_prev && first <= prev )
+            {
+                first = prev + 1;
+            }
+            for( bin = first; bin <= last; bin++ )
+            {
+                timeline->indices.items[timeline->offsets.items[bin]++] = i;
+            }
+            if( last >= first )
+            {
+                prev = last;
+                has_prev = true;
+            }
+        }
+    }
+    for( i = timeline->bin_count; i > 0; i-- )
+    {
+        timeline->offsets.items[i] = timeline->offsets.items[i - 1];
+    }
+    timeline->offsets.items[0] = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_aoi_timeline_clear( gac_aoi_timeline_t* timeline )
+{
+    if( timeline == NULL )
+    {
+        return false;
+    }
+
+    timeline->t_min = 0;
+    timeline->t_max = 0;
+    timeline->bin_width = 1;
+    timeline->bin_count = 0;
+    timeline->indices.count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_aoi_timeline_t* gac_aoi_timeline_create()
+{
+    gac_aoi_timeline_t* timeline = malloc( sizeof( gac_aoi_timeline_t ) );
+
+    if( timeline == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_aoi_timeline_init( timeline ) )
+    {
+        free( timeline );
+        return NULL;
+    }
+
+    timeline->_me = timeline;
+
+    return timeline;
+}
+
+/******************************************************************************/
+void gac_aoi_timeline_destroy( gac_aoi_timeline_t* timeline )
+{
+    if( timeline == NULL )
+    {
+        return;
+    }
+
+    free( timeline->offsets.items );
+    free( timeline->indices.items );
+    timeline->offsets.items = NULL;
+    timeline->offsets.length = 0;
+    timeline->indices.items = NULL;
+    timeline->indices.length = 0;
+    gac_aoi_timeline_clear( timeline );
+
+    if( timeline->_me != NULL )
+    {
+        free( timeline->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_aoi_timeline_init( gac_aoi_timeline_t* timeline )
+{
+    if( timeline == NULL )
+    {
+        return false;
+    }
+
+    timeline->_me = NULL;
+    timeline->offsets.items = NULL;
+    timeline->offsets.length = 0;
+    timeline->indices.items = NULL;
+    timeline->indices.length = 0;
+
+    return gac_aoi_timeline_clear( timeline );
+}
+
+/******************************************************************************/
+uint32_t gac_aoi_timeline_query( gac_aoi_timeline_t* timeline,
+        double timestamp, uint32_t** candidates )
+{
+    uint32_t bin;
+
+    if( timeline == NULL || candidates == NULL || timeline->bin_count == 0
+            || !( timestamp >= timeline->t_min
+                && timestamp <= timeline->t_max ) )
+    {
+        // no dynamic AOI is visible at this time
+        return 0;
+    }
+
+    gac_aoi_timeline_bin_range( timestamp, timestamp, timeline->t_min,
+            timeline->bin_width, timeline->bin_count, &bin, &bin );
+    *candidates = &timeline->indices.items[timeline->offsets.items[bin]];
+
+    return timeline->offsets.items[bin + 1] - timeline->offsets.items[bin];
+}
+
+/******************************************************************************/
+bool gac_aoi_timeline_span( gac_aoi_t* aoi, uint32_t idx, double* start,
+        double* end )
+{
+    if( aoi == NULL || start == NULL || end == NULL )
+    {
+        return false;
+    }
+
+    *start = -INFINITY;
+    *end = INFINITY;
+    if( idx < aoi->intervals.count )
+    {
+        *start = aoi->intervals.items[idx].start;
+        *end = aoi->intervals.items[idx].end;
+    }
+    if( aoi->keyframes.count > 0 )
+    {
+        *start = fmax( *start, aoi->keyframes.items[0].timestamp );
+        *end = fmin( *end,
+                aoi->keyframes.items[aoi->keyframes.count - 1].timestamp );
+    }
+
+    return *start <= *end;
+}
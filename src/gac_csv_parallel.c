@@ -0,0 +1,428 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_csv_parallel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/******************************************************************************/
+gac_csv_parallel_t* gac_csv_parallel_create( FILE* fp,
+        gac_label_table_t* labels, uint32_t worker_count )
+{
+    gac_csv_parallel_t* cp = malloc( sizeof( gac_csv_parallel_t ) );
+
+    if( cp == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_csv_parallel_init( cp, fp, labels, worker_count ) )
+    {
+        gac_csv_parallel_destroy( cp );
+        free( cp );
+        return NULL;
+    }
+
+    cp->_me = cp;
+
+    return cp;
+}
+
+/******************************************************************************/
+void gac_csv_parallel_destroy( gac_csv_parallel_t* cp )
+{
+    uint32_t i;
+    gac_csv_parallel_worker_t* worker;
+
+    if( cp == NULL )
+    {
+        return;
+    }
+
+    for( i = 0; i < cp->workers.count; i++ )
+    {
+        worker = &cp->workers.items[i];
+        if( worker->is_started )
+        {
+            pthread_mutex_lock( &worker->lock );
+            worker->stop = true;
+            pthread_cond_signal( &worker->consumed );
+            pthread_mutex_unlock( &worker->lock );
+            pthread_join( worker->thread, NULL );
+            worker->is_started = false;
+        }
+        pthread_cond_destroy( &worker->consumed );
+        pthread_cond_destroy( &worker->ready );
+        pthread_mutex_destroy( &worker->lock );
+        gac_csv_reader_destroy( &worker->reader );
+        gac_label_table_destroy( &worker->labels );
+        free( worker->label_ids.items );
+    }
+    free( cp->workers.items );
+    cp->workers.items = NULL;
+    cp->workers.count = 0;
+    cp->current = NULL;
+
+    gac_csv_reader_destroy( &cp->reader );
+    if( cp->data != NULL )
+    {
+        munmap( ( void* )cp->data, cp->size );
+    }
+    cp->data = NULL;
+
+    if( cp->_me != NULL )
+    {
+        free( cp->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_csv_parallel_init( gac_csv_parallel_t* cp, FILE* fp,
+        gac_label_table_t* labels, uint32_t worker_count )
+{
+    uint32_t i;
+    bool res;
+    long processor_count;
+    struct stat st;
+    void* data;
+    gac_csv_parallel_worker_t* worker;
+
+    if( cp == NULL )
+    {
+        return false;
+    }
+
+    cp->_me = NULL;
+    cp->data = NULL;
+    cp->size = 0;
+    cp->chunk_size = GAC_CSV_PARALLEL_CHUNK_SIZE;
+    cp->is_started = false;
+    cp->chunk_idx = 0;
+    cp->chunk_count = 0;
+    cp->current = NULL;
+    cp->workers.items = NULL;
+    cp->workers.count = 0;
+
+    // the reader holds the configuration and the statistics, it never reads
+    if( !gac_csv_reader_init( &cp->reader, NULL, labels, 1 ) )
+    {
+        return false;
+    }
+
+    if( fp == NULL || fstat( fileno( fp ), &st ) != 0 )
+    {
+        return false;
+    }
+    if( st.st_size > 0 )
+    {
+        data = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno( fp ),
+                0 );
+        if( data == MAP_FAILED )
+        {
+            return false;
+        }
+        cp->data = data;
+        cp->size = st.st_size;
+    }
+
+    if( worker_count == 0 )
+    {
+        processor_count = sysconf( _SC_NPROCESSORS_ONLN );
+        worker_count = processor_count > 0 ? processor_count : 1;
+    }
+    cp->workers.items = malloc( sizeof( gac_csv_parallel_worker_t )
+            * worker_count );
+    if( cp->workers.items == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < worker_count; i++ )
+    {
+        worker = &cp->workers.items[i];
+        worker->parallel = cp;
+        worker->idx = i;
+        worker->is_started = false;
+        worker->label_ids.items = NULL;
+        worker->label_ids.count = 0;
+        worker->label_ids.length = 0;
+        worker->is_ready = false;
+        worker->is_last = false;
+        worker->is_error = false;
+        worker->stop = false;
+        // both are initialised such that the destroy path can release them
+        res = gac_label_table_init( &worker->labels );
+        res = gac_csv_reader_init( &worker->reader, NULL,
+                labels == NULL ? NULL : &worker->labels, 0 ) && res;
+        pthread_mutex_init( &worker->lock, NULL );
+        pthread_cond_init( &worker->ready, NULL );
+        pthread_cond_init( &worker->consumed, NULL );
+        cp->workers.count++;
+        if( !res )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_csv_parallel_read( gac_csv_parallel_t* cp,
+        gac_sample_batch_t* batch )
+{
+    uint32_t i;
+    uint32_t id;
+    uint32_t length;
+    void* items;
+    gac_csv_parallel_worker_t* worker;
+    gac_csv_reader_t* reader;
+
+    if( cp == NULL || batch == NULL )
+    {
+        return false;
+    }
+
+    batch->count = 0;
+    if( !cp->is_started && !gac_csv_parallel_start( cp ) )
+    {
+        return false;
+    }
+
+    while( true )
+    {
+        // hand the previous batch back to its worker
+        worker = cp->current;
+        if( worker != NULL )
+        {
+            pthread_mutex_lock( &worker->lock );
+            if( worker->is_last )
+            {
+                // the statistics of a chunk are complete with its last batch
+                cp->reader.stats.line_count +=
+                    worker->reader.stats.line_count;
+                cp->reader.stats.sample_count +=
+                    worker->reader.stats.sample_count;
+                cp->reader.stats.invalid_count +=
+                    worker->reader.stats.invalid_count;
+                cp->reader.stats.error_count +=
+                    worker->reader.stats.error_count;
+                memset( &worker->reader.stats, 0,
+                        sizeof( gac_csv_reader_stats_t ) );
+                cp->chunk_idx++;
+            }
+            worker->is_ready = false;
+            pthread_cond_signal( &worker->consumed );
+            pthread_mutex_unlock( &worker->lock );
+            cp->current = NULL;
+        }
+
+        if( cp->chunk_idx >= cp->chunk_count )
+        {
+            return false;
+        }
+
+        worker = &cp->workers.items[cp->chunk_idx % cp->workers.count];
+        pthread_mutex_lock( &worker->lock );
+        while( !worker->is_ready )
+        {
+            pthread_cond_wait( &worker->ready, &worker->lock );
+        }
+        pthread_mutex_unlock( &worker->lock );
+        if( worker->is_error )
+        {
+            cp->chunk_idx = cp->chunk_count;
+            return false;
+        }
+        cp->current = worker;
+        reader = &worker->reader;
+        if( reader->samples.count > 0 )
+        {
+            break;
+        }
+    }
+
+    // map the worker label IDs to the label table of the reader, the worker
+    // does not touch its label table until the batch is handed back
+    if( cp->reader.labels != NULL )
+    {
+        for( i = 0; i < reader->samples.count; i++ )
+        {
+            id = reader->samples.label_id[i];
+            while( id >= worker->label_ids.count )
+            {
+                if( worker->label_ids.count == worker->label_ids.length )
+                {
+                    length = worker->label_ids.length == 0 ? 16
+                        : worker->label_ids.length * 2;
+                    items = realloc( worker->label_ids.items,
+                            sizeof( uint32_t ) * length );
+                    if( items == NULL )
+                    {
+                        return false;
+                    }
+                    worker->label_ids.items = items;
+                    worker->label_ids.length = length;
+                }
+                if( !gac_label_table_intern( cp->reader.labels,
+                            gac_label_table_get( &worker->labels,
+                                worker->label_ids.count ),
+                            &worker->label_ids.items[
+                                worker->label_ids.count] ) )
+                {
+                    return false;
+                }
+                worker->label_ids.count++;
+            }
+            reader->samples.label_id[i] = worker->label_ids.items[id];
+        }
+    }
+
+    return gac_csv_reader_get_batch( reader, batch );
+}
+
+/******************************************************************************/
+bool gac_csv_parallel_start( gac_csv_parallel_t* cp )
+{
+    uint32_t i;
+    uint32_t j;
+    gac_csv_parallel_worker_t* worker;
+
+    if( cp == NULL || cp->is_started )
+    {
+        return false;
+    }
+
+    if( cp->chunk_size == 0 )
+    {
+        cp->chunk_size = GAC_CSV_PARALLEL_CHUNK_SIZE;
+    }
+    cp->chunk_count = ( cp->size + cp->chunk_size - 1 ) / cp->chunk_size;
+    cp->is_started = true;
+
+    for( i = 0; i < cp->workers.count; i++ )
+    {
+        worker = &cp->workers.items[i];
+        worker->reader.delimiter = cp->reader.delimiter;
+        for( j = 0; j < GAC_CSV_FIELD_COUNT; j++ )
+        {
+            if( !gac_csv_reader_set_column( &worker->reader, j,
+                        cp->reader.columns[j] ) )
+            {
+                return false;
+            }
+        }
+        if( pthread_create( &worker->thread, NULL,
+                    gac_csv_parallel_worker_run, worker ) != 0 )
+        {
+            return false;
+        }
+        worker->is_started = true;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+void* gac_csv_parallel_worker_run( void* arg )
+{
+    uint64_t idx;
+    uint64_t start;
+    uint64_t end;
+    uint64_t length;
+    bool is_last;
+    bool stop = false;
+    const char* newline;
+    void* items;
+    gac_csv_parallel_worker_t* worker = arg;
+    gac_csv_parallel_t* cp = worker->parallel;
+    gac_csv_reader_t* reader = &worker->reader;
+
+    for( idx = worker->idx; idx < cp->chunk_count && !stop;
+            idx += cp->workers.count )
+    {
+        // a chunk starts after the first line break at or after the last
+        // byte of the previous chunk and ends with the first line break at or
+        // after its own last byte, such that each line belongs to one chunk
+        start = idx * cp->chunk_size;
+        if( start > 0 )
+        {
+            newline = memchr( &cp->data[start - 1], '\n',
+                    cp->size - start + 1 );
+            start = newline == NULL ? cp->size
+                : ( uint64_t )( newline - cp->data + 1 );
+        }
+        end = ( idx + 1 ) * cp->chunk_size;
+        if( end >= cp->size )
+        {
+            end = cp->size;
+        }
+        else
+        {
+            newline = memchr( &cp->data[end - 1], '\n', cp->size - end + 1 );
+            end = newline == NULL ? cp->size
+                : ( uint64_t )( newline - cp->data + 1 );
+        }
+        length = end > start ? end - start : 0;
+
+        // the chunk is copied as the reader terminates fields in place, one
+        // byte is reserved to terminate the last field of the chunk
+        if( length + 1 > reader->buffer.length )
+        {
+            items = NULL;
+            if( length + 1 <= UINT32_MAX )
+            {
+                items = realloc( reader->buffer.items, length + 1 );
+            }
+            if( items == NULL )
+            {
+                pthread_mutex_lock( &worker->lock );
+                reader->samples.count = 0;
+                worker->is_error = true;
+                worker->is_last = true;
+                worker->is_ready = true;
+                pthread_cond_signal( &worker->ready );
+                pthread_mutex_unlock( &worker->lock );
+                break;
+            }
+            reader->buffer.items = items;
+            reader->buffer.length = length + 1;
+        }
+        if( length > 0 )
+        {
+            memcpy( reader->buffer.items, &cp->data[start], length );
+        }
+        reader->buffer.pos = 0;
+        reader->buffer.count = length;
+        reader->is_eof = true;
+        reader->skip_lines = idx == 0 ? cp->reader.skip_lines : 0;
+
+        do
+        {
+            reader->samples.count = 0;
+            gac_csv_reader_parse_buffer( reader );
+            is_last = reader->buffer.pos == reader->buffer.count;
+
+            pthread_mutex_lock( &worker->lock );
+            worker->is_last = is_last;
+            worker->is_ready = true;
+            pthread_cond_signal( &worker->ready );
+            while( worker->is_ready && !worker->stop )
+            {
+                pthread_cond_wait( &worker->consumed, &worker->lock );
+            }
+            stop = worker->stop;
+            pthread_mutex_unlock( &worker->lock );
+        } while( !is_last && !stop );
+    }
+
+    return NULL;
+}
@@ -0,0 +1,693 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_csv_reader.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+gac_csv_reader_t* gac_csv_reader_create( FILE* fp, gac_label_table_t* labels,
+        uint32_t batch_length )
+{
+    gac_csv_reader_t* reader = malloc( sizeof( gac_csv_reader_t ) );
+
+    if( reader == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_csv_reader_init( reader, fp, labels, batch_length ) )
+    {
+        gac_csv_reader_destroy( reader );
+        free( reader );
+        return NULL;
+    }
+
+    reader->_me = reader;
+
+    return reader;
+}
+
+/******************************************************************************/
+void gac_csv_reader_destroy( gac_csv_reader_t* reader )
+{
+    if( reader == NULL )
+    {
+        return;
+    }
+
+    free( reader->fields.items );
+    free( reader->buffer.items );
+    free( reader->samples.screen_x );
+    free( reader->samples.screen_y );
+    free( reader->samples.point_x );
+    free( reader->samples.point_y );
+    free( reader->samples.point_z );
+    free( reader->samples.origin_x );
+    free( reader->samples.origin_y );
+    free( reader->samples.origin_z );
+    free( reader->samples.timestamp );
+    free( reader->samples.trial_id );
+    free( reader->samples.label_id );
+    reader->fields.items = NULL;
+    reader->buffer.items = NULL;
+    reader->samples.screen_x = NULL;
+    reader->samples.screen_y = NULL;
+    reader->samples.point_x = NULL;
+    reader->samples.point_y = NULL;
+    reader->samples.point_z = NULL;
+    reader->samples.origin_x = NULL;
+    reader->samples.origin_y = NULL;
+    reader->samples.origin_z = NULL;
+    reader->samples.timestamp = NULL;
+    reader->samples.trial_id = NULL;
+    reader->samples.label_id = NULL;
+
+    if( reader->_me != NULL )
+    {
+        free( reader->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_csv_reader_get_batch( gac_csv_reader_t* reader,
+        gac_sample_batch_t* batch )
+{
+    if( reader == NULL || batch == NULL )
+    {
+        return false;
+    }
+
+    batch->count = reader->samples.count;
+    batch->origin_x = reader->samples.origin_x;
+    batch->origin_y = reader->samples.origin_y;
+    batch->origin_z = reader->samples.origin_z;
+    batch->point_x = reader->samples.point_x;
+    batch->point_y = reader->samples.point_y;
+    batch->point_z = reader->samples.point_z;
+    batch->screen_x = NULL;
+    batch->screen_y = NULL;
+    if( reader->columns[GAC_CSV_FIELD_SCREEN_X] != GAC_CSV_COLUMN_NONE
+            && reader->columns[GAC_CSV_FIELD_SCREEN_Y] != GAC_CSV_COLUMN_NONE )
+    {
+        batch->screen_x = reader->samples.screen_x;
+        batch->screen_y = reader->samples.screen_y;
+    }
+    batch->timestamp = reader->samples.timestamp;
+    batch->trial_id = NULL;
+    if( reader->columns[GAC_CSV_FIELD_TRIAL_ID] != GAC_CSV_COLUMN_NONE )
+    {
+        batch->trial_id = reader->samples.trial_id;
+    }
+    batch->label_id = NULL;
+    if( reader->columns[GAC_CSV_FIELD_LABEL] != GAC_CSV_COLUMN_NONE
+            && reader->labels != NULL )
+    {
+        batch->label_id = reader->samples.label_id;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_init( gac_csv_reader_t* reader, FILE* fp,
+        gac_label_table_t* labels, uint32_t batch_length )
+{
+    uint32_t i;
+    uint32_t length;
+
+    if( reader == NULL )
+    {
+        return false;
+    }
+
+    length = batch_length == 0 ? GAC_CSV_READER_BATCH_LENGTH : batch_length;
+    reader->_me = NULL;
+    reader->fp = fp;
+    reader->labels = labels;
+    reader->delimiter = ',';
+    reader->skip_lines = 1;
+    reader->fields.items = NULL;
+    reader->fields.count = 0;
+    reader->buffer.pos = 0;
+    reader->buffer.count = 0;
+    reader->buffer.length = GAC_CSV_READER_BUFFER_LENGTH;
+    reader->buffer.items = malloc( reader->buffer.length );
+    reader->is_eof = fp == NULL;
+    reader->is_error = false;
+    reader->samples.count = 0;
+    reader->samples.length = length;
+    reader->samples.screen_x = malloc( sizeof( float ) * length );
+    reader->samples.screen_y = malloc( sizeof( float ) * length );
+    reader->samples.point_x = malloc( sizeof( float ) * length );
+    reader->samples.point_y = malloc( sizeof( float ) * length );
+    reader->samples.point_z = malloc( sizeof( float ) * length );
+    reader->samples.origin_x = malloc( sizeof( float ) * length );
+    reader->samples.origin_y = malloc( sizeof( float ) * length );
+    reader->samples.origin_z = malloc( sizeof( float ) * length );
+    reader->samples.timestamp = malloc( sizeof( double ) * length );
+    reader->samples.trial_id = malloc( sizeof( uint32_t ) * length );
+    reader->samples.label_id = malloc( sizeof( uint32_t ) * length );
+    reader->stats.line_count = 0;
+    reader->stats.sample_count = 0;
+    reader->stats.invalid_count = 0;
+    reader->stats.error_count = 0;
+    for( i = 0; i < GAC_CSV_FIELD_COUNT; i++ )
+    {
+        reader->columns[i] = GAC_CSV_COLUMN_NONE;
+    }
+
+    if( reader->buffer.items == NULL || reader->samples.screen_x == NULL
+            || reader->samples.screen_y == NULL
+            || reader->samples.point_x == NULL
+            || reader->samples.point_y == NULL
+            || reader->samples.point_z == NULL
+            || reader->samples.origin_x == NULL
+            || reader->samples.origin_y == NULL
+            || reader->samples.origin_z == NULL
+            || reader->samples.timestamp == NULL
+            || reader->samples.trial_id == NULL
+            || reader->samples.label_id == NULL )
+    {
+        return false;
+    }
+
+    // the column layout of the tracker export
+    for( i = 0; i < GAC_CSV_FIELD_COUNT; i++ )
+    {
+        if( !gac_csv_reader_set_column( reader, i, i ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_parse_bool( const char* str, const char* end )
+{
+    while( str < end && ( *str == ' ' || *str == '\t' ) )
+    {
+        str++;
+    }
+    while( end > str && ( end[-1] == ' ' || end[-1] == '\t' ) )
+    {
+        end--;
+    }
+
+    if( end - str == 1 )
+    {
+        return str[0] == '1';
+    }
+    if( end - str == 4 )
+    {
+        return strncmp( str, "True", 4 ) == 0
+            || strncmp( str, "true", 4 ) == 0
+            || strncmp( str, "TRUE", 4 ) == 0;
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_parse_buffer( gac_csv_reader_t* reader )
+{
+    char* line;
+    char* newline;
+
+    if( reader == NULL )
+    {
+        return false;
+    }
+
+    while( reader->samples.count < reader->samples.length )
+    {
+        line = &reader->buffer.items[reader->buffer.pos];
+        newline = memchr( line, '\n',
+                reader->buffer.count - reader->buffer.pos );
+        if( newline != NULL )
+        {
+            gac_csv_reader_parse_line( reader, line, newline );
+            reader->buffer.pos = newline - reader->buffer.items + 1;
+            continue;
+        }
+
+        if( reader->is_eof )
+        {
+            // the last line of the file has no line break
+            if( reader->buffer.pos < reader->buffer.count )
+            {
+                gac_csv_reader_parse_line( reader, line,
+                        &reader->buffer.items[reader->buffer.count] );
+                reader->buffer.pos = reader->buffer.count;
+            }
+            return false;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_parse_double( const char* str, const char* end,
+        double* value )
+{
+    const double pow10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+        1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    uint64_t mantissa = 0;
+    uint32_t digits = 0;
+    int32_t exponent = 0;
+    int32_t exp_value = 0;
+    bool is_negative = false;
+    bool is_exp_negative = false;
+    bool has_digits = false;
+    double result;
+
+    if( str == NULL || end == NULL || value == NULL )
+    {
+        return false;
+    }
+
+    while( str < end && ( *str == ' ' || *str == '\t' ) )
+    {
+        str++;
+    }
+    while( end > str && ( end[-1] == ' ' || end[-1] == '\t' ) )
+    {
+        end--;
+    }
+    if( str < end && ( *str == '-' || *str == '+' ) )
+    {
+        is_negative = *str == '-';
+        str++;
+    }
+    if( str == end )
+    {
+        return false;
+    }
+
+    // special values are matched case-insensitively
+    if( end - str == 3 && ( str[0] | 0x20 ) == 'n'
+            && ( str[1] | 0x20 ) == 'a' && ( str[2] | 0x20 ) == 'n' )
+    {
+        *value = is_negative ? -NAN : NAN;
+        return true;
+    }
+    if( ( end - str == 3 || end - str == 8 ) && ( str[0] | 0x20 ) == 'i'
+            && ( str[1] | 0x20 ) == 'n' && ( str[2] | 0x20 ) == 'f'
+            && ( end - str == 3 || strncmp( str + 3, "inity", 5 ) == 0 ) )
+    {
+        *value = is_negative ? -INFINITY : INFINITY;
+        return true;
+    }
+
+    // leading zeros are skipped, digits beyond the precision of the mantissa
+    // only shift the exponent
+    while( str < end && *str >= '0' && *str <= '9' )
+    {
+        has_digits = true;
+        if( mantissa == 0 && *str == '0' )
+        {
+            // nothing to do
+        }
+        else if( digits < 19 )
+        {
+            mantissa = mantissa * 10 + ( *str - '0' );
+            digits++;
+        }
+        else
+        {
+            exponent++;
+        }
+        str++;
+    }
+    if( str < end && *str == '.' )
+    {
+        str++;
+        while( str < end && *str >= '0' && *str <= '9' )
+        {
+            has_digits = true;
+            if( mantissa == 0 && *str == '0' )
+            {
+                exponent--;
+            }
+            else if( digits < 19 )
+            {
+                mantissa = mantissa * 10 + ( *str - '0' );
+                digits++;
+                exponent--;
+            }
+            str++;
+        }
+    }
+    if( !has_digits )
+    {
+        return false;
+    }
+    if( str < end && ( *str == 'e' || *str == 'E' ) )
+    {
+        str++;
+        if( str < end && ( *str == '-' || *str == '+' ) )
+        {
+            is_exp_negative = *str == '-';
+            str++;
+        }
+        if( str == end )
+        {
+            return false;
+        }
+        while( str < end && *str >= '0' && *str <= '9' )
+        {
+            if( exp_value < 100000 )
+            {
+                exp_value = exp_value * 10 + ( *str - '0' );
+            }
+            str++;
+        }
+        exponent += is_exp_negative ? -exp_value : exp_value;
+    }
+    if( str != end )
+    {
+        return false;
+    }
+
+    result = ( double )mantissa;
+    if( mantissa == 0 )
+    {
+        // nothing to do
+    }
+    else if( mantissa <= ( ( uint64_t )1 << 53 ) && exponent >= -22
+            && exponent <= 22 )
+    {
+        // both operands are exact, hence, the result is correctly rounded
+        result = exponent < 0 ? result / pow10[-exponent]
+            : result * pow10[exponent];
+    }
+    else if( exponent < 0 )
+    {
+        result /= pow( 10, -exponent );
+    }
+    else
+    {
+        result *= pow( 10, exponent );
+    }
+    *value = is_negative ? -result : result;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_parse_line( gac_csv_reader_t* reader, char* line,
+        char* end )
+{
+    uint32_t column;
+    uint32_t idx;
+    uint8_t field;
+    char* p;
+    char* w;
+    char* field_start;
+    char* field_end;
+    char* label = NULL;
+    char* delimiter;
+    double values[GAC_CSV_FIELD_TRIAL_ID] = { 0 };
+    uint32_t trial_id = 0;
+    uint32_t label_id = GAC_LABEL_ID_NONE;
+    bool is_valid = true;
+    bool is_error = false;
+
+    if( reader == NULL || line == NULL || end == NULL
+            || reader->samples.count == reader->samples.length )
+    {
+        return false;
+    }
+
+    reader->stats.line_count++;
+    if( reader->skip_lines > 0 )
+    {
+        reader->skip_lines--;
+        return false;
+    }
+    if( end > line && end[-1] == '\r' )
+    {
+        end--;
+    }
+    if( line == end )
+    {
+        return false;
+    }
+
+    p = line;
+    for( column = 0; column < reader->fields.count; column++ )
+    {
+        if( p > end )
+        {
+            // the line has too few columns
+            is_error = true;
+            break;
+        }
+
+        field_start = p;
+        if( p < end && *p == '"' )
+        {
+            // unescape the quoted field in place, "" is a literal quote
+            w = p;
+            p++;
+            while( p < end )
+            {
+                if( *p == '"' )
+                {
+                    p++;
+                    if( p == end || *p != '"' )
+                    {
+                        break;
+                    }
+                }
+                *w = *p;
+                w++;
+                p++;
+            }
+            field_end = w;
+            delimiter = memchr( p, reader->delimiter, end - p );
+            p = delimiter == NULL ? end : delimiter;
+        }
+        else
+        {
+            delimiter = memchr( p, reader->delimiter, end - p );
+            field_end = delimiter == NULL ? end : delimiter;
+            p = field_end;
+        }
+
+        field = reader->fields.items[column];
+        if( field < GAC_CSV_FIELD_TRIAL_ID )
+        {
+            is_error |= !gac_csv_reader_parse_double( field_start, field_end,
+                    &values[field] );
+        }
+        else if( field == GAC_CSV_FIELD_TRIAL_ID )
+        {
+            is_error |= !gac_csv_reader_parse_uint( field_start, field_end,
+                    &trial_id );
+        }
+        else if( field == GAC_CSV_FIELD_LABEL )
+        {
+            // terminate the label in place, it is interned once the line
+            // is known to be valid
+            *field_end = '\0';
+            label = field_start;
+        }
+        else if( field < GAC_CSV_FIELD_COUNT )
+        {
+            is_valid &= gac_csv_reader_parse_bool( field_start, field_end );
+        }
+
+        // skip the delimiter
+        p++;
+    }
+
+    if( is_error )
+    {
+        reader->stats.error_count++;
+        return false;
+    }
+    if( !is_valid )
+    {
+        reader->stats.invalid_count++;
+        return false;
+    }
+    if( label != NULL && reader->labels != NULL
+            && !gac_label_table_intern( reader->labels, label, &label_id ) )
+    {
+        reader->stats.error_count++;
+        return false;
+    }
+
+    idx = reader->samples.count;
+    reader->samples.screen_x[idx] = values[GAC_CSV_FIELD_SCREEN_X];
+    reader->samples.screen_y[idx] = values[GAC_CSV_FIELD_SCREEN_Y];
+    reader->samples.point_x[idx] = values[GAC_CSV_FIELD_POINT_X];
+    reader->samples.point_y[idx] = values[GAC_CSV_FIELD_POINT_Y];
+    reader->samples.point_z[idx] = values[GAC_CSV_FIELD_POINT_Z];
+    reader->samples.origin_x[idx] = values[GAC_CSV_FIELD_ORIGIN_X];
+    reader->samples.origin_y[idx] = values[GAC_CSV_FIELD_ORIGIN_Y];
+    reader->samples.origin_z[idx] = values[GAC_CSV_FIELD_ORIGIN_Z];
+    reader->samples.timestamp[idx] = values[GAC_CSV_FIELD_TIMESTAMP];
+    reader->samples.trial_id[idx] = trial_id;
+    reader->samples.label_id[idx] = label_id;
+    reader->samples.count++;
+    reader->stats.sample_count++;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_parse_uint( const char* str, const char* end,
+        uint32_t* value )
+{
+    uint64_t result = 0;
+
+    if( str == NULL || end == NULL || value == NULL )
+    {
+        return false;
+    }
+
+    while( str < end && ( *str == ' ' || *str == '\t' ) )
+    {
+        str++;
+    }
+    while( end > str && ( end[-1] == ' ' || end[-1] == '\t' ) )
+    {
+        end--;
+    }
+    if( str < end && *str == '+' )
+    {
+        str++;
+    }
+    if( str == end )
+    {
+        return false;
+    }
+
+    while( str < end )
+    {
+        if( *str < '0' || *str > '9' )
+        {
+            return false;
+        }
+        result = result * 10 + ( *str - '0' );
+        if( result > UINT32_MAX )
+        {
+            return false;
+        }
+        str++;
+    }
+    *value = result;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_read( gac_csv_reader_t* reader,
+        gac_sample_batch_t* batch )
+{
+    size_t count;
+    uint32_t length;
+    void* items;
+
+    if( reader == NULL || batch == NULL )
+    {
+        return false;
+    }
+
+    reader->samples.count = 0;
+    while( gac_csv_reader_parse_buffer( reader ) )
+    {
+        // move the incomplete line to the front and refill the buffer, one
+        // byte is reserved to terminate the last field of the file
+        reader->buffer.count -= reader->buffer.pos;
+        memmove( reader->buffer.items,
+                &reader->buffer.items[reader->buffer.pos],
+                reader->buffer.count );
+        reader->buffer.pos = 0;
+        if( reader->buffer.count + 1 >= reader->buffer.length )
+        {
+            length = reader->buffer.length * 2;
+            items = realloc( reader->buffer.items, length );
+            if( items == NULL )
+            {
+                reader->is_error = true;
+                return false;
+            }
+            reader->buffer.items = items;
+            reader->buffer.length = length;
+        }
+        count = fread( &reader->buffer.items[reader->buffer.count], 1,
+                reader->buffer.length - reader->buffer.count - 1,
+                reader->fp );
+        if( count == 0 )
+        {
+            reader->is_eof = true;
+            reader->is_error = ferror( reader->fp ) != 0;
+        }
+        reader->buffer.count += count;
+    }
+
+    gac_csv_reader_get_batch( reader, batch );
+
+    return batch->count > 0;
+}
+
+/******************************************************************************/
+bool gac_csv_reader_set_column( gac_csv_reader_t* reader,
+        gac_csv_field_t field, uint32_t column )
+{
+    uint32_t i;
+    uint32_t count;
+    uint8_t* items;
+
+    if( reader == NULL || field >= GAC_CSV_FIELD_COUNT
+            || ( column != GAC_CSV_COLUMN_NONE && column >= UINT16_MAX ) )
+    {
+        return false;
+    }
+
+    reader->columns[field] = column;
+
+    // rebuild the column lookup up to the last used column
+    count = 0;
+    for( i = 0; i < GAC_CSV_FIELD_COUNT; i++ )
+    {
+        if( reader->columns[i] != GAC_CSV_COLUMN_NONE
+                && reader->columns[i] + 1 > count )
+        {
+            count = reader->columns[i] + 1;
+        }
+    }
+    items = realloc( reader->fields.items, count == 0 ? 1 : count );
+    if( items == NULL )
+    {
+        return false;
+    }
+    reader->fields.items = items;
+    reader->fields.count = count;
+    memset( reader->fields.items, GAC_CSV_FIELD_COUNT, count );
+    for( i = 0; i < GAC_CSV_FIELD_COUNT; i++ )
+    {
+        if( reader->columns[i] != GAC_CSV_COLUMN_NONE )
+        {
+            reader->fields.items[reader->columns[i]] = i;
+        }
+    }
+
+    return true;
+}
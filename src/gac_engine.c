@@ -0,0 +1,619 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_engine.h"
+#include <stdlib.h>
+#include <time.h>
+
+/******************************************************************************/
+bool gac_engine_buffer_add( gac_engine_buffer_t* buffer, vec2* screen_point,
+        vec3* origin, vec3* point, double timestamp, uint32_t trial_id,
+        uint32_t label_id )
+{
+    uint32_t length;
+    void* items;
+
+    if( buffer == NULL )
+    {
+        return false;
+    }
+
+    if( buffer->count == buffer->length )
+    {
+        length = buffer->length == 0 ? 64 : buffer->length * 2;
+#define GAC_ENGINE_BUFFER_GROW( field ) \
+        items = realloc( buffer->field, sizeof( *buffer->field ) * length ); \
+        if( items == NULL ) \
+        { \
+            return false; \
+        } \
+        buffer->field = items;
+        GAC_ENGINE_BUFFER_GROW( origin_x );
+        GAC_ENGINE_BUFFER_GROW( origin_y );
+        GAC_ENGINE_BUFFER_GROW( origin_z );
+        GAC_ENGINE_BUFFER_GROW( point_x );
+        GAC_ENGINE_BUFFER_GROW( point_y );
+        GAC_ENGINE_BUFFER_GROW( point_z );
+        GAC_ENGINE_BUFFER_GROW( screen_x );
+        GAC_ENGINE_BUFFER_GROW( screen_y );
+        GAC_ENGINE_BUFFER_GROW( timestamp );
+        GAC_ENGINE_BUFFER_GROW( trial_id );
+        GAC_ENGINE_BUFFER_GROW( label_id );
+#undef GAC_ENGINE_BUFFER_GROW
+        buffer->length = length;
+    }
+
+    buffer->origin_x[buffer->count] = ( *origin )[0];
+    buffer->origin_y[buffer->count] = ( *origin )[1];
+    buffer->origin_z[buffer->count] = ( *origin )[2];
+    buffer->point_x[buffer->count] = ( *point )[0];
+    buffer->point_y[buffer->count] = ( *point )[1];
+    buffer->point_z[buffer->count] = ( *point )[2];
+    buffer->screen_x[buffer->count] = ( *screen_point )[0];
+    buffer->screen_y[buffer->count] = ( *screen_point )[1];
+    buffer->timestamp[buffer->count] = timestamp;
+    buffer->trial_id[buffer->count] = trial_id;
+    buffer->label_id[buffer->count] = label_id;
+    buffer->count++;
+
+    return true;
+}
+
+/******************************************************************************/
+void gac_engine_buffer_destroy( gac_engine_buffer_t* buffer )
+{
+    if( buffer == NULL )
+    {
+        return;
+    }
+
+    free( buffer->origin_x );
+    free( buffer->origin_y );
+    free( buffer->origin_z );
+    free( buffer->point_x );
+    free( buffer->point_y );
+    free( buffer->point_z );
+    free( buffer->screen_x );
+    free( buffer->screen_y );
+    free( buffer->timestamp );
+    free( buffer->trial_id );
+    free( buffer->label_id );
+    gac_engine_buffer_init( buffer );
+}
+
+/******************************************************************************/
+bool gac_engine_buffer_init( gac_engine_buffer_t* buffer )
+{
+    if( buffer == NULL )
+    {
+        return false;
+    }
+
+    buffer->origin_x = NULL;
+    buffer->origin_y = NULL;
+    buffer->origin_z = NULL;
+    buffer->point_x = NULL;
+    buffer->point_y = NULL;
+    buffer->point_z = NULL;
+    buffer->screen_x = NULL;
+    buffer->screen_y = NULL;
+    buffer->timestamp = NULL;
+    buffer->trial_id = NULL;
+    buffer->label_id = NULL;
+    buffer->count = 0;
+    buffer->length = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_engine_t* gac_engine_create( uint32_t stream_count, uint32_t worker_count,
+        gac_filter_parameter_t* parameter )
+{
+    gac_engine_t* engine = malloc( sizeof( gac_engine_t ) );
+
+    if( engine == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_engine_init( engine, stream_count, worker_count, parameter ) )
+    {
+        gac_engine_destroy( engine );
+        free( engine );
+        return NULL;
+    }
+
+    engine->_me = engine;
+
+    return engine;
+}
+
+/******************************************************************************/
+void gac_engine_destroy( gac_engine_t* engine )
+{
+    uint32_t i;
+    void* data;
+    gac_engine_worker_t* worker;
+    gac_engine_stream_t* stream;
+
+    if( engine == NULL )
+    {
+        return;
+    }
+
+    for( i = 0; i < engine->workers.count; i++ )
+    {
+        worker = &engine->workers.items[i];
+        if( worker->is_started )
+        {
+            pthread_mutex_lock( &worker->lock );
+            worker->stop = true;
+            pthread_cond_signal( &worker->work );
+            pthread_mutex_unlock( &worker->lock );
+            pthread_join( worker->thread, NULL );
+            worker->is_started = false;
+        }
+        pthread_cond_destroy( &worker->idle );
+        pthread_cond_destroy( &worker->work );
+        pthread_mutex_destroy( &worker->lock );
+    }
+    free( engine->workers.items );
+    engine->workers.items = NULL;
+    engine->workers.count = 0;
+
+    for( i = 0; i < engine->streams.count; i++ )
+    {
+        stream = &engine->streams.items[i];
+        gac_engine_buffer_destroy( &stream->pending );
+        gac_engine_buffer_destroy( &stream->processing );
+        while( gac_queue_pop( &stream->fixations, &data ) )
+        {
+            gac_fixation_destroy( data );
+        }
+        while( gac_queue_pop( &stream->saccades, &data ) )
+        {
+            gac_saccade_destroy( data );
+        }
+        gac_queue_destroy( &stream->fixations );
+        gac_queue_destroy( &stream->saccades );
+        gac_destroy( &stream->h );
+    }
+    free( engine->streams.items );
+    engine->streams.items = NULL;
+    engine->streams.count = 0;
+
+    if( engine->_me != NULL )
+    {
+        free( engine->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_engine_flush( gac_engine_t* engine )
+{
+    uint32_t i;
+    gac_engine_worker_t* worker;
+
+    if( engine == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < engine->workers.count; i++ )
+    {
+        worker = &engine->workers.items[i];
+        pthread_mutex_lock( &worker->lock );
+        while( worker->pending_count > 0 || worker->is_busy )
+        {
+            pthread_cond_wait( &worker->idle, &worker->lock );
+        }
+        pthread_mutex_unlock( &worker->lock );
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_engine_get_fixation( gac_engine_t* engine, uint32_t stream_id,
+        gac_fixation_t* fixation )
+{
+    bool res;
+    void* data = NULL;
+    gac_engine_stream_t* stream;
+
+    if( engine == NULL || fixation == NULL
+            || stream_id >= engine->streams.count )
+    {
+        return false;
+    }
+
+    stream = &engine->streams.items[stream_id];
+    pthread_mutex_lock( &stream->worker->lock );
+    res = gac_queue_pop( &stream->fixations, &data );
+    pthread_mutex_unlock( &stream->worker->lock );
+
+    if( !res )
+    {
+        return false;
+    }
+
+    res = gac_fixation_copy_to( fixation, data );
+    gac_fixation_destroy( data );
+
+    return res;
+}
+
+/******************************************************************************/
+gac_t* gac_engine_get_handler( gac_engine_t* engine, uint32_t stream_id )
+{
+    if( engine == NULL || stream_id >= engine->streams.count )
+    {
+        return NULL;
+    }
+
+    return &engine->streams.items[stream_id].h;
+}
+
+/******************************************************************************/
+const char* gac_engine_get_label( gac_engine_t* engine, uint32_t stream_id,
+        uint32_t label_id )
+{
+    const char* label;
+    gac_engine_stream_t* stream;
+
+    if( engine == NULL || stream_id >= engine->streams.count )
+    {
+        return NULL;
+    }
+
+    stream = &engine->streams.items[stream_id];
+    pthread_mutex_lock( &stream->worker->lock );
+    label = gac_get_label( &stream->h, label_id );
+    pthread_mutex_unlock( &stream->worker->lock );
+
+    return label;
+}
+
+/******************************************************************************/
+bool gac_engine_get_saccade( gac_engine_t* engine, uint32_t stream_id,
+        gac_saccade_t* saccade )
+{
+    bool res;
+    void* data = NULL;
+    gac_engine_stream_t* stream;
+
+    if( engine == NULL || saccade == NULL
+            || stream_id >= engine->streams.count )
+    {
+        return false;
+    }
+
+    stream = &engine->streams.items[stream_id];
+    pthread_mutex_lock( &stream->worker->lock );
+    res = gac_queue_pop( &stream->saccades, &data );
+    pthread_mutex_unlock( &stream->worker->lock );
+
+    if( !res )
+    {
+        return false;
+    }
+
+    res = gac_saccade_copy_to( saccade, data );
+    gac_saccade_destroy( data );
+
+    return res;
+}
+
+/******************************************************************************/
+bool gac_engine_get_stream_stats( gac_engine_t* engine, uint32_t stream_id,
+        gac_engine_stream_stats_t* stats )
+{
+    gac_engine_stream_t* stream;
+
+    if( engine == NULL || stats == NULL
+            || stream_id >= engine->streams.count )
+    {
+        return false;
+    }
+
+    stream = &engine->streams.items[stream_id];
+    pthread_mutex_lock( &stream->worker->lock );
+    *stats = stream->stats;
+    pthread_mutex_unlock( &stream->worker->lock );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_engine_init( gac_engine_t* engine, uint32_t stream_count,
+        uint32_t worker_count, gac_filter_parameter_t* parameter )
+{
+    uint32_t i;
+    gac_engine_worker_t* worker;
+    gac_engine_stream_t* stream;
+
+    if( engine == NULL )
+    {
+        return false;
+    }
+
+    engine->_me = NULL;
+    engine->streams.items = NULL;
+    engine->streams.count = 0;
+    engine->workers.items = NULL;
+    engine->workers.count = 0;
+
+    if( stream_count == 0 )
+    {
+        return false;
+    }
+
+    if( worker_count == 0 || worker_count > stream_count )
+    {
+        worker_count = stream_count;
+    }
+
+    engine->workers.items = malloc( sizeof( gac_engine_worker_t )
+            * worker_count );
+    engine->streams.items = malloc( sizeof( gac_engine_stream_t )
+            * stream_count );
+    if( engine->workers.items == NULL || engine->streams.items == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < worker_count; i++ )
+    {
+        worker = &engine->workers.items[i];
+        worker->engine = engine;
+        worker->idx = i;
+        worker->is_started = false;
+        worker->pending_count = 0;
+        worker->is_busy = false;
+        worker->stop = false;
+        pthread_mutex_init( &worker->lock, NULL );
+        pthread_cond_init( &worker->work, NULL );
+        pthread_cond_init( &worker->idle, NULL );
+        engine->workers.count++;
+    }
+
+    for( i = 0; i < stream_count; i++ )
+    {
+        stream = &engine->streams.items[i];
+        if( !gac_init( &stream->h, parameter ) )
+        {
+            return false;
+        }
+        // stream affinity: all samples of a stream are processed by the same
+        // worker to preserve the sample order
+        stream->worker = &engine->workers.items[i % worker_count];
+        gac_engine_buffer_init( &stream->pending );
+        gac_engine_buffer_init( &stream->processing );
+        gac_queue_init( &stream->fixations, 0 );
+        gac_queue_init( &stream->saccades, 0 );
+        stream->stats.pushed_count = 0;
+        stream->stats.processed_count = 0;
+        stream->stats.fixation_count = 0;
+        stream->stats.saccade_count = 0;
+        stream->stats.busy_time = 0;
+        stream->stats.throughput = 0;
+        engine->streams.count++;
+    }
+
+    for( i = 0; i < worker_count; i++ )
+    {
+        worker = &engine->workers.items[i];
+        if( pthread_create( &worker->thread, NULL, gac_engine_worker_run,
+                    worker ) != 0 )
+        {
+            return false;
+        }
+        worker->is_started = true;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_engine_push( gac_engine_t* engine, uint32_t stream_id,
+        vec2* screen_point, vec3* origin, vec3* point, double timestamp,
+        uint32_t trial_id, const char* label )
+{
+    bool res = true;
+    uint32_t label_id = GAC_LABEL_ID_NONE;
+    vec2 screen_point_default;
+    gac_engine_stream_t* stream;
+    gac_engine_worker_t* worker;
+
+    if( engine == NULL || origin == NULL || point == NULL
+            || stream_id >= engine->streams.count )
+    {
+        return false;
+    }
+
+    stream = &engine->streams.items[stream_id];
+    worker = stream->worker;
+
+    if( screen_point == NULL )
+    {
+        screen_point = &screen_point_default;
+        if( stream->h.screen != NULL )
+        {
+            gac_screen_point( stream->h.screen, point, screen_point );
+        }
+        else
+        {
+            glm_vec2_zero( *screen_point );
+        }
+    }
+
+    pthread_mutex_lock( &worker->lock );
+    if( label != NULL )
+    {
+        res = gac_get_label_id( &stream->h, label, &label_id );
+    }
+    if( res )
+    {
+        res = gac_engine_buffer_add( &stream->pending, screen_point, origin,
+                point, timestamp, trial_id, label_id );
+    }
+    if( res )
+    {
+        stream->stats.pushed_count++;
+        if( stream->pending.count == 1 )
+        {
+            worker->pending_count++;
+            pthread_cond_signal( &worker->work );
+        }
+    }
+    pthread_mutex_unlock( &worker->lock );
+
+    return res;
+}
+
+/******************************************************************************/
+bool gac_engine_stream_process( gac_engine_stream_t* stream )
+{
+    uint32_t i;
+    uint32_t offset = 0;
+    uint32_t count;
+    uint32_t fixation_count;
+    uint32_t saccade_count;
+    double busy_time;
+    struct timespec start;
+    struct timespec end;
+    gac_engine_buffer_t* buffer;
+    gac_sample_batch_t batch;
+    gac_fixation_t fixations[GAC_ENGINE_EVENT_BATCH_SIZE];
+    gac_saccade_t saccades[GAC_ENGINE_EVENT_BATCH_SIZE];
+    gac_fixation_t* fixation;
+    gac_saccade_t* saccade;
+
+    if( stream == NULL || stream->processing.count == 0 )
+    {
+        return false;
+    }
+
+    buffer = &stream->processing;
+    clock_gettime( CLOCK_MONOTONIC, &start );
+
+    while( offset < buffer->count )
+    {
+        gac_sample_batch_init( &batch, buffer->count - offset );
+        batch.origin_x = &buffer->origin_x[offset];
+        batch.origin_y = &buffer->origin_y[offset];
+        batch.origin_z = &buffer->origin_z[offset];
+        batch.point_x = &buffer->point_x[offset];
+        batch.point_y = &buffer->point_y[offset];
+        batch.point_z = &buffer->point_z[offset];
+        batch.screen_x = &buffer->screen_x[offset];
+        batch.screen_y = &buffer->screen_y[offset];
+        batch.timestamp = &buffer->timestamp[offset];
+        batch.trial_id = &buffer->trial_id[offset];
+        batch.label_id = &buffer->label_id[offset];
+
+        count = gac_sample_window_update_batch( &stream->h, &batch,
+                fixations, GAC_ENGINE_EVENT_BATCH_SIZE, &fixation_count,
+                saccades, GAC_ENGINE_EVENT_BATCH_SIZE, &saccade_count );
+        offset += count;
+
+        pthread_mutex_lock( &stream->worker->lock );
+        for( i = 0; i < fixation_count; i++ )
+        {
+            fixation = gac_fixation_copy( &fixations[i] );
+            if( fixation != NULL
+                    && !gac_queue_push( &stream->fixations, fixation ) )
+            {
+                gac_fixation_destroy( fixation );
+            }
+            gac_fixation_destroy( &fixations[i] );
+        }
+        for( i = 0; i < saccade_count; i++ )
+        {
+            saccade = gac_saccade_copy( &saccades[i] );
+            if( saccade != NULL
+                    && !gac_queue_push( &stream->saccades, saccade ) )
+            {
+                gac_saccade_destroy( saccade );
+            }
+            gac_saccade_destroy( &saccades[i] );
+        }
+        stream->stats.processed_count += count;
+        stream->stats.fixation_count += fixation_count;
+        stream->stats.saccade_count += saccade_count;
+        pthread_mutex_unlock( &stream->worker->lock );
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    busy_time = ( end.tv_sec - start.tv_sec ) * 1000.0
+        + ( end.tv_nsec - start.tv_nsec ) / 1000000.0;
+
+    pthread_mutex_lock( &stream->worker->lock );
+    stream->stats.busy_time += busy_time;
+    if( stream->stats.busy_time > 0 )
+    {
+        stream->stats.throughput = stream->stats.processed_count
+            / ( stream->stats.busy_time / 1000.0 );
+    }
+    pthread_mutex_unlock( &stream->worker->lock );
+
+    buffer->count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+void* gac_engine_worker_run( void* data )
+{
+    uint32_t i;
+    gac_engine_buffer_t buffer;
+    gac_engine_stream_t* stream;
+    gac_engine_worker_t* worker = data;
+    gac_engine_t* engine = worker->engine;
+
+    pthread_mutex_lock( &worker->lock );
+    while( true )
+    {
+        while( !worker->stop && worker->pending_count == 0 )
+        {
+            pthread_cond_wait( &worker->work, &worker->lock );
+        }
+        if( worker->stop )
+        {
+            break;
+        }
+
+        // take the pending samples of all streams of the worker such that
+        // new samples can be pushed while the worker is busy
+        for( i = worker->idx; i < engine->streams.count;
+                i += engine->workers.count )
+        {
+            stream = &engine->streams.items[i];
+            buffer = stream->processing;
+            stream->processing = stream->pending;
+            stream->pending = buffer;
+        }
+        worker->pending_count = 0;
+        worker->is_busy = true;
+        pthread_mutex_unlock( &worker->lock );
+
+        for( i = worker->idx; i < engine->streams.count;
+                i += engine->workers.count )
+        {
+            gac_engine_stream_process( &engine->streams.items[i] );
+        }
+
+        pthread_mutex_lock( &worker->lock );
+        worker->is_busy = false;
+        pthread_cond_broadcast( &worker->idle );
+    }
+    pthread_mutex_unlock( &worker->lock );
+
+    return NULL;
+}
@@ -0,0 +1,872 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_event_writer.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+bool gac_event_writer_append( gac_event_writer_t* writer, const char* str,
+        uint32_t length )
+{
+    if( !gac_event_writer_reserve( writer, length ) )
+    {
+        return false;
+    }
+
+    memcpy( &writer->buffer.items[writer->buffer.count], str, length );
+    writer->buffer.count += length;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_event_writer_begin( gac_event_writer_t* writer, const char* type )
+{
+    if( writer == NULL )
+    {
+        return false;
+    }
+
+    writer->field_count = 0;
+    if( writer->format == GAC_EVENT_WRITER_FORMAT_NDJSON )
+    {
+        if( !gac_event_writer_append( writer, "{", 1 )
+                || !gac_event_writer_field_string( writer, "type", type ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+gac_event_writer_t* gac_event_writer_create( FILE* fp,
+        gac_event_writer_format_t format, gac_label_table_t* labels,
+        bool is_async )
+{
+    gac_event_writer_t* writer = malloc( sizeof( gac_event_writer_t ) );
+
+    if( writer == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_event_writer_init( writer, fp, format, labels, is_async ) )
+    {
+        gac_event_writer_destroy( writer );
+        free( writer );
+        return NULL;
+    }
+
+    writer->_me = writer;
+
+    return writer;
+}
+
+/******************************************************************************/
+void gac_event_writer_destroy( gac_event_writer_t* writer )
+{
+    if( writer == NULL )
+    {
+        return;
+    }
+
+    if( writer->buffer.items != NULL )
+    {
+        gac_event_writer_flush( writer );
+    }
+
+    if( writer->is_async )
+    {
+        pthread_mutex_lock( &writer->lock );
+        writer->stop = true;
+        pthread_cond_signal( &writer->work );
+        pthread_mutex_unlock( &writer->lock );
+        pthread_join( writer->thread, NULL );
+        writer->is_async = false;
+    }
+    pthread_cond_destroy( &writer->idle );
+    pthread_cond_destroy( &writer->work );
+    pthread_mutex_destroy( &writer->lock );
+
+    free( writer->buffer.items );
+    writer->buffer.items = NULL;
+    free( writer->pending.items );
+    writer->pending.items = NULL;
+
+    if( writer->_me != NULL )
+    {
+        free( writer->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_event_writer_end( gac_event_writer_t* writer )
+{
+    if( writer == NULL )
+    {
+        return false;
+    }
+
+    if( writer->format == GAC_EVENT_WRITER_FORMAT_NDJSON )
+    {
+        return gac_event_writer_append( writer, "}\n", 2 );
+    }
+
+    return gac_event_writer_append( writer, "\n", 1 );
+}
+
+/******************************************************************************/
+bool gac_event_writer_field_name( gac_event_writer_t* writer,
+        const char* name )
+{
+    uint32_t length;
+
+    if( writer == NULL )
+    {
+        return false;
+    }
+
+    if( writer->field_count > 0 && !gac_event_writer_append( writer, ",", 1 ) )
+    {
+        return false;
+    }
+    writer->field_count++;
+
+    if( writer->format == GAC_EVENT_WRITER_FORMAT_NDJSON )
+    {
+        // field names are identifiers of the library and need no escaping
+        length = strlen( name );
+        if( !gac_event_writer_reserve( writer, length + 3 ) )
+        {
+            return false;
+        }
+        writer->buffer.items[writer->buffer.count++] = '"';
+        memcpy( &writer->buffer.items[writer->buffer.count], name, length );
+        writer->buffer.count += length;
+        writer->buffer.items[writer->buffer.count++] = '"';
+        writer->buffer.items[writer->buffer.count++] = ':';
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_event_writer_field_number( gac_event_writer_t* writer,
+        const char* name, double value, bool is_float )
+{
+    if( !gac_event_writer_field_name( writer, name ) )
+    {
+        return false;
+    }
+
+    if( writer->format == GAC_EVENT_WRITER_FORMAT_NDJSON && !isfinite( value ) )
+    {
+        return gac_event_writer_append( writer, "null", 4 );
+    }
+
+    if( !gac_event_writer_reserve( writer,
+                GAC_EVENT_WRITER_NUMBER_LENGTH + 1 ) )
+    {
+        return false;
+    }
+    writer->buffer.count += gac_event_writer_format_number(
+            &writer->buffer.items[writer->buffer.count], value, is_float );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_event_writer_field_string( gac_event_writer_t* writer,
+        const char* name, const char* value )
+{
+    const char* hex = "0123456789abcdef";
+    uint32_t length;
+    bool is_quoted;
+    char* pos;
+    unsigned char c;
+
+    if( !gac_event_writer_field_name( writer, name ) )
+    {
+        return false;
+    }
+
+    if( value == NULL )
+    {
+        value = "";
+    }
+    length = strlen( value );
+    is_quoted = writer->format == GAC_EVENT_WRITER_FORMAT_NDJSON
+        || strpbrk( value, ",\"\r\n" ) != NULL;
+
+    // escaping a character takes at most six bytes
+    if( length > ( UINT32_MAX - 2 ) / 6
+            || !gac_event_writer_reserve( writer, length * 6 + 2 ) )
+    {
+        return false;
+    }
+
+    pos = &writer->buffer.items[writer->buffer.count];
+    if( is_quoted )
+    {
+        *pos++ = '"';
+    }
+    for( ; *value != '\0'; value++ )
+    {
+        c = *value;
+        if( writer->format == GAC_EVENT_WRITER_FORMAT_CSV )
+        {
+            if( c == '"' )
+            {
+                *pos++ = '"';
+            }
+            *pos++ = c;
+        }
+        else if( c == '"' || c == '\\' )
+        {
+            *pos++ = '\\';
+            *pos++ = c;
+        }
+        else if( c < 0x20 )
+        {
+            memcpy( pos, "\\u00", 4 );
+            pos += 4;
+            *pos++ = hex[c >> 4];
+            *pos++ = hex[c & 0xf];
+        }
+        else
+        {
+            *pos++ = c;
+        }
+    }
+    if( is_quoted )
+    {
+        *pos++ = '"';
+    }
+    writer->buffer.count = pos - writer->buffer.items;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_event_writer_field_uint( gac_event_writer_t* writer,
+        const char* name, uint64_t value )
+{
+    char digits[20];
+    uint32_t count = 0;
+
+    if( !gac_event_writer_field_name( writer, name ) )
+    {
+        return false;
+    }
+
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while( value > 0 );
+
+    if( !gac_event_writer_reserve( writer, count ) )
+    {
+        return false;
+    }
+    while( count > 0 )
+    {
+        writer->buffer.items[writer->buffer.count++] = digits[--count];
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_event_writer_flush( gac_event_writer_t* writer )
+{
+    bool is_error;
+
+    if( writer == NULL || !gac_event_writer_submit( writer ) )
+    {
+        return false;
+    }
+
+    if( writer->is_async )
+    {
+        pthread_mutex_lock( &writer->lock );
+        while( writer->pending.count > 0 )
+        {
+            pthread_cond_wait( &writer->idle, &writer->lock );
+        }
+        pthread_mutex_unlock( &writer->lock );
+    }
+
+    pthread_mutex_lock( &writer->lock );
+    is_error = writer->is_error;
+    pthread_mutex_unlock( &writer->lock );
+
+    if( fflush( writer->fp ) != 0 )
+    {
+        return false;
+    }
+
+    return !is_error;
+}
+
+/******************************************************************************/
+uint32_t gac_event_writer_format_number( char* str, double value,
+        bool is_float )
+{
+    const double pow10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+        1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    char digits[GAC_EVENT_WRITER_NUMBER_LENGTH];
+    char* pos = str;
+    char* exp_pos;
+    char c;
+    double a;
+    double back;
+    uint64_t mant = 0;
+    int32_t count = 0;
+    int32_t k;
+    int32_t k_max;
+    int32_t e;
+    int32_t s = 0;
+    int32_t p;
+    int32_t i;
+    bool is_found = false;
+
+    if( isnan( value ) )
+    {
+        memcpy( str, "NaN", 4 );
+        return 3;
+    }
+    if( signbit( value ) )
+    {
+        *pos++ = '-';
+    }
+    a = fabs( value );
+    if( isinf( a ) )
+    {
+        memcpy( pos, "inf", 4 );
+        return pos - str + 3;
+    }
+    if( a == 0 )
+    {
+        memcpy( pos, "0", 2 );
+        return pos - str + 1;
+    }
+
+    // find the shortest mantissa which converts back to the same value, the
+    // conversion is exact as long as the mantissa and the power of ten are
+    // exactly representable, which holds for up to 15 digits
+    k_max = is_float ? 9 : 15;
+    e = floor( log10( a ) );
+    for( k = 1; k <= k_max; k++ )
+    {
+        s = k - 1 - e;
+        if( s > 22 || s < -22 )
+        {
+            break;
+        }
+        mant = floor( ( s < 0 ? a / pow10[-s] : a * pow10[s] ) + 0.5 );
+        back = s < 0 ? mant * pow10[-s] : mant / pow10[s];
+        if( is_float ? ( float )back == ( float )a : back == a )
+        {
+            is_found = true;
+            break;
+        }
+    }
+
+    if( is_found )
+    {
+        do
+        {
+            digits[count++] = '0' + mant % 10;
+            mant /= 10;
+        } while( mant > 0 );
+        for( i = 0; i < count / 2; i++ )
+        {
+            c = digits[i];
+            digits[i] = digits[count - 1 - i];
+            digits[count - 1 - i] = c;
+        }
+        p = count - s;
+    }
+    else
+    {
+        // enough digits to always convert back, e.g. `1.2345678901234567e-05`
+        snprintf( digits, sizeof( digits ), "%.*e", is_float ? 8 : 16, a );
+        exp_pos = strchr( digits, 'e' );
+        p = atoi( exp_pos + 1 ) + 1;
+        for( i = 0; &digits[i] < exp_pos; i++ )
+        {
+            if( digits[i] >= '0' && digits[i] <= '9' )
+            {
+                digits[count++] = digits[i];
+            }
+        }
+    }
+    while( count > 1 && digits[count - 1] == '0' )
+    {
+        count--;
+    }
+
+    if( p > -6 && p <= 21 )
+    {
+        if( p <= 0 )
+        {
+            *pos++ = '0';
+            *pos++ = '.';
+            for( i = p; i < 0; i++ )
+            {
+                *pos++ = '0';
+            }
+            memcpy( pos, digits, count );
+            pos += count;
+        }
+        else if( p < count )
+        {
+            memcpy( pos, digits, p );
+            pos += p;
+            *pos++ = '.';
+            memcpy( pos, &digits[p], count - p );
+            pos += count - p;
+        }
+        else
+        {
+            memcpy( pos, digits, count );
+            pos += count;
+            for( i = count; i < p; i++ )
+            {
+                *pos++ = '0';
+            }
+        }
+    }
+    else
+    {
+        *pos++ = digits[0];
+        if( count > 1 )
+        {
+            *pos++ = '.';
+            memcpy( pos, &digits[1], count - 1 );
+            pos += count - 1;
+        }
+        *pos++ = 'e';
+        *pos++ = p - 1 < 0 ? '-' : '+';
+        e = abs( p - 1 );
+        if( e >= 100 )
+        {
+            *pos++ = '0' + e / 100;
+        }
+        if( e >= 10 )
+        {
+            *pos++ = '0' + e / 10 % 10;
+        }
+        *pos++ = '0' + e % 10;
+    }
+    *pos = '\0';
+
+    return pos - str;
+}
+
+/******************************************************************************/
+bool gac_event_writer_init( gac_event_writer_t* writer, FILE* fp,
+        gac_event_writer_format_t format, gac_label_table_t* labels,
+        bool is_async )
+{
+    if( writer == NULL )
+    {
+        return false;
+    }
+
+    writer->_me = NULL;
+    writer->fp = fp;
+    writer->format = format;
+    writer->labels = labels;
+    writer->field_count = 0;
+    writer->buffer.items = NULL;
+    writer->buffer.count = 0;
+    writer->buffer.length = 0;
+    writer->pending.items = NULL;
+    writer->pending.count = 0;
+    writer->pending.length = 0;
+    writer->is_async = false;
+    writer->is_error = false;
+    writer->stop = false;
+    pthread_mutex_init( &writer->lock, NULL );
+    pthread_cond_init( &writer->work, NULL );
+    pthread_cond_init( &writer->idle, NULL );
+
+    if( fp == NULL )
+    {
+        return false;
+    }
+
+    writer->buffer.items = malloc( GAC_EVENT_WRITER_BUFFER_LENGTH );
+    if( writer->buffer.items == NULL )
+    {
+        return false;
+    }
+    writer->buffer.length = GAC_EVENT_WRITER_BUFFER_LENGTH;
+
+    if( is_async )
+    {
+        writer->pending.items = malloc( GAC_EVENT_WRITER_BUFFER_LENGTH );
+        if( writer->pending.items == NULL )
+        {
+            return false;
+        }
+        writer->pending.length = GAC_EVENT_WRITER_BUFFER_LENGTH;
+        if( pthread_create( &writer->thread, NULL, gac_event_writer_run,
+                    writer ) != 0 )
+        {
+            return false;
+        }
+        writer->is_async = true;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_event_writer_reserve( gac_event_writer_t* writer, uint32_t size )
+{
+    uint32_t length;
+    char* items;
+
+    if( writer == NULL || writer->buffer.items == NULL )
+    {
+        return false;
+    }
+
+    if( size <= writer->buffer.length - writer->buffer.count )
+    {
+        return true;
+    }
+
+    if( !gac_event_writer_submit( writer ) )
+    {
+        return false;
+    }
+
+    if( size > writer->buffer.length )
+    {
+        length = size;
+        items = realloc( writer->buffer.items, length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        writer->buffer.items = items;
+        writer->buffer.length = length;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+void* gac_event_writer_run( void* arg )
+{
+    size_t count;
+    gac_event_writer_t* writer = arg;
+
+    pthread_mutex_lock( &writer->lock );
+    while( true )
+    {
+        while( writer->pending.count == 0 && !writer->stop )
+        {
+            pthread_cond_wait( &writer->work, &writer->lock );
+        }
+        if( writer->pending.count == 0 )
+        {
+            break;
+        }
+
+        // the pending buffer is not touched by the caller until it is empty
+        pthread_mutex_unlock( &writer->lock );
+        count = fwrite( writer->pending.items, 1, writer->pending.count,
+                writer->fp );
+        pthread_mutex_lock( &writer->lock );
+
+        if( count != writer->pending.count )
+        {
+            writer->is_error = true;
+        }
+        writer->pending.count = 0;
+        pthread_cond_signal( &writer->idle );
+    }
+    pthread_mutex_unlock( &writer->lock );
+
+    return NULL;
+}
+
+/******************************************************************************/
+bool gac_event_writer_submit( gac_event_writer_t* writer )
+{
+    char* items;
+    uint32_t length;
+    bool is_error;
+
+    if( writer == NULL )
+    {
+        return false;
+    }
+
+    if( writer->buffer.count == 0 )
+    {
+        return true;
+    }
+
+    if( !writer->is_async )
+    {
+        if( fwrite( writer->buffer.items, 1, writer->buffer.count, writer->fp )
+                != writer->buffer.count )
+        {
+            writer->is_error = true;
+        }
+        writer->buffer.count = 0;
+        return !writer->is_error;
+    }
+
+    pthread_mutex_lock( &writer->lock );
+    while( writer->pending.count > 0 )
+    {
+        pthread_cond_wait( &writer->idle, &writer->lock );
+    }
+    items = writer->pending.items;
+    length = writer->pending.length;
+    writer->pending.items = writer->buffer.items;
+    writer->pending.count = writer->buffer.count;
+    writer->pending.length = writer->buffer.length;
+    writer->buffer.items = items;
+    writer->buffer.count = 0;
+    writer->buffer.length = length;
+    is_error = writer->is_error;
+    pthread_cond_signal( &writer->work );
+    pthread_mutex_unlock( &writer->lock );
+
+    return !is_error;
+}
+
+/******************************************************************************/
+bool gac_event_writer_write_aoi( gac_event_writer_t* writer,
+        gac_aoi_collection_analysis_result_t* result )
+{
+    uint32_t i;
+    bool res = true;
+    gac_aoi_analysis_t* analysis;
+    double trial_timestamp;
+    double label_timestamp;
+    double first_saccade_start_onset;
+    double first_saccade_end_onset;
+    double first_fixation_onset;
+    double label_onset;
+
+    if( writer == NULL || result == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < result->aois.count; i++ )
+    {
+        analysis = &result->aois.items[i].analysis;
+        if( analysis->fixation_count == 0 )
+        {
+            continue;
+        }
+        trial_timestamp = gac_sample_get_trial_timestamp(
+                &analysis->first_fixation.first_sample );
+        label_timestamp = gac_sample_get_label_timestamp(
+                &analysis->first_fixation.first_sample );
+        first_saccade_start_onset = gac_sample_get_onset(
+                &analysis->first_saccade.first_sample, trial_timestamp );
+        first_saccade_end_onset = gac_sample_get_onset(
+                &analysis->first_saccade.last_sample, trial_timestamp );
+        first_fixation_onset = gac_sample_get_onset(
+                &analysis->first_fixation.first_sample, trial_timestamp );
+        label_onset = label_timestamp - trial_timestamp;
+        if( label_onset < 0 )
+        {
+            label_onset = 0;
+        }
+
+        res &= gac_event_writer_begin( writer, "aoi" );
+        res &= gac_event_writer_field_uint( writer, "trial_id",
+                result->trial_id );
+        res &= gac_event_writer_field_number( writer, "trial_timestamp",
+                trial_timestamp, false );
+        res &= gac_event_writer_field_number( writer, "dwell_time",
+                analysis->dwell_time, false );
+        res &= gac_event_writer_field_number( writer, "dwell_time_rel",
+                analysis->dwell_time_relative, false );
+        res &= gac_event_writer_field_number( writer,
+                "first_fixation_duration", analysis->first_fixation.duration,
+                false );
+        res &= gac_event_writer_field_number( writer, "first_fixation_onset",
+                first_fixation_onset, false );
+        res &= gac_event_writer_field_uint( writer,
+                "first_fixation_visited_ia_count",
+                analysis->aoi_visited_before_count );
+        res &= gac_event_writer_field_number( writer,
+                "first_saccade_start_onset", first_saccade_start_onset, false );
+        res &= gac_event_writer_field_number( writer,
+                "first_saccade_end_onset", first_saccade_end_onset, false );
+        res &= gac_event_writer_field_number( writer, "first_saccade_latency",
+                first_saccade_start_onset - label_onset, false );
+        res &= gac_event_writer_field_uint( writer, "enter_saccade_count",
+                analysis->enter_saccade_count );
+        res &= gac_event_writer_field_number( writer, "fixation_count_rel",
+                analysis->fixation_count_relative, false );
+        res &= gac_event_writer_field_uint( writer, "fixation_count",
+                analysis->fixation_count );
+        res &= gac_event_writer_field_string( writer, "label",
+                result->aois.items[i].label );
+        res &= gac_event_writer_field_number( writer, "label_onset",
+                label_onset, false );
+        res &= gac_event_writer_end( writer );
+    }
+
+    return res;
+}
+
+/******************************************************************************/
+bool gac_event_writer_write_fixation( gac_event_writer_t* writer,
+        gac_fixation_t* fixation )
+{
+    bool res = true;
+    gac_sample_t* sample;
+
+    if( writer == NULL || fixation == NULL )
+    {
+        return false;
+    }
+
+    sample = &fixation->first_sample;
+    res &= gac_event_writer_begin( writer, "fixation" );
+    res &= gac_event_writer_field_number( writer, "timestamp",
+            sample->timestamp, false );
+    res &= gac_event_writer_field_number( writer, "trial_onset",
+            sample->trial_onset, false );
+    res &= gac_event_writer_field_number( writer, "label_onset",
+            sample->label_onset, false );
+    res &= gac_event_writer_field_uint( writer, "trial_id", sample->trial_id );
+    res &= gac_event_writer_field_string( writer, "label",
+            writer->labels == NULL ? NULL
+            : gac_label_table_get( writer->labels, sample->label_id ) );
+    res &= gac_event_writer_field_number( writer, "sx",
+            fixation->screen_point[0], true );
+    res &= gac_event_writer_field_number( writer, "sy",
+            fixation->screen_point[1], true );
+    res &= gac_event_writer_field_number( writer, "px",
+            fixation->point[0], true );
+    res &= gac_event_writer_field_number( writer, "py",
+            fixation->point[1], true );
+    res &= gac_event_writer_field_number( writer, "pz",
+            fixation->point[2], true );
+    res &= gac_event_writer_field_number( writer, "duration",
+            fixation->duration, false );
+    res &= gac_event_writer_end( writer );
+
+    return res;
+}
+
+/******************************************************************************/
+bool gac_event_writer_write_header( gac_event_writer_t* writer,
+        gac_event_type_t type )
+{
+    const char* header;
+
+    if( writer == NULL )
+    {
+        return false;
+    }
+
+    if( writer->format != GAC_EVENT_WRITER_FORMAT_CSV )
+    {
+        return true;
+    }
+
+    switch( type )
+    {
+        case GAC_EVENT_TYPE_FIXATION:
+            header = "timestamp,trial_onset,label_onset,trial_id,"
+                "label,sx,sy,px,py,pz,duration\n";
+            break;
+        case GAC_EVENT_TYPE_SACCADE:
+            header = "timestamp,trial_onset,label_onset,trial_id,"
+                "label,s1x,s1y,p1x,p1y,p1z,s2x,s2y,p2x,p2y,p2z,duration\n";
+            break;
+        case GAC_EVENT_TYPE_AOI:
+            header = "trial_id,trial_timestamp,dwell_time,dwell_time_rel,"
+                "first_fixation_duration,first_fixation_onset,"
+                "first_fixation_visited_ia_count,first_saccade_start_onset,"
+                "first_saccade_end_onset,first_saccade_latency,"
+                "enter_saccade_count,fixation_count_rel,fixation_count,label,"
+                "label_onset\n";
+            break;
+        default:
+            return false;
+    }
+
+    return gac_event_writer_append( writer, header, strlen( header ) );
+}
+
+/******************************************************************************/
+bool gac_event_writer_write_saccade( gac_event_writer_t* writer,
+        gac_saccade_t* saccade )
+{
+    bool res = true;
+    gac_sample_t* first;
+    gac_sample_t* last;
+
+    if( writer == NULL || saccade == NULL )
+    {
+        return false;
+    }
+
+    first = &saccade->first_sample;
+    last = &saccade->last_sample;
+    res &= gac_event_writer_begin( writer, "saccade" );
+    res &= gac_event_writer_field_number( writer, "timestamp",
+            first->timestamp, false );
+    res &= gac_event_writer_field_number( writer, "trial_onset",
+            first->trial_onset, false );
+    res &= gac_event_writer_field_number( writer, "label_onset",
+            first->label_onset, false );
+    res &= gac_event_writer_field_uint( writer, "trial_id", first->trial_id );
+    res &= gac_event_writer_field_string( writer, "label",
+            writer->labels == NULL ? NULL
+            : gac_label_table_get( writer->labels, first->label_id ) );
+    res &= gac_event_writer_field_number( writer, "s1x",
+            first->screen_point[0], true );
+    res &= gac_event_writer_field_number( writer, "s1y",
+            first->screen_point[1], true );
+    res &= gac_event_writer_field_number( writer, "p1x", first->point[0],
+            true );
+    res &= gac_event_writer_field_number( writer, "p1y", first->point[1],
+            true );
+    res &= gac_event_writer_field_number( writer, "p1z", first->point[2],
+            true );
+    res &= gac_event_writer_field_number( writer, "s2x",
+            last->screen_point[0], true );
+    res &= gac_event_writer_field_number( writer, "s2y",
+            last->screen_point[1], true );
+    res &= gac_event_writer_field_number( writer, "p2x", last->point[0],
+            true );
+    res &= gac_event_writer_field_number( writer, "p2y", last->point[1],
+            true );
+    res &= gac_event_writer_field_number( writer, "p2z", last->point[2],
+            true );
+    res &= gac_event_writer_field_number( writer, "duration",
+            last->timestamp - first->timestamp, false );
+    res &= gac_event_writer_end( writer );
+
+    return res;
+}
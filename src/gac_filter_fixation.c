@@ -7,30 +7,22 @@
  */
 
 #include "gac_filter_fixation.h"
+#include <float.h>
 
 /******************************************************************************/
 bool gac_filter_fixation( gac_filter_fixation_t* filter,
         gac_sample_t* sample, gac_fixation_t* fixation )
 {
     double duration;
-    float dispersion, dispersion_threshold, distance;
-    vec3 origin;
-    vec3 point;
-    vec2 screen_point;
     gac_sample_t* first_sample;
-    gac_queue_t* window;
 
-    glm_vec2_zero( screen_point );
-    glm_vec3_zero( point );
-    glm_vec3_zero( origin );
     if( fixation == NULL || sample == NULL || filter == NULL )
     {
         return false;
     }
-    window = &filter->window;
-    gac_queue_push( window, sample );
+    gac_filter_fixation_window_push( filter, sample );
 
-    first_sample = window->head->data;
+    first_sample = gac_queue_at( &filter->window, 0 );
     duration = sample->timestamp - first_sample->timestamp;
     if( duration < 0 )
     {
@@ -42,20 +34,13 @@ bool gac_filter_fixation( gac_filter_fixation_t* filter,
         else
         {
             filter->is_collecting = false;
-            gac_queue_clear( window );
+            gac_filter_fixation_window_clear( filter );
             return false;
         }
     }
     else if( duration >= filter->duration_threshold )
     {
-        gac_samples_dispersion( window, &dispersion, 0 );
-        gac_samples_average_origin( window, &origin, 0 );
-        gac_samples_average_point( window, &point, 0 );
-        gac_samples_average_screen_point( window, &screen_point, 0 );
-        distance = glm_vec3_distance( origin, point );
-        dispersion_threshold = distance * filter->normalized_dispersion_threshold;
-
-        if( dispersion <= dispersion_threshold)
+        if( gac_filter_fixation_window_is_fixation( filter ) )
         {
             if( !filter->is_collecting )
             {
@@ -63,8 +48,7 @@ bool gac_filter_fixation( gac_filter_fixation_t* filter,
                 filter->is_collecting = true;
             }
             filter->duration = duration;
-            glm_vec3_copy( point, filter->point );
-            glm_vec2_copy( screen_point, filter->screen_point );
+            filter->count = filter->window.count;
         }
         else if( filter->is_collecting )
         {
@@ -72,17 +56,55 @@ bool gac_filter_fixation( gac_filter_fixation_t* filter,
         }
         else
         {
-            gac_queue_remove( window );
+            gac_filter_fixation_window_remove( filter );
         }
     }
 
     return false;
 
 fixation_stop:
+    gac_filter_fixation_centroid( filter );
     gac_fixation_init( fixation, &filter->screen_point, &filter->point,
             filter->duration, first_sample );
     filter->is_collecting = false;
-    gac_queue_clear( window );
+    gac_filter_fixation_window_clear( filter );
+    return true;
+}
+
+/******************************************************************************/
+bool gac_filter_fixation_centroid( gac_filter_fixation_t* filter )
+{
+    uint32_t i;
+    gac_sample_t* sample;
+    gac_queue_iter_t iter;
+
+    if( filter == NULL || filter->count == 0
+            || filter->count > filter->window.count )
+    {
+        return false;
+    }
+
+    glm_vec3_zero( filter->point );
+    glm_vec2_zero( filter->screen_point );
+
+    // the samples of the fixation are summed newest first in single
+    // precision, exactly as gac_samples_average_point() sums a window
+    gac_queue_iter_init( &iter, &filter->window, true );
+    for( i = 0; i < filter->window.count; i++ )
+    {
+        sample = gac_queue_iter_next( &iter );
+        if( i < filter->window.count - filter->count )
+        {
+            // the samples after the end of the fixation
+            continue;
+        }
+        glm_vec3_add( filter->point, sample->point, filter->point );
+        glm_vec2_add( filter->screen_point, sample->screen_point,
+                filter->screen_point );
+    }
+
+    glm_vec3_divs( filter->point, filter->count, filter->point );
+    glm_vec2_divs( filter->screen_point, filter->count, filter->screen_point );
     return true;
 }
 
@@ -110,6 +132,9 @@ void gac_filter_fixation_destroy( gac_filter_fixation_t* filter )
     }
 
     gac_queue_destroy( &filter->window );
+    gac_minmax_destroy( &filter->extrema[0] );
+    gac_minmax_destroy( &filter->extrema[1] );
+    gac_minmax_destroy( &filter->extrema[2] );
     if( filter->_me != NULL )
     {
         free( filter->_me );
@@ -128,6 +153,7 @@ bool gac_filter_fixation_init( gac_filter_fixation_t* filter,
 
     filter->_me = NULL;
     filter->duration = 0;
+    filter->count = 0;
     filter->new_samples = 0;
     glm_vec2_zero( filter->screen_point );
     glm_vec3_zero( filter->point );
@@ -137,6 +163,173 @@ bool gac_filter_fixation_init( gac_filter_fixation_t* filter,
         gac_fixation_normalised_dispersion_threshold( dispersion_threshold );
     gac_queue_init( &filter->window, 0 );
     gac_queue_set_rm_handler( &filter->window, gac_sample_destroy );
+    gac_sample_sum_clear( &filter->sum );
+    filter->magnitude = 0;
+    gac_minmax_init( &filter->extrema[0] );
+    gac_minmax_init( &filter->extrema[1] );
+    gac_minmax_init( &filter->extrema[2] );
+
+    return true;
+}
+
+/******************************************************************************/
+double gac_filter_fixation_magnitude( gac_sample_t* sample )
+{
+    uint32_t i;
+    double magnitude = 0;
+
+    if( sample == NULL )
+    {
+        return 0;
+    }
+
+    for( i = 0; i < 3; i++ )
+    {
+        magnitude = fmax( magnitude, fabs( sample->point[i] ) );
+        magnitude = fmax( magnitude, fabs( sample->origin[i] ) );
+    }
+
+    return magnitude;
+}
+
+/******************************************************************************/
+bool gac_filter_fixation_window_clear( gac_filter_fixation_t* filter )
+{
+    if( filter == NULL )
+    {
+        return false;
+    }
+
+    gac_sample_sum_clear( &filter->sum );
+    filter->magnitude = 0;
+    gac_minmax_clear( &filter->extrema[0] );
+    gac_minmax_clear( &filter->extrema[1] );
+    gac_minmax_clear( &filter->extrema[2] );
+
+    return gac_queue_clear( &filter->window );
+}
+
+/******************************************************************************/
+bool gac_filter_fixation_window_is_fixation( gac_filter_fixation_t* filter )
+{
+    uint32_t i;
+    double delta, distance, error, threshold;
+    float dispersion, dispersion_threshold;
+    vec3 max;
+    vec3 min;
+    vec3 origin;
+    vec3 point;
+    gac_queue_t* window;
+
+    if( filter == NULL || filter->window.count == 0 )
+    {
+        return false;
+    }
+    window = &filter->window;
+
+    if( filter->sum.count > 0 && filter->sum.invalid == 0 )
+    {
+        for( i = 0; i < 3; i++ )
+        {
+            gac_minmax_min( &filter->extrema[i], &min[i] );
+            gac_minmax_max( &filter->extrema[i], &max[i] );
+        }
+        dispersion = sqrt(
+                ( max[0] - min[0] ) * ( max[0] - min[0] )
+                + ( max[1] - min[1] ) * ( max[1] - min[1] )
+                + ( max[2] - min[2] ) * ( max[2] - min[2] ) );
+
+        distance = 0;
+        for( i = 0; i < 3; i++ )
+        {
+            delta = ( filter->sum.point[i] - filter->sum.origin[i] )
+                / filter->sum.count;
+            distance += delta * delta;
+        }
+        threshold = sqrt( distance ) * filter->normalized_dispersion_threshold;
+
+        // a bound of the rounding error of the single precision threshold,
+        // the averages are off by at most (n - 1) * eps / 2 of the sum of the
+        // absolute values, the distance and the threshold by a few eps
+        error = 4 * sqrt( 3 ) * FLT_EPSILON * filter->magnitude
+            * ( filter->sum.count + 1 ) / filter->sum.count
+            * filter->normalized_dispersion_threshold
+            + 4 * FLT_EPSILON * threshold;
+        if( fabs( dispersion - threshold ) > 2 * error )
+        {
+            return dispersion <= threshold;
+        }
+    }
+    else
+    {
+        // the window holds non-finite samples, scan the whole window
+        gac_samples_dispersion( window, &dispersion, 0 );
+    }
+
+    // close to the threshold the decision is made with the single precision
+    // averages of the window, summed newest first
+    gac_samples_average_origin( window, &origin, 0 );
+    gac_samples_average_point( window, &point, 0 );
+    dispersion_threshold = glm_vec3_distance( origin, point )
+        * filter->normalized_dispersion_threshold;
+
+    return dispersion <= dispersion_threshold;
+}
+
+/******************************************************************************/
+bool gac_filter_fixation_window_push( gac_filter_fixation_t* filter,
+        gac_sample_t* sample )
+{
+    if( filter == NULL || sample == NULL )
+    {
+        return false;
+    }
+
+    if( !gac_queue_push( &filter->window, sample ) )
+    {
+        return false;
+    }
+
+    gac_sample_sum_add( &filter->sum, sample );
+    if( gac_sample_is_finite( sample ) )
+    {
+        filter->magnitude += gac_filter_fixation_magnitude( sample );
+    }
+    gac_minmax_push( &filter->extrema[0], sample->point[0] );
+    gac_minmax_push( &filter->extrema[1], sample->point[1] );
+    gac_minmax_push( &filter->extrema[2], sample->point[2] );
 
     return true;
 }
+
+/******************************************************************************/
+bool gac_filter_fixation_window_remove( gac_filter_fixation_t* filter )
+{
+    gac_sample_t* sample;
+
+    if( filter == NULL )
+    {
+        return false;
+    }
+
+    sample = gac_queue_at( &filter->window, 0 );
+    if( sample == NULL )
+    {
+        return false;
+    }
+
+    gac_sample_sum_sub( &filter->sum, sample );
+    if( filter->sum.count == 0 )
+    {
+        filter->magnitude = 0;
+    }
+    else if( gac_sample_is_finite( sample ) )
+    {
+        filter->magnitude -= gac_filter_fixation_magnitude( sample );
+    }
+    gac_minmax_pop( &filter->extrema[0] );
+    gac_minmax_pop( &filter->extrema[1] );
+    gac_minmax_pop( &filter->extrema[2] );
+
+    return gac_queue_remove( &filter->window );
+}
@@ -34,7 +34,7 @@ uint32_t gac_filter_gap( gac_filter_gap_t* filter, gac_queue_t* samples,
         return 1;
     }
 
-    last_sample = samples->tail->data;
+    last_sample = gac_queue_at( samples, samples->count - 1 );
     inter_arrival_time = sample->timestamp - last_sample->timestamp;
 
     if( inter_arrival_time > filter->sample_period
@@ -51,9 +51,9 @@ uint32_t gac_filter_gap( gac_filter_gap_t* filter, gac_queue_t* samples,
         glm_vec3_lerp( last_sample->point, sample->point, factor, point );
         glm_vec2_lerp( last_sample->screen_point, sample->screen_point, factor,
                 screen_point );
-        new_sample = gac_sample_create( &screen_point, &origin, &point,
-                last_sample->timestamp + delta,
-                sample->trial_id, sample->label );
+        new_sample = gac_sample_create_pooled( filter->pool, &screen_point,
+                &origin, &point, last_sample->timestamp + delta,
+                sample->trial_id, sample->label_id );
         new_sample->label_onset = sample->label_onset + delta;
         new_sample->trial_onset = sample->trial_onset + delta;
         gac_queue_push( samples, new_sample );
@@ -105,6 +105,7 @@ bool gac_filter_gap_init( gac_filter_gap_t* filter, double max_gap_length,
     filter->is_enabled = max_gap_length == 0 ? false : true;
     filter->max_gap_length = max_gap_length;
     filter->sample_period = sample_period;
+    filter->pool = NULL;
 
     return true;
 }
@@ -19,9 +19,34 @@ gac_sample_t* gac_filter_noise( gac_filter_noise_t* filter,
 
     if( filter->window.count == filter->window.length )
     {
+        if( filter->is_summing )
+        {
+            gac_sample_sum_sub( &filter->sum,
+                    gac_queue_at( &filter->window, 0 ) );
+        }
         gac_queue_remove( &filter->window );
     }
     gac_queue_push( &filter->window, sample );
+    if( filter->is_summing )
+    {
+        gac_sample_sum_add( &filter->sum, sample );
+        filter->sum_count++;
+        if( filter->sum_count >= GAC_FILTER_NOISE_SUM_REBASE )
+        {
+            gac_filter_noise_rebase( filter );
+        }
+    }
+    else if( filter->type == GAC_FILTER_NOISE_TYPE_MEDIAN )
+    {
+        gac_median_push( &filter->medians[0], sample->screen_point[0] );
+        gac_median_push( &filter->medians[1], sample->screen_point[1] );
+        gac_median_push( &filter->medians[2], sample->point[0] );
+        gac_median_push( &filter->medians[3], sample->point[1] );
+        gac_median_push( &filter->medians[4], sample->point[2] );
+        gac_median_push( &filter->medians[5], sample->origin[0] );
+        gac_median_push( &filter->medians[6], sample->origin[1] );
+        gac_median_push( &filter->medians[7], sample->origin[2] );
+    }
 
     if( filter->window.count < filter->window.length )
     {
@@ -33,7 +58,7 @@ gac_sample_t* gac_filter_noise( gac_filter_noise_t* filter,
         case GAC_FILTER_NOISE_TYPE_AVERAGE:
             return gac_filter_noise_average( filter );
         case GAC_FILTER_NOISE_TYPE_MEDIAN:
-            return sample;
+            return gac_filter_noise_median( filter );
     }
 
     return sample;
@@ -42,32 +67,52 @@ gac_sample_t* gac_filter_noise( gac_filter_noise_t* filter,
 /******************************************************************************/
 gac_sample_t* gac_filter_noise_average( gac_filter_noise_t* filter )
 {
-    uint32_t count = 0;
+    gac_sample_t* sample;
+    vec2 v2d;
+    vec3 v3d;
+
+    glm_vec2_zero( v2d );
+    glm_vec3_zero( v3d );
+    sample = gac_sample_create_pooled( filter->pool, &v2d, &v3d, &v3d, 0, 0,
+            GAC_LABEL_ID_NONE );
+    if( sample == NULL )
+    {
+        return NULL;
+    }
+
+    gac_filter_noise_average_to( filter, sample );
+
+    return sample;
+}
+
+/******************************************************************************/
+bool gac_filter_noise_average_to( gac_filter_noise_t* filter,
+        gac_sample_t* sample )
+{
     gac_sample_t* sample_mid;
-    gac_sample_t* sample_new;
-    gac_queue_item_t* mid;
     vec2 screen_point;
     vec3 point;
     vec3 origin;
 
-    gac_samples_average_screen_point( &filter->window, &screen_point, 0 );
-    gac_samples_average_point( &filter->window, &point, 0 );
-    gac_samples_average_origin( &filter->window, &origin, 0 );
+    if( filter == NULL || sample == NULL || filter->window.count == 0 )
+    {
+        return false;
+    }
 
-    mid = filter->window.tail;
-    while( mid != NULL && mid->next != NULL && count < filter->mid )
+    if( !filter->is_summing || !gac_sample_sum_average( &filter->sum,
+                &screen_point, &origin, &point ) )
     {
-        mid = mid->next;
-        count++;
+        // short window or non-finite samples, scan the whole window
+        gac_samples_average_screen_point( &filter->window, &screen_point, 0 );
+        gac_samples_average_point( &filter->window, &point, 0 );
+        gac_samples_average_origin( &filter->window, &origin, 0 );
     }
-    sample_mid = mid->data;
 
-    sample_new = gac_sample_create( &screen_point, &origin, &point,
-            sample_mid->timestamp, sample_mid->trial_id, sample_mid->label );
-    sample_new->label_onset = sample_mid->label_onset;
-    sample_new->trial_onset = sample_mid->trial_onset;
+    sample_mid = gac_queue_at( &filter->window,
+            filter->window.count - 1 - filter->mid );
 
-    return sample_new;
+    return gac_filter_noise_sample_to( sample, sample_mid, &screen_point,
+            &origin, &point );
 }
 
 /******************************************************************************/
@@ -87,12 +132,21 @@ gac_filter_noise_t* gac_filter_noise_create( gac_filter_noise_type_t type,
 /******************************************************************************/
 void gac_filter_noise_destroy( gac_filter_noise_t* filter )
 {
+    uint32_t i;
+
     if( filter == NULL )
     {
         return;
     }
 
     gac_queue_destroy( &filter->window );
+    if( filter->type == GAC_FILTER_NOISE_TYPE_MEDIAN )
+    {
+        for( i = 0; i < 8; i++ )
+        {
+            gac_median_destroy( &filter->medians[i] );
+        }
+    }
     if( filter->_me != NULL )
     {
         free( filter->_me );
@@ -103,6 +157,9 @@ void gac_filter_noise_destroy( gac_filter_noise_t* filter )
 bool gac_filter_noise_init( gac_filter_noise_t* filter,
         gac_filter_noise_type_t type, uint32_t mid_idx )
 {
+    uint32_t i;
+    bool res = true;
+
     if( filter == NULL )
     {
         return false;
@@ -112,8 +169,109 @@ bool gac_filter_noise_init( gac_filter_noise_t* filter,
     filter->is_enabled = mid_idx == 0 ? false : true;
     filter->type = type;
     filter->mid = mid_idx;
+    filter->pool = NULL;
+    filter->is_summing = type == GAC_FILTER_NOISE_TYPE_AVERAGE
+        && mid_idx * 2 + 1 >= GAC_FILTER_NOISE_SUM_MIN_LENGTH;
+    gac_sample_sum_clear( &filter->sum );
+    filter->sum_count = 0;
     gac_queue_init( &filter->window, mid_idx * 2 + 1 );
     gac_queue_set_rm_handler( &filter->window, gac_sample_destroy );
+    if( type == GAC_FILTER_NOISE_TYPE_MEDIAN )
+    {
+        for( i = 0; i < 8; i++ )
+        {
+            res &= gac_median_init( &filter->medians[i], mid_idx * 2 + 1 );
+        }
+    }
+
+    return res;
+}
+
+/******************************************************************************/
+gac_sample_t* gac_filter_noise_median( gac_filter_noise_t* filter )
+{
+    gac_sample_t* sample;
+    vec2 v2d;
+    vec3 v3d;
+
+    glm_vec2_zero( v2d );
+    glm_vec3_zero( v3d );
+    sample = gac_sample_create_pooled( filter->pool, &v2d, &v3d, &v3d, 0, 0,
+            GAC_LABEL_ID_NONE );
+    if( sample == NULL )
+    {
+        return NULL;
+    }
+
+    gac_filter_noise_median_to( filter, sample );
+
+    return sample;
+}
+
+/******************************************************************************/
+bool gac_filter_noise_median_to( gac_filter_noise_t* filter,
+        gac_sample_t* sample )
+{
+    gac_sample_t* sample_mid;
+    vec2 screen_point;
+    vec3 point;
+    vec3 origin;
+
+    if( filter == NULL || sample == NULL || filter->window.count == 0 )
+    {
+        return false;
+    }
+
+    gac_median_get( &filter->medians[0], &screen_point[0] );
+    gac_median_get( &filter->medians[1], &screen_point[1] );
+    gac_median_get( &filter->medians[2], &point[0] );
+    gac_median_get( &filter->medians[3], &point[1] );
+    gac_median_get( &filter->medians[4], &point[2] );
+    gac_median_get( &filter->medians[5], &origin[0] );
+    gac_median_get( &filter->medians[6], &origin[1] );
+    gac_median_get( &filter->medians[7], &origin[2] );
+
+    sample_mid = gac_queue_at( &filter->window,
+            filter->window.count - 1 - filter->mid );
+
+    return gac_filter_noise_sample_to( sample, sample_mid, &screen_point,
+            &origin, &point );
+}
+
+/******************************************************************************/
+bool gac_filter_noise_rebase( gac_filter_noise_t* filter )
+{
+    gac_sample_t* sample;
+    gac_queue_iter_t iter;
+
+    if( filter == NULL )
+    {
+        return false;
+    }
+
+    gac_sample_sum_clear( &filter->sum );
+    gac_queue_iter_init( &iter, &filter->window, true );
+    while( ( sample = gac_queue_iter_next( &iter ) ) != NULL )
+    {
+        gac_sample_sum_add( &filter->sum, sample );
+    }
+    filter->sum_count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_filter_noise_sample_to( gac_sample_t* sample, gac_sample_t* sample_mid,
+        vec2* screen_point, vec3* origin, vec3* point )
+{
+    glm_vec2_copy( *screen_point, sample->screen_point );
+    glm_vec3_copy( *origin, sample->origin );
+    glm_vec3_copy( *point, sample->point );
+    sample->timestamp = sample_mid->timestamp;
+    sample->trial_id = sample_mid->trial_id;
+    sample->label_id = sample_mid->label_id;
+    sample->label_onset = sample_mid->label_onset;
+    sample->trial_onset = sample_mid->trial_onset;
 
     return true;
 }
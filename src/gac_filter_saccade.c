@@ -33,8 +33,8 @@ bool gac_filter_saccade( gac_filter_saccade_t* filter, gac_sample_t* sample,
         return false;
     }
 
-    s2 = window->tail->data;
-    s1 = window->tail->next->data;
+    s2 = gac_queue_at( window, window->count - 1 );
+    s1 = gac_queue_at( window, window->count - 2 );
     duration = s2->timestamp - s1->timestamp;
 
     glm_vec3_sub( s1->point, s1->origin, v1 );
@@ -55,7 +55,7 @@ bool gac_filter_saccade( gac_filter_saccade_t* filter, gac_sample_t* sample,
     {
         // saccade stop
         s2 = s1;
-        s1 = window->head->data;
+        s1 = gac_queue_at( window, 0 );
         gac_saccade_init( saccade, s1, s2 );
         filter->is_collecting = false;
         gac_queue_clear( window );
@@ -0,0 +1,285 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_heatmap.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+bool gac_heatmap_add( gac_heatmap_t* heatmap, float x, float y,
+        float weight )
+{
+    uint32_t cx;
+    uint32_t cy;
+
+    if( heatmap == NULL || !( x >= 0 && x < 1 && y >= 0 && y < 1 ) )
+    {
+        return false;
+    }
+
+    cx = x * heatmap->width;
+    cy = y * heatmap->height;
+    if( cx >= heatmap->width )
+    {
+        cx = heatmap->width - 1;
+    }
+    if( cy >= heatmap->height )
+    {
+        cy = heatmap->height - 1;
+    }
+    heatmap->points[( uint64_t )cy * heatmap->width + cx] += weight;
+    heatmap->is_dirty = true;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_heatmap_add_fixation( gac_heatmap_t* heatmap,
+        gac_fixation_t* fixation )
+{
+    if( fixation == NULL || !gac_heatmap_add( heatmap,
+                fixation->screen_point[0], fixation->screen_point[1],
+                fixation->duration ) )
+    {
+        return false;
+    }
+
+    heatmap->fixation_count++;
+    heatmap->duration += fixation->duration;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_heatmap_blur( gac_heatmap_t* heatmap )
+{
+    uint32_t x, y, t;
+    uint32_t y_min, y_max;
+    uint32_t radius;
+    uint32_t width;
+    float k;
+    float* dst;
+    const float* src;
+
+    if( heatmap == NULL )
+    {
+        return false;
+    }
+
+    width = heatmap->width;
+    radius = heatmap->kernel.radius;
+    if( heatmap->map == NULL )
+    {
+        heatmap->map = malloc( sizeof( float ) * ( uint64_t )width
+                * heatmap->height );
+        if( heatmap->map == NULL )
+        {
+            return false;
+        }
+    }
+    if( heatmap->row == NULL )
+    {
+        // the padding of the row buffer is never written
+        heatmap->row = calloc( width + 2 * radius, sizeof( float ) );
+        if( heatmap->row == NULL )
+        {
+            return false;
+        }
+    }
+
+    for( y = 0; y < heatmap->height; y++ )
+    {
+        // vertical pass, accumulate whole rows of the point grid
+        dst = &heatmap->map[( uint64_t )y * width];
+        memset( dst, 0, sizeof( float ) * width );
+        y_min = y < radius ? 0 : y - radius;
+        y_max = y + radius < heatmap->height ? y + radius
+            : heatmap->height - 1;
+        for( t = y_min; t <= y_max; t++ )
+        {
+            k = heatmap->kernel.items[t + radius - y];
+            src = &heatmap->points[( uint64_t )t * width];
+            for( x = 0; x < width; x++ )
+            {
+                dst[x] += k * src[x];
+            }
+        }
+
+        // horizontal pass on the zero-padded copy of the row
+        memcpy( &heatmap->row[radius], dst, sizeof( float ) * width );
+        memset( dst, 0, sizeof( float ) * width );
+        for( t = 0; t <= 2 * radius; t++ )
+        {
+            k = heatmap->kernel.items[t];
+            src = &heatmap->row[t];
+            for( x = 0; x < width; x++ )
+            {
+                dst[x] += k * src[x];
+            }
+        }
+    }
+    heatmap->is_dirty = false;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_heatmap_clear( gac_heatmap_t* heatmap )
+{
+    if( heatmap == NULL )
+    {
+        return false;
+    }
+
+    memset( heatmap->points, 0, sizeof( float ) * ( uint64_t )heatmap->width
+            * heatmap->height );
+    heatmap->fixation_count = 0;
+    heatmap->duration = 0;
+    heatmap->is_dirty = true;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_heatmap_t* gac_heatmap_create( uint32_t width, uint32_t height,
+        float sigma )
+{
+    gac_heatmap_t* heatmap = malloc( sizeof( gac_heatmap_t ) );
+
+    if( heatmap == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_heatmap_init( heatmap, width, height, sigma ) )
+    {
+        gac_heatmap_destroy( heatmap );
+        free( heatmap );
+        return NULL;
+    }
+
+    heatmap->_me = heatmap;
+
+    return heatmap;
+}
+
+/******************************************************************************/
+void gac_heatmap_destroy( gac_heatmap_t* heatmap )
+{
+    if( heatmap == NULL )
+    {
+        return;
+    }
+
+    free( heatmap->points );
+    free( heatmap->map );
+    free( heatmap->row );
+    free( heatmap->kernel.items );
+    heatmap->points = NULL;
+    heatmap->map = NULL;
+    heatmap->row = NULL;
+    heatmap->kernel.items = NULL;
+
+    if( heatmap->_me != NULL )
+    {
+        free( heatmap->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_heatmap_get( gac_heatmap_t* heatmap, const float** map )
+{
+    if( heatmap == NULL || map == NULL )
+    {
+        return false;
+    }
+
+    if( heatmap->is_dirty && !gac_heatmap_blur( heatmap ) )
+    {
+        return false;
+    }
+    *map = heatmap->map;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_heatmap_init( gac_heatmap_t* heatmap, uint32_t width,
+        uint32_t height, float sigma )
+{
+    uint32_t i;
+    uint32_t max_radius;
+    float sum;
+    float d;
+
+    if( heatmap == NULL )
+    {
+        return false;
+    }
+
+    heatmap->_me = NULL;
+    heatmap->width = width;
+    heatmap->height = height;
+    heatmap->sigma = sigma > 0 ? sigma : 0;
+    heatmap->key = 0;
+    heatmap->fixation_count = 0;
+    heatmap->duration = 0;
+    heatmap->points = NULL;
+    heatmap->map = NULL;
+    heatmap->row = NULL;
+    heatmap->kernel.items = NULL;
+    heatmap->kernel.radius = 0;
+    heatmap->is_dirty = true;
+
+    if( width == 0 || height == 0
+            || ( uint64_t )width * height > UINT32_MAX )
+    {
+        return false;
+    }
+
+    heatmap->points = calloc( ( uint64_t )width * height, sizeof( float ) );
+    if( heatmap->points == NULL )
+    {
+        return false;
+    }
+
+    // the kernel is cut off at three standard deviations
+    max_radius = width > height ? width : height;
+    if( heatmap->sigma * 3 < max_radius )
+    {
+        heatmap->kernel.radius = ceilf( heatmap->sigma * 3 );
+    }
+    else
+    {
+        heatmap->kernel.radius = max_radius;
+    }
+    heatmap->kernel.items = malloc( sizeof( float )
+            * ( 2 * heatmap->kernel.radius + 1 ) );
+    if( heatmap->kernel.items == NULL )
+    {
+        return false;
+    }
+    heatmap->kernel.items[heatmap->kernel.radius] = 1;
+    sum = 1;
+    for( i = 1; i <= heatmap->kernel.radius; i++ )
+    {
+        d = i / heatmap->sigma;
+        heatmap->kernel.items[heatmap->kernel.radius + i] =
+            expf( -0.5f * d * d );
+        heatmap->kernel.items[heatmap->kernel.radius - i] =
+            heatmap->kernel.items[heatmap->kernel.radius + i];
+        sum += 2 * heatmap->kernel.items[heatmap->kernel.radius + i];
+    }
+    for( i = 0; i <= 2 * heatmap->kernel.radius; i++ )
+    {
+        heatmap->kernel.items[i] /= sum;
+    }
+
+    return true;
+}
@@ -0,0 +1,201 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_heatmap_collection.h"
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+bool gac_heatmap_collection_add_fixation( gac_heatmap_collection_t* hc,
+        gac_fixation_t* fixation )
+{
+    uint32_t idx;
+    uint32_t key;
+    uint32_t length;
+    gac_heatmap_t* heatmap;
+    void* items;
+
+    if( hc == NULL || fixation == NULL || !hc->is_enabled
+            || !( fixation->screen_point[0] >= 0
+                && fixation->screen_point[0] < 1
+                && fixation->screen_point[1] >= 0
+                && fixation->screen_point[1] < 1 ) )
+    {
+        return false;
+    }
+
+    key = 0;
+    if( hc->key == GAC_HEATMAP_KEY_TRIAL )
+    {
+        key = fixation->first_sample.trial_id;
+    }
+    else if( hc->key == GAC_HEATMAP_KEY_LABEL )
+    {
+        key = fixation->first_sample.label_id;
+    }
+
+    if( !gac_heatmap_collection_find( hc, key, &idx ) )
+    {
+        if( hc->heatmaps.count == hc->heatmaps.length )
+        {
+            length = hc->heatmaps.length == 0 ? 4 : hc->heatmaps.length * 2;
+            items = realloc( hc->heatmaps.items,
+                    sizeof( gac_heatmap_t* ) * length );
+            if( items == NULL )
+            {
+                return false;
+            }
+            hc->heatmaps.items = items;
+            hc->heatmaps.length = length;
+        }
+        heatmap = gac_heatmap_create( hc->width, hc->height, hc->sigma );
+        if( heatmap == NULL )
+        {
+            return false;
+        }
+        heatmap->key = key;
+        memmove( &hc->heatmaps.items[idx + 1], &hc->heatmaps.items[idx],
+                sizeof( gac_heatmap_t* ) * ( hc->heatmaps.count - idx ) );
+        hc->heatmaps.items[idx] = heatmap;
+        hc->heatmaps.count++;
+    }
+
+    return gac_heatmap_add_fixation( hc->heatmaps.items[idx], fixation );
+}
+
+/******************************************************************************/
+bool gac_heatmap_collection_clear( gac_heatmap_collection_t* hc )
+{
+    uint32_t i;
+
+    if( hc == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < hc->heatmaps.count; i++ )
+    {
+        gac_heatmap_destroy( hc->heatmaps.items[i] );
+    }
+    hc->heatmaps.count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_heatmap_collection_t* gac_heatmap_collection_create()
+{
+    gac_heatmap_collection_t* hc =
+        malloc( sizeof( gac_heatmap_collection_t ) );
+
+    if( hc == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_heatmap_collection_init( hc ) )
+    {
+        free( hc );
+        return NULL;
+    }
+
+    hc->_me = hc;
+
+    return hc;
+}
+
+/******************************************************************************/
+void gac_heatmap_collection_destroy( gac_heatmap_collection_t* hc )
+{
+    if( hc == NULL )
+    {
+        return;
+    }
+
+    gac_heatmap_collection_clear( hc );
+    free( hc->heatmaps.items );
+    hc->heatmaps.items = NULL;
+    hc->heatmaps.length = 0;
+
+    if( hc->_me != NULL )
+    {
+        free( hc->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_heatmap_collection_find( gac_heatmap_collection_t* hc, uint32_t key,
+        uint32_t* idx )
+{
+    uint32_t low;
+    uint32_t high;
+    uint32_t mid;
+
+    if( hc == NULL || idx == NULL )
+    {
+        return false;
+    }
+
+    low = 0;
+    high = hc->heatmaps.count;
+    while( low < high )
+    {
+        mid = low + ( high - low ) / 2;
+        if( hc->heatmaps.items[mid]->key < key )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    *idx = low;
+
+    return low < hc->heatmaps.count && hc->heatmaps.items[low]->key == key;
+}
+
+/******************************************************************************/
+bool gac_heatmap_collection_init( gac_heatmap_collection_t* hc )
+{
+    if( hc == NULL )
+    {
+        return false;
+    }
+
+    hc->_me = NULL;
+    hc->is_enabled = false;
+    hc->key = GAC_HEATMAP_KEY_NONE;
+    hc->width = 0;
+    hc->height = 0;
+    hc->sigma = 0;
+    hc->heatmaps.items = NULL;
+    hc->heatmaps.count = 0;
+    hc->heatmaps.length = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_heatmap_collection_set( gac_heatmap_collection_t* hc,
+        uint32_t width, uint32_t height, float sigma, gac_heatmap_key_t key )
+{
+    if( hc == NULL )
+    {
+        return false;
+    }
+
+    gac_heatmap_collection_clear( hc );
+    hc->is_enabled = width > 0 && height > 0;
+    hc->width = width;
+    hc->height = height;
+    hc->sigma = sigma;
+    hc->key = key;
+
+    return true;
+}
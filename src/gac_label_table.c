@@ -0,0 +1,213 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_label_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************/
+gac_label_table_t* gac_label_table_create()
+{
+    gac_label_table_t* table = malloc( sizeof( gac_label_table_t ) );
+    if( !gac_label_table_init( table ) )
+    {
+        return NULL;
+    }
+    table->_me = table;
+
+    return table;
+}
+
+/******************************************************************************/
+void gac_label_table_destroy( gac_label_table_t* table )
+{
+    uint32_t i;
+
+    if( table == NULL )
+    {
+        return;
+    }
+
+    for( i = 0; i < table->labels.count; i++ )
+    {
+        free( table->labels.items[i] );
+    }
+    free( table->labels.items );
+    free( table->buckets.items );
+    table->labels.items = NULL;
+    table->labels.count = 0;
+    table->labels.length = 0;
+    table->buckets.items = NULL;
+    table->buckets.length = 0;
+
+    if( table->_me != NULL )
+    {
+        free( table->_me );
+    }
+}
+
+/******************************************************************************/
+const char* gac_label_table_get( gac_label_table_t* table, uint32_t id )
+{
+    if( id == GAC_LABEL_ID_NONE )
+    {
+        return "";
+    }
+
+    if( table == NULL || id >= table->labels.count )
+    {
+        return NULL;
+    }
+
+    return table->labels.items[id];
+}
+
+/******************************************************************************/
+uint32_t gac_label_table_hash( const char* label )
+{
+    uint32_t hash = 2166136261u;
+
+    while( *label != '\0' )
+    {
+        hash ^= ( uint8_t )*label;
+        hash *= 16777619u;
+        label++;
+    }
+
+    return hash;
+}
+
+/******************************************************************************/
+bool gac_label_table_init( gac_label_table_t* table )
+{
+    if( table == NULL )
+    {
+        return false;
+    }
+
+    table->_me = NULL;
+    table->labels.items = NULL;
+    table->labels.count = 0;
+    table->labels.length = 0;
+    table->buckets.items = NULL;
+    table->buckets.length = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_label_table_intern( gac_label_table_t* table, const char* label,
+        uint32_t* id )
+{
+    uint32_t idx;
+    uint32_t mask;
+    uint32_t length;
+    char* copy;
+    char** items;
+
+    if( table == NULL || id == NULL )
+    {
+        return false;
+    }
+
+    if( label == NULL || label[0] == '\0' )
+    {
+        *id = GAC_LABEL_ID_NONE;
+        return true;
+    }
+
+    // keep the load factor of the hash index below one half
+    if( ( table->labels.count + 1 ) * 2 > table->buckets.length )
+    {
+        if( !gac_label_table_rehash( table, table->buckets.length == 0 ? 16
+                    : table->buckets.length * 2 ) )
+        {
+            return false;
+        }
+    }
+
+    mask = table->buckets.length - 1;
+    idx = gac_label_table_hash( label ) & mask;
+    while( table->buckets.items[idx] != 0 )
+    {
+        if( strcmp( table->labels.items[table->buckets.items[idx]],
+                    label ) == 0 )
+        {
+            *id = table->buckets.items[idx];
+            return true;
+        }
+        idx = ( idx + 1 ) & mask;
+    }
+
+    if( table->labels.count + 1 >= table->labels.length )
+    {
+        length = table->labels.length == 0 ? 8 : table->labels.length * 2;
+        items = realloc( table->labels.items, sizeof( char* ) * length );
+        if( items == NULL )
+        {
+            return false;
+        }
+        table->labels.items = items;
+        table->labels.length = length;
+    }
+    if( table->labels.count == 0 )
+    {
+        // reserve the first entry for the empty label
+        table->labels.items[0] = NULL;
+        table->labels.count = 1;
+    }
+
+    copy = malloc( strlen( label ) + 1 );
+    if( copy == NULL )
+    {
+        return false;
+    }
+    strcpy( copy, label );
+
+    *id = table->labels.count;
+    table->labels.items[*id] = copy;
+    table->labels.count++;
+    table->buckets.items[idx] = *id;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_label_table_rehash( gac_label_table_t* table, uint32_t length )
+{
+    uint32_t i;
+    uint32_t idx;
+    uint32_t* items;
+
+    if( table == NULL || length <= table->labels.count )
+    {
+        return false;
+    }
+
+    items = calloc( length, sizeof( uint32_t ) );
+    if( items == NULL )
+    {
+        return false;
+    }
+
+    for( i = 1; i < table->labels.count; i++ )
+    {
+        idx = gac_label_table_hash( table->labels.items[i] ) & ( length - 1 );
+        while( items[idx] != 0 )
+        {
+            idx = ( idx + 1 ) & ( length - 1 );
+        }
+        items[idx] = i;
+    }
+
+    free( table->buckets.items );
+    table->buckets.items = items;
+    table->buckets.length = length;
+
+    return true;
+}
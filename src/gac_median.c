@@ -0,0 +1,296 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_median.h"
+#include <math.h>
+#include <stdlib.h>
+
+/******************************************************************************/
+bool gac_median_clear( gac_median_t* median )
+{
+    if( median == NULL )
+    {
+        return false;
+    }
+
+    median->count = 0;
+    median->oldest = 0;
+    median->lo.count = 0;
+    median->hi.count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_median_t* gac_median_create( uint32_t length )
+{
+    gac_median_t* median = malloc( sizeof( gac_median_t ) );
+    if( !gac_median_init( median, length ) )
+    {
+        free( median );
+        return NULL;
+    }
+    median->_me = median;
+
+    return median;
+}
+
+/******************************************************************************/
+void gac_median_destroy( gac_median_t* median )
+{
+    if( median == NULL )
+    {
+        return;
+    }
+
+    free( median->values );
+    free( median->pos );
+    free( median->lo.items );
+    free( median->hi.items );
+    median->values = NULL;
+    median->pos = NULL;
+    median->lo.items = NULL;
+    median->hi.items = NULL;
+
+    if( median->_me != NULL )
+    {
+        free( median->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_median_get( gac_median_t* median, float* value )
+{
+    if( median == NULL || value == NULL || median->count == 0 )
+    {
+        return false;
+    }
+
+    if( median->lo.count > median->hi.count )
+    {
+        *value = median->values[median->lo.items[0]];
+    }
+    else
+    {
+        *value = ( median->values[median->lo.items[0]]
+                + median->values[median->hi.items[0]] ) / 2;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_median_init( gac_median_t* median, uint32_t length )
+{
+    if( median == NULL || length == 0 )
+    {
+        return false;
+    }
+
+    median->_me = NULL;
+    median->length = length;
+    median->count = 0;
+    median->oldest = 0;
+    median->lo.count = 0;
+    median->hi.count = 0;
+    median->values = malloc( sizeof( float ) * length );
+    median->pos = malloc( sizeof( uint32_t ) * length );
+    median->lo.items = malloc( sizeof( uint32_t ) * ( length / 2 + 1 ) );
+    median->hi.items = malloc( sizeof( uint32_t ) * ( length / 2 + 1 ) );
+    if( median->values == NULL || median->pos == NULL
+            || median->lo.items == NULL || median->hi.items == NULL )
+    {
+        gac_median_destroy( median );
+        return false;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_median_less( float a, float b )
+{
+    return a < b || ( !isnan( a ) && isnan( b ) );
+}
+
+/******************************************************************************/
+bool gac_median_push( gac_median_t* median, float value )
+{
+    uint32_t slot;
+    uint32_t lo_root;
+    uint32_t hi_root;
+
+    if( median == NULL )
+    {
+        return false;
+    }
+
+    if( median->count < median->length )
+    {
+        slot = ( median->oldest + median->count ) % median->length;
+        median->values[slot] = value;
+        median->count++;
+
+        if( median->lo.count == 0 || !gac_median_less(
+                    median->values[median->lo.items[0]], value ) )
+        {
+            median->lo.items[median->lo.count] = slot;
+            median->pos[slot] = median->lo.count;
+            median->lo.count++;
+        }
+        else
+        {
+            median->hi.items[median->hi.count] = slot;
+            median->pos[slot] = median->hi.count | GAC_MEDIAN_HI;
+            median->hi.count++;
+        }
+        gac_median_sift_up( median, slot );
+
+        // keep the lower heap equal in size or one item larger
+        if( median->lo.count > median->hi.count + 1 )
+        {
+            gac_median_transfer( median, true );
+        }
+        else if( median->hi.count > median->lo.count )
+        {
+            gac_median_transfer( median, false );
+        }
+
+        return true;
+    }
+
+    // replace the oldest value in place and restore the heap orders
+    slot = median->oldest;
+    median->oldest = ( median->oldest + 1 ) % median->length;
+    median->values[slot] = value;
+    gac_median_sift_up( median, slot );
+    gac_median_sift_down( median, slot );
+
+    if( median->lo.count > 0 && median->hi.count > 0 )
+    {
+        lo_root = median->lo.items[0];
+        hi_root = median->hi.items[0];
+        if( gac_median_less( median->values[hi_root],
+                    median->values[lo_root] ) )
+        {
+            median->lo.items[0] = hi_root;
+            median->pos[hi_root] = 0;
+            median->hi.items[0] = lo_root;
+            median->pos[lo_root] = GAC_MEDIAN_HI;
+            gac_median_sift_down( median, hi_root );
+            gac_median_sift_down( median, lo_root );
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+void gac_median_sift_down( gac_median_t* median, uint32_t slot )
+{
+    bool is_hi = ( median->pos[slot] & GAC_MEDIAN_HI ) != 0;
+    uint32_t idx = median->pos[slot] & ~GAC_MEDIAN_HI;
+    uint32_t* items = is_hi ? median->hi.items : median->lo.items;
+    uint32_t count = is_hi ? median->hi.count : median->lo.count;
+    uint32_t child;
+    uint32_t tmp;
+    float a, b;
+
+    while( 2 * idx + 1 < count )
+    {
+        child = 2 * idx + 1;
+        if( child + 1 < count )
+        {
+            a = median->values[items[child + 1]];
+            b = median->values[items[child]];
+            if( is_hi ? gac_median_less( a, b ) : gac_median_less( b, a ) )
+            {
+                child++;
+            }
+        }
+        a = median->values[items[child]];
+        b = median->values[items[idx]];
+        if( !( is_hi ? gac_median_less( a, b ) : gac_median_less( b, a ) ) )
+        {
+            break;
+        }
+        tmp = items[child];
+        items[child] = items[idx];
+        items[idx] = tmp;
+        median->pos[items[idx]] = idx | ( is_hi ? GAC_MEDIAN_HI : 0 );
+        median->pos[items[child]] = child | ( is_hi ? GAC_MEDIAN_HI : 0 );
+        idx = child;
+    }
+}
+
+/******************************************************************************/
+void gac_median_sift_up( gac_median_t* median, uint32_t slot )
+{
+    bool is_hi = ( median->pos[slot] & GAC_MEDIAN_HI ) != 0;
+    uint32_t idx = median->pos[slot] & ~GAC_MEDIAN_HI;
+    uint32_t* items = is_hi ? median->hi.items : median->lo.items;
+    uint32_t parent;
+    uint32_t tmp;
+    float a, b;
+
+    while( idx > 0 )
+    {
+        parent = ( idx - 1 ) / 2;
+        a = median->values[items[idx]];
+        b = median->values[items[parent]];
+        if( !( is_hi ? gac_median_less( a, b ) : gac_median_less( b, a ) ) )
+        {
+            break;
+        }
+        tmp = items[parent];
+        items[parent] = items[idx];
+        items[idx] = tmp;
+        median->pos[items[idx]] = idx | ( is_hi ? GAC_MEDIAN_HI : 0 );
+        median->pos[items[parent]] = parent | ( is_hi ? GAC_MEDIAN_HI : 0 );
+        idx = parent;
+    }
+}
+
+/******************************************************************************/
+void gac_median_transfer( gac_median_t* median, bool to_hi )
+{
+    uint32_t slot;
+    uint32_t last;
+
+    if( to_hi )
+    {
+        slot = median->lo.items[0];
+        median->lo.count--;
+        if( median->lo.count > 0 )
+        {
+            last = median->lo.items[median->lo.count];
+            median->lo.items[0] = last;
+            median->pos[last] = 0;
+            gac_median_sift_down( median, last );
+        }
+        median->hi.items[median->hi.count] = slot;
+        median->pos[slot] = median->hi.count | GAC_MEDIAN_HI;
+        median->hi.count++;
+    }
+    else
+    {
+        slot = median->hi.items[0];
+        median->hi.count--;
+        if( median->hi.count > 0 )
+        {
+            last = median->hi.items[median->hi.count];
+            median->hi.items[0] = last;
+            median->pos[last] = GAC_MEDIAN_HI;
+            gac_median_sift_down( median, last );
+        }
+        median->lo.items[median->lo.count] = slot;
+        median->pos[slot] = median->lo.count;
+        median->lo.count++;
+    }
+    gac_median_sift_up( median, slot );
+}
@@ -0,0 +1,206 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_minmax.h"
+#include <stdlib.h>
+
+/******************************************************************************/
+bool gac_minmax_clear( gac_minmax_t* minmax )
+{
+    if( minmax == NULL )
+    {
+        return false;
+    }
+
+    minmax->min.head = 0;
+    minmax->min.count = 0;
+    minmax->max.head = 0;
+    minmax->max.count = 0;
+    minmax->first = minmax->next;
+
+    return true;
+}
+
+/******************************************************************************/
+gac_minmax_t* gac_minmax_create()
+{
+    gac_minmax_t* minmax = malloc( sizeof( gac_minmax_t ) );
+    if( !gac_minmax_init( minmax ) )
+    {
+        return NULL;
+    }
+    minmax->_me = minmax;
+
+    return minmax;
+}
+
+/******************************************************************************/
+bool gac_minmax_deque_push( gac_minmax_deque_t* deque, uint32_t seq,
+        float value, bool is_max )
+{
+    uint32_t i;
+    uint32_t capacity;
+    uint32_t mask;
+    gac_minmax_item_t* back;
+    gac_minmax_item_t* items;
+
+    // drop all values which can no longer become an extremum
+    mask = deque->capacity - 1;
+    while( deque->count > 0 )
+    {
+        back = &deque->items[( deque->head + deque->count - 1 ) & mask];
+        if( ( is_max && back->value > value )
+                || ( !is_max && back->value < value ) )
+        {
+            break;
+        }
+        deque->count--;
+    }
+
+    if( deque->count == deque->capacity )
+    {
+        capacity = deque->capacity == 0 ? 8 : deque->capacity * 2;
+        items = malloc( sizeof( gac_minmax_item_t ) * capacity );
+        if( items == NULL )
+        {
+            return false;
+        }
+        for( i = 0; i < deque->count; i++ )
+        {
+            items[i] = deque->items[( deque->head + i ) & mask];
+        }
+        free( deque->items );
+        deque->items = items;
+        deque->head = 0;
+        deque->capacity = capacity;
+        mask = capacity - 1;
+    }
+
+    back = &deque->items[( deque->head + deque->count ) & mask];
+    back->seq = seq;
+    back->value = value;
+    deque->count++;
+
+    return true;
+}
+
+/******************************************************************************/
+void gac_minmax_destroy( gac_minmax_t* minmax )
+{
+    if( minmax == NULL )
+    {
+        return;
+    }
+
+    free( minmax->min.items );
+    free( minmax->max.items );
+    minmax->min.items = NULL;
+    minmax->max.items = NULL;
+
+    if( minmax->_me != NULL )
+    {
+        free( minmax->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_minmax_init( gac_minmax_t* minmax )
+{
+    if( minmax == NULL )
+    {
+        return false;
+    }
+
+    minmax->_me = NULL;
+    minmax->min.items = NULL;
+    minmax->min.head = 0;
+    minmax->min.count = 0;
+    minmax->min.capacity = 0;
+    minmax->max.items = NULL;
+    minmax->max.head = 0;
+    minmax->max.count = 0;
+    minmax->max.capacity = 0;
+    minmax->first = 0;
+    minmax->next = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_minmax_max( gac_minmax_t* minmax, float* max )
+{
+    if( minmax == NULL || minmax->max.count == 0 )
+    {
+        return false;
+    }
+
+    *max = minmax->max.items[minmax->max.head].value;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_minmax_min( gac_minmax_t* minmax, float* min )
+{
+    if( minmax == NULL || minmax->min.count == 0 )
+    {
+        return false;
+    }
+
+    *min = minmax->min.items[minmax->min.head].value;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_minmax_pop( gac_minmax_t* minmax )
+{
+    if( minmax == NULL || minmax->first == minmax->next )
+    {
+        return false;
+    }
+
+    if( minmax->min.count > 0
+            && minmax->min.items[minmax->min.head].seq == minmax->first )
+    {
+        minmax->min.head = ( minmax->min.head + 1 )
+            & ( minmax->min.capacity - 1 );
+        minmax->min.count--;
+    }
+    if( minmax->max.count > 0
+            && minmax->max.items[minmax->max.head].seq == minmax->first )
+    {
+        minmax->max.head = ( minmax->max.head + 1 )
+            & ( minmax->max.capacity - 1 );
+        minmax->max.count--;
+    }
+    minmax->first++;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_minmax_push( gac_minmax_t* minmax, float value )
+{
+    if( minmax == NULL )
+    {
+        return false;
+    }
+
+    if( !gac_minmax_deque_push( &minmax->min, minmax->next, value, false ) )
+    {
+        return false;
+    }
+    if( !gac_minmax_deque_push( &minmax->max, minmax->next, value, true ) )
+    {
+        return false;
+    }
+    minmax->next++;
+
+    return true;
+}
@@ -9,9 +9,23 @@
 #include "gac_queue.h"
 #include <stdlib.h>
 
+/******************************************************************************/
+void* gac_queue_at( gac_queue_t* queue, uint32_t idx )
+{
+    if( queue == NULL || idx >= queue->count )
+    {
+        return NULL;
+    }
+
+    return queue->items[( queue->head + idx ) & ( queue->capacity - 1 )];
+}
+
 /******************************************************************************/
 bool gac_queue_clear( gac_queue_t* queue )
 {
+    uint32_t i;
+    uint32_t mask;
+
     if( queue == NULL )
     {
         return false;
@@ -22,17 +36,18 @@ bool gac_queue_clear( gac_queue_t* queue )
         return true;
     }
 
-    while( queue->tail != NULL )
+    mask = queue->capacity - 1;
+    for( i = 0; i < queue->count; i++ )
     {
-        if( queue->tail->data != NULL && queue->rm != NULL )
+        if( queue->items[( queue->head + i ) & mask] != NULL
+                && queue->rm != NULL )
         {
-            queue->rm( queue->tail->data );
-            queue->tail->data = NULL;
+            queue->rm( queue->items[( queue->head + i ) & mask] );
         }
-        queue->count--;
-        queue->tail = queue->tail->next;
+        queue->items[( queue->head + i ) & mask] = NULL;
     }
-    queue->tail = queue->head;
+    queue->count = 0;
+    queue->head = 0;
 
     return true;
 }
@@ -53,27 +68,16 @@ gac_queue_t* gac_queue_create( uint32_t length )
 /******************************************************************************/
 void gac_queue_destroy( gac_queue_t* queue )
 {
-    gac_queue_item_t* head;
-    gac_queue_item_t* item;
-
     if( queue == NULL )
     {
         return;
     }
 
-    if( queue->length > 0 )
+    if( queue->items != NULL )
     {
-        head = queue->head;
-        while( head != NULL )
-        {
-            item = head;
-            head = head->prev;
-            if( item->data != NULL && queue->rm != NULL )
-            {
-                queue->rm( item->data );
-            }
-            free( item );
-        }
+        gac_queue_clear( queue );
+        free( queue->items );
+        queue->items = NULL;
     }
 
     if( queue->_me != NULL )
@@ -86,48 +90,48 @@ void gac_queue_destroy( gac_queue_t* queue )
 bool gac_queue_grow( gac_queue_t* queue, uint32_t count )
 {
     uint32_t i;
-    gac_queue_item_t* item = NULL;
-    gac_queue_item_t* last_item = NULL;
+    uint32_t capacity;
+    void** items;
 
     if( queue == NULL )
     {
         return false;
     }
 
-    if( queue->tail != NULL )
+    if( queue->length + count <= queue->capacity )
     {
-        last_item = queue->tail->prev;
+        queue->length += count;
+        return true;
     }
 
-    for( i = 0; i < count; i++ )
+    capacity = queue->capacity == 0 ? 8 : queue->capacity;
+    while( capacity < queue->length + count )
     {
-        item = malloc( sizeof( gac_queue_item_t ) );
-        item->data = NULL;
-        item->next = NULL;
-        item->prev = last_item;
-        if( last_item != NULL )
-        {
-            last_item->next = item;
-        }
-        last_item = item;
-        queue->length++;
+        capacity *= 2;
     }
 
-    if( queue->tail != NULL )
+    items = malloc( sizeof( void* ) * capacity );
+    if( items == NULL )
     {
-        queue->tail->prev = item;
-        item->next = queue->tail;
+        return false;
     }
-    else
+
+    // unwrap the ring such that the head is located at index 0
+    for( i = 0; i < queue->count; i++ )
     {
-        queue->tail = item;
+        items[i] = queue->items[( queue->head + i ) & ( queue->capacity - 1 )];
     }
-
-    if( queue->head == NULL )
+    for( i = queue->count; i < capacity; i++ )
     {
-        queue->head = item;
+        items[i] = NULL;
     }
 
+    free( queue->items );
+    queue->items = items;
+    queue->head = 0;
+    queue->capacity = capacity;
+    queue->length += count;
+
     return true;
 }
 
@@ -140,52 +144,77 @@ bool gac_queue_init( gac_queue_t* queue, uint32_t length )
     }
 
     queue->_me = NULL;
+    queue->items = NULL;
+    queue->head = 0;
     queue->count = 0;
     queue->length = 0;
-    queue->head = NULL;
-    queue->tail = NULL;
+    queue->capacity = 0;
     queue->rm = NULL;
 
     return gac_queue_grow( queue, length );
 }
 
 /******************************************************************************/
-bool gac_queue_pop( gac_queue_t* queue, void** data )
+bool gac_queue_iter_init( gac_queue_iter_t* iter, gac_queue_t* queue,
+        bool reverse )
 {
-    gac_queue_item_t* free_item;
-
-    if( queue->count == 0 )
+    if( iter == NULL || queue == NULL )
     {
         return false;
     }
 
-    free_item = queue->head;
+    iter->items = queue->items;
+    iter->mask = queue->capacity - 1;
+    iter->remaining = queue->count;
+    iter->reverse = reverse;
+    iter->pos = queue->head;
+    if( reverse )
+    {
+        iter->pos = ( queue->head + queue->count - 1 ) & iter->mask;
+    }
 
-    if( data != NULL )
+    return true;
+}
+
+/******************************************************************************/
+void* gac_queue_iter_next( gac_queue_iter_t* iter )
+{
+    void* data;
+
+    if( iter == NULL || iter->remaining == 0 )
     {
-        *data = free_item->data;
+        return NULL;
     }
 
-    free_item->data = NULL;
-    if( queue->length == 1 )
+    data = iter->items[iter->pos];
+    if( iter->reverse )
     {
-        queue->head = free_item;
-        queue->tail = free_item;
-        free_item->next = NULL;
-        free_item->prev = NULL;
+        iter->pos = ( iter->pos - 1 ) & iter->mask;
     }
-    else if( queue->count > 1 )
+    else
     {
-        queue->head = queue->head->prev;
-        free_item->next = queue->tail;
-        free_item->prev = queue->tail->prev;
-        if( free_item->prev != NULL )
-        {
-            free_item->prev->next = free_item;
-        }
-        queue->tail->prev = free_item;
+        iter->pos = ( iter->pos + 1 ) & iter->mask;
     }
-    queue->head->next = NULL;
+    iter->remaining--;
+
+    return data;
+}
+
+/******************************************************************************/
+bool gac_queue_pop( gac_queue_t* queue, void** data )
+{
+    if( queue->count == 0 )
+    {
+        return false;
+    }
+
+    if( data != NULL )
+    {
+        *data = queue->items[queue->head];
+    }
+
+    queue->items[queue->head] = NULL;
+    queue->head = ( queue->head + 1 ) & ( queue->capacity - 1 );
     queue->count--;
 
     return true;
@@ -194,8 +223,6 @@ bool gac_queue_pop( gac_queue_t* queue, void** data )
 /******************************************************************************/
 bool gac_queue_push( gac_queue_t* queue, void* data )
 {
-    gac_queue_item_t* item;
-
     if( data == NULL )
     {
         return false;
@@ -203,19 +230,14 @@ bool gac_queue_push( gac_queue_t* queue, void* data )
 
     if( queue->count == queue->length )
     {
-        gac_queue_grow( queue, 1 );
-    }
-    if( queue->count == 0 )
-    {
-        item = queue->tail;
-    }
-    else
-    {
-        item = queue->tail->prev;
+        if( !gac_queue_grow( queue, 1 ) )
+        {
+            return false;
+        }
     }
 
-    item->data = data;
-    queue->tail = item;
+    queue->items[( queue->head + queue->count ) & ( queue->capacity - 1 )] =
+        data;
     queue->count++;
 
     return true;
@@ -0,0 +1,316 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_ring.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+/******************************************************************************/
+uint32_t gac_ring_count( gac_ring_t* ring )
+{
+    uint32_t head;
+    uint32_t tail;
+
+    if( ring == NULL )
+    {
+        return 0;
+    }
+
+    head = atomic_load_explicit( &ring->head, memory_order_acquire );
+    tail = atomic_load_explicit( &ring->tail, memory_order_acquire );
+
+    return tail - head;
+}
+
+/******************************************************************************/
+gac_ring_t* gac_ring_create( uint32_t capacity, gac_ring_wait_mode_t mode )
+{
+    gac_ring_t* ring = malloc( sizeof( gac_ring_t ) );
+
+    if( ring == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_ring_init( ring, capacity, mode ) )
+    {
+        free( ring );
+        return NULL;
+    }
+
+    ring->_me = ring;
+
+    return ring;
+}
+
+/******************************************************************************/
+void gac_ring_destroy( gac_ring_t* ring )
+{
+    if( ring == NULL )
+    {
+        return;
+    }
+
+    if( ring->items != NULL )
+    {
+        free( ring->items );
+        ring->items = NULL;
+        sem_destroy( &ring->signal );
+    }
+
+    if( ring->_me != NULL )
+    {
+        free( ring->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_ring_get_stats( gac_ring_t* ring, gac_ring_stats_t* stats )
+{
+    if( ring == NULL || stats == NULL )
+    {
+        return false;
+    }
+
+    stats->capacity = ring->capacity;
+    stats->count = gac_ring_count( ring );
+    stats->peak_count = atomic_load_explicit( &ring->peak_count,
+            memory_order_relaxed );
+    stats->push_count = atomic_load_explicit( &ring->push_count,
+            memory_order_relaxed );
+    stats->pop_count = atomic_load_explicit( &ring->pop_count,
+            memory_order_relaxed );
+    stats->overflow_count = atomic_load_explicit( &ring->overflow_count,
+            memory_order_relaxed );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_ring_init( gac_ring_t* ring, uint32_t capacity,
+        gac_ring_wait_mode_t mode )
+{
+    uint32_t length = 1;
+
+    if( ring == NULL )
+    {
+        return false;
+    }
+
+    ring->_me = NULL;
+    ring->items = NULL;
+    ring->capacity = 0;
+    ring->mode = mode;
+    atomic_init( &ring->tail, 0 );
+    ring->head_cache = 0;
+    atomic_init( &ring->peak_count, 0 );
+    atomic_init( &ring->push_count, 0 );
+    atomic_init( &ring->overflow_count, 0 );
+    atomic_init( &ring->head, 0 );
+    ring->tail_cache = 0;
+    atomic_init( &ring->pop_count, 0 );
+    atomic_init( &ring->waiting, false );
+
+    if( capacity == 0 || capacity > 0x80000000u )
+    {
+        return false;
+    }
+
+    while( length < capacity )
+    {
+        length *= 2;
+    }
+
+    ring->items = malloc( sizeof( gac_ring_sample_t ) * length );
+    if( ring->items == NULL )
+    {
+        return false;
+    }
+
+    if( sem_init( &ring->signal, 0, 0 ) != 0 )
+    {
+        free( ring->items );
+        ring->items = NULL;
+        return false;
+    }
+
+    ring->capacity = length;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_ring_pop( gac_ring_t* ring, gac_ring_sample_t* sample )
+{
+    uint32_t head;
+
+    if( ring == NULL || sample == NULL )
+    {
+        return false;
+    }
+
+    head = atomic_load_explicit( &ring->head, memory_order_relaxed );
+    if( head == ring->tail_cache )
+    {
+        ring->tail_cache = atomic_load_explicit( &ring->tail,
+                memory_order_acquire );
+        if( head == ring->tail_cache )
+        {
+            return false;
+        }
+    }
+
+    *sample = ring->items[head & ( ring->capacity - 1 )];
+    atomic_store_explicit( &ring->head, head + 1, memory_order_release );
+    atomic_store_explicit( &ring->pop_count,
+            atomic_load_explicit( &ring->pop_count, memory_order_relaxed ) + 1,
+            memory_order_relaxed );
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_ring_push( gac_ring_t* ring, gac_ring_sample_t* sample )
+{
+    uint32_t tail;
+    uint32_t count;
+
+    if( ring == NULL || sample == NULL )
+    {
+        return false;
+    }
+
+    tail = atomic_load_explicit( &ring->tail, memory_order_relaxed );
+    if( tail - ring->head_cache == ring->capacity )
+    {
+        ring->head_cache = atomic_load_explicit( &ring->head,
+                memory_order_acquire );
+        if( tail - ring->head_cache == ring->capacity )
+        {
+            atomic_fetch_add_explicit( &ring->overflow_count, 1,
+                    memory_order_relaxed );
+            return false;
+        }
+    }
+
+    ring->items[tail & ( ring->capacity - 1 )] = *sample;
+    atomic_store_explicit( &ring->tail, tail + 1, memory_order_release );
+
+    count = tail + 1 - ring->head_cache;
+    if( count > atomic_load_explicit( &ring->peak_count,
+                memory_order_relaxed ) )
+    {
+        atomic_store_explicit( &ring->peak_count, count,
+                memory_order_relaxed );
+    }
+    atomic_store_explicit( &ring->push_count,
+            atomic_load_explicit( &ring->push_count, memory_order_relaxed ) + 1,
+            memory_order_relaxed );
+
+    if( ring->mode == GAC_RING_WAIT_BLOCK )
+    {
+        // pairs with the fence in gac_ring_wait(): either the consumer sees
+        // the new tail or the producer sees the waiting flag
+        atomic_thread_fence( memory_order_seq_cst );
+        if( atomic_load_explicit( &ring->waiting, memory_order_relaxed )
+                && atomic_exchange( &ring->waiting, false ) )
+        {
+            sem_post( &ring->signal );
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_ring_wait( gac_ring_t* ring, uint32_t timeout )
+{
+    int res;
+    uint32_t i;
+    struct timespec now;
+    struct timespec deadline;
+
+    if( ring == NULL )
+    {
+        return false;
+    }
+
+    if( gac_ring_count( ring ) > 0 || ring->mode == GAC_RING_WAIT_NONE )
+    {
+        return gac_ring_count( ring ) > 0;
+    }
+
+    clock_gettime( CLOCK_REALTIME, &now );
+    deadline.tv_sec = now.tv_sec + timeout / 1000;
+    deadline.tv_nsec = now.tv_nsec + ( timeout % 1000 ) * 1000000L;
+    if( deadline.tv_nsec >= 1000000000L )
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    if( ring->mode == GAC_RING_WAIT_SPIN )
+    {
+        while( gac_ring_count( ring ) == 0 )
+        {
+            for( i = 0; i < GAC_RING_SPIN_COUNT
+                    && gac_ring_count( ring ) == 0; i++ );
+            if( gac_ring_count( ring ) > 0 )
+            {
+                break;
+            }
+            sched_yield();
+            if( timeout > 0 )
+            {
+                clock_gettime( CLOCK_REALTIME, &now );
+                if( now.tv_sec > deadline.tv_sec
+                        || ( now.tv_sec == deadline.tv_sec
+                            && now.tv_nsec >= deadline.tv_nsec ) )
+                {
+                    break;
+                }
+            }
+        }
+        return gac_ring_count( ring ) > 0;
+    }
+
+    atomic_store_explicit( &ring->waiting, true, memory_order_relaxed );
+    atomic_thread_fence( memory_order_seq_cst );
+    if( gac_ring_count( ring ) == 0 )
+    {
+        do
+        {
+            if( timeout > 0 )
+            {
+                res = sem_timedwait( &ring->signal, &deadline );
+            }
+            else
+            {
+                res = sem_wait( &ring->signal );
+            }
+        }
+        while( res != 0 && errno == EINTR );
+
+        if( res == 0 )
+        {
+            // the producer cleared the waiting flag
+            return gac_ring_count( ring ) > 0;
+        }
+    }
+
+    if( !atomic_exchange( &ring->waiting, false ) )
+    {
+        // the producer cleared the flag and posts the signal, consume it to
+        // keep the semaphore balanced
+        while( sem_wait( &ring->signal ) != 0 && errno == EINTR );
+    }
+
+    return gac_ring_count( ring ) > 0;
+}
@@ -7,8 +7,9 @@
  */
 
 #include "gac_sample.h"
+#include "gac_sample_pool.h"
+#include <math.h>
 #include <stdlib.h>
-#include <string.h>
 
 /******************************************************************************/
 gac_sample_t* gac_sample_copy( gac_sample_t* sample )
@@ -21,7 +22,8 @@ gac_sample_t* gac_sample_copy( gac_sample_t* sample )
     }
 
     new_sample = gac_sample_create( &sample->screen_point, &sample->origin,
-            &sample->point, sample->timestamp, sample->trial_id, sample->label );
+            &sample->point, sample->timestamp, sample->trial_id,
+            sample->label_id );
 
     new_sample->label_onset = sample->label_onset;
     new_sample->trial_onset = sample->trial_onset;
@@ -39,7 +41,8 @@ bool gac_sample_copy_to( gac_sample_t* dest, gac_sample_t* sample )
     }
 
     res = gac_sample_init( dest, &sample->screen_point, &sample->origin,
-            &sample->point, sample->timestamp, sample->trial_id, sample->label );
+            &sample->point, sample->timestamp, sample->trial_id,
+            sample->label_id );
 
     dest->label_onset = sample->label_onset;
     dest->trial_onset = sample->trial_onset;
@@ -49,11 +52,11 @@ bool gac_sample_copy_to( gac_sample_t* dest, gac_sample_t* sample )
 
 /******************************************************************************/
 gac_sample_t* gac_sample_create( vec2* screen_point, vec3* origin, vec3* point,
-        double timestamp, uint32_t trial_id, const char* label )
+        double timestamp, uint32_t trial_id, uint32_t label_id )
 {
     gac_sample_t* sample = malloc( sizeof( gac_sample_t ) );
     if( !gac_sample_init( sample, screen_point, origin, point, timestamp,
-                trial_id, label ) )
+                trial_id, label_id ) )
     {
         return NULL;
     }
@@ -62,6 +65,37 @@ gac_sample_t* gac_sample_create( vec2* screen_point, vec3* origin, vec3* point,
     return sample;
 }
 
+/******************************************************************************/
+gac_sample_t* gac_sample_create_pooled( gac_sample_pool_t* pool,
+        vec2* screen_point, vec3* origin, vec3* point, double timestamp,
+        uint32_t trial_id, uint32_t label_id )
+{
+    gac_sample_t* sample;
+
+    if( pool == NULL )
+    {
+        return gac_sample_create( screen_point, origin, point, timestamp,
+                trial_id, label_id );
+    }
+
+    sample = gac_sample_pool_acquire( pool );
+    if( sample == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_sample_init( sample, screen_point, origin, point, timestamp,
+                trial_id, label_id ) )
+    {
+        sample->pool = pool;
+        gac_sample_pool_release( pool, sample );
+        return NULL;
+    }
+    sample->pool = pool;
+
+    return sample;
+}
+
 /******************************************************************************/
 void gac_sample_destroy( void* data )
 {
@@ -72,7 +106,11 @@ void gac_sample_destroy( void* data )
         return;
     }
 
-    if( sample->_me != NULL )
+    if( sample->pool != NULL )
+    {
+        gac_sample_pool_release( sample->pool, sample );
+    }
+    else if( sample->_me != NULL )
     {
         free( sample->_me );
     }
@@ -103,7 +141,7 @@ double gac_sample_get_trial_timestamp( gac_sample_t* sample )
 
 /******************************************************************************/
 bool gac_sample_init( gac_sample_t* sample, vec2* screen_point, vec3* origin,
-        vec3* point, double timestamp, uint32_t trial_id, const char* label )
+        vec3* point, double timestamp, uint32_t trial_id, uint32_t label_id )
 {
     if( sample == NULL || screen_point == NULL || origin == NULL
             || point == NULL )
@@ -112,11 +150,8 @@ bool gac_sample_init( gac_sample_t* sample, vec2* screen_point, vec3* origin,
     }
 
     sample->_me = NULL;
-    memset( sample->label, '\0', sizeof( sample->label ) );
-    if( label != NULL )
-    {
-        strncpy( sample->label, label, GAC_SAMPLE_MAX_LABEL_LEN - 1 );
-    }
+    sample->pool = NULL;
+    sample->label_id = label_id;
     glm_vec2_copy( *screen_point, sample->screen_point );
     glm_vec3_copy( *origin, sample->origin );
     glm_vec3_copy( *point, sample->point );
@@ -129,78 +164,189 @@ bool gac_sample_init( gac_sample_t* sample, vec2* screen_point, vec3* origin,
 }
 
 /******************************************************************************/
-bool gac_samples_average_point( gac_queue_t* samples, vec3* avg,
-        uint32_t count )
+bool gac_sample_is_finite( gac_sample_t* sample )
 {
-    uint32_t i = 0;
-    gac_sample_t* sample;
-    gac_queue_item_t* item = samples->tail;
+    return isfinite( sample->screen_point[0] )
+        && isfinite( sample->screen_point[1] )
+        && isfinite( sample->point[0] )
+        && isfinite( sample->point[1] )
+        && isfinite( sample->point[2] )
+        && isfinite( sample->origin[0] )
+        && isfinite( sample->origin[1] )
+        && isfinite( sample->origin[2] );
+}
 
-    if( avg == NULL || samples->count == 0 )
+/******************************************************************************/
+bool gac_sample_sum_add( gac_sample_sum_t* sum, gac_sample_t* sample )
+{
+    if( sum == NULL || sample == NULL )
     {
         return false;
     }
 
-    glm_vec3_zero( *avg );
+    sum->count++;
+    if( !gac_sample_is_finite( sample ) )
+    {
+        sum->invalid++;
+        return true;
+    }
+
+    sum->screen_point[0] += sample->screen_point[0];
+    sum->screen_point[1] += sample->screen_point[1];
+    sum->point[0] += sample->point[0];
+    sum->point[1] += sample->point[1];
+    sum->point[2] += sample->point[2];
+    sum->origin[0] += sample->origin[0];
+    sum->origin[1] += sample->origin[1];
+    sum->origin[2] += sample->origin[2];
 
-    while( item != NULL )
+    return true;
+}
+
+/******************************************************************************/
+bool gac_sample_sum_average( gac_sample_sum_t* sum, vec2* screen_point,
+        vec3* origin, vec3* point )
+{
+    if( sum == NULL || sum->count == 0 || sum->invalid > 0 )
     {
-        sample = item->data;
-        glm_vec3_add( *avg, sample->point, *avg );
-        item = item->next;
+        return false;
+    }
 
-        i++;
-        if( i == count )
-        {
-            goto success;
-        }
+    if( screen_point != NULL )
+    {
+        ( *screen_point )[0] = sum->screen_point[0] / sum->count;
+        ( *screen_point )[1] = sum->screen_point[1] / sum->count;
     }
+    if( origin != NULL )
+    {
+        ( *origin )[0] = sum->origin[0] / sum->count;
+        ( *origin )[1] = sum->origin[1] / sum->count;
+        ( *origin )[2] = sum->origin[2] / sum->count;
+    }
+    if( point != NULL )
+    {
+        ( *point )[0] = sum->point[0] / sum->count;
+        ( *point )[1] = sum->point[1] / sum->count;
+        ( *point )[2] = sum->point[2] / sum->count;
+    }
+
+    return true;
+}
 
-    if( count > 0 && i < count )
+/******************************************************************************/
+bool gac_sample_sum_clear( gac_sample_sum_t* sum )
+{
+    if( sum == NULL )
     {
         return false;
     }
 
-success:
-    glm_vec3_divs( *avg, samples->count, *avg );
+    sum->count = 0;
+    sum->invalid = 0;
+    sum->screen_point[0] = 0;
+    sum->screen_point[1] = 0;
+    sum->point[0] = 0;
+    sum->point[1] = 0;
+    sum->point[2] = 0;
+    sum->origin[0] = 0;
+    sum->origin[1] = 0;
+    sum->origin[2] = 0;
+
     return true;
 }
 
 /******************************************************************************/
-bool gac_samples_average_origin( gac_queue_t* samples, vec3* avg,
+bool gac_sample_sum_sub( gac_sample_sum_t* sum, gac_sample_t* sample )
+{
+    if( sum == NULL || sample == NULL || sum->count == 0 )
+    {
+        return false;
+    }
+
+    if( sum->count == 1 )
+    {
+        // reset instead of subtracting to discard accumulated rounding errors
+        return gac_sample_sum_clear( sum );
+    }
+
+    sum->count--;
+    if( !gac_sample_is_finite( sample ) )
+    {
+        sum->invalid--;
+        return true;
+    }
+
+    sum->screen_point[0] -= sample->screen_point[0];
+    sum->screen_point[1] -= sample->screen_point[1];
+    sum->point[0] -= sample->point[0];
+    sum->point[1] -= sample->point[1];
+    sum->point[2] -= sample->point[2];
+    sum->origin[0] -= sample->origin[0];
+    sum->origin[1] -= sample->origin[1];
+    sum->origin[2] -= sample->origin[2];
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_samples_average_point( gac_queue_t* samples, vec3* avg,
         uint32_t count )
 {
-    uint32_t i = 0;
+    uint32_t i;
     gac_sample_t* sample;
-    gac_queue_item_t* item = samples->tail;
+    gac_queue_iter_t iter;
 
-    if( avg == NULL || samples->count == 0 )
+    if( count == 0 )
+    {
+        count = samples->count;
+    }
+
+    if( avg == NULL || samples->count == 0 || count > samples->count )
     {
         return false;
     }
 
     glm_vec3_zero( *avg );
 
-    while( item != NULL )
+    gac_queue_iter_init( &iter, samples, true );
+    for( i = 0; i < count; i++ )
     {
-        sample = item->data;
-        glm_vec3_add( *avg, sample->origin, *avg );
-        item = item->next;
+        sample = gac_queue_iter_next( &iter );
+        glm_vec3_add( *avg, sample->point, *avg );
+    }
 
-        i++;
-        if( i == count )
-        {
-            goto success;
-        }
+    glm_vec3_divs( *avg, count, *avg );
+    return true;
+}
+
+/******************************************************************************/
+bool gac_samples_average_origin( gac_queue_t* samples, vec3* avg,
+        uint32_t count )
+{
+    uint32_t i;
+    gac_sample_t* sample;
+    gac_queue_iter_t iter;
+
+    if( count == 0 )
+    {
+        count = samples->count;
     }
 
-    if( count > 0 && i < count )
+    if( avg == NULL || samples->count == 0 || count > samples->count )
     {
         return false;
     }
 
-success:
-    glm_vec3_divs( *avg, samples->count, *avg );
+    glm_vec3_zero( *avg );
+
+    gac_queue_iter_init( &iter, samples, true );
+    for( i = 0; i < count; i++ )
+    {
+        sample = gac_queue_iter_next( &iter );
+        glm_vec3_add( *avg, sample->origin, *avg );
+    }
+
+    glm_vec3_divs( *avg, count, *avg );
     return true;
 }
 
@@ -208,37 +354,30 @@ success:
 bool gac_samples_average_screen_point( gac_queue_t* samples, vec2* avg,
         uint32_t count )
 {
-    uint32_t i = 0;
+    uint32_t i;
     gac_sample_t* sample;
-    gac_queue_item_t* item = samples->tail;
+    gac_queue_iter_t iter;
+
+    if( count == 0 )
+    {
+        count = samples->count;
+    }
 
-    if( avg == NULL || samples->count == 0 )
+    if( avg == NULL || samples->count == 0 || count > samples->count )
     {
         return false;
     }
 
     glm_vec2_zero( *avg );
 
-    while( item != NULL )
+    gac_queue_iter_init( &iter, samples, true );
+    for( i = 0; i < count; i++ )
     {
-        sample = item->data;
+        sample = gac_queue_iter_next( &iter );
         glm_vec2_add( *avg, sample->screen_point, *avg );
-        item = item->next;
-
-        i++;
-        if( i == count )
-        {
-            goto success;
-        }
     }
 
-    if( count > 0 && i < count )
-    {
-        return false;
-    }
-
-success:
-    glm_vec2_divs( *avg, samples->count, *avg );
+    glm_vec2_divs( *avg, count, *avg );
     return true;
 }
 
@@ -246,28 +385,32 @@ success:
 bool gac_samples_dispersion( gac_queue_t* samples, float* dispersion,
         uint32_t count )
 {
-    uint32_t i = 0;
+    uint32_t i;
     gac_sample_t* sample;
-    gac_queue_item_t* item = samples->tail;
-    bool is_first = true;
+    gac_queue_iter_t iter;
     vec3 max;
     vec3 min;
     glm_vec3_zero( min );
     glm_vec3_zero( max );
 
-    if( dispersion == NULL )
+    if( count == 0 )
+    {
+        count = samples->count;
+    }
+
+    if( dispersion == NULL || count > samples->count )
     {
         return false;
     }
 
-    while( item != NULL )
+    gac_queue_iter_init( &iter, samples, true );
+    for( i = 0; i < count; i++ )
     {
-        sample = item->data;
-        if( is_first )
+        sample = gac_queue_iter_next( &iter );
+        if( i == 0 )
         {
             glm_vec3_copy( sample->point, max );
             glm_vec3_copy( sample->point, min );
-            is_first = false;
         }
         else
         {
@@ -296,21 +439,8 @@ bool gac_samples_dispersion( gac_queue_t* samples, float* dispersion,
                 min[2] = sample->point[2];
             }
         }
-        item = item->next;
-
-        i++;
-        if( i == count )
-        {
-            goto success;
-        }
-    }
-
-    if( count > 0 && i < count )
-    {
-        return false;
     }
 
-success:
     *dispersion = sqrt(
             ( max[0] - min[0] ) * ( max[0] - min[0] )
             + ( max[1] - min[1] ) * ( max[1] - min[1] )
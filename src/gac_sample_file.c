@@ -0,0 +1,545 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_sample_file.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** The size of a block of a given sample count in bytes. */
+#define GAC_SAMPLE_FILE_BLOCK_SIZE( count ) \
+    ( sizeof( gac_sample_file_block_t ) \
+      + ( ( ( uint64_t )( count ) * ( GAC_SAMPLE_FILE_COLUMN_COUNT + 1 ) \
+              * 4 + 7 ) & ~( uint64_t )7 ) )
+
+/******************************************************************************/
+bool gac_sample_file_convert( gac_csv_reader_t* reader, FILE* fp,
+        uint32_t ticks_per_ms )
+{
+    uint32_t i;
+    uint32_t length;
+    uint32_t trial_id;
+    uint32_t label_id;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t padding = 0;
+    int64_t ticks;
+    int64_t prev_ticks = 0;
+    double value;
+    bool res = false;
+    const char* label;
+    const float* columns[GAC_SAMPLE_FILE_COLUMN_COUNT];
+    float* zeros = NULL;
+    int32_t* deltas = NULL;
+    void* items;
+    gac_sample_batch_t batch;
+    gac_sample_file_header_t header;
+    gac_sample_file_block_t block;
+    struct {
+        gac_sample_file_segment_t* items;
+        uint64_t count;
+        uint64_t length;
+    } segments = { NULL, 0, 0 };
+
+    if( reader == NULL || fp == NULL )
+    {
+        return false;
+    }
+
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, GAC_SAMPLE_FILE_MAGIC,
+            sizeof( GAC_SAMPLE_FILE_MAGIC ) );
+    header.version = GAC_SAMPLE_FILE_VERSION;
+    header.byte_order = GAC_SAMPLE_FILE_BYTE_ORDER;
+    header.block_length = reader->samples.length;
+    header.ticks_per_ms = ticks_per_ms == 0 ? GAC_SAMPLE_FILE_TICKS_PER_MS
+        : ticks_per_ms;
+    if( reader->columns[GAC_CSV_FIELD_SCREEN_X] != GAC_CSV_COLUMN_NONE
+            && reader->columns[GAC_CSV_FIELD_SCREEN_Y] != GAC_CSV_COLUMN_NONE )
+    {
+        header.flags |= GAC_SAMPLE_FILE_FLAG_SCREEN;
+    }
+
+    // the header is written again once all offsets are known
+    zeros = calloc( header.block_length, sizeof( float ) );
+    deltas = malloc( sizeof( int32_t ) * header.block_length );
+    if( zeros == NULL || deltas == NULL
+            || fwrite( &header, sizeof( header ), 1, fp ) != 1 )
+    {
+        goto convert_end;
+    }
+    offset = sizeof( header );
+
+    while( gac_csv_reader_read( reader, &batch ) )
+    {
+        for( i = 0; i < batch.count; i++ )
+        {
+            value = batch.timestamp[i] * header.ticks_per_ms;
+            if( !( value > -9e18 && value < 9e18 ) )
+            {
+                goto convert_end;
+            }
+            ticks = llround( value );
+            if( i == 0 )
+            {
+                block.ticks = ticks;
+            }
+            else if( ticks - prev_ticks > INT32_MAX
+                    || ticks - prev_ticks < INT32_MIN )
+            {
+                goto convert_end;
+            }
+            deltas[i] = i == 0 ? 0 : ticks - prev_ticks;
+            prev_ticks = ticks;
+
+            // a new segment starts whenever the trial or the label changes
+            trial_id = batch.trial_id == NULL ? 0 : batch.trial_id[i];
+            label_id = batch.label_id == NULL ? GAC_LABEL_ID_NONE
+                : batch.label_id[i];
+            if( segments.count == 0
+                    || segments.items[segments.count - 1].trial_id != trial_id
+                    || segments.items[segments.count - 1].label_id
+                        != label_id )
+            {
+                if( segments.count == segments.length )
+                {
+                    length = segments.length == 0 ? 16 : segments.length * 2;
+                    items = realloc( segments.items,
+                            sizeof( gac_sample_file_segment_t ) * length );
+                    if( items == NULL )
+                    {
+                        goto convert_end;
+                    }
+                    segments.items = items;
+                    segments.length = length;
+                }
+                segments.items[segments.count].first =
+                    header.sample_count + i;
+                segments.items[segments.count].trial_id = trial_id;
+                segments.items[segments.count].label_id = label_id;
+                segments.count++;
+            }
+        }
+
+        block.count = batch.count;
+        block.reserved = 0;
+        columns[0] = batch.screen_x == NULL ? zeros : batch.screen_x;
+        columns[1] = batch.screen_y == NULL ? zeros : batch.screen_y;
+        columns[2] = batch.point_x;
+        columns[3] = batch.point_y;
+        columns[4] = batch.point_z;
+        columns[5] = batch.origin_x;
+        columns[6] = batch.origin_y;
+        columns[7] = batch.origin_z;
+        if( fwrite( &block, sizeof( block ), 1, fp ) != 1 )
+        {
+            goto convert_end;
+        }
+        for( i = 0; i < GAC_SAMPLE_FILE_COLUMN_COUNT; i++ )
+        {
+            if( fwrite( columns[i], sizeof( float ), batch.count, fp )
+                    != batch.count )
+            {
+                goto convert_end;
+            }
+        }
+        size = GAC_SAMPLE_FILE_BLOCK_SIZE( batch.count ) - sizeof( block )
+            - ( uint64_t )batch.count * ( GAC_SAMPLE_FILE_COLUMN_COUNT + 1 )
+            * 4;
+        if( fwrite( deltas, sizeof( int32_t ), batch.count, fp )
+                    != batch.count
+                || fwrite( &padding, 1, size, fp ) != size )
+        {
+            goto convert_end;
+        }
+        offset += GAC_SAMPLE_FILE_BLOCK_SIZE( batch.count );
+        header.sample_count += batch.count;
+    }
+    // a failed read must not be taken for the end of the file
+    if( reader->is_error )
+    {
+        goto convert_end;
+    }
+
+    header.segment_offset = offset;
+    header.segment_count = segments.count;
+    if( fwrite( segments.items, sizeof( gac_sample_file_segment_t ),
+                segments.count, fp ) != segments.count )
+    {
+        goto convert_end;
+    }
+    offset += sizeof( gac_sample_file_segment_t ) * segments.count;
+
+    // the label strings are stored in the order of their IDs
+    header.label_offset = offset;
+    if( reader->labels != NULL )
+    {
+        for( i = 1; i < reader->labels->labels.count; i++ )
+        {
+            label = gac_label_table_get( reader->labels, i );
+            length = strlen( label ) + 1;
+            if( fwrite( label, 1, length, fp ) != length )
+            {
+                goto convert_end;
+            }
+            header.label_size += length;
+            header.label_count++;
+        }
+    }
+
+    if( fseek( fp, 0, SEEK_SET ) != 0
+            || fwrite( &header, sizeof( header ), 1, fp ) != 1
+            || fseek( fp, 0, SEEK_END ) != 0 || fflush( fp ) != 0 )
+    {
+        goto convert_end;
+    }
+    res = true;
+
+convert_end:
+    free( zeros );
+    free( deltas );
+    free( segments.items );
+
+    return res;
+}
+
+/******************************************************************************/
+gac_sample_file_t* gac_sample_file_create( FILE* fp,
+        gac_label_table_t* labels )
+{
+    gac_sample_file_t* file = malloc( sizeof( gac_sample_file_t ) );
+
+    if( file == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_sample_file_init( file, fp, labels ) )
+    {
+        gac_sample_file_destroy( file );
+        free( file );
+        return NULL;
+    }
+
+    file->_me = file;
+
+    return file;
+}
+
+/******************************************************************************/
+void gac_sample_file_destroy( gac_sample_file_t* file )
+{
+    if( file == NULL )
+    {
+        return;
+    }
+
+    if( file->data != NULL )
+    {
+        munmap( ( void* )file->data, file->size );
+    }
+    free( file->label_ids );
+    free( file->samples.timestamp );
+    free( file->samples.trial_id );
+    free( file->samples.label_id );
+    file->data = NULL;
+    file->header = NULL;
+    file->segments = NULL;
+    file->label_ids = NULL;
+    file->samples.timestamp = NULL;
+    file->samples.trial_id = NULL;
+    file->samples.label_id = NULL;
+
+    if( file->_me != NULL )
+    {
+        free( file->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_sample_file_init( gac_sample_file_t* file, FILE* fp,
+        gac_label_table_t* labels )
+{
+    uint64_t i;
+    uint64_t block_count;
+    uint64_t end;
+    uint32_t id;
+    struct stat st;
+    void* data;
+    const char* label;
+    const char* label_end;
+    const gac_sample_file_header_t* header;
+
+    if( file == NULL )
+    {
+        return false;
+    }
+
+    file->_me = NULL;
+    file->data = NULL;
+    file->size = 0;
+    file->header = NULL;
+    file->segments = NULL;
+    file->block_size = 0;
+    file->pos = 0;
+    file->segment_idx = 0;
+    file->label_ids = NULL;
+    file->samples.timestamp = NULL;
+    file->samples.trial_id = NULL;
+    file->samples.label_id = NULL;
+
+    if( fp == NULL || fstat( fileno( fp ), &st ) != 0
+            || st.st_size < ( off_t )sizeof( gac_sample_file_header_t ) )
+    {
+        return false;
+    }
+    data = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno( fp ), 0 );
+    if( data == MAP_FAILED )
+    {
+        return false;
+    }
+    file->data = data;
+    file->size = st.st_size;
+    header = data;
+    file->header = header;
+
+    // validate the layout such that reading never leaves the mapping
+    if( memcmp( header->magic, GAC_SAMPLE_FILE_MAGIC,
+                sizeof( GAC_SAMPLE_FILE_MAGIC ) ) != 0
+            || header->version != GAC_SAMPLE_FILE_VERSION
+            || header->byte_order != GAC_SAMPLE_FILE_BYTE_ORDER
+            || header->block_length == 0 || header->ticks_per_ms == 0
+            || header->sample_count > file->size
+            || header->segment_offset > file->size
+            || header->segment_offset % 8 != 0
+            || header->segment_count > ( file->size - header->segment_offset )
+                / sizeof( gac_sample_file_segment_t )
+            || header->label_offset > file->size
+            || header->label_size > file->size - header->label_offset
+            || ( header->sample_count > 0 && header->segment_count == 0 ) )
+    {
+        return false;
+    }
+    file->block_size = GAC_SAMPLE_FILE_BLOCK_SIZE( header->block_length );
+    block_count = ( header->sample_count + header->block_length - 1 )
+        / header->block_length;
+    end = sizeof( gac_sample_file_header_t );
+    if( block_count > 0 )
+    {
+        end += ( block_count - 1 ) * file->block_size
+            + GAC_SAMPLE_FILE_BLOCK_SIZE( header->sample_count
+                    - ( block_count - 1 ) * header->block_length );
+    }
+    if( end > header->segment_offset )
+    {
+        return false;
+    }
+
+    file->segments = ( const gac_sample_file_segment_t* )(
+            file->data + header->segment_offset );
+    for( i = 0; i < header->segment_count; i++ )
+    {
+        if( file->segments[i].label_id > header->label_count
+                || file->segments[i].first >= header->sample_count
+                || ( i == 0 && file->segments[i].first != 0 )
+                || ( i > 0 && file->segments[i].first
+                    <= file->segments[i - 1].first ) )
+        {
+            return false;
+        }
+    }
+
+    // map the label IDs of the file to the label table of the reader
+    file->label_ids = malloc( sizeof( uint32_t )
+            * ( ( uint64_t )header->label_count + 1 ) );
+    if( file->label_ids == NULL )
+    {
+        return false;
+    }
+    file->label_ids[0] = GAC_LABEL_ID_NONE;
+    label = ( const char* )file->data + header->label_offset;
+    label_end = label + header->label_size;
+    for( id = 1; id <= header->label_count; id++ )
+    {
+        if( label == label_end )
+        {
+            return false;
+        }
+        file->label_ids[id] = GAC_LABEL_ID_NONE;
+        if( labels != NULL && !gac_label_table_intern( labels, label,
+                    &file->label_ids[id] ) )
+        {
+            return false;
+        }
+        label = memchr( label, '\0', label_end - label );
+        if( label == NULL )
+        {
+            return false;
+        }
+        label++;
+    }
+
+    file->samples.timestamp = malloc( sizeof( double )
+            * header->block_length );
+    file->samples.trial_id = malloc( sizeof( uint32_t )
+            * header->block_length );
+    file->samples.label_id = malloc( sizeof( uint32_t )
+            * header->block_length );
+    if( file->samples.timestamp == NULL || file->samples.trial_id == NULL
+            || file->samples.label_id == NULL )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_sample_file_read( gac_sample_file_t* file,
+        gac_sample_batch_t* batch )
+{
+    uint32_t i;
+    uint32_t count;
+    uint32_t start;
+    uint64_t block_idx;
+    int64_t ticks;
+    const gac_sample_file_header_t* header;
+    const gac_sample_file_block_t* block;
+    const gac_sample_file_segment_t* segment;
+    const float* columns;
+    const int32_t* deltas;
+
+    if( file == NULL || batch == NULL )
+    {
+        return false;
+    }
+
+    batch->count = 0;
+    header = file->header;
+    if( file->pos >= header->sample_count )
+    {
+        return false;
+    }
+
+    block_idx = file->pos / header->block_length;
+    start = file->pos % header->block_length;
+    count = header->sample_count - block_idx * header->block_length;
+    if( count > header->block_length )
+    {
+        count = header->block_length;
+    }
+    block = ( const gac_sample_file_block_t* )( file->data
+            + sizeof( gac_sample_file_header_t )
+            + block_idx * file->block_size );
+    if( block->count != count )
+    {
+        return false;
+    }
+    columns = ( const float* )( block + 1 );
+    deltas = ( const int32_t* )( columns
+            + ( uint64_t )GAC_SAMPLE_FILE_COLUMN_COUNT * count );
+
+    // decode the timestamps and expand the segments of the batch samples
+    ticks = block->ticks;
+    for( i = 0; i < start; i++ )
+    {
+        ticks += deltas[i];
+    }
+    for( i = 0; i < count - start; i++ )
+    {
+        ticks += deltas[start + i];
+        file->samples.timestamp[i] = ( double )ticks / header->ticks_per_ms;
+        while( file->segment_idx + 1 < header->segment_count
+                && file->segments[file->segment_idx + 1].first
+                    <= file->pos + i )
+        {
+            file->segment_idx++;
+        }
+        segment = &file->segments[file->segment_idx];
+        file->samples.trial_id[i] = segment->trial_id;
+        file->samples.label_id[i] = file->label_ids[segment->label_id];
+    }
+
+    batch->count = count - start;
+    batch->screen_x = NULL;
+    batch->screen_y = NULL;
+    if( header->flags & GAC_SAMPLE_FILE_FLAG_SCREEN )
+    {
+        batch->screen_x = &columns[start];
+        batch->screen_y = &columns[count + start];
+    }
+    batch->point_x = &columns[2 * count + start];
+    batch->point_y = &columns[3 * count + start];
+    batch->point_z = &columns[4 * count + start];
+    batch->origin_x = &columns[5 * count + start];
+    batch->origin_y = &columns[6 * count + start];
+    batch->origin_z = &columns[7 * count + start];
+    batch->timestamp = file->samples.timestamp;
+    batch->trial_id = file->samples.trial_id;
+    batch->label_id = file->samples.label_id;
+    file->pos += batch->count;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_sample_file_seek( gac_sample_file_t* file, uint64_t pos )
+{
+    uint64_t low;
+    uint64_t high;
+    uint64_t mid;
+
+    if( file == NULL || pos > file->header->sample_count )
+    {
+        return false;
+    }
+
+    // find the last segment starting at or before the position
+    low = 0;
+    high = file->header->segment_count;
+    while( high - low > 1 )
+    {
+        mid = low + ( high - low ) / 2;
+        if( file->segments[mid].first <= pos )
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    file->segment_idx = low;
+    file->pos = pos;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_sample_file_seek_trial( gac_sample_file_t* file,
+        uint32_t trial_id )
+{
+    uint64_t i;
+
+    if( file == NULL )
+    {
+        return false;
+    }
+
+    for( i = 0; i < file->header->segment_count; i++ )
+    {
+        if( file->segments[i].trial_id == trial_id )
+        {
+            return gac_sample_file_seek( file, file->segments[i].first );
+        }
+    }
+
+    return false;
+}
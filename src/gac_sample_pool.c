@@ -0,0 +1,191 @@
+/**
+ * @author  Simon Maurer
+ * @license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "gac_sample_pool.h"
+#include <stdlib.h>
+
+/******************************************************************************/
+gac_sample_t* gac_sample_pool_acquire( gac_sample_pool_t* pool )
+{
+    uint32_t i;
+    uint32_t length;
+    gac_sample_t* slab;
+    gac_sample_t* sample;
+    void* items;
+
+    if( pool == NULL )
+    {
+        return NULL;
+    }
+
+    if( pool->free.count == 0 )
+    {
+        if( pool->slabs.count == pool->slabs.length )
+        {
+            length = pool->slabs.length == 0 ? 4 : pool->slabs.length * 2;
+            items = realloc( pool->slabs.items,
+                    sizeof( gac_sample_t* ) * length );
+            if( items == NULL )
+            {
+                return NULL;
+            }
+            pool->slabs.items = items;
+            pool->slabs.length = length;
+        }
+
+        length = pool->stats.capacity + pool->slab_size;
+        if( length > pool->free.length )
+        {
+            items = realloc( pool->free.items,
+                    sizeof( gac_sample_t* ) * length );
+            if( items == NULL )
+            {
+                return NULL;
+            }
+            pool->free.items = items;
+            pool->free.length = length;
+        }
+
+        slab = malloc( sizeof( gac_sample_t ) * pool->slab_size );
+        if( slab == NULL )
+        {
+            return NULL;
+        }
+        pool->slabs.items[pool->slabs.count] = slab;
+        pool->slabs.count++;
+        pool->stats.slab_count++;
+        pool->stats.capacity += pool->slab_size;
+
+        // push in reverse order to hand out samples in memory order
+        for( i = pool->slab_size; i > 0; i-- )
+        {
+            pool->free.items[pool->free.count] = &slab[i - 1];
+            pool->free.count++;
+        }
+    }
+
+    pool->free.count--;
+    sample = pool->free.items[pool->free.count];
+    sample->_me = NULL;
+    sample->pool = pool;
+
+    pool->stats.in_use++;
+    pool->stats.acquire_count++;
+    if( pool->stats.in_use > pool->stats.peak_in_use )
+    {
+        pool->stats.peak_in_use = pool->stats.in_use;
+    }
+
+    return sample;
+}
+
+/******************************************************************************/
+gac_sample_pool_t* gac_sample_pool_create( uint32_t slab_size )
+{
+    gac_sample_pool_t* pool = malloc( sizeof( gac_sample_pool_t ) );
+
+    if( pool == NULL )
+    {
+        return NULL;
+    }
+
+    if( !gac_sample_pool_init( pool, slab_size ) )
+    {
+        gac_sample_pool_destroy( pool );
+        return NULL;
+    }
+
+    pool->_me = pool;
+
+    return pool;
+}
+
+/******************************************************************************/
+void gac_sample_pool_destroy( gac_sample_pool_t* pool )
+{
+    uint32_t i;
+
+    if( pool == NULL )
+    {
+        return;
+    }
+
+    for( i = 0; i < pool->slabs.count; i++ )
+    {
+        free( pool->slabs.items[i] );
+    }
+    free( pool->slabs.items );
+    free( pool->free.items );
+    pool->slabs.items = NULL;
+    pool->slabs.count = 0;
+    pool->free.items = NULL;
+    pool->free.count = 0;
+
+    if( pool->_me != NULL )
+    {
+        free( pool->_me );
+    }
+}
+
+/******************************************************************************/
+bool gac_sample_pool_get_stats( gac_sample_pool_t* pool,
+        gac_sample_pool_stats_t* stats )
+{
+    if( pool == NULL || stats == NULL )
+    {
+        return false;
+    }
+
+    *stats = pool->stats;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_sample_pool_init( gac_sample_pool_t* pool, uint32_t slab_size )
+{
+    if( pool == NULL )
+    {
+        return false;
+    }
+
+    pool->_me = NULL;
+    pool->slab_size = slab_size == 0 ? GAC_SAMPLE_POOL_SLAB_SIZE : slab_size;
+    pool->slabs.items = NULL;
+    pool->slabs.count = 0;
+    pool->slabs.length = 0;
+    pool->free.items = NULL;
+    pool->free.count = 0;
+    pool->free.length = 0;
+    pool->stats.capacity = 0;
+    pool->stats.in_use = 0;
+    pool->stats.peak_in_use = 0;
+    pool->stats.slab_count = 0;
+    pool->stats.acquire_count = 0;
+    pool->stats.release_count = 0;
+
+    return true;
+}
+
+/******************************************************************************/
+bool gac_sample_pool_release( gac_sample_pool_t* pool, gac_sample_t* sample )
+{
+    if( pool == NULL || sample == NULL || sample->pool != pool
+            || pool->free.count == pool->free.length )
+    {
+        return false;
+    }
+
+    sample->pool = NULL;
+    pool->free.items[pool->free.count] = sample;
+    pool->free.count++;
+    pool->stats.in_use--;
+    pool->stats.release_count++;
+
+    return true;
+}
@@ -17,6 +17,7 @@ LINK_DIR = -L$(LIBDIR)
 
 LINK_FILE = -lrt \
 			-lm \
+			-lpthread \
 			-lgac
 
 CFLAGS = -Wall
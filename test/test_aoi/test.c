@@ -0,0 +1,422 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define CIRCLE_POINT_COUNT 64
+#define CIRCLE_RADIUS 0.2
+#define QUERY_COUNT 5000
+
+static gac_aoi_t aoi;
+
+float rand_unit()
+{
+    return ( float )rand() / RAND_MAX;
+}
+
+void aoi_setup()
+{
+    srand( 42 );
+    gac_aoi_init( &aoi, "aoi" );
+}
+
+void aoi_teardown()
+{
+    gac_aoi_destroy( &aoi );
+}
+
+void aoi_add_circle( gac_aoi_t* aoi, bool is_clockwise, bool is_closed )
+{
+    int i;
+    float angle;
+    int count = is_closed ? CIRCLE_POINT_COUNT + 1 : CIRCLE_POINT_COUNT;
+
+    for( i = 0; i < count; i++ )
+    {
+        angle = 2 * M_PI * i / CIRCLE_POINT_COUNT;
+        if( is_clockwise )
+        {
+            angle = -angle;
+        }
+        gac_aoi_add_point( aoi, 0.5 + CIRCLE_RADIUS * cos( angle ),
+                0.5 + CIRCLE_RADIUS * sin( angle ) );
+    }
+}
+
+MU_TEST( aoi_rect )
+{
+    int i;
+    float x, y;
+    bool same = true;
+
+    gac_aoi_add_rect( &aoi, 0.2, 0.3, 0.4, 0.2 );
+    mu_check( gac_aoi_compile( &aoi ) );
+    mu_assert_int_eq( GAC_AOI_SHAPE_RECT, aoi.shape );
+    mu_check( gac_aoi_includes_point( &aoi, 0.2, 0.3 ) );
+    mu_check( gac_aoi_includes_point( &aoi, 0.4, 0.4 ) );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.1, 0.4 ) );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.4, 0.55 ) );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x = rand_unit();
+        y = rand_unit();
+        same &= gac_aoi_includes_point( &aoi, x, y )
+            == ( x >= 0.2 && x <= 0.6 && y >= 0.3 && y <= 0.5 );
+    }
+    mu_check( same );
+
+    // a closing point does not change the shape
+    gac_aoi_add_point( &aoi, 0.2, 0.3 );
+    mu_assert_int_eq( GAC_AOI_SHAPE_NONE, aoi.shape );
+    mu_check( gac_aoi_includes_point( &aoi, 0.4, 0.4 ) );
+    mu_assert_int_eq( GAC_AOI_SHAPE_RECT, aoi.shape );
+}
+
+MU_TEST( aoi_convex )
+{
+    int i, j;
+    float x, y, distance;
+    bool same = true;
+
+    for( j = 0; j < 4; j++ )
+    {
+        gac_aoi_destroy( &aoi );
+        gac_aoi_init( &aoi, "aoi" );
+        aoi_add_circle( &aoi, j % 2, j / 2 );
+        mu_check( gac_aoi_compile( &aoi ) );
+        mu_assert_int_eq( GAC_AOI_SHAPE_CONVEX, aoi.shape );
+        mu_assert_int_eq( CIRCLE_POINT_COUNT, aoi.hull.count );
+
+        for( i = 0; i < QUERY_COUNT; i++ )
+        {
+            x = rand_unit();
+            y = rand_unit();
+            distance = sqrt( ( x - 0.5 ) * ( x - 0.5 )
+                    + ( y - 0.5 ) * ( y - 0.5 ) );
+            if( distance < CIRCLE_RADIUS * cos( M_PI / CIRCLE_POINT_COUNT )
+                    - 1e-5 )
+            {
+                same &= gac_aoi_includes_point( &aoi, x, y );
+            }
+            else if( distance > CIRCLE_RADIUS )
+            {
+                same &= !gac_aoi_includes_point( &aoi, x, y );
+            }
+        }
+    }
+    mu_check( same );
+}
+
+MU_TEST( aoi_polygon )
+{
+    int i;
+    float x, y;
+    bool same = true;
+
+    // an L-shaped AOI with a colinear point
+    gac_aoi_add_point( &aoi, 0.2, 0.2 );
+    gac_aoi_add_point( &aoi, 0.4, 0.2 );
+    gac_aoi_add_point( &aoi, 0.4, 0.6 );
+    gac_aoi_add_point( &aoi, 0.6, 0.6 );
+    gac_aoi_add_point( &aoi, 0.8, 0.6 );
+    gac_aoi_add_point( &aoi, 0.8, 0.8 );
+    gac_aoi_add_point( &aoi, 0.2, 0.8 );
+    mu_check( gac_aoi_compile( &aoi ) );
+    mu_assert_int_eq( GAC_AOI_SHAPE_POLYGON, aoi.shape );
+    mu_assert_int_eq( 3, aoi.edges.count );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x = rand_unit();
+        y = rand_unit();
+        same &= gac_aoi_includes_point( &aoi, x, y )
+            == ( ( x > 0.2 && x < 0.4 && y > 0.2 && y < 0.8 )
+                    || ( x > 0.2 && x < 0.8 && y > 0.6 && y < 0.8 ) );
+    }
+    mu_check( same );
+}
+
+MU_TEST( aoi_star )
+{
+    int i;
+    float angle;
+
+    // a self-intersecting pentagram, the center is outside (even-odd rule)
+    for( i = 0; i < 5; i++ )
+    {
+        angle = 2 * M_PI * 2 * i / 5;
+        gac_aoi_add_point( &aoi, 0.5 + 0.3 * cos( angle ),
+                0.5 + 0.3 * sin( angle ) );
+    }
+    mu_check( gac_aoi_compile( &aoi ) );
+    mu_assert_int_eq( GAC_AOI_SHAPE_POLYGON, aoi.shape );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.5, 0.5 ) );
+    mu_check( gac_aoi_includes_point( &aoi, 0.5 + 0.2, 0.5 ) );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.5 + 0.1, 0.5 + 0.25 ) );
+}
+
+MU_TEST( aoi_invalid )
+{
+    mu_check( !gac_aoi_includes_point( NULL, 0.5, 0.5 ) );
+    gac_aoi_add_point( &aoi, 0.2, 0.2 );
+    gac_aoi_add_point( &aoi, 0.4, 0.4 );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.3, 0.3 ) );
+    gac_aoi_add_point( &aoi, 0.6, 0.6 );
+    mu_check( gac_aoi_compile( &aoi ) );
+    mu_assert_int_eq( GAC_AOI_SHAPE_POLYGON, aoi.shape );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.3, 0.3 ) );
+}
+
+MU_TEST( aoi_orientation )
+{
+    vec2 p = { 0.2, 0.2 };
+    vec2 q = { 0.6, 0.2 };
+    vec2 r_ccw = { 0.6, 0.6 };
+    vec2 r_cw = { 0.6, -0.2 };
+    vec2 r_colinear = { 0.8, 0.2 };
+    vec2 a = { 0.4, 0.0 };
+    vec2 b = { 0.4, 0.4 };
+
+    // negative and fractional cross products are not truncated
+    mu_assert_int_eq( GAC_AOI_ORIENTATION_COUNTER_CLOCKWISE,
+            gac_aoi_orientation_triplet( &p, &q, &r_ccw ) );
+    mu_assert_int_eq( GAC_AOI_ORIENTATION_CLOCKWISE,
+            gac_aoi_orientation_triplet( &p, &q, &r_cw ) );
+    mu_assert_int_eq( GAC_AOI_ORIENTATION_COLINEAR,
+            gac_aoi_orientation_triplet( &p, &q, &r_colinear ) );
+    mu_check( gac_aoi_intersect( &p, &q, &a, &b ) );
+    mu_check( !gac_aoi_intersect( &p, &q, &r_ccw, &b ) );
+}
+
+MU_TEST( aoi_closing_edge )
+{
+    int i;
+    float x, y;
+    bool same = true;
+    gac_aoi_t closed;
+
+    // the contour is closed without repeating the first point
+    gac_aoi_init( &closed, "closed" );
+    gac_aoi_add_point( &aoi, 0.2, 0.2 );
+    gac_aoi_add_point( &aoi, 0.8, 0.2 );
+    gac_aoi_add_point( &aoi, 0.5, 0.5 );
+    gac_aoi_add_point( &aoi, 0.8, 0.8 );
+    gac_aoi_add_point( &aoi, 0.2, 0.8 );
+    gac_aoi_add_point( &closed, 0.2, 0.2 );
+    gac_aoi_add_point( &closed, 0.8, 0.2 );
+    gac_aoi_add_point( &closed, 0.5, 0.5 );
+    gac_aoi_add_point( &closed, 0.8, 0.8 );
+    gac_aoi_add_point( &closed, 0.2, 0.8 );
+    gac_aoi_add_point( &closed, 0.2, 0.2 );
+    mu_check( gac_aoi_includes_point( &aoi, 0.21, 0.5 ) );
+    mu_check( gac_aoi_includes_point( &aoi, 0.21, 0.25 ) );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.19, 0.5 ) );
+    mu_check( !gac_aoi_includes_point( &aoi, 0.7, 0.5 ) );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x = rand_unit();
+        y = rand_unit();
+        same &= gac_aoi_includes_point( &aoi, x, y )
+            == gac_aoi_includes_point( &closed, x, y );
+    }
+    mu_check( same );
+    gac_aoi_destroy( &closed );
+}
+
+MU_TEST( aoi_copy )
+{
+    gac_aoi_t* aoi_copy;
+
+    aoi_add_circle( &aoi, false, false );
+    mu_check( gac_aoi_includes_point( &aoi, 0.5, 0.5 ) );
+    aoi_copy = gac_aoi_copy( &aoi );
+    mu_check( aoi_copy != NULL );
+    mu_check( aoi_copy->hull.items != aoi.hull.items );
+    mu_check( gac_aoi_includes_point( aoi_copy, 0.5, 0.5 ) );
+    mu_assert_int_eq( GAC_AOI_SHAPE_CONVEX, aoi_copy->shape );
+    gac_aoi_destroy( aoi_copy );
+}
+
+MU_TEST( aoi_batch )
+{
+    int i, j;
+    float angle;
+    float x[QUERY_COUNT];
+    float y[QUERY_COUNT];
+    bool inside[QUERY_COUNT];
+    gac_aoi_t aois[4];
+    bool same = true;
+    uint32_t hit_count = 0;
+
+    for( j = 0; j < 4; j++ )
+    {
+        gac_aoi_init( &aois[j], NULL );
+    }
+    gac_aoi_add_rect( &aois[0], 0.2, 0.3, 0.4, 0.2 );
+    aoi_add_circle( &aois[1], false, true );
+    gac_aoi_add_point( &aois[2], 0.2, 0.2 );
+    gac_aoi_add_point( &aois[2], 0.4, 0.2 );
+    gac_aoi_add_point( &aois[2], 0.4, 0.6 );
+    gac_aoi_add_point( &aois[2], 0.8, 0.6 );
+    gac_aoi_add_point( &aois[2], 0.8, 0.8 );
+    gac_aoi_add_point( &aois[2], 0.2, 0.8 );
+    for( i = 0; i < 5; i++ )
+    {
+        angle = 2 * M_PI * 2 * i / 5;
+        gac_aoi_add_point( &aois[3], 0.5 + 0.3 * cos( angle ),
+                0.5 + 0.3 * sin( angle ) );
+    }
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x[i] = 1.2 * rand_unit() - 0.1;
+        y[i] = 1.2 * rand_unit() - 0.1;
+    }
+
+    for( j = 0; j < 4; j++ )
+    {
+        mu_check( gac_aoi_includes_points( &aois[j], x, y, QUERY_COUNT,
+                    inside ) );
+        for( i = 0; i < QUERY_COUNT; i++ )
+        {
+            same &= inside[i] == gac_aoi_includes_point( &aois[j], x[i],
+                    y[i] );
+            hit_count += inside[i];
+        }
+        gac_aoi_destroy( &aois[j] );
+    }
+    mu_check( same );
+    mu_check( hit_count > 0 );
+
+    // AOIs with less than three points include no points
+    mu_check( gac_aoi_includes_points( &aoi, x, y, QUERY_COUNT, inside ) );
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        same &= !inside[i];
+    }
+    mu_check( same );
+    mu_check( !gac_aoi_includes_points( NULL, x, y, QUERY_COUNT, inside ) );
+}
+
+MU_TEST( aoi_keyframe )
+{
+    uint32_t idx;
+    float weight;
+    float x[4] = { 0, 0.2, 0.2, 0 };
+    float y[4] = { 0.4, 0.4, 0.6, 0.6 };
+    vec2* contour;
+    gac_aoi_edge_t* edges;
+    gac_aoi_t* aoi_copy;
+
+    // a rectangle moving right and then up
+    mu_check( gac_aoi_add_keyframe( &aoi, 1000, x, y, 4 ) );
+    mu_assert_int_eq( 4, aoi.points.count );
+    mu_assert_double_eq( 1000, aoi.timestamp );
+    mu_check( gac_aoi_includes_point( &aoi, 0.1, 0.5 ) );
+    x[0] = x[3] = 0.5;
+    x[1] = x[2] = 0.7;
+    mu_check( gac_aoi_add_keyframe( &aoi, 1100, x, y, 4 ) );
+    y[0] = y[1] = 0;
+    y[2] = y[3] = 0.2;
+    mu_check( gac_aoi_add_keyframe( &aoi, 1200, x, y, 4 ) );
+    mu_check( !gac_aoi_add_keyframe( &aoi, 1300, x, y, 3 ) );
+    mu_check( !gac_aoi_add_keyframe( &aoi, 1150, x, y, 4 ) );
+    mu_assert_int_eq( 3, aoi.keyframes.count );
+    mu_check( gac_aoi_is_dynamic( &aoi ) );
+
+    mu_check( !gac_aoi_is_visible( &aoi, 999 ) );
+    mu_check( gac_aoi_is_visible( &aoi, 1000 ) );
+    mu_check( gac_aoi_is_visible( &aoi, 1200 ) );
+    mu_check( !gac_aoi_is_visible( &aoi, 1201 ) );
+    mu_check( gac_aoi_find_keyframe( &aoi, 1150, &idx, &weight ) );
+    mu_assert_int_eq( 1, idx );
+    mu_assert_double_eq( 0.5, weight );
+    mu_check( gac_aoi_find_keyframe( &aoi, 1300, &idx, &weight ) );
+    mu_assert_int_eq( 2, idx );
+    mu_assert_double_eq( 0, weight );
+
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.35, 0.5, 1050 ) );
+    mu_assert_double_eq( 1050, aoi.timestamp );
+    mu_assert_double_eq( 0.25, aoi.bounding_box.x_min );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.1, 0.5, 1050 ) );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.1, 0.5, 1000 ) );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.6, 0.5, 1100 ) );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.6, 0.3, 1150 ) );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.6, 0.5, 1150 ) );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.6, 0.1, 1250 ) );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.1, 0.5, 900 ) );
+
+    // points outside of the interpolated bounding box are rejected without
+    // interpolating the points
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.9, 0.9, 1050 ) );
+    mu_assert_double_eq( 1150, aoi.timestamp );
+    mu_check( !gac_aoi_resolve( &aoi, NAN ) );
+
+    // the compiled buffers are reused when the AOI is resolved again
+    contour = aoi.contour.items;
+    edges = aoi.edges.items;
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.6, 0.3, 1160 ) );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.6, 0.2, 1170 ) );
+    mu_check( aoi.contour.items == contour );
+    mu_check( aoi.edges.items == edges );
+    mu_assert_int_eq( 5, aoi.contour.length );
+
+    aoi_copy = gac_aoi_copy( &aoi );
+    mu_check( aoi_copy != NULL );
+    mu_check( aoi_copy->keyframes.points != aoi.keyframes.points );
+    mu_assert_int_eq( 3, aoi_copy->keyframes.count );
+    mu_check( gac_aoi_includes_point_at( aoi_copy, 0.35, 0.5, 1050 ) );
+    gac_aoi_destroy( aoi_copy );
+}
+
+MU_TEST( aoi_interval )
+{
+    mu_check( !gac_aoi_is_dynamic( &aoi ) );
+    gac_aoi_add_rect( &aoi, 0.2, 0.2, 0.2, 0.2 );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.3, 0.3, 5 ) );
+    mu_check( gac_aoi_add_interval( &aoi, 0, 10 ) );
+    mu_check( gac_aoi_add_interval( &aoi, 20, 30 ) );
+    mu_check( !gac_aoi_add_interval( &aoi, 25, 40 ) );
+    mu_check( !gac_aoi_add_interval( &aoi, 40, 35 ) );
+    mu_check( !gac_aoi_add_interval( &aoi, 40, INFINITY ) );
+    mu_check( gac_aoi_is_dynamic( &aoi ) );
+
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.3, 0.3, -1 ) );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.3, 0.3, 5 ) );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.3, 0.3, 15 ) );
+    mu_check( gac_aoi_includes_point_at( &aoi, 0.3, 0.3, 30 ) );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.3, 0.3, 31 ) );
+    mu_check( !gac_aoi_includes_point_at( &aoi, 0.3, 0.3, NAN ) );
+    mu_check( gac_aoi_includes_point( &aoi, 0.3, 0.3 ) );
+}
+
+MU_TEST_SUITE( aoi_suite )
+{
+    MU_SUITE_CONFIGURE( &aoi_setup, &aoi_teardown );
+    MU_RUN_TEST( aoi_rect );
+    MU_RUN_TEST( aoi_convex );
+    MU_RUN_TEST( aoi_polygon );
+    MU_RUN_TEST( aoi_star );
+    MU_RUN_TEST( aoi_invalid );
+    MU_RUN_TEST( aoi_orientation );
+    MU_RUN_TEST( aoi_closing_edge );
+    MU_RUN_TEST( aoi_copy );
+    MU_RUN_TEST( aoi_batch );
+    MU_RUN_TEST( aoi_keyframe );
+    MU_RUN_TEST( aoi_interval );
+}
+
+int main()
+{
+    MU_RUN_SUITE( aoi_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
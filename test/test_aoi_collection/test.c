@@ -0,0 +1,388 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define AOI_COUNT 300
+#define POINT_COUNT 150
+#define GRID_DIM 20
+
+static gac_aoi_collection_t aoic_stack;
+static gac_aoi_collection_t* aoic_heap;
+static gac_aoi_collection_t* aoic;
+
+void fixation_make( gac_fixation_t* fixation, float x, float y,
+        uint32_t trial_id )
+{
+    vec2 screen_point = { x, y };
+    vec3 v3d = { 0, 0, 0 };
+    gac_sample_t sample;
+
+    gac_sample_init( &sample, &screen_point, &v3d, &v3d, 0, trial_id,
+            GAC_LABEL_ID_NONE );
+    gac_fixation_init( fixation, &screen_point, &v3d, 100, &sample );
+}
+
+void sample_make( gac_sample_t* sample, float x, float y, double timestamp,
+        uint32_t trial_id )
+{
+    vec2 screen_point = { x, y };
+    vec3 v3d = { 0, 0, 0 };
+
+    gac_sample_init( sample, &screen_point, &v3d, &v3d, timestamp, trial_id,
+            GAC_LABEL_ID_NONE );
+}
+
+void aoic_setup()
+{
+    int i, j;
+    float x, y, angle;
+    char label[GAC_AOI_MAX_LABEL_LEN];
+    gac_aoi_t aoi;
+    gac_aoi_t* aoi_heap;
+
+    gac_aoi_collection_init( &aoic_stack );
+    aoic = &aoic_stack;
+
+    // a grid of circular AOIs, every other one allocated on the heap
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        sprintf( label, "aoi%d", i );
+        x = ( i % GRID_DIM + 0.5 ) / GRID_DIM;
+        y = ( i / GRID_DIM + 0.5 ) / GRID_DIM;
+        if( i % 2 == 0 )
+        {
+            gac_aoi_init( &aoi, label );
+            aoi_heap = &aoi;
+        }
+        else
+        {
+            aoi_heap = gac_aoi_create( label );
+        }
+        for( j = 0; j <= POINT_COUNT; j++ )
+        {
+            angle = 2 * M_PI * j / POINT_COUNT;
+            gac_aoi_add_point( aoi_heap, x + 0.4 / GRID_DIM * cos( angle ),
+                    y + 0.4 / GRID_DIM * sin( angle ) );
+        }
+        gac_aoi_collection_add( aoic, aoi_heap );
+        if( i % 2 == 0 )
+        {
+            gac_aoi_destroy( &aoi );
+        }
+    }
+}
+
+void aoic_teardown()
+{
+    gac_aoi_collection_destroy( aoic );
+}
+
+MU_TEST( aoic_init_stack )
+{
+    mu_check( gac_aoi_collection_init( &aoic_stack ) );
+    aoic = &aoic_stack;
+    mu_assert_int_eq( 0, aoic->aois.count );
+}
+
+MU_TEST( aoic_init_heap )
+{
+    aoic_heap = gac_aoi_collection_create();
+    aoic = aoic_heap;
+    mu_check( aoic != NULL );
+    mu_assert_int_eq( 0, aoic->aois.count );
+}
+
+MU_TEST_SUITE( aoic_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &aoic_teardown );
+    MU_RUN_TEST( aoic_init_stack );
+    MU_RUN_TEST( aoic_init_heap );
+}
+
+MU_TEST( aoic_add )
+{
+    int i;
+
+    mu_assert_int_eq( AOI_COUNT, aoic->aois.count );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        mu_assert_int_eq( POINT_COUNT + 1, aoic->aois.items[i].points.count );
+        mu_check( aoic->aois.items[i]._me == NULL );
+    }
+    mu_assert_string_eq( "aoi299", aoic->aois.items[299].label );
+}
+
+MU_TEST( aoic_analyse )
+{
+    int i;
+    bool res;
+    gac_aoi_t* aoi;
+    gac_fixation_t fixation;
+    gac_aoi_collection_analysis_result_t analysis;
+
+    // one fixation in each of the first and last AOI and one outside
+    fixation_make( &fixation, 0.5 / GRID_DIM, 0.5 / GRID_DIM, 0 );
+    mu_check( !gac_aoi_collection_analyse_fixation( aoic, &fixation,
+                &analysis ) );
+    fixation_make( &fixation, ( ( AOI_COUNT - 1 ) % GRID_DIM + 0.5 )
+            / GRID_DIM, ( ( AOI_COUNT - 1 ) / GRID_DIM + 0.5 ) / GRID_DIM, 0 );
+    mu_check( !gac_aoi_collection_analyse_fixation( aoic, &fixation,
+                &analysis ) );
+    fixation_make( &fixation, 0.5, 0.99, 0 );
+    mu_check( !gac_aoi_collection_analyse_fixation( aoic, &fixation,
+                &analysis ) );
+
+    res = gac_aoi_collection_analyse_finalise( aoic, &analysis );
+    mu_check( res );
+    mu_assert_int_eq( 0, analysis.trial_id );
+    mu_assert_int_eq( 2, analysis.aois.count );
+    for( i = 0; i < 2; i++ )
+    {
+        mu_assert_int_eq( 1, analysis.aois.items[i].analysis.fixation_count );
+        mu_assert_double_eq( 1.0 / 3,
+                analysis.aois.items[i].analysis.fixation_count_relative );
+    }
+    mu_assert_int_eq( 0, analysis.aois.items[0].aoi_id );
+    mu_assert_string_eq( "aoi0", analysis.aois.items[0].label );
+    mu_assert_int_eq( 0,
+            analysis.aois.items[0].analysis.aoi_visited_before_count );
+    mu_assert_int_eq( AOI_COUNT - 1, analysis.aois.items[1].aoi_id );
+    mu_assert_int_eq( 1, analysis.aois.items[1].analysis
+            .aoi_visited_before_count );
+
+    // the fixation outside of all AOIs is not part of the scanpath
+    mu_assert_int_eq( 2, analysis.scanpath->aois.count );
+    mu_assert_int_eq( 0, analysis.scanpath->aois.items[0] );
+    mu_assert_int_eq( AOI_COUNT - 1, analysis.scanpath->aois.items[1] );
+    mu_assert_int_eq( 1, analysis.scanpath->transitions.count );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count(
+                analysis.scanpath, 0, AOI_COUNT - 1 ) );
+    mu_assert_int_eq( 0, aoic->scanpath.aois.count );
+
+    // the analysis of the reported AOIs is cleared
+    mu_assert_int_eq( 0, aoic->aois.items[0].analysis.fixation_count );
+    mu_assert_int_eq( 0, aoic->touched.count );
+
+    // AOIs are reported in ascending order regardless of the hit order
+    fixation_make( &fixation, 10.5 / GRID_DIM, 10.5 / GRID_DIM, 1 );
+    gac_aoi_collection_analyse_fixation( aoic, &fixation, &analysis );
+    fixation_make( &fixation, 0.5 / GRID_DIM, 0.5 / GRID_DIM, 1 );
+    gac_aoi_collection_analyse_fixation( aoic, &fixation, &analysis );
+    mu_check( gac_aoi_collection_analyse_finalise( aoic, &analysis ) );
+    mu_assert_int_eq( 1, analysis.trial_id );
+    mu_assert_int_eq( 2, analysis.aois.count );
+    mu_assert_int_eq( 0, analysis.aois.items[0].aoi_id );
+    mu_assert_int_eq( 10 * GRID_DIM + 10, analysis.aois.items[1].aoi_id );
+    mu_assert_int_eq( 1, analysis.aois.items[0].analysis
+            .aoi_visited_before_count );
+
+    // the scanpath keeps the hit order
+    mu_assert_int_eq( 2, analysis.scanpath->aois.count );
+    mu_assert_int_eq( 10 * GRID_DIM + 10, analysis.scanpath->aois.items[0] );
+    mu_assert_int_eq( 0, analysis.scanpath->aois.items[1] );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count(
+                analysis.scanpath, 10 * GRID_DIM + 10, 0 ) );
+    mu_assert_int_eq( 0, gac_aoi_scanpath_get_transition_count(
+                analysis.scanpath, 0, AOI_COUNT - 1 ) );
+
+    // the labels of the result outlive a reallocation of the AOI list
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        aoi = gac_aoi_create( "added" );
+        gac_aoi_add_rect( aoi, 0, 0, 0.01, 0.01 );
+        mu_check( gac_aoi_collection_add( aoic, aoi ) );
+    }
+    mu_assert_string_eq( "aoi0", analysis.aois.items[0].label );
+    mu_assert_string_eq( "aoi210", analysis.aois.items[1].label );
+}
+
+MU_TEST( aoic_includes_points )
+{
+    uint32_t i, j;
+    float x[GRID_DIM * 4];
+    float y[GRID_DIM * 4];
+    bool* inside;
+    bool same = true;
+    uint32_t hit_count = 0;
+
+    // a diagonal through the AOI centers and the gaps between the AOIs
+    for( j = 0; j < GRID_DIM * 4; j++ )
+    {
+        x[j] = ( j + 0.5 ) / ( GRID_DIM * 4 );
+        y[j] = x[j];
+    }
+
+    inside = malloc( sizeof( bool ) * AOI_COUNT * GRID_DIM * 4 );
+    mu_check( gac_aoi_collection_includes_points( aoic, x, y, GRID_DIM * 4,
+                inside ) );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        for( j = 0; j < GRID_DIM * 4; j++ )
+        {
+            same &= inside[i * GRID_DIM * 4 + j] == gac_aoi_includes_point(
+                    &aoic->aois.items[i], x[j], y[j] );
+            hit_count += inside[i * GRID_DIM * 4 + j];
+        }
+    }
+    free( inside );
+    mu_check( same );
+    mu_assert_int_eq( 2 * ( AOI_COUNT / GRID_DIM ), hit_count );
+}
+
+MU_TEST( aoic_analyse_sample )
+{
+    int i;
+    uint32_t count;
+    uint32_t* hits;
+    float x, y;
+    gac_sample_t samples[30];
+    gac_fixation_t fixation;
+    gac_saccade_t saccade;
+    gac_aoi_collection_analysis_result_t analysis;
+
+    // 10 samples on AOI 0, 10 samples between the AOIs, 10 samples on AOI 1
+    for( i = 0; i < 30; i++ )
+    {
+        x = ( i < 10 ? 0.5 : ( i < 20 ? 1 : 1.5 ) ) / GRID_DIM;
+        y = 0.5 / GRID_DIM;
+        sample_make( &samples[i], x, y, i * 10, 0 );
+        mu_check( gac_aoi_collection_analyse_sample( aoic, &samples[i] ) );
+    }
+    count = gac_aoi_collection_get_sample_hits( aoic, &hits );
+    mu_assert_int_eq( 1, count );
+    mu_assert_int_eq( 1, hits[0] );
+
+    // only the most recent samples are kept
+    mu_check( gac_aoi_collection_find_sample_hits( aoic, &samples[25], &hits,
+                &count ) );
+    mu_assert_int_eq( 1, count );
+    mu_check( !gac_aoi_collection_find_sample_hits( aoic, &samples[19],
+                &hits, &count ) );
+
+    gac_saccade_init( &saccade, &samples[19], &samples[25] );
+    mu_check( gac_aoi_collection_analyse_saccade( aoic, &saccade ) );
+    gac_saccade_destroy( &saccade );
+    gac_saccade_init( &saccade, &samples[22], &samples[25] );
+    mu_check( gac_aoi_collection_analyse_saccade( aoic, &saccade ) );
+    gac_saccade_destroy( &saccade );
+    mu_assert_int_eq( 1, aoic->aois.items[1].analysis.enter_saccade_count );
+
+    fixation_make( &fixation, 0.5 / GRID_DIM, 0.5 / GRID_DIM, 0 );
+    mu_check( !gac_aoi_collection_analyse_fixation( aoic, &fixation,
+                &analysis ) );
+    gac_fixation_destroy( &fixation );
+    mu_check( gac_aoi_collection_analyse_finalise( aoic, &analysis ) );
+    mu_assert_int_eq( 10, analysis.aois.items[0].analysis.sample_count );
+    mu_assert_double_eq( 100, analysis.aois.items[0].analysis
+            .sample_dwell_time );
+    mu_assert_double_eq( 100.0 / 290, analysis.aois.items[0].analysis
+            .sample_dwell_time_relative );
+    mu_assert_int_eq( 10, analysis.aois.items[1].analysis.sample_count );
+    mu_assert_double_eq( 90, analysis.aois.items[1].analysis
+            .sample_dwell_time );
+    mu_assert_int_eq( 2, analysis.aois.count );
+
+    // a trial change adds the accumulated samples to the AOI analysis
+    for( i = 0; i < 3; i++ )
+    {
+        sample_make( &samples[i], 0.5 / GRID_DIM, 0.5 / GRID_DIM,
+                300 + i * 10, 1 );
+        mu_check( gac_aoi_collection_analyse_sample( aoic, &samples[i] ) );
+    }
+    mu_assert_int_eq( 0, aoic->aois.items[0].analysis.sample_count );
+    sample_make( &samples[3], 0.5 / GRID_DIM, 0.5 / GRID_DIM, 400, 2 );
+    mu_check( gac_aoi_collection_analyse_sample( aoic, &samples[3] ) );
+    mu_assert_int_eq( 3, aoic->aois.items[0].analysis.sample_count );
+    mu_assert_double_eq( 20, aoic->aois.items[0].analysis.sample_dwell_time );
+    mu_assert_int_eq( 1, aoic->samples.count );
+}
+
+MU_TEST( aoic_dynamic )
+{
+    uint32_t count;
+    uint32_t* hits;
+    float x[4] = { 0, 0.1, 0.1, 0 };
+    float y[4] = { 0.9, 0.9, 1, 1 };
+    gac_aoi_t aoi;
+    gac_sample_t sample;
+    gac_fixation_t fixation;
+
+    // a rectangle moving along the bottom of the screen
+    gac_aoi_init( &aoi, "moving" );
+    mu_check( gac_aoi_add_keyframe( &aoi, 0, x, y, 4 ) );
+    x[0] = x[3] = 0.9;
+    x[1] = x[2] = 1;
+    mu_check( gac_aoi_add_keyframe( &aoi, 1000, x, y, 4 ) );
+    mu_check( gac_aoi_collection_add( aoic, &aoi ) );
+    gac_aoi_destroy( &aoi );
+
+    // a rectangle covering the first AOI for a short time
+    gac_aoi_init( &aoi, "flash" );
+    gac_aoi_add_rect( &aoi, 0, 0, 0.05, 0.05 );
+    mu_check( gac_aoi_add_interval( &aoi, 0, 200 ) );
+    mu_check( gac_aoi_collection_add( aoic, &aoi ) );
+    gac_aoi_destroy( &aoi );
+
+    mu_check( aoic->timeline.bin_count > 0 );
+    count = gac_aoi_collection_hits( aoic, 0.5 / GRID_DIM, 0.5 / GRID_DIM,
+            100, &hits );
+    mu_assert_int_eq( 2, count );
+    mu_assert_int_eq( 0, hits[0] );
+    mu_assert_int_eq( AOI_COUNT + 1, hits[1] );
+    count = gac_aoi_collection_hits( aoic, 0.5 / GRID_DIM, 0.5 / GRID_DIM,
+            300, &hits );
+    mu_assert_int_eq( 1, count );
+    mu_assert_int_eq( 0, hits[0] );
+
+    count = gac_aoi_collection_hits( aoic, 0.55, 0.95, 500, &hits );
+    mu_assert_int_eq( 1, count );
+    mu_assert_int_eq( AOI_COUNT, hits[0] );
+    mu_assert_int_eq( 0, gac_aoi_collection_hits( aoic, 0.55, 0.95, 0,
+                &hits ) );
+
+    // dynamic AOIs are not rasterised
+    mu_check( gac_aoi_collection_rasterise( aoic, 64, 64 ) );
+    mu_assert_int_eq( 0, gac_aoi_collection_hits( aoic, 0.55, 0.95, 2000,
+                &hits ) );
+    mu_assert_int_eq( 1, gac_aoi_collection_hits( aoic, 0.55, 0.95, 500,
+                &hits ) );
+
+    // the fixation is resolved at its middle
+    sample_make( &sample, 0.55, 0.95, 450, 0 );
+    gac_fixation_init( &fixation, &sample.screen_point, &sample.point, 100,
+            &sample );
+    gac_aoi_collection_analyse_fixation( aoic, &fixation, NULL );
+    gac_fixation_destroy( &fixation );
+    sample_make( &sample, 0.05, 0.95, 450, 0 );
+    gac_fixation_init( &fixation, &sample.screen_point, &sample.point, 100,
+            &sample );
+    gac_aoi_collection_analyse_fixation( aoic, &fixation, NULL );
+    gac_fixation_destroy( &fixation );
+    mu_assert_int_eq( 1, aoic->aois.items[AOI_COUNT].analysis.fixation_count );
+    mu_assert_int_eq( 2, aoic->analysis.fixation_count );
+}
+
+MU_TEST_SUITE( aoic_suite )
+{
+    MU_SUITE_CONFIGURE( &aoic_setup, &aoic_teardown );
+    MU_RUN_TEST( aoic_add );
+    MU_RUN_TEST( aoic_analyse );
+    MU_RUN_TEST( aoic_includes_points );
+    MU_RUN_TEST( aoic_analyse_sample );
+    MU_RUN_TEST( aoic_dynamic );
+}
+
+int main()
+{
+    MU_RUN_SUITE( aoic_init_suite );
+    MU_RUN_SUITE( aoic_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
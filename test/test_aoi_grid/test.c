@@ -0,0 +1,190 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <stdlib.h>
+
+#define AOI_COUNT 50
+#define QUERY_COUNT 2000
+
+static gac_aoi_grid_t grid_stack;
+static gac_aoi_grid_t* grid_heap;
+static gac_aoi_grid_t* grid;
+static gac_aoi_t aois[AOI_COUNT];
+
+float rand_unit()
+{
+    return ( float )rand() / RAND_MAX;
+}
+
+void grid_setup()
+{
+    int i;
+    float x, y;
+
+    srand( 42 );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        gac_aoi_init( &aois[i], NULL );
+        x = rand_unit();
+        y = rand_unit();
+        if( i % 2 == 0 )
+        {
+            gac_aoi_add_rect( &aois[i], x, y, 0.2 * rand_unit(),
+                    0.2 * rand_unit() );
+        }
+        else
+        {
+            gac_aoi_add_point( &aois[i], x, y );
+            gac_aoi_add_point( &aois[i], x + 0.1, y + 0.02 );
+            gac_aoi_add_point( &aois[i], x + 0.05, y + 0.15 );
+            gac_aoi_add_point( &aois[i], x, y );
+        }
+    }
+    gac_aoi_grid_init( &grid_stack );
+    grid = &grid_stack;
+}
+
+void grid_teardown()
+{
+    gac_aoi_grid_destroy( grid );
+}
+
+void grid_aoi_teardown()
+{
+    int i;
+
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        gac_aoi_destroy( &aois[i] );
+    }
+    gac_aoi_grid_destroy( grid );
+}
+
+MU_TEST( grid_init_stack )
+{
+    uint32_t* candidates;
+
+    mu_check( gac_aoi_grid_init( &grid_stack ) );
+    grid = &grid_stack;
+    mu_assert_int_eq( 0, gac_aoi_grid_query( grid, 0.5, 0.5, &candidates ) );
+}
+
+MU_TEST( grid_init_heap )
+{
+    grid_heap = gac_aoi_grid_create();
+    grid = grid_heap;
+    mu_check( grid != NULL );
+    mu_assert_int_eq( 0, grid->indices.count );
+}
+
+MU_TEST_SUITE( grid_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &grid_teardown );
+    MU_RUN_TEST( grid_init_stack );
+    MU_RUN_TEST( grid_init_heap );
+}
+
+MU_TEST( grid_query )
+{
+    int i, j;
+    uint32_t k, count;
+    uint32_t* candidates;
+    float x, y;
+    bool hit;
+    bool in_order = true;
+    uint32_t expected = 0;
+    uint32_t found = 0;
+
+    mu_check( gac_aoi_grid_build( grid, aois, AOI_COUNT ) );
+    mu_check( grid->cols > 1 );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x = 1.4 * rand_unit() - 0.2;
+        y = 1.4 * rand_unit() - 0.2;
+        count = gac_aoi_grid_query( grid, x, y, &candidates );
+        mu_check( count <= AOI_COUNT );
+        for( k = 1; k < count; k++ )
+        {
+            in_order &= candidates[k - 1] < candidates[k];
+        }
+        for( j = 0; j < AOI_COUNT; j++ )
+        {
+            if( !gac_aoi_includes_point( &aois[j], x, y ) )
+            {
+                continue;
+            }
+            expected++;
+            hit = false;
+            for( k = 0; k < count; k++ )
+            {
+                hit |= candidates[k] == j;
+            }
+            found += hit;
+        }
+    }
+    mu_check( in_order );
+    mu_check( expected > 0 );
+    mu_assert_int_eq( expected, found );
+}
+
+MU_TEST( grid_query_corners )
+{
+    int i;
+    uint32_t k, count;
+    uint32_t* candidates;
+    bool hit;
+
+    mu_check( gac_aoi_grid_build( grid, aois, AOI_COUNT ) );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        count = gac_aoi_grid_query( grid, aois[i].bounding_box.x_max,
+                aois[i].bounding_box.y_max, &candidates );
+        hit = false;
+        for( k = 0; k < count; k++ )
+        {
+            hit |= candidates[k] == i;
+        }
+        mu_check( hit );
+    }
+}
+
+MU_TEST( grid_rebuild )
+{
+    uint32_t* candidates;
+
+    mu_check( gac_aoi_grid_build( grid, aois, AOI_COUNT ) );
+    mu_check( gac_aoi_grid_build( grid, aois, 1 ) );
+    mu_assert_int_eq( 1, grid->cols );
+    mu_assert_int_eq( 1, gac_aoi_grid_query( grid,
+                aois[0].bounding_box.x_min, aois[0].bounding_box.y_min,
+                &candidates ) );
+    mu_assert_int_eq( 0, candidates[0] );
+    mu_assert_int_eq( 0, gac_aoi_grid_query( grid, -1, -1, &candidates ) );
+    mu_assert_int_eq( 0, gac_aoi_grid_query( grid, NAN, 0.5, &candidates ) );
+    mu_check( gac_aoi_grid_build( grid, aois, 0 ) );
+    mu_assert_int_eq( 0, gac_aoi_grid_query( grid,
+                aois[0].bounding_box.x_min, aois[0].bounding_box.y_min,
+                &candidates ) );
+}
+
+MU_TEST_SUITE( grid_suite )
+{
+    MU_SUITE_CONFIGURE( &grid_setup, &grid_aoi_teardown );
+    MU_RUN_TEST( grid_query );
+    MU_RUN_TEST( grid_query_corners );
+    MU_RUN_TEST( grid_rebuild );
+}
+
+int main()
+{
+    MU_RUN_SUITE( grid_init_suite );
+    MU_RUN_SUITE( grid_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
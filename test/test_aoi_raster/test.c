@@ -0,0 +1,269 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <stdlib.h>
+
+#define AOI_COUNT 50
+#define QUERY_COUNT 5000
+#define RASTER_WIDTH 320
+#define RASTER_HEIGHT 180
+
+static gac_aoi_raster_t raster_stack;
+static gac_aoi_raster_t* raster_heap;
+static gac_aoi_raster_t* raster;
+static gac_aoi_t aois[AOI_COUNT];
+
+float rand_unit()
+{
+    return ( float )rand() / RAND_MAX;
+}
+
+void raster_setup()
+{
+    int i;
+    float x, y;
+
+    srand( 42 );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        gac_aoi_init( &aois[i], NULL );
+        x = rand_unit();
+        y = rand_unit();
+        if( i % 2 == 0 )
+        {
+            gac_aoi_add_rect( &aois[i], x, y, 0.3 * rand_unit(),
+                    0.3 * rand_unit() );
+        }
+        else
+        {
+            gac_aoi_add_point( &aois[i], x, y );
+            gac_aoi_add_point( &aois[i], x + 0.2, y + 0.04 );
+            gac_aoi_add_point( &aois[i], x + 0.1, y + 0.3 );
+            gac_aoi_add_point( &aois[i], x, y );
+        }
+    }
+    gac_aoi_raster_init( &raster_stack );
+    raster = &raster_stack;
+}
+
+void raster_teardown()
+{
+    gac_aoi_raster_destroy( raster );
+}
+
+void raster_aoi_teardown()
+{
+    int i;
+
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        gac_aoi_destroy( &aois[i] );
+    }
+    gac_aoi_raster_destroy( raster );
+}
+
+MU_TEST( raster_init_stack )
+{
+    uint32_t count;
+    uint32_t hits[1];
+
+    mu_check( gac_aoi_raster_init( &raster_stack ) );
+    raster = &raster_stack;
+    mu_check( !gac_aoi_raster_query( raster, aois, 0.5, 0.5, hits, 1,
+                &count ) );
+}
+
+MU_TEST( raster_init_heap )
+{
+    raster_heap = gac_aoi_raster_create();
+    raster = raster_heap;
+    mu_check( raster != NULL );
+    mu_assert_int_eq( 0, raster->width );
+    mu_check( raster->cells == NULL );
+}
+
+MU_TEST_SUITE( raster_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &raster_teardown );
+    MU_RUN_TEST( raster_init_stack );
+    MU_RUN_TEST( raster_init_heap );
+}
+
+MU_TEST( raster_query )
+{
+    int i, j;
+    uint32_t k, count;
+    uint32_t hits[AOI_COUNT];
+    float x, y;
+    bool in_order = true;
+    uint32_t expected = 0;
+    uint32_t found = 0;
+    uint32_t mismatch = 0;
+
+    mu_check( gac_aoi_raster_build( raster, aois, AOI_COUNT, RASTER_WIDTH,
+                RASTER_HEIGHT ) );
+    mu_check( raster->sets.parents == NULL );
+    mu_check( raster->offsets.count > 1 );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x = rand_unit();
+        y = rand_unit();
+        mu_check( gac_aoi_raster_query( raster, aois, x, y, hits, AOI_COUNT,
+                    &count ) );
+        for( k = 1; k < count; k++ )
+        {
+            in_order &= hits[k - 1] < hits[k];
+        }
+        k = 0;
+        for( j = 0; j < AOI_COUNT; j++ )
+        {
+            if( gac_aoi_includes_point( &aois[j], x, y ) )
+            {
+                expected++;
+                if( k < count && hits[k] == j )
+                {
+                    found++;
+                    k++;
+                }
+                else
+                {
+                    mismatch++;
+                }
+            }
+        }
+        mismatch += count - k;
+    }
+    mu_check( in_order );
+    mu_check( expected > 0 );
+    mu_assert_int_eq( expected, found );
+    mu_assert_int_eq( 0, mismatch );
+}
+
+MU_TEST( raster_query_length )
+{
+    int j;
+    uint32_t count;
+    uint32_t hits[AOI_COUNT];
+    uint32_t expected = 0;
+    float x = aois[0].bounding_box.x_min + 0.01;
+    float y = aois[0].bounding_box.y_min + 0.01;
+
+    for( j = 0; j < AOI_COUNT; j++ )
+    {
+        expected += gac_aoi_includes_point( &aois[j], x, y );
+    }
+    mu_check( expected > 0 );
+    mu_check( gac_aoi_raster_build( raster, aois, AOI_COUNT, RASTER_WIDTH,
+                RASTER_HEIGHT ) );
+    mu_check( gac_aoi_raster_query( raster, aois, x, y, hits, AOI_COUNT,
+                &count ) );
+    mu_assert_int_eq( expected, count );
+    mu_assert_int_eq( 0, hits[0] );
+    mu_check( gac_aoi_raster_query( raster, aois, x, y, hits, 0, &count ) );
+    mu_assert_int_eq( 0, count );
+}
+
+MU_TEST( raster_query_outside )
+{
+    uint32_t count;
+    uint32_t hits[AOI_COUNT];
+
+    mu_check( gac_aoi_raster_build( raster, aois, AOI_COUNT, RASTER_WIDTH,
+                RASTER_HEIGHT ) );
+    mu_check( !gac_aoi_raster_query( raster, aois, -0.1, 0.5, hits,
+                AOI_COUNT, &count ) );
+    mu_check( !gac_aoi_raster_query( raster, aois, 0.5, 1.1, hits,
+                AOI_COUNT, &count ) );
+    mu_check( !gac_aoi_raster_query( raster, aois, NAN, 0.5, hits,
+                AOI_COUNT, &count ) );
+    mu_check( gac_aoi_raster_query( raster, aois, 1, 1, hits, AOI_COUNT,
+                &count ) );
+}
+
+MU_TEST( raster_rebuild )
+{
+    uint32_t count;
+    uint32_t hits[AOI_COUNT];
+
+    mu_check( gac_aoi_raster_build( raster, aois, AOI_COUNT, RASTER_WIDTH,
+                RASTER_HEIGHT ) );
+    mu_check( gac_aoi_raster_build( raster, aois, 0, 16, 16 ) );
+    mu_assert_int_eq( 16, raster->width );
+    mu_assert_int_eq( 1, raster->offsets.count );
+    mu_check( gac_aoi_raster_query( raster, aois, 0.5, 0.5, hits, AOI_COUNT,
+                &count ) );
+    mu_assert_int_eq( 0, count );
+    mu_check( !gac_aoi_raster_build( raster, aois, AOI_COUNT, 0, 16 ) );
+    mu_check( gac_aoi_raster_clear( raster ) );
+    mu_check( !gac_aoi_raster_query( raster, aois, 0.5, 0.5, hits,
+                AOI_COUNT, &count ) );
+}
+
+MU_TEST( raster_collection )
+{
+    int i, j;
+    uint32_t k, count;
+    uint32_t* hits;
+    uint32_t expected[AOI_COUNT];
+    float x, y;
+    gac_aoi_collection_t aoic;
+    bool same = true;
+
+    gac_aoi_collection_init( &aoic );
+    mu_check( gac_aoi_collection_rasterise( &aoic, RASTER_WIDTH,
+                RASTER_HEIGHT ) );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        mu_check( gac_aoi_collection_add( &aoic, &aois[i] ) );
+    }
+    mu_check( aoic.raster.cells != NULL );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        x = 1.4 * rand_unit() - 0.2;
+        y = 1.4 * rand_unit() - 0.2;
+        count = 0;
+        for( j = 0; j < AOI_COUNT; j++ )
+        {
+            if( gac_aoi_includes_point( &aois[j], x, y ) )
+            {
+                expected[count] = j;
+                count++;
+            }
+        }
+        same &= count == gac_aoi_collection_hits( &aoic, x, y, 0, &hits );
+        for( k = 0; k < count && same; k++ )
+        {
+            same &= expected[k] == hits[k];
+        }
+    }
+    mu_check( same );
+
+    mu_check( gac_aoi_collection_rasterise( &aoic, 0, 0 ) );
+    mu_check( aoic.raster.cells == NULL );
+    gac_aoi_collection_destroy( &aoic );
+}
+
+MU_TEST_SUITE( raster_suite )
+{
+    MU_SUITE_CONFIGURE( &raster_setup, &raster_aoi_teardown );
+    MU_RUN_TEST( raster_query );
+    MU_RUN_TEST( raster_query_length );
+    MU_RUN_TEST( raster_query_outside );
+    MU_RUN_TEST( raster_rebuild );
+    MU_RUN_TEST( raster_collection );
+}
+
+int main()
+{
+    MU_RUN_SUITE( raster_init_suite );
+    MU_RUN_SUITE( raster_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,161 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+
+#define AOI_COUNT 40
+
+static gac_aoi_scanpath_t scanpath_stack;
+static gac_aoi_scanpath_t* scanpath_heap;
+static gac_aoi_scanpath_t* scanpath;
+
+void scanpath_setup()
+{
+    gac_aoi_scanpath_init( &scanpath_stack );
+    scanpath = &scanpath_stack;
+}
+
+void scanpath_teardown()
+{
+    gac_aoi_scanpath_destroy( scanpath );
+}
+
+MU_TEST( scanpath_init_stack )
+{
+    mu_check( gac_aoi_scanpath_init( &scanpath_stack ) );
+    scanpath = &scanpath_stack;
+    mu_assert_int_eq( 0, scanpath->aois.count );
+    mu_assert_int_eq( 0, gac_aoi_scanpath_get_transition_count( scanpath, 0,
+                1 ) );
+}
+
+MU_TEST( scanpath_init_heap )
+{
+    scanpath_heap = gac_aoi_scanpath_create();
+    scanpath = scanpath_heap;
+    mu_check( scanpath != NULL );
+    mu_assert_int_eq( 0, scanpath->transitions.count );
+}
+
+MU_TEST_SUITE( scanpath_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &scanpath_teardown );
+    MU_RUN_TEST( scanpath_init_stack );
+    MU_RUN_TEST( scanpath_init_heap );
+}
+
+MU_TEST( scanpath_add )
+{
+    uint32_t i;
+    uint32_t sequence[7] = { 3, 5, 3, 5, 5, 1, 3 };
+
+    for( i = 0; i < 7; i++ )
+    {
+        mu_check( gac_aoi_scanpath_add( scanpath, sequence[i],
+                    100 * i ) );
+    }
+    mu_assert_int_eq( 7, scanpath->aois.count );
+    for( i = 0; i < 7; i++ )
+    {
+        mu_assert_int_eq( sequence[i], scanpath->aois.items[i] );
+        mu_assert_double_eq( 100 * i, scanpath->aois.durations[i] );
+    }
+
+    // transitions are listed in order of their first occurrence
+    mu_assert_int_eq( 5, scanpath->transitions.count );
+    mu_assert_int_eq( 3, scanpath->transitions.items[0].from );
+    mu_assert_int_eq( 5, scanpath->transitions.items[0].to );
+    mu_assert_int_eq( 2, scanpath->transitions.items[0].count );
+    mu_assert_int_eq( 2, gac_aoi_scanpath_get_transition_count( scanpath, 3,
+                5 ) );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count( scanpath, 5,
+                3 ) );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count( scanpath, 5,
+                5 ) );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count( scanpath, 5,
+                1 ) );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count( scanpath, 1,
+                3 ) );
+    mu_assert_int_eq( 0, gac_aoi_scanpath_get_transition_count( scanpath, 3,
+                1 ) );
+}
+
+MU_TEST( scanpath_grow )
+{
+    uint32_t i, j;
+    uint32_t count = 0;
+    bool same = true;
+
+    // visit every ordered pair of distinct AOIs twice to force a rehash
+    for( i = 0; i < 2; i++ )
+    {
+        for( j = 0; j < AOI_COUNT * AOI_COUNT; j++ )
+        {
+            mu_check( gac_aoi_scanpath_add( scanpath, j / AOI_COUNT,
+                        100 ) );
+            mu_check( gac_aoi_scanpath_add( scanpath, j % AOI_COUNT,
+                        100 ) );
+        }
+    }
+    mu_check( scanpath->buckets.length >= 2 * scanpath->transitions.count );
+    for( i = 0; i < scanpath->transitions.count; i++ )
+    {
+        same &= scanpath->transitions.items[i].count
+            == gac_aoi_scanpath_get_transition_count( scanpath,
+                    scanpath->transitions.items[i].from,
+                    scanpath->transitions.items[i].to );
+        count += scanpath->transitions.items[i].count;
+    }
+    mu_check( same );
+    mu_assert_int_eq( scanpath->aois.count - 1, count );
+    mu_assert_int_eq( 4, gac_aoi_scanpath_get_transition_count( scanpath, 1,
+                2 ) );
+}
+
+MU_TEST( scanpath_clear )
+{
+    uint32_t i;
+    bool empty = true;
+
+    for( i = 0; i < AOI_COUNT * 4; i++ )
+    {
+        gac_aoi_scanpath_add( scanpath, ( i * 7 ) % AOI_COUNT, 100 );
+    }
+    mu_check( gac_aoi_scanpath_clear( scanpath ) );
+    mu_assert_int_eq( 0, scanpath->aois.count );
+    mu_assert_int_eq( 0, scanpath->transitions.count );
+    for( i = 0; i < scanpath->buckets.length; i++ )
+    {
+        empty &= scanpath->buckets.items[i] == 0;
+    }
+    mu_check( empty );
+
+    // the scanpath is reusable after clearing it
+    gac_aoi_scanpath_add( scanpath, 2, 100 );
+    gac_aoi_scanpath_add( scanpath, 9, 100 );
+    mu_assert_int_eq( 1, scanpath->transitions.count );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_get_transition_count( scanpath, 2,
+                9 ) );
+    mu_assert_int_eq( 0, gac_aoi_scanpath_get_transition_count( scanpath, 0,
+                7 ) );
+}
+
+MU_TEST_SUITE( scanpath_suite )
+{
+    MU_SUITE_CONFIGURE( &scanpath_setup, &scanpath_teardown );
+    MU_RUN_TEST( scanpath_add );
+    MU_RUN_TEST( scanpath_grow );
+    MU_RUN_TEST( scanpath_clear );
+}
+
+int main()
+{
+    MU_RUN_SUITE( scanpath_init_suite );
+    MU_RUN_SUITE( scanpath_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,253 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <stdlib.h>
+
+#define SEQ_LENGTH 300
+#define PAIR_COUNT 200
+
+static gac_aoi_scanpath_compare_t cmp_stack;
+static gac_aoi_scanpath_compare_t* cmp_heap;
+static gac_aoi_scanpath_compare_t* cmp;
+static uint32_t seq_a[SEQ_LENGTH];
+static uint32_t seq_b[SEQ_LENGTH];
+static uint32_t dp[SEQ_LENGTH + 1];
+
+uint32_t levenshtein_naive( const uint32_t* a, uint32_t a_count,
+        const uint32_t* b, uint32_t b_count )
+{
+    uint32_t i, j;
+    uint32_t diag, up, best;
+
+    for( j = 0; j <= b_count; j++ )
+    {
+        dp[j] = j;
+    }
+    for( i = 1; i <= a_count; i++ )
+    {
+        diag = dp[0];
+        dp[0] = i;
+        for( j = 1; j <= b_count; j++ )
+        {
+            up = dp[j];
+            best = diag + ( a[i - 1] != b[j - 1] );
+            if( up + 1 < best )
+            {
+                best = up + 1;
+            }
+            if( dp[j - 1] + 1 < best )
+            {
+                best = dp[j - 1] + 1;
+            }
+            diag = up;
+            dp[j] = best;
+        }
+    }
+
+    return dp[b_count];
+}
+
+void cmp_setup()
+{
+    srand( 42 );
+    gac_aoi_scanpath_compare_init( &cmp_stack );
+    cmp = &cmp_stack;
+}
+
+void cmp_teardown()
+{
+    gac_aoi_scanpath_compare_destroy( cmp );
+}
+
+MU_TEST( cmp_init_stack )
+{
+    double score;
+
+    mu_check( gac_aoi_scanpath_compare_init( &cmp_stack ) );
+    cmp = &cmp_stack;
+    // ScanMatch requires a substitution matrix
+    mu_check( !gac_aoi_scanpath_compare_scanmatch( cmp, seq_a, NULL, 0,
+                seq_b, NULL, 0, &score ) );
+}
+
+MU_TEST( cmp_init_heap )
+{
+    cmp_heap = gac_aoi_scanpath_compare_create();
+    cmp = cmp_heap;
+    mu_check( cmp != NULL );
+    mu_assert_int_eq( 0, cmp->peq.length );
+}
+
+MU_TEST_SUITE( cmp_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &cmp_teardown );
+    MU_RUN_TEST( cmp_init_stack );
+    MU_RUN_TEST( cmp_init_heap );
+}
+
+MU_TEST( cmp_levenshtein )
+{
+    uint32_t distance;
+    uint32_t a[6] = { 1, 2, 3, 3, 4, 5 };
+    uint32_t b[7] = { 7, 2, 3, 4, 4, 5, 6 };
+
+    mu_check( gac_aoi_scanpath_compare_levenshtein( cmp, a, 6, b, 7,
+                &distance ) );
+    mu_assert_int_eq( 3, distance );
+    mu_check( gac_aoi_scanpath_compare_levenshtein( cmp, b, 7, a, 6,
+                &distance ) );
+    mu_assert_int_eq( 3, distance );
+    mu_check( gac_aoi_scanpath_compare_levenshtein( cmp, a, 6, a, 6,
+                &distance ) );
+    mu_assert_int_eq( 0, distance );
+    mu_check( gac_aoi_scanpath_compare_levenshtein( cmp, a, 0, b, 7,
+                &distance ) );
+    mu_assert_int_eq( 7, distance );
+    mu_check( gac_aoi_scanpath_compare_levenshtein( cmp, NULL, 0, NULL, 0,
+                &distance ) );
+    mu_assert_int_eq( 0, distance );
+}
+
+MU_TEST( cmp_levenshtein_random )
+{
+    uint32_t i, k;
+    uint32_t a_count, b_count, alphabet;
+    uint32_t distance;
+    bool same = true;
+    bool ok = true;
+
+    // cover single and multiple words of the bit vectors
+    for( k = 0; k < PAIR_COUNT; k++ )
+    {
+        a_count = rand() % SEQ_LENGTH;
+        b_count = rand() % SEQ_LENGTH;
+        alphabet = k % 2 == 0 ? 4 : 500;
+        for( i = 0; i < a_count; i++ )
+        {
+            seq_a[i] = rand() % alphabet;
+        }
+        for( i = 0; i < b_count; i++ )
+        {
+            // similar sequences with a few random changes
+            seq_b[i] = i < a_count && rand() % 4 != 0 ? seq_a[i]
+                : ( uint32_t )( rand() % alphabet );
+        }
+        ok &= gac_aoi_scanpath_compare_levenshtein( cmp, seq_a, a_count,
+                seq_b, b_count, &distance );
+        same &= distance == levenshtein_naive( seq_a, a_count, seq_b,
+                b_count );
+    }
+    mu_check( ok );
+    mu_check( same );
+
+    // the match masks are cleared after each comparison
+    same = true;
+    for( i = 0; i < cmp->peq.length; i++ )
+    {
+        same &= cmp->peq.items[i] == 0;
+    }
+    mu_check( same );
+}
+
+MU_TEST( cmp_scanmatch )
+{
+    double score;
+    uint32_t a[3] = { 0, 1, 2 };
+    uint32_t b[3] = { 0, 2, 1 };
+    double durations[3] = { 100, 200, 100 };
+    double b_durations[3] = { 100, 100, 200 };
+    double substitution[9] = {
+        2, 0, -1,
+        0, 2, 0,
+        -1, 0, 2
+    };
+
+    mu_check( gac_aoi_scanpath_compare_set_substitution( cmp, substitution,
+                3, 0, 0 ) );
+    mu_check( gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 3, a,
+                durations, 3, &score ) );
+    mu_assert_double_eq( 1, score );
+
+    // without bins: 0-0 matches, best alignment of 1 2 and 2 1 scores 2
+    mu_check( gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 3, b,
+                b_durations, 3, &score ) );
+    mu_assert_double_eq( 4.0 / 6, score );
+
+    // with bins of 100ms: 0 1 1 2 and 0 2 1 1 align 0 1 1 and 0 1 1
+    mu_check( gac_aoi_scanpath_compare_set_substitution( cmp, substitution,
+                3, 0, 100 ) );
+    mu_assert_int_eq( 2, gac_aoi_scanpath_compare_bin_count( cmp, 160 ) );
+    mu_assert_int_eq( 1, gac_aoi_scanpath_compare_bin_count( cmp, 20 ) );
+    mu_check( gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 3, b,
+                b_durations, 3, &score ) );
+    mu_assert_double_eq( 6.0 / 8, score );
+
+    // gaps are penalised
+    mu_check( gac_aoi_scanpath_compare_set_substitution( cmp, substitution,
+                3, -1, 100 ) );
+    mu_check( gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 3, a,
+                durations, 1, &score ) );
+    mu_assert_double_eq( ( 2.0 - 3 ) / 8, score );
+
+    // AOIs must be covered by the substitution matrix
+    a[0] = 3;
+    mu_check( !gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 3, b,
+                b_durations, 3, &score ) );
+    mu_check( gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 0, b,
+                b_durations, 0, &score ) );
+    mu_assert_double_eq( 0, score );
+}
+
+MU_TEST( cmp_scanmatch_aois )
+{
+    int i;
+    double score;
+    gac_aoi_t aois[3];
+    uint32_t a[2] = { 0, 1 };
+    uint32_t b[2] = { 0, 2 };
+    double durations[2] = { 100, 100 };
+
+    for( i = 0; i < 3; i++ )
+    {
+        gac_aoi_init( &aois[i], NULL );
+        gac_aoi_add_rect( &aois[i], 0.125 * i, 0, 0.125, 0.125 );
+    }
+    mu_check( gac_aoi_scanpath_compare_set_aois( cmp, aois, 3, 0.5, 0, 0 ) );
+    mu_assert_int_eq( 3, cmp->scanmatch.aoi_count );
+    mu_assert_double_eq( 1, cmp->scanmatch.substitution[0] );
+    mu_assert_double_eq( 0.75, cmp->scanmatch.substitution[1] );
+    mu_assert_double_eq( 0.5, cmp->scanmatch.substitution[2] );
+    mu_assert_double_eq( 0.75, cmp->scanmatch.substitution[5] );
+
+    mu_check( gac_aoi_scanpath_compare_scanmatch( cmp, a, durations, 2, b,
+                durations, 2, &score ) );
+    mu_assert_double_eq( 0.875, score );
+    mu_check( !gac_aoi_scanpath_compare_set_aois( cmp, aois, 3, 0, 0, 0 ) );
+
+    for( i = 0; i < 3; i++ )
+    {
+        gac_aoi_destroy( &aois[i] );
+    }
+}
+
+MU_TEST_SUITE( cmp_suite )
+{
+    MU_SUITE_CONFIGURE( &cmp_setup, &cmp_teardown );
+    MU_RUN_TEST( cmp_levenshtein );
+    MU_RUN_TEST( cmp_levenshtein_random );
+    MU_RUN_TEST( cmp_scanmatch );
+    MU_RUN_TEST( cmp_scanmatch_aois );
+}
+
+int main()
+{
+    MU_RUN_SUITE( cmp_init_suite );
+    MU_RUN_SUITE( cmp_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
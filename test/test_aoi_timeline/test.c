@@ -0,0 +1,228 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <stdlib.h>
+
+#define AOI_COUNT 60
+#define QUERY_COUNT 2000
+#define DURATION 10000.0
+
+static gac_aoi_timeline_t timeline_stack;
+static gac_aoi_timeline_t* timeline_heap;
+static gac_aoi_timeline_t* timeline;
+static gac_aoi_t aois[AOI_COUNT];
+
+float rand_unit()
+{
+    return ( float )rand() / RAND_MAX;
+}
+
+void timeline_setup()
+{
+    int i;
+    double start;
+    float x[3] = { 0.1, 0.3, 0.2 };
+    float y[3] = { 0.1, 0.1, 0.3 };
+
+    srand( 42 );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        gac_aoi_init( &aois[i], NULL );
+        start = DURATION * rand_unit();
+        if( i % 3 == 0 )
+        {
+            // static AOIs are not indexed
+            gac_aoi_add_rect( &aois[i], 0.1, 0.1, 0.2, 0.2 );
+        }
+        else if( i % 3 == 1 )
+        {
+            gac_aoi_add_keyframe( &aois[i], start, x, y, 3 );
+            gac_aoi_add_keyframe( &aois[i], start + 500 * rand_unit() + 1, x,
+                    y, 3 );
+        }
+        else
+        {
+            gac_aoi_add_rect( &aois[i], 0.1, 0.1, 0.2, 0.2 );
+            gac_aoi_add_interval( &aois[i], start, start + 100 );
+            gac_aoi_add_interval( &aois[i], start + 300, start + 400 );
+        }
+    }
+    gac_aoi_timeline_init( &timeline_stack );
+    timeline = &timeline_stack;
+}
+
+void timeline_teardown()
+{
+    gac_aoi_timeline_destroy( timeline );
+}
+
+void timeline_aoi_teardown()
+{
+    int i;
+
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        gac_aoi_destroy( &aois[i] );
+    }
+    gac_aoi_timeline_destroy( timeline );
+}
+
+MU_TEST( timeline_init_stack )
+{
+    uint32_t* candidates;
+
+    mu_check( gac_aoi_timeline_init( &timeline_stack ) );
+    timeline = &timeline_stack;
+    mu_assert_int_eq( 0, gac_aoi_timeline_query( timeline, 0,
+                &candidates ) );
+}
+
+MU_TEST( timeline_init_heap )
+{
+    timeline_heap = gac_aoi_timeline_create();
+    timeline = timeline_heap;
+    mu_check( timeline != NULL );
+    mu_assert_int_eq( 0, timeline->indices.count );
+}
+
+MU_TEST_SUITE( timeline_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &timeline_teardown );
+    MU_RUN_TEST( timeline_init_stack );
+    MU_RUN_TEST( timeline_init_heap );
+}
+
+MU_TEST( timeline_query )
+{
+    int i, j;
+    uint32_t k, count;
+    uint32_t* candidates;
+    double timestamp;
+    bool hit;
+    bool in_order = true;
+    bool is_dynamic = true;
+    uint32_t expected = 0;
+    uint32_t found = 0;
+
+    mu_check( gac_aoi_timeline_build( timeline, aois, AOI_COUNT ) );
+    mu_check( timeline->bin_count > 1 );
+
+    for( i = 0; i < QUERY_COUNT; i++ )
+    {
+        timestamp = 1.2 * DURATION * rand_unit() - 0.1 * DURATION;
+        count = gac_aoi_timeline_query( timeline, timestamp, &candidates );
+        for( k = 0; k < count; k++ )
+        {
+            in_order &= k == 0 || candidates[k - 1] < candidates[k];
+            is_dynamic &= gac_aoi_is_dynamic( &aois[candidates[k]] );
+        }
+        for( j = 0; j < AOI_COUNT; j++ )
+        {
+            if( !gac_aoi_is_dynamic( &aois[j] )
+                    || !gac_aoi_is_visible( &aois[j], timestamp ) )
+            {
+                continue;
+            }
+            expected++;
+            hit = false;
+            for( k = 0; k < count; k++ )
+            {
+                hit |= candidates[k] == j;
+            }
+            found += hit;
+        }
+    }
+    mu_check( in_order );
+    mu_check( is_dynamic );
+    mu_check( expected > 0 );
+    mu_assert_int_eq( expected, found );
+}
+
+MU_TEST( timeline_query_bounds )
+{
+    int i;
+    uint32_t k, count;
+    uint32_t* candidates;
+    double start, end;
+    bool hit;
+
+    mu_check( gac_aoi_timeline_build( timeline, aois, AOI_COUNT ) );
+    for( i = 0; i < AOI_COUNT; i++ )
+    {
+        if( !gac_aoi_is_dynamic( &aois[i] ) )
+        {
+            continue;
+        }
+        mu_check( gac_aoi_timeline_span( &aois[i], 0, &start, &end ) );
+        count = gac_aoi_timeline_query( timeline, end, &candidates );
+        hit = false;
+        for( k = 0; k < count; k++ )
+        {
+            hit |= candidates[k] == i;
+        }
+        mu_check( hit );
+    }
+}
+
+MU_TEST( timeline_rebuild )
+{
+    int i;
+    uint32_t* candidates;
+    gac_aoi_t dynamic_aois[2];
+
+    // all intervals of the first AOI fall into the first bin
+    for( i = 0; i < 2; i++ )
+    {
+        gac_aoi_init( &dynamic_aois[i], NULL );
+        gac_aoi_add_rect( &dynamic_aois[i], 0.1, 0.1, 0.2, 0.2 );
+    }
+    gac_aoi_add_interval( &dynamic_aois[0], 0, 1 );
+    gac_aoi_add_interval( &dynamic_aois[0], 2, 3 );
+    gac_aoi_add_interval( &dynamic_aois[0], 4, 5 );
+    gac_aoi_add_interval( &dynamic_aois[1], 0, 100 );
+    mu_check( gac_aoi_timeline_build( timeline, dynamic_aois, 2 ) );
+    mu_assert_int_eq( 4, timeline->bin_count );
+    mu_assert_int_eq( 5, timeline->indices.count );
+    mu_assert_int_eq( 2, gac_aoi_timeline_query( timeline, 1.5,
+                &candidates ) );
+    mu_assert_int_eq( 0, candidates[0] );
+    mu_assert_int_eq( 1, candidates[1] );
+    mu_assert_int_eq( 1, gac_aoi_timeline_query( timeline, 50,
+                &candidates ) );
+    mu_assert_int_eq( 1, candidates[0] );
+    mu_assert_int_eq( 0, gac_aoi_timeline_query( timeline, 101,
+                &candidates ) );
+    mu_assert_int_eq( 0, gac_aoi_timeline_query( timeline, NAN,
+                &candidates ) );
+    for( i = 0; i < 2; i++ )
+    {
+        gac_aoi_destroy( &dynamic_aois[i] );
+    }
+
+    mu_check( gac_aoi_timeline_build( timeline, aois, AOI_COUNT ) );
+    mu_check( gac_aoi_timeline_build( timeline, aois, 1 ) );
+    mu_assert_int_eq( 0, timeline->bin_count );
+    mu_assert_int_eq( 0, gac_aoi_timeline_query( timeline, DURATION / 2,
+                &candidates ) );
+}
+
+MU_TEST_SUITE( timeline_suite )
+{
+    MU_SUITE_CONFIGURE( &timeline_setup, &timeline_aoi_teardown );
+    MU_RUN_TEST( timeline_query );
+    MU_RUN_TEST( timeline_query_bounds );
+    MU_RUN_TEST( timeline_rebuild );
+}
+
+int main()
+{
+    MU_RUN_SUITE( timeline_init_suite );
+    MU_RUN_SUITE( timeline_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,240 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include "gac_csv_parallel.h"
+#include <string.h>
+
+#define HEADER "sx,sy,px,py,pz,ox,oy,oz,timestamp,trial_id,label,svalid," \
+    "pvalid,ovalid\n"
+#define LINE_COUNT 20000
+
+static gac_csv_parallel_t cp_stack;
+static gac_csv_parallel_t* cp_heap;
+static gac_csv_parallel_t* cp;
+static gac_label_table_t labels;
+static FILE* fp;
+
+void fp_setup()
+{
+    uint32_t i;
+    char line[256];
+    const char* label_strings[3] = { "", "fixation cross", "" };
+
+    // every 7th line is invalid, every 1000th line is malformed, and the
+    // label changes every 3000 lines
+    fp = tmpfile();
+    fputs( HEADER, fp );
+    for( i = 0; i < LINE_COUNT; i++ )
+    {
+        sprintf( line, "%f,0.5,%d,1,2,3,4,5,%d.25,%d,%s,%s,True,True%s",
+                i / ( double )LINE_COUNT, i, i, i / 5000,
+                label_strings[( i / 3000 ) % 3], i % 7 == 0 ? "False" : "True",
+                i % 1000 == 999 ? ",\n" : "\n" );
+        if( i % 1000 == 999 )
+        {
+            line[0] = 'x';
+        }
+        if( ( i / 3000 ) % 3 == 2 )
+        {
+            // escape the label
+            sprintf( line, "%f,0.5,%d,1,2,3,4,5,%d.25,%d,"
+                    "\"\"\"quoted\"\", label\",%s,True,True\n",
+                    i / ( double )LINE_COUNT, i, i, i / 5000,
+                    i % 7 == 0 ? "False" : "True" );
+        }
+        fputs( line, fp );
+    }
+    // the last line has no line break
+    fputs( "0.5,0.5,1,2,3,4,5,6,99999,9,end,True,True,True", fp );
+    fflush( fp );
+    gac_label_table_init( &labels );
+}
+
+void fp_teardown()
+{
+    gac_csv_parallel_destroy( cp );
+    gac_label_table_destroy( &labels );
+    fclose( fp );
+}
+
+void parallel_compare( uint32_t worker_count, uint32_t chunk_size )
+{
+    uint32_t i;
+    uint32_t pos = 0;
+    gac_label_table_t seq_labels;
+    gac_csv_reader_t reader;
+    gac_sample_batch_t batch;
+    gac_sample_batch_t seq_batch;
+
+    gac_csv_parallel_init( &cp_stack, fp, &labels, worker_count );
+    cp = &cp_stack;
+    cp->chunk_size = chunk_size;
+
+    rewind( fp );
+    gac_label_table_init( &seq_labels );
+    gac_csv_reader_init( &reader, fp, &seq_labels, 1 << 20 );
+    gac_csv_reader_read( &reader, &seq_batch );
+
+    while( gac_csv_parallel_read( cp, &batch ) )
+    {
+        mu_check( batch.screen_x != NULL );
+        mu_check( batch.label_id != NULL );
+        for( i = 0; i < batch.count; i++ )
+        {
+            mu_check( pos < seq_batch.count );
+            mu_check( batch.screen_x[i] == seq_batch.screen_x[pos] );
+            mu_check( batch.point_x[i] == seq_batch.point_x[pos] );
+            mu_check( batch.origin_z[i] == seq_batch.origin_z[pos] );
+            mu_check( batch.timestamp[i] == seq_batch.timestamp[pos] );
+            mu_assert_int_eq( seq_batch.trial_id[pos], batch.trial_id[i] );
+            mu_assert_string_eq(
+                    gac_label_table_get( &seq_labels,
+                        seq_batch.label_id[pos] ),
+                    gac_label_table_get( &labels, batch.label_id[i] ) );
+            pos++;
+        }
+    }
+    mu_assert_int_eq( seq_batch.count, pos );
+    mu_assert_int_eq( reader.stats.line_count, cp->reader.stats.line_count );
+    mu_assert_int_eq( reader.stats.sample_count,
+            cp->reader.stats.sample_count );
+    mu_assert_int_eq( reader.stats.invalid_count,
+            cp->reader.stats.invalid_count );
+    mu_assert_int_eq( reader.stats.error_count,
+            cp->reader.stats.error_count );
+    mu_check( !gac_csv_parallel_read( cp, &batch ) );
+
+    gac_csv_reader_destroy( &reader );
+    gac_label_table_destroy( &seq_labels );
+}
+
+MU_TEST( parallel_init_stack )
+{
+    mu_check( gac_csv_parallel_init( &cp_stack, fp, &labels, 2 ) );
+    cp = &cp_stack;
+    mu_assert_int_eq( 2, cp->workers.count );
+    mu_check( cp->data != NULL );
+    mu_check( !cp->is_started );
+}
+
+MU_TEST( parallel_init_heap )
+{
+    cp_heap = gac_csv_parallel_create( fp, NULL, 0 );
+    cp = cp_heap;
+    mu_check( cp != NULL );
+    mu_check( cp->workers.count > 0 );
+    mu_check( gac_csv_parallel_create( NULL, NULL, 1 ) == NULL );
+}
+
+MU_TEST_SUITE( parallel_init_suite )
+{
+    MU_SUITE_CONFIGURE( &fp_setup, &fp_teardown );
+    MU_RUN_TEST( parallel_init_stack );
+    MU_RUN_TEST( parallel_init_heap );
+}
+
+MU_TEST( parallel_one_worker )
+{
+    parallel_compare( 1, 0 );
+}
+
+MU_TEST( parallel_workers )
+{
+    parallel_compare( 3, 200000 );
+}
+
+MU_TEST( parallel_small_chunks )
+{
+    // chunks are shorter than lines, hence, many chunks are empty
+    parallel_compare( 4, 37 );
+}
+
+MU_TEST( parallel_stop )
+{
+    gac_sample_batch_t batch;
+
+    // destroying the reader stops workers waiting for their batch handover
+    gac_csv_parallel_init( &cp_stack, fp, NULL, 4 );
+    cp = &cp_stack;
+    cp->chunk_size = 4096;
+    mu_check( gac_csv_parallel_read( cp, &batch ) );
+    mu_check( batch.label_id == NULL );
+    mu_check( gac_csv_parallel_read( cp, &batch ) );
+}
+
+MU_TEST( parallel_columns )
+{
+    uint32_t count = 0;
+    FILE* fp_columns;
+    gac_csv_parallel_t* cp_columns;
+    gac_sample_batch_t batch;
+
+    fp_columns = tmpfile();
+    fputs( "10;1;2;3;4;5;6\n20;1;2;3;4;5;6\n", fp_columns );
+    fflush( fp_columns );
+    cp_columns = gac_csv_parallel_create( fp_columns, NULL, 2 );
+    fclose( fp_columns );
+    cp_columns->chunk_size = 8;
+    cp_columns->reader.delimiter = ';';
+    cp_columns->reader.skip_lines = 0;
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_TIMESTAMP,
+            0 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_ORIGIN_X,
+            1 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_ORIGIN_Y,
+            2 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_ORIGIN_Z,
+            3 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_POINT_X,
+            4 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_POINT_Y,
+            5 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_POINT_Z,
+            6 );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_SCREEN_X,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_SCREEN_Y,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( &cp_columns->reader,
+            GAC_CSV_FIELD_ORIGIN_VALID, GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( &cp_columns->reader,
+            GAC_CSV_FIELD_SCREEN_VALID, GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( &cp_columns->reader,
+            GAC_CSV_FIELD_POINT_VALID, GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_TRIAL_ID,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( &cp_columns->reader, GAC_CSV_FIELD_LABEL,
+            GAC_CSV_COLUMN_NONE );
+    while( gac_csv_parallel_read( cp_columns, &batch ) )
+    {
+        mu_check( batch.screen_x == NULL );
+        mu_check( batch.trial_id == NULL );
+        mu_assert_double_eq( 10 * ( count + 1 ), batch.timestamp[0] );
+        count += batch.count;
+    }
+    mu_assert_int_eq( 2, count );
+    gac_csv_parallel_destroy( cp_columns );
+}
+
+MU_TEST_SUITE( parallel_suite )
+{
+    MU_SUITE_CONFIGURE( &fp_setup, &fp_teardown );
+    MU_RUN_TEST( parallel_one_worker );
+    MU_RUN_TEST( parallel_workers );
+    MU_RUN_TEST( parallel_small_chunks );
+    MU_RUN_TEST( parallel_stop );
+    MU_RUN_TEST( parallel_columns );
+}
+
+int main()
+{
+    MU_RUN_SUITE( parallel_init_suite );
+    MU_RUN_SUITE( parallel_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,356 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include "gac_csv_reader.h"
+#include <math.h>
+#include <string.h>
+
+#define HEADER "sx,sy,px,py,pz,ox,oy,oz,timestamp,trial_id,label,svalid," \
+    "pvalid,ovalid\n"
+
+static gac_csv_reader_t reader_stack;
+static gac_csv_reader_t* reader_heap;
+static gac_csv_reader_t* reader;
+static gac_label_table_t labels;
+static FILE* fp;
+
+bool parse_double( const char* str, double* value )
+{
+    return gac_csv_reader_parse_double( str, str + strlen( str ), value );
+}
+
+void reader_open( const char* content, uint32_t batch_length )
+{
+    fp = tmpfile();
+    fputs( content, fp );
+    rewind( fp );
+    gac_label_table_init( &labels );
+    gac_csv_reader_init( &reader_stack, fp, &labels, batch_length );
+    reader = &reader_stack;
+}
+
+void reader_teardown()
+{
+    gac_csv_reader_destroy( reader );
+    if( fp != NULL )
+    {
+        fclose( fp );
+        fp = NULL;
+        gac_label_table_destroy( &labels );
+    }
+}
+
+MU_TEST( reader_init_stack )
+{
+    mu_check( gac_csv_reader_init( &reader_stack, NULL, NULL, 0 ) );
+    reader = &reader_stack;
+    mu_assert_int_eq( GAC_CSV_READER_BATCH_LENGTH, reader->samples.length );
+    mu_assert_int_eq( GAC_CSV_FIELD_COUNT, reader->fields.count );
+    mu_assert_int_eq( GAC_CSV_FIELD_LABEL,
+            reader->fields.items[GAC_CSV_FIELD_LABEL] );
+    mu_check( reader->is_eof );
+}
+
+MU_TEST( reader_init_heap )
+{
+    gac_sample_batch_t batch;
+
+    reader_heap = gac_csv_reader_create( NULL, NULL, 16 );
+    reader = reader_heap;
+    mu_check( reader != NULL );
+    mu_assert_int_eq( 16, reader->samples.length );
+    mu_check( !gac_csv_reader_read( reader, &batch ) );
+    mu_assert_int_eq( 0, batch.count );
+}
+
+MU_TEST_SUITE( reader_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &reader_teardown );
+    MU_RUN_TEST( reader_init_stack );
+    MU_RUN_TEST( reader_init_heap );
+}
+
+MU_TEST( parse_double_value )
+{
+    double value;
+
+    mu_check( parse_double( "0", &value ) );
+    mu_assert_double_eq( 0, value );
+    mu_check( parse_double( "-0.0", &value ) );
+    mu_check( value == 0 && signbit( value ) );
+    mu_check( parse_double( "12.5", &value ) );
+    mu_check( value == 12.5 );
+    mu_check( parse_double( " -298.64031982421875 ", &value ) );
+    mu_check( value == -298.64031982421875 );
+    mu_check( parse_double( "0.1", &value ) );
+    mu_check( value == 0.1 );
+    mu_check( parse_double( "+.5", &value ) );
+    mu_check( value == 0.5 );
+    mu_check( parse_double( "3.", &value ) );
+    mu_check( value == 3 );
+    mu_check( parse_double( "1e-3", &value ) );
+    mu_check( value == 1e-3 );
+    mu_check( parse_double( "2.5E+4", &value ) );
+    mu_check( value == 25000 );
+    mu_check( parse_double( "0.000000000000000000000000000001", &value ) );
+    mu_assert_double_eq( 1e-30, value );
+    mu_check( parse_double( "123456789012345678901234", &value ) );
+    mu_assert_double_eq( 1, value / 123456789012345678901234.0 );
+    mu_check( parse_double( "1683721023456.789", &value ) );
+    mu_check( value == 1683721023456.789 );
+    mu_check( parse_double( "1e400", &value ) );
+    mu_check( isinf( value ) );
+    mu_check( parse_double( "NaN", &value ) );
+    mu_check( isnan( value ) );
+    mu_check( parse_double( "nan", &value ) );
+    mu_check( isnan( value ) );
+    mu_check( parse_double( "-inf", &value ) );
+    mu_check( isinf( value ) && value < 0 );
+    mu_check( parse_double( "Infinity", &value ) );
+    mu_check( isinf( value ) && value > 0 );
+}
+
+MU_TEST( parse_double_error )
+{
+    double value;
+
+    mu_check( !parse_double( "", &value ) );
+    mu_check( !parse_double( " ", &value ) );
+    mu_check( !parse_double( "-", &value ) );
+    mu_check( !parse_double( ".", &value ) );
+    mu_check( !parse_double( "1,5", &value ) );
+    mu_check( !parse_double( "1e", &value ) );
+    mu_check( !parse_double( "1.2.3", &value ) );
+    mu_check( !parse_double( "abc", &value ) );
+    mu_check( !parse_double( "infinite", &value ) );
+}
+
+MU_TEST( parse_uint_bool )
+{
+    const char* str;
+    uint32_t value;
+
+    str = "42";
+    mu_check( gac_csv_reader_parse_uint( str, str + 2, &value ) );
+    mu_assert_int_eq( 42, value );
+    str = "4294967295";
+    mu_check( gac_csv_reader_parse_uint( str, str + 10, &value ) );
+    mu_check( value == UINT32_MAX );
+    str = "4294967296";
+    mu_check( !gac_csv_reader_parse_uint( str, str + 10, &value ) );
+    str = "-1";
+    mu_check( !gac_csv_reader_parse_uint( str, str + 2, &value ) );
+    str = "";
+    mu_check( !gac_csv_reader_parse_uint( str, str, &value ) );
+
+    str = "True";
+    mu_check( gac_csv_reader_parse_bool( str, str + 4 ) );
+    str = "true";
+    mu_check( gac_csv_reader_parse_bool( str, str + 4 ) );
+    str = "1";
+    mu_check( gac_csv_reader_parse_bool( str, str + 1 ) );
+    str = "False";
+    mu_check( !gac_csv_reader_parse_bool( str, str + 5 ) );
+    str = "";
+    mu_check( !gac_csv_reader_parse_bool( str, str ) );
+}
+
+MU_TEST_SUITE( parse_suite )
+{
+    MU_RUN_TEST( parse_double_value );
+    MU_RUN_TEST( parse_double_error );
+    MU_RUN_TEST( parse_uint_bool );
+}
+
+MU_TEST( reader_read )
+{
+    gac_sample_batch_t batch;
+
+    reader_open( HEADER
+            "0.5,0.25,1,2,3,4,5,6,100.5,1,\"a,\"\"b\"\"\",True,True,True\r\n"
+            "\n"
+            "NaN,NaN,NaN,NaN,NaN,NaN,NaN,NaN,116,1,,False,False,False\n"
+            "0.5,0.25,1,2,3,4,5,6,abc,1,a,True,True,True\n"
+            "0.5,0.25,1,2\n"
+            "0.75,0.5,7,8,9,10,11,12,133,2,,True,True,True", 0 );
+
+    mu_check( gac_csv_reader_read( reader, &batch ) );
+    mu_assert_int_eq( 2, batch.count );
+    mu_assert_double_eq( 0.5, batch.screen_x[0] );
+    mu_assert_double_eq( 0.25, batch.screen_y[0] );
+    mu_assert_double_eq( 1, batch.point_x[0] );
+    mu_assert_double_eq( 3, batch.point_z[0] );
+    mu_assert_double_eq( 4, batch.origin_x[0] );
+    mu_assert_double_eq( 6, batch.origin_z[0] );
+    mu_assert_double_eq( 100.5, batch.timestamp[0] );
+    mu_assert_int_eq( 1, batch.trial_id[0] );
+    mu_assert_string_eq( "a,\"b\"",
+            gac_label_table_get( &labels, batch.label_id[0] ) );
+    mu_assert_double_eq( 133, batch.timestamp[1] );
+    mu_assert_int_eq( 2, batch.trial_id[1] );
+    mu_assert_int_eq( GAC_LABEL_ID_NONE, batch.label_id[1] );
+
+    mu_check( !gac_csv_reader_read( reader, &batch ) );
+    mu_assert_int_eq( 7, reader->stats.line_count );
+    mu_assert_int_eq( 2, reader->stats.sample_count );
+    mu_assert_int_eq( 1, reader->stats.invalid_count );
+    mu_assert_int_eq( 2, reader->stats.error_count );
+}
+
+MU_TEST( reader_batch )
+{
+    uint32_t i;
+    uint32_t count;
+    uint32_t batch_count;
+    char line[128];
+    gac_sample_batch_t batch;
+
+    // the lines exceed the file buffer several times
+    fp = tmpfile();
+    fputs( HEADER, fp );
+    for( i = 0; i < 10000; i++ )
+    {
+        sprintf( line, "%f,%f,1,2,3,4,5,6,%d,%d,label%d,True,True,True\n",
+                ( i % 100 ) / 100.0, 0.5, i, i / 1000, i / 2500 );
+        fputs( line, fp );
+    }
+    rewind( fp );
+    gac_label_table_init( &labels );
+    gac_csv_reader_init( &reader_stack, fp, &labels, 300 );
+    reader = &reader_stack;
+
+    count = 0;
+    batch_count = 0;
+    while( gac_csv_reader_read( reader, &batch ) )
+    {
+        mu_check( batch.count <= 300 );
+        for( i = 0; i < batch.count; i++ )
+        {
+            mu_assert_double_eq( count, batch.timestamp[i] );
+            mu_assert_int_eq( count / 1000, batch.trial_id[i] );
+            mu_assert_int_eq( count / 2500 + 1, batch.label_id[i] );
+            count++;
+        }
+        batch_count++;
+    }
+    mu_assert_int_eq( 10000, count );
+    mu_assert_int_eq( 34, batch_count );
+    mu_assert_int_eq( 5, labels.labels.count );
+}
+
+MU_TEST( reader_columns )
+{
+    gac_sample_batch_t batch;
+
+    reader_open( "ts;ox;oy;oz;px;py;pz\n"
+            "10;1;2;3;4;5;6\n"
+            "20;1;2;3;4;5;\n", 0 );
+    reader->delimiter = ';';
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_TIMESTAMP, 0 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_ORIGIN_X, 1 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_ORIGIN_Y, 2 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_ORIGIN_Z, 3 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_POINT_X, 4 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_POINT_Y, 5 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_POINT_Z, 6 );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_SCREEN_X,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_SCREEN_Y,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_TRIAL_ID,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_LABEL,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_SCREEN_VALID,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_POINT_VALID,
+            GAC_CSV_COLUMN_NONE );
+    gac_csv_reader_set_column( reader, GAC_CSV_FIELD_ORIGIN_VALID,
+            GAC_CSV_COLUMN_NONE );
+    mu_assert_int_eq( 7, reader->fields.count );
+    mu_check( !gac_csv_reader_set_column( reader, GAC_CSV_FIELD_COUNT, 0 ) );
+
+    mu_check( gac_csv_reader_read( reader, &batch ) );
+    mu_assert_int_eq( 1, batch.count );
+    mu_check( batch.screen_x == NULL );
+    mu_check( batch.trial_id == NULL );
+    mu_check( batch.label_id == NULL );
+    mu_assert_double_eq( 10, batch.timestamp[0] );
+    mu_assert_double_eq( 1, batch.origin_x[0] );
+    mu_assert_double_eq( 6, batch.point_z[0] );
+    mu_assert_int_eq( 1, reader->stats.error_count );
+}
+
+MU_TEST( reader_update_batch )
+{
+    uint32_t i;
+    uint32_t fixation_count;
+    uint32_t saccade_count;
+    uint32_t count = 0;
+    char line[128];
+    gac_t h;
+    gac_sample_batch_t batch;
+    gac_fixation_t fixations[8];
+    gac_saccade_t saccades[8];
+
+    // two fixations separated by a saccade
+    fp = tmpfile();
+    fputs( HEADER, fp );
+    for( i = 0; i < 60; i++ )
+    {
+        sprintf( line, "0.5,0.5,%d,0,600,0,0,0,%f,1,l,True,True,True\n",
+                i < 30 ? 0 : 200, i * 1000.0 / 60.0 );
+        fputs( line, fp );
+    }
+    rewind( fp );
+    gac_init( &h, NULL );
+    gac_csv_reader_init( &reader_stack, fp, &h.labels, 0 );
+    reader = &reader_stack;
+
+    while( gac_csv_reader_read( reader, &batch ) )
+    {
+        count += gac_sample_window_update_batch( &h, &batch, fixations, 8,
+                &fixation_count, saccades, 8, &saccade_count );
+        for( i = 0; i < fixation_count; i++ )
+        {
+            mu_assert_string_eq( "l", gac_get_label( &h,
+                        fixations[i].first_sample.label_id ) );
+            gac_fixation_destroy( &fixations[i] );
+        }
+        for( i = 0; i < saccade_count; i++ )
+        {
+            gac_saccade_destroy( &saccades[i] );
+        }
+        mu_check( fixation_count > 0 );
+        mu_check( saccade_count > 0 );
+    }
+    mu_assert_int_eq( 60, count );
+    gac_destroy( &h );
+    fclose( fp );
+    fp = NULL;
+    gac_csv_reader_destroy( reader );
+    reader = NULL;
+}
+
+MU_TEST_SUITE( reader_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &reader_teardown );
+    MU_RUN_TEST( reader_read );
+    MU_RUN_TEST( reader_batch );
+    MU_RUN_TEST( reader_columns );
+    MU_RUN_TEST( reader_update_batch );
+}
+
+int main()
+{
+    MU_RUN_SUITE( reader_init_suite );
+    MU_RUN_SUITE( parse_suite );
+    MU_RUN_SUITE( reader_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,226 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac_engine.h"
+
+#undef MINUNIT_EPSILON
+#define MINUNIT_EPSILON 1E-7
+
+#define SAMPLE_COUNT 18
+#define STREAM_COUNT 5
+#define WORKER_COUNT 2
+
+static gac_engine_t* engine;
+static gac_engine_t* engine_heap;
+static gac_engine_t engine_stack;
+static gac_filter_parameter_t params;
+
+static float points[SAMPLE_COUNT][3] =
+{
+    { 300, 301, 500 },
+    { 301, 300, 500 },
+    { 300, 299, 500 },
+    { 300, 300, 500 }, // s1 start
+    { 400, 400, 500 },
+    { 500, 500, 500 }, // s1 stop, f1 start
+    { 501, 499, 499 },
+    { 501, 500, 500 },
+    { 499, 499, 500 },
+    { 499, 499, 500 },
+    { 499, 499, 500 },
+    { 499, 499, 500 },
+    { 499, 499, 500 },
+    { 500, 500, 499 },
+    { 500, 500, 499 },
+    { 501, 499, 500 }, // f1 stop, s2 start
+    { 600, 600, 500 }, // s2 stop
+    { 600, 601, 500 }
+};
+
+static float origins[SAMPLE_COUNT][3] =
+{
+    { 495, 505, 10 },
+    { 495, 505, 10 },
+    { 495, 505, 10 },
+    { 495, 505, 10 },
+    { 496, 504, 8 },
+    { 500, 500, 0 },
+    { 501, 501, 0 },
+    { 503, 498, 0 },
+    { 500, 500, 0 },
+    { 503, 499, 1 },
+    { 503, 499, 1 },
+    { 503, 499, 2 },
+    { 503, 499, 3 },
+    { 501, 499, 2 },
+    { 501, 499, 2 },
+    { 502, 500, 1 },
+    { 505, 504, 0 },
+    { 505, 504, 0 }
+};
+
+void engine_setup()
+{
+    params.fixation.dispersion_threshold = 0.5;
+    params.fixation.duration_threshold = 100;
+    params.saccade.velocity_threshold = 25;
+    params.noise.mid_idx = 0;
+    params.noise.type = GAC_FILTER_NOISE_TYPE_AVERAGE;
+    params.gap.max_gap_length = 0;
+    params.gap.sample_period = 1000.0/60.0;
+    gac_engine_init( &engine_stack, STREAM_COUNT, WORKER_COUNT, &params );
+    engine = &engine_stack;
+}
+
+void engine_teardown()
+{
+    gac_engine_destroy( engine );
+}
+
+void push_samples( uint32_t stream_id, const char* label )
+{
+    int i;
+    double timestamp = 1000;
+
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        timestamp += 1000.0 / 60;
+        gac_engine_push( engine, stream_id, NULL, &origins[i], &points[i],
+                timestamp, stream_id, label );
+    }
+}
+
+void avg( int start, int stop, float values[SAMPLE_COUNT][3], float avg[3] )
+{
+    int i, count = 0;
+    avg[0] = 0;
+    avg[1] = 0;
+    avg[2] = 0;
+
+    for( i = start; i <= stop; i++ )
+    {
+        avg[0] += values[i][0];
+        avg[1] += values[i][1];
+        avg[2] += values[i][2];
+        count++;
+    }
+
+    avg[0] /= count;
+    avg[1] /= count;
+    avg[2] /= count;
+}
+
+MU_TEST( engine_init_stack )
+{
+    mu_check( gac_engine_init( &engine_stack, STREAM_COUNT, WORKER_COUNT,
+                NULL ) );
+    engine = &engine_stack;
+    mu_assert_int_eq( STREAM_COUNT, engine->streams.count );
+    mu_assert_int_eq( WORKER_COUNT, engine->workers.count );
+}
+
+MU_TEST( engine_init_heap )
+{
+    engine_heap = gac_engine_create( 2, 0, NULL );
+    engine = engine_heap;
+    mu_check( engine != NULL );
+    mu_assert_int_eq( 2, engine->streams.count );
+    mu_assert_int_eq( 2, engine->workers.count );
+    mu_check( gac_engine_get_handler( engine, 1 ) != NULL );
+    mu_check( gac_engine_get_handler( engine, 2 ) == NULL );
+}
+
+MU_TEST( engine_init_invalid )
+{
+    mu_check( gac_engine_create( 0, 1, NULL ) == NULL );
+    engine = NULL;
+}
+
+MU_TEST_SUITE( engine_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &engine_teardown );
+    MU_RUN_TEST( engine_init_stack );
+    MU_RUN_TEST( engine_init_heap );
+    MU_RUN_TEST( engine_init_invalid );
+}
+
+MU_TEST( engine_streams )
+{
+    int i;
+    uint32_t stream_id;
+    gac_fixation_t fixation;
+    gac_saccade_t saccade;
+    gac_engine_stream_stats_t stats;
+    float point_avg[3];
+
+    for( stream_id = 0; stream_id < STREAM_COUNT; stream_id++ )
+    {
+        push_samples( stream_id, "stimulus" );
+    }
+    mu_check( gac_engine_flush( engine ) );
+    avg( 5, 15, points, point_avg );
+
+    for( stream_id = 0; stream_id < STREAM_COUNT; stream_id++ )
+    {
+        mu_check( gac_engine_get_fixation( engine, stream_id, &fixation ) );
+        mu_assert_double_eq( point_avg[0], fixation.point[0] );
+        mu_assert_double_eq( point_avg[1], fixation.point[1] );
+        mu_assert_double_eq( point_avg[2], fixation.point[2] );
+        mu_assert_double_eq( 10 * 1000.0 / 60, fixation.duration );
+        mu_assert_int_eq( stream_id, fixation.first_sample.trial_id );
+        mu_assert_string_eq( "stimulus", gac_engine_get_label( engine,
+                    stream_id, fixation.first_sample.label_id ) );
+        gac_fixation_destroy( &fixation );
+        mu_check( !gac_engine_get_fixation( engine, stream_id, &fixation ) );
+
+        for( i = 0; i < 2; i++ )
+        {
+            mu_check( gac_engine_get_saccade( engine, stream_id,
+                        &saccade ) );
+            mu_assert_double_eq( i == 0 ? points[3][0] : points[15][0],
+                    saccade.first_sample.point[0] );
+            mu_assert_double_eq( i == 0 ? points[5][0] : points[16][0],
+                    saccade.last_sample.point[0] );
+            gac_saccade_destroy( &saccade );
+        }
+        mu_check( !gac_engine_get_saccade( engine, stream_id, &saccade ) );
+
+        mu_check( gac_engine_get_stream_stats( engine, stream_id, &stats ) );
+        mu_assert_int_eq( SAMPLE_COUNT, stats.pushed_count );
+        mu_assert_int_eq( SAMPLE_COUNT, stats.processed_count );
+        mu_assert_int_eq( 1, stats.fixation_count );
+        mu_assert_int_eq( 2, stats.saccade_count );
+        mu_check( stats.busy_time >= 0 );
+    }
+}
+
+MU_TEST( engine_stream_invalid )
+{
+    gac_fixation_t fixation;
+    gac_engine_stream_stats_t stats;
+
+    mu_check( !gac_engine_push( engine, STREAM_COUNT, NULL, &origins[0],
+                &points[0], 0, 0, NULL ) );
+    mu_check( !gac_engine_get_fixation( engine, STREAM_COUNT, &fixation ) );
+    mu_check( !gac_engine_get_stream_stats( engine, STREAM_COUNT, &stats ) );
+    mu_check( gac_engine_get_label( engine, STREAM_COUNT, 0 ) == NULL );
+}
+
+MU_TEST_SUITE( engine_stream_suite )
+{
+    MU_SUITE_CONFIGURE( &engine_setup, &engine_teardown );
+    MU_RUN_TEST( engine_streams );
+    MU_RUN_TEST( engine_stream_invalid );
+}
+
+int main()
+{
+    MU_RUN_SUITE( engine_init_suite );
+    MU_RUN_SUITE( engine_stream_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
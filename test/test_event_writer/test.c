@@ -0,0 +1,331 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include "gac_event_writer.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static gac_event_writer_t writer_stack;
+static gac_event_writer_t* writer_heap;
+static gac_event_writer_t* writer;
+static gac_label_table_t labels;
+static gac_fixation_t fixation;
+static gac_saccade_t saccade;
+static FILE* fp;
+static char content[8192];
+
+char* number( double value, bool is_float )
+{
+    static char str[GAC_EVENT_WRITER_NUMBER_LENGTH + 1];
+
+    if( gac_event_writer_format_number( str, value, is_float )
+            != strlen( str ) )
+    {
+        return "";
+    }
+    return str;
+}
+
+const char* writer_content()
+{
+    size_t count;
+
+    gac_event_writer_flush( writer );
+    rewind( fp );
+    count = fread( content, 1, sizeof( content ) - 1, fp );
+    content[count] = '\0';
+    return content;
+}
+
+void writer_open( gac_event_writer_format_t format, bool is_async )
+{
+    fp = tmpfile();
+    gac_event_writer_init( &writer_stack, fp, format, &labels, is_async );
+    writer = &writer_stack;
+}
+
+void writer_setup()
+{
+    uint32_t id;
+
+    gac_label_table_init( &labels );
+    gac_label_table_intern( &labels, "a,b", &id );
+    gac_label_table_intern( &labels, "a\"b", &id );
+
+    memset( &fixation, 0, sizeof( gac_fixation_t ) );
+    fixation.first_sample.timestamp = 1000.5;
+    fixation.first_sample.trial_onset = 20;
+    fixation.first_sample.label_onset = 0.25;
+    fixation.first_sample.trial_id = 3;
+    fixation.first_sample.label_id = 1;
+    fixation.screen_point[0] = 0.1;
+    fixation.screen_point[1] = 0.2;
+    fixation.point[0] = 1.5;
+    fixation.point[1] = -2;
+    fixation.point[2] = 600;
+    fixation.duration = 150.25;
+
+    memset( &saccade, 0, sizeof( gac_saccade_t ) );
+    saccade.first_sample.timestamp = 0.25;
+    saccade.first_sample.trial_onset = 1e-7;
+    saccade.first_sample.trial_id = 4;
+    saccade.first_sample.label_id = 2;
+    saccade.first_sample.point[0] = NAN;
+    saccade.last_sample.timestamp = 3.5;
+    saccade.last_sample.screen_point[0] = 1e21;
+}
+
+void writer_teardown()
+{
+    gac_event_writer_destroy( writer );
+    writer = NULL;
+    if( fp != NULL )
+    {
+        fclose( fp );
+        fp = NULL;
+    }
+    gac_label_table_destroy( &labels );
+}
+
+MU_TEST( writer_init_stack )
+{
+    fp = tmpfile();
+    mu_check( gac_event_writer_init( &writer_stack, fp,
+                GAC_EVENT_WRITER_FORMAT_CSV, NULL, false ) );
+    writer = &writer_stack;
+    mu_assert_int_eq( GAC_EVENT_WRITER_BUFFER_LENGTH, writer->buffer.length );
+    mu_assert_int_eq( 0, writer->buffer.count );
+    mu_check( !writer->is_async );
+    mu_check( writer->pending.items == NULL );
+}
+
+MU_TEST( writer_init_heap )
+{
+    fp = tmpfile();
+    writer_heap = gac_event_writer_create( fp,
+            GAC_EVENT_WRITER_FORMAT_NDJSON, NULL, true );
+    writer = writer_heap;
+    mu_check( writer != NULL );
+    mu_check( writer->is_async );
+    mu_assert_int_eq( GAC_EVENT_WRITER_BUFFER_LENGTH, writer->pending.length );
+    mu_check( gac_event_writer_create( NULL, GAC_EVENT_WRITER_FORMAT_CSV,
+                NULL, false ) == NULL );
+}
+
+MU_TEST_SUITE( writer_init_suite )
+{
+    MU_SUITE_CONFIGURE( &writer_setup, &writer_teardown );
+    MU_RUN_TEST( writer_init_stack );
+    MU_RUN_TEST( writer_init_heap );
+}
+
+MU_TEST( format_number_shortest )
+{
+    mu_assert_string_eq( "0.1", number( 0.1, false ) );
+    mu_assert_string_eq( "0.1", number( 0.1f, true ) );
+    mu_assert_string_eq( "0.10000000149011612", number( 0.1f, false ) );
+    mu_assert_string_eq( "100", number( 100, false ) );
+    mu_assert_string_eq( "-0.25", number( -0.25, false ) );
+    mu_assert_string_eq( "1000.5", number( 1000.5, false ) );
+    mu_assert_string_eq( "16.666666666666668", number( 1000.0 / 60, false ) );
+    mu_assert_string_eq( "123456789012", number( 123456789012.0, false ) );
+    mu_assert_string_eq( "0.000001", number( 1e-6, false ) );
+    mu_assert_string_eq( "1e-7", number( 1e-7, false ) );
+    mu_assert_string_eq( "1.5e+21", number( 1.5e21, false ) );
+    mu_assert_string_eq( "100000000000000000000", number( 1e20, false ) );
+    mu_assert_string_eq( "1.0000000000000001e+300", number( 1e300, false ) );
+    mu_assert_string_eq( "1.7976931348623157e+308", number( DBL_MAX, false ) );
+    mu_assert_string_eq( "4.9406564584124654e-324",
+            number( 4.9406564584124654e-324, false ) );
+    mu_assert_string_eq( "3.40282347e+38", number( FLT_MAX, true ) );
+    mu_assert_string_eq( "0", number( 0, false ) );
+    mu_assert_string_eq( "-0", number( -0.0, false ) );
+    mu_assert_string_eq( "NaN", number( NAN, false ) );
+    mu_assert_string_eq( "inf", number( INFINITY, true ) );
+    mu_assert_string_eq( "-inf", number( -INFINITY, false ) );
+}
+
+MU_TEST( format_number_roundtrip )
+{
+    uint32_t i;
+    uint64_t bits = 88172645463325252ull;
+    double value;
+    float value_float;
+    uint32_t bits_float;
+
+    for( i = 0; i < 200000; i++ )
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        memcpy( &value, &bits, sizeof( double ) );
+        if( isfinite( value ) )
+        {
+            mu_check( strtod( number( value, false ), NULL ) == value );
+        }
+        bits_float = bits >> 32;
+        memcpy( &value_float, &bits_float, sizeof( float ) );
+        if( isfinite( value_float ) )
+        {
+            mu_check( strtof( number( value_float, true ), NULL )
+                    == value_float );
+        }
+        // values with few decimals as produced by trackers
+        value = ( ( int64_t )( bits % 2000000 ) - 1000000 ) / 1000.0;
+        mu_check( strlen( number( value, false ) ) <= 9 );
+        mu_check( strtod( number( value, false ), NULL ) == value );
+    }
+}
+
+MU_TEST_SUITE( format_suite )
+{
+    MU_RUN_TEST( format_number_shortest );
+    MU_RUN_TEST( format_number_roundtrip );
+}
+
+MU_TEST( write_csv )
+{
+    writer_open( GAC_EVENT_WRITER_FORMAT_CSV, false );
+    mu_check( gac_event_writer_write_header( writer,
+                GAC_EVENT_TYPE_FIXATION ) );
+    mu_check( gac_event_writer_write_fixation( writer, &fixation ) );
+    fixation.first_sample.label_id = 2;
+    mu_check( gac_event_writer_write_fixation( writer, &fixation ) );
+    mu_check( gac_event_writer_write_saccade( writer, &saccade ) );
+    mu_assert_string_eq( "timestamp,trial_onset,label_onset,trial_id,label,"
+            "sx,sy,px,py,pz,duration\n"
+            "1000.5,20,0.25,3,\"a,b\",0.1,0.2,1.5,-2,600,150.25\n"
+            "1000.5,20,0.25,3,\"a\"\"b\",0.1,0.2,1.5,-2,600,150.25\n"
+            "0.25,1e-7,0,4,\"a\"\"b\",0,0,NaN,0,0,1e+21,0,0,0,0,3.25\n",
+            writer_content() );
+}
+
+MU_TEST( write_ndjson )
+{
+    writer_open( GAC_EVENT_WRITER_FORMAT_NDJSON, false );
+    mu_check( gac_event_writer_write_header( writer,
+                GAC_EVENT_TYPE_FIXATION ) );
+    mu_check( gac_event_writer_write_fixation( writer, &fixation ) );
+    mu_check( gac_event_writer_write_saccade( writer, &saccade ) );
+    mu_check( gac_event_writer_begin( writer, "note" ) );
+    mu_check( gac_event_writer_field_string( writer, "text", "a\\\n\x01" ) );
+    mu_check( gac_event_writer_field_uint( writer, "count", UINT64_MAX ) );
+    mu_check( gac_event_writer_end( writer ) );
+    mu_assert_string_eq( "{\"type\":\"fixation\",\"timestamp\":1000.5,"
+            "\"trial_onset\":20,\"label_onset\":0.25,\"trial_id\":3,"
+            "\"label\":\"a,b\",\"sx\":0.1,\"sy\":0.2,\"px\":1.5,\"py\":-2,"
+            "\"pz\":600,\"duration\":150.25}\n"
+            "{\"type\":\"saccade\",\"timestamp\":0.25,\"trial_onset\":1e-7,"
+            "\"label_onset\":0,\"trial_id\":4,\"label\":\"a\\\"b\","
+            "\"s1x\":0,\"s1y\":0,\"p1x\":null,\"p1y\":0,\"p1z\":0,"
+            "\"s2x\":1e+21,\"s2y\":0,\"p2x\":0,\"p2y\":0,\"p2z\":0,"
+            "\"duration\":3.25}\n"
+            "{\"type\":\"note\",\"text\":\"a\\\\\\u000a\\u0001\","
+            "\"count\":18446744073709551615}\n",
+            writer_content() );
+}
+
+MU_TEST( write_aoi )
+{
+    gac_aoi_collection_analysis_item_t items[2];
+    gac_aoi_collection_analysis_result_t result;
+    gac_aoi_analysis_t* analysis;
+
+    memset( items, 0, sizeof( items ) );
+    strcpy( items[0].label, "aoi0" );
+    analysis = &items[0].analysis;
+    analysis->first_fixation.first_sample.timestamp = 1100;
+    analysis->first_fixation.first_sample.trial_onset = 100;
+    analysis->first_fixation.first_sample.label_onset = 50;
+    analysis->first_fixation.duration = 120;
+    analysis->first_saccade.first_sample.timestamp = 1080;
+    analysis->first_saccade.last_sample.timestamp = 1090;
+    analysis->dwell_time = 240;
+    analysis->dwell_time_relative = 0.5;
+    analysis->aoi_visited_before_count = 1;
+    analysis->enter_saccade_count = 1;
+    analysis->fixation_count_relative = 0.25;
+    analysis->fixation_count = 2;
+    strcpy( items[1].label, "aoi1" );
+    result.aois.items = items;
+    result.aois.count = 2;
+    result.scanpath = NULL;
+    result.trial_id = 7;
+
+    writer_open( GAC_EVENT_WRITER_FORMAT_CSV, false );
+    mu_check( gac_event_writer_write_header( writer, GAC_EVENT_TYPE_AOI ) );
+    mu_check( gac_event_writer_write_aoi( writer, &result ) );
+    mu_assert_string_eq( "trial_id,trial_timestamp,dwell_time,dwell_time_rel,"
+            "first_fixation_duration,first_fixation_onset,"
+            "first_fixation_visited_ia_count,first_saccade_start_onset,"
+            "first_saccade_end_onset,first_saccade_latency,"
+            "enter_saccade_count,fixation_count_rel,fixation_count,label,"
+            "label_onset\n"
+            "7,1000,240,0.5,120,100,1,80,90,30,1,0.25,2,aoi0,50\n",
+            writer_content() );
+}
+
+MU_TEST( write_async )
+{
+    uint32_t i;
+    long size;
+    char* expected;
+    char* actual;
+    FILE* fp_sync;
+    gac_event_writer_t writer_sync;
+
+    // enough events to swap the buffers several times
+    fp_sync = tmpfile();
+    gac_event_writer_init( &writer_sync, fp_sync,
+            GAC_EVENT_WRITER_FORMAT_NDJSON, &labels, false );
+    writer_open( GAC_EVENT_WRITER_FORMAT_NDJSON, true );
+    for( i = 0; i < 50000; i++ )
+    {
+        fixation.first_sample.timestamp = i * ( 1000.0 / 60 );
+        fixation.first_sample.trial_id = i / 1000;
+        mu_check( gac_event_writer_write_fixation( writer, &fixation ) );
+        mu_check( gac_event_writer_write_fixation( &writer_sync,
+                    &fixation ) );
+    }
+    gac_event_writer_destroy( &writer_sync );
+    mu_check( gac_event_writer_flush( writer ) );
+
+    size = ftell( fp_sync );
+    mu_check( size > 4 * GAC_EVENT_WRITER_BUFFER_LENGTH );
+    mu_assert_int_eq( size, ftell( fp ) );
+    expected = malloc( size );
+    actual = malloc( size );
+    rewind( fp_sync );
+    rewind( fp );
+    mu_assert_int_eq( size, fread( expected, 1, size, fp_sync ) );
+    mu_assert_int_eq( size, fread( actual, 1, size, fp ) );
+    mu_check( memcmp( expected, actual, size ) == 0 );
+    free( expected );
+    free( actual );
+    fclose( fp_sync );
+}
+
+MU_TEST_SUITE( writer_suite )
+{
+    MU_SUITE_CONFIGURE( &writer_setup, &writer_teardown );
+    MU_RUN_TEST( write_csv );
+    MU_RUN_TEST( write_ndjson );
+    MU_RUN_TEST( write_aoi );
+    MU_RUN_TEST( write_async );
+}
+
+int main()
+{
+    MU_RUN_SUITE( writer_init_suite );
+    MU_RUN_SUITE( format_suite );
+    MU_RUN_SUITE( writer_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
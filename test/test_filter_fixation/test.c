@@ -6,11 +6,16 @@
 
 #include "minunit.h"
 #include "gac.h"
+#include <stdlib.h>
+#include <string.h>
 
 #undef MINUNIT_EPSILON
 #define MINUNIT_EPSILON 1E-7
 
 #define SAMPLE_COUNT 11
+#define CENTROID_COUNT 120
+#define REFERENCE_COUNT 20000
+#define REFERENCE_OFFSET 1000000
 
 static gac_filter_fixation_t* fixation;
 static gac_filter_fixation_t* fixation_heap;
@@ -104,7 +109,7 @@ MU_TEST_SUITE( h_init_suite )
 bool add_sample( gac_fixation_t* point )
 {
     timestamp += 1000.0 / 60;
-    gac_sample_t* sample = gac_sample_create( &screen_point, &origins[idx], &points[idx], timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &screen_point, &origins[idx], &points[idx], timestamp, 0, GAC_LABEL_ID_NONE );
     idx++;
 
     return gac_filter_fixation( fixation, sample, point );
@@ -173,11 +178,159 @@ MU_TEST( fixation_1 )
     mu_assert_double_eq( 1000 + 3 * 1000.0 / 60, point.first_sample.timestamp );
 }
 
+MU_TEST( fixation_centroid )
+{
+    int i, k;
+    gac_fixation_t point;
+    gac_sample_t* sample;
+    float jitter[CENTROID_COUNT + 1][3];
+    vec3 origin = { 500, 500, 0 };
+    vec3 point_avg;
+
+    for( i = 0; i <= CENTROID_COUNT; i++ )
+    {
+        jitter[i][0] = 500 + 0.1f * sinf( i * 0.7f );
+        jitter[i][1] = 500 + 0.1f * cosf( i * 1.3f );
+        jitter[i][2] = 500 + 0.01f * i;
+    }
+    // the last sample ends the fixation
+    jitter[CENTROID_COUNT][0] = 700;
+
+    for( i = 0; i <= CENTROID_COUNT; i++ )
+    {
+        timestamp += 1000.0 / 60;
+        sample = gac_sample_create( &screen_point, &origin, &jitter[i],
+                timestamp, 0, GAC_LABEL_ID_NONE );
+        mu_check( gac_filter_fixation( fixation, sample, &point )
+                == ( i == CENTROID_COUNT ) );
+    }
+
+    // the centroid is summed in single precision from the newest sample
+    glm_vec3_zero( point_avg );
+    for( k = CENTROID_COUNT - 1; k >= 0; k-- )
+    {
+        glm_vec3_add( point_avg, jitter[k], point_avg );
+    }
+    glm_vec3_divs( point_avg, CENTROID_COUNT, point_avg );
+    mu_check( memcmp( point_avg, point.point, sizeof( vec3 ) ) == 0 );
+}
+
+bool reference_fixation( gac_queue_t* window, gac_sample_t* sample,
+        gac_fixation_t* fixation )
+{
+    static bool is_collecting = false;
+    static double last_duration = 0;
+    static vec3 last_point;
+    static vec2 last_screen_point;
+    double duration;
+    float dispersion, distance;
+    vec3 origin;
+    vec3 point;
+    vec2 screen_point;
+    gac_sample_t* first_sample;
+
+    // the filter as it scanned the whole window on each sample
+    gac_queue_push( window, sample );
+    first_sample = gac_queue_at( window, 0 );
+    duration = sample->timestamp - first_sample->timestamp;
+    if( duration >= fixation_stack.duration_threshold )
+    {
+        gac_samples_dispersion( window, &dispersion, 0 );
+        gac_samples_average_origin( window, &origin, 0 );
+        gac_samples_average_point( window, &point, 0 );
+        gac_samples_average_screen_point( window, &screen_point, 0 );
+        distance = glm_vec3_distance( origin, point );
+        if( dispersion <= ( float )( distance
+                    * fixation_stack.normalized_dispersion_threshold ) )
+        {
+            is_collecting = true;
+            last_duration = duration;
+            glm_vec3_copy( point, last_point );
+            glm_vec2_copy( screen_point, last_screen_point );
+        }
+        else if( is_collecting )
+        {
+            gac_fixation_init( fixation, &last_screen_point, &last_point,
+                    last_duration, first_sample );
+            is_collecting = false;
+            gac_queue_clear( window );
+            return true;
+        }
+        else
+        {
+            gac_queue_remove( window );
+        }
+    }
+
+    return false;
+}
+
+MU_TEST( fixation_reference )
+{
+    int i;
+    int count = 0;
+    bool same = true;
+    bool res;
+    gac_fixation_t point;
+    gac_fixation_t reference;
+    gac_queue_t window;
+    vec2 screen;
+    vec3 origin;
+    vec3 target = { REFERENCE_OFFSET + 500, REFERENCE_OFFSET + 500, 500 };
+    vec3 gaze;
+
+    srand( 42 );
+    gac_queue_init( &window, 0 );
+    gac_queue_set_rm_handler( &window, gac_sample_destroy );
+    for( i = 0; i < REFERENCE_COUNT; i++ )
+    {
+        if( rand() % 50 == 0 )
+        {
+            // a saccade to a new target
+            target[0] = REFERENCE_OFFSET + 300 + rand() % 400;
+            target[1] = REFERENCE_OFFSET + 300 + rand() % 400;
+        }
+        // the jitter keeps the dispersion close to the threshold
+        gaze[0] = target[0] + 3.2f * rand() / RAND_MAX;
+        gaze[1] = target[1] + 3.2f * rand() / RAND_MAX;
+        gaze[2] = target[2] + 0.3f * rand() / RAND_MAX;
+        origin[0] = REFERENCE_OFFSET + 500 + 0.7f * rand() / RAND_MAX;
+        origin[1] = REFERENCE_OFFSET + 500 + 0.7f * rand() / RAND_MAX;
+        origin[2] = 0.3f * rand() / RAND_MAX;
+        screen[0] = ( gaze[0] - REFERENCE_OFFSET ) / 1000;
+        screen[1] = ( gaze[1] - REFERENCE_OFFSET ) / 1000;
+        timestamp += 1000.0 / 60;
+
+        res = gac_filter_fixation( fixation, gac_sample_create( &screen,
+                    &origin, &gaze, timestamp, 0, GAC_LABEL_ID_NONE ),
+                &point );
+        same &= res == reference_fixation( &window, gac_sample_create(
+                    &screen, &origin, &gaze, timestamp, 0,
+                    GAC_LABEL_ID_NONE ), &reference );
+        if( res )
+        {
+            same &= memcmp( point.point, reference.point,
+                    sizeof( vec3 ) ) == 0;
+            same &= memcmp( point.screen_point, reference.screen_point,
+                    sizeof( vec2 ) ) == 0;
+            same &= point.duration == reference.duration;
+            same &= point.first_sample.timestamp
+                == reference.first_sample.timestamp;
+            count++;
+        }
+    }
+    gac_queue_destroy( &window );
+    mu_check( same );
+    mu_check( count > 10 );
+}
+
 MU_TEST_SUITE( h_default_suite )
 {
     MU_SUITE_CONFIGURE( &fixation_setup, &fixation_teardown );
     MU_RUN_TEST( fixation_0 );
     MU_RUN_TEST( fixation_1 );
+    MU_RUN_TEST( fixation_centroid );
+    MU_RUN_TEST( fixation_reference );
 }
 
 int main()
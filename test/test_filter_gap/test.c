@@ -71,7 +71,7 @@ MU_TEST( gap_1 )
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
 
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( 1, count );
     mu_assert_int_eq( 1, samples->count );
@@ -99,12 +99,12 @@ MU_TEST( gap_2 )
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
 
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 1 );
 
-    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 2 );
@@ -142,12 +142,12 @@ MU_TEST( gap_2_plus )
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
 
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 1 );
 
-    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 2 );
@@ -185,12 +185,12 @@ MU_TEST( gap_2_minus )
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
 
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 1 );
 
-    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 2 );
@@ -228,12 +228,12 @@ MU_TEST( gap_2_max )
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
 
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 1 );
 
-    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    sample = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
     count = gac_filter_gap( gap, samples, sample );
     mu_assert_int_eq( count, 1 );
     mu_assert_int_eq( samples->count, 2 );
@@ -266,12 +266,12 @@ MU_TEST( gap_2_fill_1 )
     double timestamp = 1000;
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
-    gac_sample_t* sample1 = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample1 = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
 
     double timestamp2= 1033.333333;
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
-    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
 
     count = gac_filter_gap( gap, samples, sample1 );
     mu_assert_int_eq( count, 1 );
@@ -319,12 +319,12 @@ MU_TEST( gap_2_fill_2 )
     double timestamp = 1000;
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
-    gac_sample_t* sample1 = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample1 = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
 
     double timestamp2= 1050;
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
-    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
 
     count = gac_filter_gap( gap, samples, sample1 );
     mu_assert_int_eq( count, 1 );
@@ -6,6 +6,7 @@
 
 #include "minunit.h"
 #include "gac.h"
+#include <string.h>
 
 #undef MINUNIT_EPSILON
 #define MINUNIT_EPSILON 1E-7
@@ -21,12 +22,31 @@ float avg3( float a, float b, float c )
     return ( a + b + c ) / 3.0F;
 }
 
+float med3( float a, float b, float c )
+{
+    if( ( a <= b && b <= c ) || ( c <= b && b <= a ) )
+    {
+        return b;
+    }
+    if( ( b <= a && a <= c ) || ( c <= a && a <= b ) )
+    {
+        return a;
+    }
+    return c;
+}
+
 void noise_setup()
 {
     gac_filter_noise_init( &noise_stack, GAC_FILTER_NOISE_TYPE_AVERAGE, 1 );
     noise = &noise_stack;
 }
 
+void noise_setup_median()
+{
+    gac_filter_noise_init( &noise_stack, GAC_FILTER_NOISE_TYPE_MEDIAN, 1 );
+    noise = &noise_stack;
+}
+
 void noise_teardown()
 {
     gac_filter_noise_destroy( noise );
@@ -66,7 +86,7 @@ MU_TEST( noise_1 )
     double timestamp = 1.12345;
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
     sample = gac_filter_noise( noise, sample );
     mu_check( sample == NULL );
 }
@@ -76,12 +96,12 @@ MU_TEST( noise_2 )
     double timestamp = 1.12345;
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
 
     double timestamp2= 2.12345;
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
-    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
 
     sample = gac_filter_noise( noise, sample );
     mu_check( sample == NULL );
@@ -95,17 +115,17 @@ MU_TEST( noise_3 )
     double timestamp = 1.12345;
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
 
     double timestamp2 = 2.12345;
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
-    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
 
     double timestamp3 = 3.12345;
     float o3[3] = { 0.4, 0.5, 0.6 };
     float p3[3] = { 0.7, 0.8, 0.9 };
-    gac_sample_t* sample3 = gac_sample_create( &s, &o3, &p3, timestamp3, 0, NULL );
+    gac_sample_t* sample3 = gac_sample_create( &s, &o3, &p3, timestamp3, 0, GAC_LABEL_ID_NONE );
 
     sample = gac_filter_noise( noise, sample );
     mu_check( sample == NULL );
@@ -129,22 +149,22 @@ MU_TEST( noise_4 )
     double timestamp = 1.12345;
     float o[3] = { 0.1, 0.2, 0.3 };
     float p[3] = { 0.4, 0.5, 0.6 };
-    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &s, &o, &p, timestamp, 0, GAC_LABEL_ID_NONE );
 
     double timestamp2 = 2.12345;
     float o2[3] = { 0.2, 0.3, 0.4 };
     float p2[3] = { 0.5, 0.6, 0.7 };
-    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, NULL );
+    gac_sample_t* sample2 = gac_sample_create( &s, &o2, &p2, timestamp2, 0, GAC_LABEL_ID_NONE );
 
     double timestamp3 = 3.12345;
     float o3[3] = { 0.4, 0.5, 0.6 };
     float p3[3] = { 0.7, 0.8, 0.9 };
-    gac_sample_t* sample3 = gac_sample_create( &s, &o3, &p3, timestamp3, 0, NULL );
+    gac_sample_t* sample3 = gac_sample_create( &s, &o3, &p3, timestamp3, 0, GAC_LABEL_ID_NONE );
 
     double timestamp4 = 4.12345;
     float o4[3] = { 0.6, 0.7, 0.8 };
     float p4[3] = { 0.9, 0.9, 0.9 };
-    gac_sample_t* sample4 = gac_sample_create( &s, &o4, &p4, timestamp4, 0, NULL );
+    gac_sample_t* sample4 = gac_sample_create( &s, &o4, &p4, timestamp4, 0, GAC_LABEL_ID_NONE );
 
     sample = gac_filter_noise( noise, sample );
     mu_check( sample == NULL );
@@ -173,12 +193,177 @@ MU_TEST( noise_4 )
     gac_sample_destroy( sample );
 }
 
+MU_TEST( noise_median )
+{
+    int i;
+    gac_sample_t* sample;
+    float s2[2];
+    float o[5][3] = {
+        { 0.1, 0.2, 0.3 },
+        { 0.4, 0.1, 0.3 },
+        { 0.2, 0.5, 0.1 },
+        { 0.9, 0.0, 0.2 },
+        { 0.3, 0.3, 0.3 }
+    };
+    float p[5][3] = {
+        { 0.4, 0.5, 0.6 },
+        { 0.5, 9.0, 0.7 },
+        { 0.3, 0.6, 0.5 },
+        { 0.7, 0.1, 0.6 },
+        { 0.6, 0.6, 0.2 }
+    };
+
+    for( i = 0; i < 5; i++ )
+    {
+        s2[0] = p[i][0] / 2;
+        s2[1] = p[i][1] / 2;
+        sample = gac_sample_create( &s2, &o[i], &p[i], i, 0,
+                GAC_LABEL_ID_NONE );
+        sample = gac_filter_noise( noise, sample );
+        if( i < 2 )
+        {
+            mu_check( sample == NULL );
+            continue;
+        }
+        mu_check( sample != NULL );
+        mu_assert_double_eq( med3( o[i-2][0], o[i-1][0], o[i][0] ),
+                sample->origin[0] );
+        mu_assert_double_eq( med3( o[i-2][1], o[i-1][1], o[i][1] ),
+                sample->origin[1] );
+        mu_assert_double_eq( med3( o[i-2][2], o[i-1][2], o[i][2] ),
+                sample->origin[2] );
+        mu_assert_double_eq( med3( p[i-2][0], p[i-1][0], p[i][0] ),
+                sample->point[0] );
+        mu_assert_double_eq( med3( p[i-2][1], p[i-1][1], p[i][1] ),
+                sample->point[1] );
+        mu_assert_double_eq( med3( p[i-2][2], p[i-1][2], p[i][2] ),
+                sample->point[2] );
+        mu_assert_double_eq( med3( p[i-2][0], p[i-1][0], p[i][0] ) / 2,
+                sample->screen_point[0] );
+        mu_assert_double_eq( i - 1, sample->timestamp );
+        gac_sample_destroy( sample );
+    }
+}
+
+MU_TEST( noise_average_to )
+{
+    int i, j;
+    double ref;
+    gac_sample_t* sample;
+    gac_sample_t out;
+    float o[3] = { 0.1, 0.2, 0.3 };
+    float p[3];
+    float values[200];
+
+    gac_filter_noise_destroy( noise );
+    gac_filter_noise_init( &noise_stack, GAC_FILTER_NOISE_TYPE_AVERAGE, 10 );
+    noise = &noise_stack;
+    gac_sample_init( &out, &s, &o, &o, 0, 0, GAC_LABEL_ID_NONE );
+
+    for( i = 0; i < 200; i++ )
+    {
+        values[i] = ( float )( ( i * 37 ) % 101 ) / 100;
+        p[0] = values[i];
+        p[1] = 1 - values[i];
+        p[2] = 0.5;
+        sample = gac_sample_create( &s, &o, &p, i, 0, GAC_LABEL_ID_NONE );
+        sample = gac_filter_noise( noise, sample );
+        gac_sample_destroy( sample );
+        if( i < 20 )
+        {
+            continue;
+        }
+        mu_assert( gac_filter_noise_average_to( noise, &out ), "average" );
+        ref = 0;
+        for( j = i - 20; j <= i; j++ )
+        {
+            ref += values[j];
+        }
+        ref /= 21;
+        mu_assert_double_eq( ( float )ref, out.point[0] );
+        mu_assert_double_eq( 0.5, out.point[2] );
+        mu_assert_double_eq( o[1], out.origin[1] );
+        mu_assert_double_eq( i - 10, out.timestamp );
+        mu_check( out._me == NULL );
+    }
+}
+
+MU_TEST( noise_average_short )
+{
+    int i;
+    gac_sample_t* sample;
+    gac_sample_t out;
+    float o[3] = { 0.1, 0.2, 0.3 };
+    float p[3];
+    vec3 avg;
+
+    // short windows are summed up in single precision as before
+    mu_check( !noise->is_summing );
+    gac_sample_init( &out, &s, &o, &o, 0, 0, GAC_LABEL_ID_NONE );
+    for( i = 0; i < 50; i++ )
+    {
+        p[0] = 300 + ( float )( ( i * 37 ) % 101 ) / 7;
+        p[1] = -p[0] / 3;
+        p[2] = 0.1 * i;
+        sample = gac_sample_create( &s, &o, &p, i, 0, GAC_LABEL_ID_NONE );
+        sample = gac_filter_noise( noise, sample );
+        gac_sample_destroy( sample );
+        if( noise->window.count < noise->window.length )
+        {
+            continue;
+        }
+        mu_check( gac_filter_noise_average_to( noise, &out ) );
+        gac_samples_average_point( &noise->window, &avg, 0 );
+        mu_check( memcmp( avg, out.point, sizeof( vec3 ) ) == 0 );
+    }
+}
+
+MU_TEST( noise_average_rebase )
+{
+    int i, j;
+    double ref;
+    gac_sample_t* sample;
+    float o[3] = { 0.1, 0.2, 0.3 };
+    float p[3];
+
+    gac_filter_noise_destroy( noise );
+    gac_filter_noise_init( &noise_stack, GAC_FILTER_NOISE_TYPE_AVERAGE, 10 );
+    noise = &noise_stack;
+    mu_check( noise->is_summing );
+
+    p[1] = 0;
+    p[2] = 0;
+    for( i = 0; i < 3 * GAC_FILTER_NOISE_SUM_REBASE; i++ )
+    {
+        p[0] = 600 + ( float )( ( i * 37 ) % 101 ) / 7;
+        sample = gac_sample_create( &s, &o, &p, i, 0, GAC_LABEL_ID_NONE );
+        sample = gac_filter_noise( noise, sample );
+        gac_sample_destroy( sample );
+        mu_check( noise->sum_count < GAC_FILTER_NOISE_SUM_REBASE );
+        if( noise->sum_count > 0 )
+        {
+            continue;
+        }
+        // after a rebase the sums hold the exact sum of the window
+        ref = 0;
+        for( j = 0; j < noise->window.count; j++ )
+        {
+            ref += ( ( gac_sample_t* )gac_queue_at( &noise->window,
+                        j ) )->point[0];
+        }
+        mu_assert_double_eq( ref, noise->sum.point[0] );
+    }
+}
+
 void noise_run()
 {
     MU_RUN_TEST( noise_1 );
     MU_RUN_TEST( noise_2 );
     MU_RUN_TEST( noise_3 );
     MU_RUN_TEST( noise_4 );
+    MU_RUN_TEST( noise_average_to );
+    MU_RUN_TEST( noise_average_short );
+    MU_RUN_TEST( noise_average_rebase );
 }
 
 MU_TEST_SUITE( noise_suite )
@@ -187,10 +372,17 @@ MU_TEST_SUITE( noise_suite )
     noise_run();
 }
 
+MU_TEST_SUITE( noise_median_suite )
+{
+    MU_SUITE_CONFIGURE( &noise_setup_median, &noise_teardown );
+    MU_RUN_TEST( noise_median );
+}
+
 int main()
 {
     MU_RUN_SUITE( noise_init_suite );
     MU_RUN_SUITE( noise_suite );
+    MU_RUN_SUITE( noise_median_suite );
     MU_REPORT();
     return MU_EXIT_CODE;
 }
@@ -110,7 +110,7 @@ MU_TEST_SUITE( h_init_suite )
 bool add_sample( gac_saccade_t* point )
 {
     timestamp += 1000.0 / 60;
-    gac_sample_t* sample = gac_sample_create( &screen_point, &origins[idx], &points[idx], timestamp, 0, NULL );
+    gac_sample_t* sample = gac_sample_create( &screen_point, &origins[idx], &points[idx], timestamp, 0, GAC_LABEL_ID_NONE );
     idx++;
 
     return gac_filter_saccade( saccade, sample, point );
@@ -339,6 +339,241 @@ MU_TEST( h_filter )
     mu_assert_double_eq( 1000 + 16 * 1000.0 / 60, saccade.first_sample.timestamp );
 }
 
+void batch_setup( gac_sample_batch_t* batch, float ox[SAMPLE_COUNT],
+        float oy[SAMPLE_COUNT], float oz[SAMPLE_COUNT], float px[SAMPLE_COUNT],
+        float py[SAMPLE_COUNT], float pz[SAMPLE_COUNT],
+        double ts[SAMPLE_COUNT] )
+{
+    int i;
+
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        ox[i] = origins[i][0];
+        oy[i] = origins[i][1];
+        oz[i] = origins[i][2];
+        px[i] = points[i][0];
+        py[i] = points[i][1];
+        pz[i] = points[i][2];
+        ts[i] = 1000 + ( i + 1 ) * 1000.0 / 60;
+    }
+
+    gac_sample_batch_init( batch, SAMPLE_COUNT );
+    batch->origin_x = ox;
+    batch->origin_y = oy;
+    batch->origin_z = oz;
+    batch->point_x = px;
+    batch->point_y = py;
+    batch->point_z = pz;
+    batch->timestamp = ts;
+}
+
+MU_TEST( h_batch )
+{
+    gac_sample_batch_t batch;
+    gac_fixation_t fixations[4];
+    gac_saccade_t saccades[4];
+    uint32_t fixation_count, saccade_count, consumed;
+    float ox[SAMPLE_COUNT], oy[SAMPLE_COUNT], oz[SAMPLE_COUNT];
+    float px[SAMPLE_COUNT], py[SAMPLE_COUNT], pz[SAMPLE_COUNT];
+    double ts[SAMPLE_COUNT];
+    float point_avg[3];
+    gac_heatmap_t* heatmap;
+    const float* map;
+
+    mu_check( gac_set_heatmap( h, 4, 4, 0, GAC_HEATMAP_KEY_TRIAL ) );
+    batch_setup( &batch, ox, oy, oz, px, py, pz, ts );
+    consumed = gac_sample_window_update_batch( h, &batch, fixations, 4,
+            &fixation_count, saccades, 4, &saccade_count );
+    mu_assert_int_eq( SAMPLE_COUNT, consumed );
+    mu_assert_int_eq( 1, fixation_count );
+    mu_assert_int_eq( 2, saccade_count );
+
+    // without a screen the fixation is located at the screen origin
+    heatmap = gac_get_heatmap( h, 0 );
+    mu_check( heatmap != NULL );
+    mu_check( gac_get_heatmap( h, 1 ) == NULL );
+    mu_assert_int_eq( 1, heatmap->fixation_count );
+    mu_check( gac_heatmap_get( heatmap, &map ) );
+    mu_assert_double_eq( ( float )fixations[0].duration, map[0] );
+
+    avg( 5, 15, points, point_avg );
+    mu_assert_double_eq( point_avg[0], fixations[0].point[0] );
+    mu_assert_double_eq( point_avg[1], fixations[0].point[1] );
+    mu_assert_double_eq( point_avg[2], fixations[0].point[2] );
+    mu_assert_double_eq( 10 * 1000.0 / 60, fixations[0].duration );
+    mu_assert_double_eq( 1000 + 6 * 1000.0 / 60,
+            fixations[0].first_sample.timestamp );
+    mu_assert_double_eq( points[3][0], saccades[0].first_sample.point[0] );
+    mu_assert_double_eq( points[5][0], saccades[0].last_sample.point[0] );
+    mu_assert_double_eq( 1000 + 4 * 1000.0 / 60,
+            saccades[0].first_sample.timestamp );
+    mu_assert_double_eq( points[15][0], saccades[1].first_sample.point[0] );
+    mu_assert_double_eq( points[16][0], saccades[1].last_sample.point[0] );
+    mu_assert_double_eq( 1000 + 16 * 1000.0 / 60,
+            saccades[1].first_sample.timestamp );
+}
+
+MU_TEST( h_batch_resume )
+{
+    gac_sample_batch_t batch;
+    gac_fixation_t fixation;
+    gac_saccade_t saccade;
+    uint32_t fixation_count, saccade_count, consumed;
+    uint32_t fixation_total = 0;
+    uint32_t saccade_total = 0;
+    uint32_t calls = 0;
+    float ox[SAMPLE_COUNT], oy[SAMPLE_COUNT], oz[SAMPLE_COUNT];
+    float px[SAMPLE_COUNT], py[SAMPLE_COUNT], pz[SAMPLE_COUNT];
+    double ts[SAMPLE_COUNT];
+
+    batch_setup( &batch, ox, oy, oz, px, py, pz, ts );
+    while( batch.count > 0 )
+    {
+        consumed = gac_sample_window_update_batch( h, &batch, &fixation, 1,
+                &fixation_count, &saccade, 1, &saccade_count );
+        if( saccade_count == 1 )
+        {
+            mu_assert_double_eq( saccade_total == 0 ? points[3][0]
+                    : points[15][0], saccade.first_sample.point[0] );
+            gac_saccade_destroy( &saccade );
+        }
+        if( fixation_count == 1 )
+        {
+            mu_assert_double_eq( 10 * 1000.0 / 60, fixation.duration );
+            gac_fixation_destroy( &fixation );
+        }
+        fixation_total += fixation_count;
+        saccade_total += saccade_count;
+        batch.count -= consumed;
+        batch.origin_x += consumed;
+        batch.origin_y += consumed;
+        batch.origin_z += consumed;
+        batch.point_x += consumed;
+        batch.point_y += consumed;
+        batch.point_z += consumed;
+        batch.timestamp += consumed;
+        calls++;
+    }
+    mu_check( calls > 1 );
+    mu_assert_int_eq( 1, fixation_total );
+    mu_assert_int_eq( 2, saccade_total );
+}
+
+MU_TEST( h_batch_fixations_only )
+{
+    gac_sample_batch_t batch;
+    gac_fixation_t fixations[4];
+    uint32_t fixation_count, saccade_count, consumed, fixation_total;
+    float ox[SAMPLE_COUNT], oy[SAMPLE_COUNT], oz[SAMPLE_COUNT];
+    float px[SAMPLE_COUNT], py[SAMPLE_COUNT], pz[SAMPLE_COUNT];
+    double ts[SAMPLE_COUNT];
+
+    // saccades are detected and discarded, the batch is fed in two calls
+    batch_setup( &batch, ox, oy, oz, px, py, pz, ts );
+    batch.count = SAMPLE_COUNT / 2;
+    consumed = gac_sample_window_update_batch( h, &batch, fixations, 4,
+            &fixation_count, NULL, 0, &saccade_count );
+    mu_assert_int_eq( SAMPLE_COUNT / 2, consumed );
+    mu_assert_int_eq( 0, saccade_count );
+    fixation_total = fixation_count;
+
+    batch.count = SAMPLE_COUNT - consumed;
+    batch.origin_x += consumed;
+    batch.origin_y += consumed;
+    batch.origin_z += consumed;
+    batch.point_x += consumed;
+    batch.point_y += consumed;
+    batch.point_z += consumed;
+    batch.timestamp += consumed;
+    consumed = gac_sample_window_update_batch( h, &batch,
+            &fixations[fixation_total], 4 - fixation_total, &fixation_count,
+            NULL, 0, &saccade_count );
+    fixation_total += fixation_count;
+    mu_assert_int_eq( SAMPLE_COUNT - SAMPLE_COUNT / 2, consumed );
+    mu_assert_int_eq( 0, saccade_count );
+    mu_assert_int_eq( 1, fixation_total );
+    mu_assert_int_eq( 0, h->saccade.new_samples );
+    mu_assert_int_eq( 0, h->fixation.new_samples );
+    mu_assert_double_eq( 10 * 1000.0 / 60, fixations[0].duration );
+    gac_fixation_destroy( &fixations[0] );
+}
+
+MU_TEST( h_ring )
+{
+    int i;
+    gac_fixation_t fixations[4];
+    gac_saccade_t saccades[4];
+    uint32_t fixation_count, saccade_count;
+    gac_ring_stats_t stats;
+    float point_avg[3];
+
+    mu_check( !gac_push( h, NULL, &origins[0], &points[0], 0, 0, 0 ) );
+    mu_check( gac_set_ring( h, SAMPLE_COUNT, GAC_RING_WAIT_NONE ) );
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        timestamp += 1000.0 / 60;
+        mu_check( gac_push( h, NULL, &origins[i], &points[i], timestamp, 0,
+                    GAC_LABEL_ID_NONE ) );
+    }
+    mu_assert_int_eq( SAMPLE_COUNT, gac_drain( h, 0, fixations, 4,
+                &fixation_count, saccades, 4, &saccade_count ) );
+    mu_assert_int_eq( 1, fixation_count );
+    mu_assert_int_eq( 2, saccade_count );
+
+    avg( 5, 15, points, point_avg );
+    mu_assert_double_eq( point_avg[0], fixations[0].point[0] );
+    mu_assert_double_eq( 10 * 1000.0 / 60, fixations[0].duration );
+    mu_assert_double_eq( points[3][0], saccades[0].first_sample.point[0] );
+    mu_assert_double_eq( points[16][0], saccades[1].last_sample.point[0] );
+    gac_fixation_destroy( &fixations[0] );
+    for( i = 0; i < 2; i++ )
+    {
+        gac_saccade_destroy( &saccades[i] );
+    }
+
+    mu_assert_int_eq( 0, gac_drain( h, 0, fixations, 4, &fixation_count,
+                saccades, 4, &saccade_count ) );
+    mu_check( gac_get_ring_stats( h, &stats ) );
+    mu_assert_int_eq( SAMPLE_COUNT, stats.push_count );
+    mu_assert_int_eq( SAMPLE_COUNT, stats.pop_count );
+    mu_assert_int_eq( 0, stats.overflow_count );
+}
+
+MU_TEST( h_ring_fixations_only )
+{
+    int i;
+    gac_fixation_t fixations[4];
+    uint32_t fixation_count, saccade_count;
+    uint32_t fixation_total = 0;
+    uint32_t drained = 0;
+    gac_ring_stats_t stats;
+
+    // saccades are detected and discarded, the ring is drained twice
+    mu_check( gac_set_ring( h, SAMPLE_COUNT, GAC_RING_WAIT_NONE ) );
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        timestamp += 1000.0 / 60;
+        mu_check( gac_push( h, NULL, &origins[i], &points[i], timestamp, 0,
+                    GAC_LABEL_ID_NONE ) );
+        if( i == SAMPLE_COUNT / 2 || i == SAMPLE_COUNT - 1 )
+        {
+            drained += gac_drain( h, 0, &fixations[fixation_total],
+                    4 - fixation_total, &fixation_count, NULL, 0,
+                    &saccade_count );
+            fixation_total += fixation_count;
+            mu_assert_int_eq( 0, saccade_count );
+        }
+    }
+    mu_assert_int_eq( SAMPLE_COUNT, drained );
+    mu_assert_int_eq( 1, fixation_total );
+    mu_assert_double_eq( 10 * 1000.0 / 60, fixations[0].duration );
+    gac_fixation_destroy( &fixations[0] );
+
+    mu_check( gac_get_ring_stats( h, &stats ) );
+    mu_assert_int_eq( SAMPLE_COUNT, stats.pop_count );
+    mu_assert_int_eq( 0, stats.overflow_count );
+}
+
 MU_TEST_SUITE( h_default_suite )
 {
     MU_SUITE_CONFIGURE( &h_setup_default, &h_teardown );
@@ -349,6 +584,11 @@ MU_TEST_SUITE( h_no_filter_suite )
 {
     MU_SUITE_CONFIGURE( &h_setup_no_filter, &h_teardown );
     MU_RUN_TEST( h_filter );
+    MU_RUN_TEST( h_batch );
+    MU_RUN_TEST( h_batch_resume );
+    MU_RUN_TEST( h_batch_fixations_only );
+    MU_RUN_TEST( h_ring );
+    MU_RUN_TEST( h_ring_fixations_only );
 }
 
 int main()
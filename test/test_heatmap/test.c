@@ -0,0 +1,258 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <math.h>
+
+#undef MINUNIT_EPSILON
+#define MINUNIT_EPSILON 1E-4
+
+#define WIDTH 64
+#define HEIGHT 48
+#define SIGMA 2.5
+
+static gac_heatmap_t heatmap_stack;
+static gac_heatmap_t* heatmap_heap;
+static gac_heatmap_t* heatmap;
+static gac_heatmap_collection_t hc_stack;
+static gac_heatmap_collection_t* hc;
+
+void fixation_make( gac_fixation_t* fixation, float x, float y,
+        double duration, uint32_t trial_id, uint32_t label_id )
+{
+    vec2 screen_point = { x, y };
+    vec3 point = { 0, 0, 0 };
+    gac_sample_t sample;
+
+    gac_sample_init( &sample, &screen_point, &point, &point, 0, trial_id,
+            label_id );
+    gac_fixation_init( fixation, &screen_point, &point, duration, &sample );
+}
+
+void heatmap_setup()
+{
+    gac_heatmap_init( &heatmap_stack, WIDTH, HEIGHT, SIGMA );
+    heatmap = &heatmap_stack;
+}
+
+void heatmap_teardown()
+{
+    gac_heatmap_destroy( heatmap );
+}
+
+void hc_setup()
+{
+    gac_heatmap_collection_init( &hc_stack );
+    hc = &hc_stack;
+}
+
+void hc_teardown()
+{
+    gac_heatmap_collection_destroy( hc );
+}
+
+MU_TEST( heatmap_init_stack )
+{
+    mu_check( gac_heatmap_init( &heatmap_stack, WIDTH, HEIGHT, SIGMA ) );
+    heatmap = &heatmap_stack;
+    mu_assert_int_eq( 8, heatmap->kernel.radius );
+    mu_check( heatmap->map == NULL );
+}
+
+MU_TEST( heatmap_init_heap )
+{
+    heatmap_heap = gac_heatmap_create( WIDTH, HEIGHT, 0 );
+    heatmap = heatmap_heap;
+    mu_check( heatmap != NULL );
+    mu_assert_int_eq( 0, heatmap->kernel.radius );
+    mu_check( gac_heatmap_create( 0, HEIGHT, SIGMA ) == NULL );
+}
+
+MU_TEST_SUITE( heatmap_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &heatmap_teardown );
+    MU_RUN_TEST( heatmap_init_stack );
+    MU_RUN_TEST( heatmap_init_heap );
+}
+
+MU_TEST( heatmap_add )
+{
+    gac_fixation_t fixation;
+
+    mu_check( gac_heatmap_add( heatmap, 0, 0, 1 ) );
+    mu_check( gac_heatmap_add( heatmap, 0.999999, 0.999999, 2 ) );
+    mu_check( !gac_heatmap_add( heatmap, 1, 0.5, 1 ) );
+    mu_check( !gac_heatmap_add( heatmap, -0.1, 0.5, 1 ) );
+    mu_check( !gac_heatmap_add( heatmap, NAN, 0.5, 1 ) );
+    mu_assert_double_eq( 1, heatmap->points[0] );
+    mu_assert_double_eq( 2, heatmap->points[WIDTH * HEIGHT - 1] );
+
+    fixation_make( &fixation, 10.5 / WIDTH, 20.5 / HEIGHT, 150, 0, 0 );
+    mu_check( gac_heatmap_add_fixation( heatmap, &fixation ) );
+    mu_check( gac_heatmap_add_fixation( heatmap, &fixation ) );
+    mu_assert_double_eq( 300, heatmap->points[20 * WIDTH + 10] );
+    mu_assert_int_eq( 2, heatmap->fixation_count );
+    mu_assert_double_eq( 300, heatmap->duration );
+
+    mu_check( gac_heatmap_clear( heatmap ) );
+    mu_assert_double_eq( 0, heatmap->points[20 * WIDTH + 10] );
+    mu_assert_int_eq( 0, heatmap->fixation_count );
+}
+
+MU_TEST( heatmap_blur )
+{
+    int x, y, cx, cy;
+    double sum = 0;
+    double expected;
+    double norm = 0;
+    double max_error = 0;
+    const float* map;
+
+    // one point away from the borders keeps its mass and matches the
+    // two-dimensional Gaussian
+    cx = 30;
+    cy = 20;
+    gac_heatmap_add( heatmap, ( cx + 0.5 ) / WIDTH, ( cy + 0.5 ) / HEIGHT,
+            100 );
+    mu_check( gac_heatmap_get( heatmap, &map ) );
+    mu_check( !heatmap->is_dirty );
+    for( x = -8; x <= 8; x++ )
+    {
+        norm += exp( -0.5 * x * x / ( SIGMA * SIGMA ) );
+    }
+    for( y = 0; y < HEIGHT; y++ )
+    {
+        for( x = 0; x < WIDTH; x++ )
+        {
+            sum += map[y * WIDTH + x];
+            expected = 0;
+            if( abs( x - cx ) <= 8 && abs( y - cy ) <= 8 )
+            {
+                expected = 100 * exp( -0.5 * ( ( x - cx ) * ( x - cx )
+                            + ( y - cy ) * ( y - cy ) ) / ( SIGMA * SIGMA ) )
+                    / ( norm * norm );
+            }
+            if( fabs( expected - map[y * WIDTH + x] ) > max_error )
+            {
+                max_error = fabs( expected - map[y * WIDTH + x] );
+            }
+        }
+    }
+    mu_assert_double_eq( 100, sum );
+    mu_assert_double_eq( 0, max_error );
+    mu_assert_double_eq( map[cy * WIDTH + cx + 3], map[( cy - 3 ) * WIDTH
+            + cx] );
+
+    // the heatmap is only blurred again after a new point is added
+    gac_heatmap_add( heatmap, 0, 0, 100 );
+    mu_check( heatmap->is_dirty );
+    mu_check( gac_heatmap_get( heatmap, &map ) );
+    mu_check( map[0] > 0 );
+    mu_check( map[0] < 100 );
+}
+
+MU_TEST( heatmap_no_blur )
+{
+    const float* map;
+
+    gac_heatmap_destroy( heatmap );
+    gac_heatmap_init( &heatmap_stack, WIDTH, HEIGHT, 0 );
+    gac_heatmap_add( heatmap, 0.5, 0.5, 10 );
+    mu_check( gac_heatmap_get( heatmap, &map ) );
+    mu_assert_double_eq( 10, map[HEIGHT / 2 * WIDTH + WIDTH / 2] );
+    mu_assert_double_eq( 0, map[HEIGHT / 2 * WIDTH + WIDTH / 2 + 1] );
+}
+
+MU_TEST_SUITE( heatmap_suite )
+{
+    MU_SUITE_CONFIGURE( &heatmap_setup, &heatmap_teardown );
+    MU_RUN_TEST( heatmap_add );
+    MU_RUN_TEST( heatmap_blur );
+    MU_RUN_TEST( heatmap_no_blur );
+}
+
+MU_TEST( hc_trial )
+{
+    uint32_t i;
+    uint32_t idx;
+    uint32_t trials[5] = { 7, 3, 7, 1, 5 };
+    gac_fixation_t fixation;
+
+    fixation_make( &fixation, 0.5, 0.5, 100, 1, 0 );
+    mu_check( !gac_heatmap_collection_add_fixation( hc, &fixation ) );
+
+    mu_check( gac_heatmap_collection_set( hc, WIDTH, HEIGHT, SIGMA,
+                GAC_HEATMAP_KEY_TRIAL ) );
+    for( i = 0; i < 5; i++ )
+    {
+        fixation_make( &fixation, 0.5, 0.5, 100, trials[i], 0 );
+        mu_check( gac_heatmap_collection_add_fixation( hc, &fixation ) );
+    }
+    // fixations outside of the screen do not create a heatmap
+    fixation_make( &fixation, 1.5, 0.5, 100, 9, 0 );
+    mu_check( !gac_heatmap_collection_add_fixation( hc, &fixation ) );
+
+    mu_assert_int_eq( 4, hc->heatmaps.count );
+    for( i = 0; i < 4; i++ )
+    {
+        mu_assert_int_eq( 2 * i + 1, hc->heatmaps.items[i]->key );
+    }
+    mu_check( gac_heatmap_collection_find( hc, 7, &idx ) );
+    mu_assert_int_eq( 3, idx );
+    mu_assert_int_eq( 2, hc->heatmaps.items[idx]->fixation_count );
+    mu_check( !gac_heatmap_collection_find( hc, 4, &idx ) );
+    mu_assert_int_eq( 2, idx );
+
+    // reconfiguring removes all heatmaps
+    mu_check( gac_heatmap_collection_set( hc, 0, 0, 0,
+                GAC_HEATMAP_KEY_NONE ) );
+    mu_assert_int_eq( 0, hc->heatmaps.count );
+    mu_check( !hc->is_enabled );
+}
+
+MU_TEST( hc_label )
+{
+    uint32_t i;
+    gac_fixation_t fixation;
+
+    gac_heatmap_collection_set( hc, WIDTH, HEIGHT, SIGMA,
+            GAC_HEATMAP_KEY_LABEL );
+    for( i = 0; i < 4; i++ )
+    {
+        fixation_make( &fixation, 0.5, 0.5, 100, i, i % 2 );
+        mu_check( gac_heatmap_collection_add_fixation( hc, &fixation ) );
+    }
+    mu_assert_int_eq( 2, hc->heatmaps.count );
+    mu_assert_double_eq( 200, hc->heatmaps.items[0]->duration );
+
+    gac_heatmap_collection_set( hc, WIDTH, HEIGHT, SIGMA,
+            GAC_HEATMAP_KEY_NONE );
+    for( i = 0; i < 4; i++ )
+    {
+        fixation_make( &fixation, 0.5, 0.5, 100, i, i % 2 );
+        gac_heatmap_collection_add_fixation( hc, &fixation );
+    }
+    mu_assert_int_eq( 1, hc->heatmaps.count );
+    mu_assert_int_eq( 0, hc->heatmaps.items[0]->key );
+    mu_assert_int_eq( 4, hc->heatmaps.items[0]->fixation_count );
+}
+
+MU_TEST_SUITE( hc_suite )
+{
+    MU_SUITE_CONFIGURE( &hc_setup, &hc_teardown );
+    MU_RUN_TEST( hc_trial );
+    MU_RUN_TEST( hc_label );
+}
+
+int main()
+{
+    MU_RUN_SUITE( heatmap_init_suite );
+    MU_RUN_SUITE( heatmap_suite );
+    MU_RUN_SUITE( hc_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,148 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LABEL_COUNT 100
+
+static gac_label_table_t table_stack;
+static gac_label_table_t* table;
+
+void table_setup()
+{
+    gac_label_table_init( &table_stack );
+    table = &table_stack;
+}
+
+void table_teardown()
+{
+    gac_label_table_destroy( table );
+}
+
+MU_TEST( table_init_stack )
+{
+    gac_label_table_t t;
+
+    mu_assert( gac_label_table_init( &t ), "init" );
+    mu_assert( t._me == NULL, "self pointer" );
+    mu_assert_int_eq( 0, t.labels.count );
+    gac_label_table_destroy( &t );
+}
+
+MU_TEST( table_init_heap )
+{
+    gac_label_table_t* t = gac_label_table_create();
+
+    mu_assert( t != NULL, "create" );
+    mu_assert( t->_me == t, "self pointer" );
+    gac_label_table_destroy( t );
+}
+
+MU_TEST( table_none )
+{
+    uint32_t id = 42;
+
+    mu_assert( gac_label_table_intern( table, NULL, &id ), "intern NULL" );
+    mu_assert_int_eq( GAC_LABEL_ID_NONE, id );
+    id = 42;
+    mu_assert( gac_label_table_intern( table, "", &id ), "intern empty" );
+    mu_assert_int_eq( GAC_LABEL_ID_NONE, id );
+    mu_assert_string_eq( "", gac_label_table_get( table, GAC_LABEL_ID_NONE ) );
+    mu_check( gac_label_table_get( table, 1 ) == NULL );
+}
+
+MU_TEST( table_intern_1 )
+{
+    uint32_t id1, id2;
+    char label[] = "stimulus";
+
+    mu_assert( gac_label_table_intern( table, label, &id1 ), "intern" );
+    mu_check( id1 != GAC_LABEL_ID_NONE );
+    label[0] = 'S';
+    mu_assert_string_eq( "stimulus", gac_label_table_get( table, id1 ) );
+    mu_assert( gac_label_table_intern( table, "stimulus", &id2 ), "intern" );
+    mu_assert_int_eq( id1, id2 );
+    mu_assert( gac_label_table_intern( table, label, &id2 ), "intern" );
+    mu_check( id1 != id2 );
+}
+
+MU_TEST( table_intern_n )
+{
+    uint32_t i, id;
+    uint32_t ids[LABEL_COUNT];
+    char label[32];
+
+    for( i = 0; i < LABEL_COUNT; i++ )
+    {
+        sprintf( label, "label%d", i );
+        mu_assert( gac_label_table_intern( table, label, &ids[i] ), "intern" );
+    }
+    mu_assert_int_eq( LABEL_COUNT + 1, table->labels.count );
+    for( i = 0; i < LABEL_COUNT; i++ )
+    {
+        sprintf( label, "label%d", i );
+        gac_label_table_intern( table, label, &id );
+        mu_assert_int_eq( ids[i], id );
+        mu_assert_string_eq( label, gac_label_table_get( table, id ) );
+    }
+    mu_assert_int_eq( LABEL_COUNT + 1, table->labels.count );
+}
+
+MU_TEST( table_gaze )
+{
+    gac_t h;
+    gac_filter_parameter_t params;
+    gac_sample_t* sample;
+    uint32_t id;
+    const char* labels[4] = { "a", "a", "b", NULL };
+    double onsets[4] = { 0, 10, 0, 10 };
+    int i;
+
+    gac_get_filter_parameter_default( &params );
+    params.noise.mid_idx = 0;
+    params.gap.max_gap_length = 0;
+    gac_init( &h, &params );
+
+    for( i = 0; i < 4; i++ )
+    {
+        gac_sample_window_update( &h, 0, 0, 0, 1, 1, 1, 1000 + i * 10, 0,
+                labels[i] );
+        sample = gac_queue_at( &h.samples, h.samples.count - 1 );
+        mu_assert_double_eq( onsets[i], sample->label_onset );
+        mu_assert_string_eq( labels[i] == NULL ? "" : labels[i],
+                gac_get_label( &h, sample->label_id ) );
+    }
+
+    mu_assert( gac_get_label_id( &h, "b", &id ), "label id" );
+    mu_assert_string_eq( "b", gac_get_label( &h, id ) );
+    gac_destroy( &h );
+}
+
+MU_TEST_SUITE( table_init_suite )
+{
+    MU_RUN_TEST( table_init_stack );
+    MU_RUN_TEST( table_init_heap );
+}
+
+MU_TEST_SUITE( table_suite )
+{
+    MU_SUITE_CONFIGURE( &table_setup, &table_teardown );
+    MU_RUN_TEST( table_none );
+    MU_RUN_TEST( table_intern_1 );
+    MU_RUN_TEST( table_intern_n );
+    MU_RUN_TEST( table_gaze );
+}
+
+int main()
+{
+    MU_RUN_SUITE( table_init_suite );
+    MU_RUN_SUITE( table_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
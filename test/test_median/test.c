@@ -0,0 +1,159 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define VALUE_COUNT 300
+
+static gac_median_t median_stack;
+static gac_median_t* median;
+static float values[VALUE_COUNT];
+
+int cmp( const void* a, const void* b )
+{
+    float fa = *( const float* )a;
+    float fb = *( const float* )b;
+    return ( fa > fb ) - ( fa < fb );
+}
+
+float ref_median( uint32_t first, uint32_t count )
+{
+    uint32_t i;
+    float sorted[VALUE_COUNT];
+
+    for( i = 0; i < count; i++ )
+    {
+        sorted[i] = values[first + i];
+    }
+    qsort( sorted, count, sizeof( float ), cmp );
+    if( count % 2 == 1 )
+    {
+        return sorted[count / 2];
+    }
+    return ( sorted[count / 2 - 1] + sorted[count / 2] ) / 2;
+}
+
+void median_setup()
+{
+    uint32_t i;
+    uint32_t seed = 7;
+
+    for( i = 0; i < VALUE_COUNT; i++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        // few distinct values to exercise duplicates
+        values[i] = ( float )( ( seed >> 16 ) % 50 ) / 4;
+    }
+}
+
+void median_slide( uint32_t length )
+{
+    uint32_t i, count;
+    float val;
+
+    gac_median_init( &median_stack, length );
+    median = &median_stack;
+    for( i = 0; i < VALUE_COUNT; i++ )
+    {
+        mu_assert( gac_median_push( median, values[i] ), "push" );
+        count = i + 1 < length ? i + 1 : length;
+        mu_assert( gac_median_get( median, &val ), "get" );
+        mu_assert_double_eq( ref_median( i + 1 - count, count ), val );
+    }
+    gac_median_destroy( median );
+}
+
+MU_TEST( median_init_stack )
+{
+    float val;
+    gac_median_t m;
+
+    mu_assert( !gac_median_init( &m, 0 ), "zero length" );
+    mu_assert( gac_median_init( &m, 5 ), "init" );
+    mu_assert( m._me == NULL, "self pointer" );
+    mu_assert( !gac_median_get( &m, &val ), "empty" );
+    gac_median_destroy( &m );
+}
+
+MU_TEST( median_init_heap )
+{
+    gac_median_t* m = gac_median_create( 5 );
+
+    mu_assert( m != NULL, "create" );
+    mu_assert( m->_me == m, "self pointer" );
+    gac_median_destroy( m );
+}
+
+MU_TEST( median_slide_1 )
+{
+    median_slide( 1 );
+}
+
+MU_TEST( median_slide_odd )
+{
+    median_slide( 3 );
+    median_slide( 21 );
+}
+
+MU_TEST( median_slide_even )
+{
+    median_slide( 2 );
+    median_slide( 16 );
+}
+
+MU_TEST( median_nan )
+{
+    float val;
+
+    gac_median_init( &median_stack, 3 );
+    median = &median_stack;
+    gac_median_push( median, 1 );
+    gac_median_push( median, NAN );
+    gac_median_push( median, 3 );
+    gac_median_get( median, &val );
+    mu_assert_double_eq( 3, val );
+    gac_median_push( median, NAN );
+    gac_median_get( median, &val );
+    mu_check( isnan( val ) );
+    gac_median_push( median, 0 );
+    gac_median_get( median, &val );
+    mu_assert_double_eq( 3, val );
+    gac_median_push( median, 5 );
+    gac_median_get( median, &val );
+    mu_assert_double_eq( 5, val );
+    gac_median_push( median, 4 );
+    gac_median_get( median, &val );
+    mu_assert_double_eq( 4, val );
+    mu_assert( gac_median_clear( median ), "clear" );
+    mu_assert( !gac_median_get( median, &val ), "empty" );
+    gac_median_destroy( median );
+}
+
+MU_TEST_SUITE( median_init_suite )
+{
+    MU_RUN_TEST( median_init_stack );
+    MU_RUN_TEST( median_init_heap );
+}
+
+MU_TEST_SUITE( median_suite )
+{
+    MU_SUITE_CONFIGURE( &median_setup, NULL );
+    MU_RUN_TEST( median_slide_1 );
+    MU_RUN_TEST( median_slide_odd );
+    MU_RUN_TEST( median_slide_even );
+    MU_RUN_TEST( median_nan );
+}
+
+int main()
+{
+    MU_RUN_SUITE( median_init_suite );
+    MU_RUN_SUITE( median_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,172 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+
+#define VALUE_COUNT 200
+
+static gac_minmax_t minmax_stack;
+static gac_minmax_t* minmax;
+static float values[VALUE_COUNT];
+
+void minmax_setup()
+{
+    uint32_t i;
+    uint32_t seed = 42;
+
+    for( i = 0; i < VALUE_COUNT; i++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        values[i] = ( float )( ( seed >> 16 ) % 1000 ) / 10;
+    }
+
+    gac_minmax_init( &minmax_stack );
+    minmax = &minmax_stack;
+}
+
+void minmax_teardown()
+{
+    gac_minmax_destroy( minmax );
+}
+
+void minmax_check( uint32_t first, uint32_t next )
+{
+    uint32_t i;
+    float min, max;
+    float ref_min = values[first];
+    float ref_max = values[first];
+
+    for( i = first; i < next; i++ )
+    {
+        if( values[i] < ref_min )
+        {
+            ref_min = values[i];
+        }
+        if( values[i] > ref_max )
+        {
+            ref_max = values[i];
+        }
+    }
+
+    mu_assert( gac_minmax_min( minmax, &min ), "min" );
+    mu_assert( gac_minmax_max( minmax, &max ), "max" );
+    mu_assert_double_eq( ref_min, min );
+    mu_assert_double_eq( ref_max, max );
+}
+
+MU_TEST( minmax_init_stack )
+{
+    float val;
+    gac_minmax_t m;
+
+    mu_assert( gac_minmax_init( &m ), "init" );
+    mu_assert( m._me == NULL, "self pointer" );
+    mu_assert( !gac_minmax_min( &m, &val ), "empty min" );
+    mu_assert( !gac_minmax_max( &m, &val ), "empty max" );
+    mu_assert( !gac_minmax_pop( &m ), "empty pop" );
+    gac_minmax_destroy( &m );
+}
+
+MU_TEST( minmax_init_heap )
+{
+    gac_minmax_t* m = gac_minmax_create();
+
+    mu_assert( m != NULL, "create" );
+    mu_assert( m->_me == m, "self pointer" );
+    gac_minmax_destroy( m );
+}
+
+MU_TEST( minmax_grow )
+{
+    uint32_t i;
+
+    for( i = 0; i < VALUE_COUNT; i++ )
+    {
+        mu_assert( gac_minmax_push( minmax, values[i] ), "push" );
+        minmax_check( 0, i + 1 );
+    }
+}
+
+MU_TEST( minmax_slide )
+{
+    uint32_t i;
+    uint32_t width = 17;
+
+    for( i = 0; i < VALUE_COUNT; i++ )
+    {
+        gac_minmax_push( minmax, values[i] );
+        if( i >= width )
+        {
+            mu_assert( gac_minmax_pop( minmax ), "pop" );
+            minmax_check( i - width + 1, i + 1 );
+        }
+        else
+        {
+            minmax_check( 0, i + 1 );
+        }
+    }
+}
+
+MU_TEST( minmax_drain )
+{
+    uint32_t i;
+    float val;
+
+    for( i = 0; i < VALUE_COUNT; i++ )
+    {
+        gac_minmax_push( minmax, values[i] );
+    }
+    for( i = 1; i < VALUE_COUNT; i++ )
+    {
+        gac_minmax_pop( minmax );
+        minmax_check( i, VALUE_COUNT );
+    }
+    mu_assert( gac_minmax_pop( minmax ), "pop last" );
+    mu_assert( !gac_minmax_min( minmax, &val ), "empty min" );
+    mu_assert( !gac_minmax_pop( minmax ), "empty pop" );
+}
+
+MU_TEST( minmax_clear )
+{
+    uint32_t i;
+    float val;
+
+    for( i = 0; i < 10; i++ )
+    {
+        gac_minmax_push( minmax, values[i] );
+    }
+    mu_assert( gac_minmax_clear( minmax ), "clear" );
+    mu_assert( !gac_minmax_max( minmax, &val ), "empty max" );
+    for( i = 10; i < 20; i++ )
+    {
+        gac_minmax_push( minmax, values[i] );
+    }
+    minmax_check( 10, 20 );
+}
+
+MU_TEST_SUITE( minmax_init_suite )
+{
+    MU_RUN_TEST( minmax_init_stack );
+    MU_RUN_TEST( minmax_init_heap );
+}
+
+MU_TEST_SUITE( minmax_suite )
+{
+    MU_SUITE_CONFIGURE( &minmax_setup, &minmax_teardown );
+    MU_RUN_TEST( minmax_grow );
+    MU_RUN_TEST( minmax_slide );
+    MU_RUN_TEST( minmax_drain );
+    MU_RUN_TEST( minmax_clear );
+}
+
+int main()
+{
+    MU_RUN_SUITE( minmax_init_suite );
+    MU_RUN_SUITE( minmax_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
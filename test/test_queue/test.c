@@ -292,6 +292,83 @@ MU_TEST( grow_n_push_np2_pop_np2 )
     pop();
 }
 
+MU_TEST( push_np_pop_n_push_np )
+{
+    int i;
+    for( i = 0; i < 7; i++ )
+    {
+        push();
+    }
+    pop();
+    pop();
+    pop();
+    pop();
+    pop();
+    for( i = 0; i < 9; i++ )
+    {
+        push();
+    }
+    for( i = 0; i < 11; i++ )
+    {
+        pop();
+    }
+}
+
+MU_TEST( at_n )
+{
+    int i;
+    for( i = 0; i < 10; i++ )
+    {
+        push();
+    }
+    pop();
+    pop();
+    for( i = 0; i < 4; i++ )
+    {
+        push();
+    }
+    for( i = 0; i < q->count; i++ )
+    {
+        mu_assert_double_eq( vals[pop_idx + i],
+                *( double* )gac_queue_at( q, i ) );
+    }
+    mu_check( gac_queue_at( q, q->count ) == NULL );
+}
+
+MU_TEST( iter_n )
+{
+    int i;
+    double* x;
+    gac_queue_iter_t iter;
+    for( i = 0; i < 10; i++ )
+    {
+        push();
+    }
+    pop();
+    pop();
+    pop();
+    for( i = 0; i < 5; i++ )
+    {
+        push();
+    }
+
+    gac_queue_iter_init( &iter, q, false );
+    for( i = 0; i < q->count; i++ )
+    {
+        x = gac_queue_iter_next( &iter );
+        mu_assert_double_eq( vals[pop_idx + i], *x );
+    }
+    mu_check( gac_queue_iter_next( &iter ) == NULL );
+
+    gac_queue_iter_init( &iter, q, true );
+    for( i = 0; i < q->count; i++ )
+    {
+        x = gac_queue_iter_next( &iter );
+        mu_assert_double_eq( vals[push_idx - 1 - i], *x );
+    }
+    mu_check( gac_queue_iter_next( &iter ) == NULL );
+}
+
 MU_TEST( clear_0 )
 {
     clear();
@@ -373,6 +450,9 @@ void testcases()
     MU_RUN_TEST( grow_n_push_np );
     MU_RUN_TEST( grow_n_push_np2 );
     MU_RUN_TEST( grow_n_push_np2_pop_np2 );
+    MU_RUN_TEST( push_np_pop_n_push_np );
+    MU_RUN_TEST( at_n );
+    MU_RUN_TEST( iter_n );
     MU_RUN_TEST( clear_0 );
     MU_RUN_TEST( clear_1 );
     MU_RUN_TEST( clear_n );
@@ -0,0 +1,236 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define THREAD_SAMPLE_COUNT 20000
+
+static gac_ring_t ring_stack;
+static gac_ring_t* ring_heap;
+static gac_ring_t* ring;
+
+gac_ring_sample_t sample_make( uint32_t i )
+{
+    gac_ring_sample_t sample;
+
+    sample.screen_point[0] = i;
+    sample.screen_point[1] = -( float )i;
+    sample.origin[0] = 0;
+    sample.origin[1] = 0;
+    sample.origin[2] = 0;
+    sample.point[0] = i;
+    sample.point[1] = i;
+    sample.point[2] = i;
+    sample.timestamp = i;
+    sample.trial_id = i;
+    sample.label_id = 0;
+    sample.has_screen_point = true;
+
+    return sample;
+}
+
+void ring_setup()
+{
+    gac_ring_init( &ring_stack, 3, GAC_RING_WAIT_NONE );
+    ring = &ring_stack;
+}
+
+void ring_teardown()
+{
+    gac_ring_destroy( ring );
+}
+
+MU_TEST( ring_init_stack )
+{
+    mu_check( gac_ring_init( &ring_stack, 5, GAC_RING_WAIT_NONE ) );
+    ring = &ring_stack;
+    mu_assert_int_eq( 8, ring->capacity );
+    mu_assert_int_eq( 0, gac_ring_count( ring ) );
+}
+
+MU_TEST( ring_init_heap )
+{
+    ring_heap = gac_ring_create( 16, GAC_RING_WAIT_BLOCK );
+    ring = ring_heap;
+    mu_check( ring != NULL );
+    mu_assert_int_eq( 16, ring->capacity );
+}
+
+MU_TEST( ring_init_invalid )
+{
+    ring = gac_ring_create( 0, GAC_RING_WAIT_NONE );
+    mu_check( ring == NULL );
+}
+
+MU_TEST_SUITE( ring_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &ring_teardown );
+    MU_RUN_TEST( ring_init_stack );
+    MU_RUN_TEST( ring_init_heap );
+    MU_RUN_TEST( ring_init_invalid );
+}
+
+MU_TEST( ring_push_pop )
+{
+    uint32_t i, j;
+    gac_ring_sample_t sample;
+
+    // wrap around the ring several times
+    for( i = 0; i < 5; i++ )
+    {
+        for( j = 0; j < 3; j++ )
+        {
+            sample = sample_make( i * 3 + j );
+            mu_check( gac_ring_push( ring, &sample ) );
+        }
+        mu_assert_int_eq( 3, gac_ring_count( ring ) );
+        for( j = 0; j < 3; j++ )
+        {
+            mu_check( gac_ring_pop( ring, &sample ) );
+            mu_assert_double_eq( i * 3 + j, sample.timestamp );
+            mu_assert_int_eq( i * 3 + j, sample.trial_id );
+            mu_assert_double_eq( -( float )( i * 3 + j ),
+                    sample.screen_point[1] );
+        }
+        mu_check( !gac_ring_pop( ring, &sample ) );
+    }
+}
+
+MU_TEST( ring_overflow )
+{
+    uint32_t i;
+    gac_ring_sample_t sample;
+    gac_ring_stats_t stats;
+
+    for( i = 0; i < 6; i++ )
+    {
+        sample = sample_make( i );
+        mu_check( gac_ring_push( ring, &sample ) == ( i < 4 ) );
+    }
+    mu_check( gac_ring_pop( ring, &sample ) );
+    mu_assert_int_eq( 0, sample.trial_id );
+    sample = sample_make( 6 );
+    mu_check( gac_ring_push( ring, &sample ) );
+
+    mu_check( gac_ring_get_stats( ring, &stats ) );
+    mu_assert_int_eq( 4, stats.capacity );
+    mu_assert_int_eq( 4, stats.count );
+    mu_assert_int_eq( 4, stats.peak_count );
+    mu_assert_int_eq( 5, stats.push_count );
+    mu_assert_int_eq( 1, stats.pop_count );
+    mu_assert_int_eq( 2, stats.overflow_count );
+
+    for( i = 1; i < 4; i++ )
+    {
+        mu_check( gac_ring_pop( ring, &sample ) );
+        mu_assert_int_eq( i, sample.trial_id );
+    }
+    mu_check( gac_ring_pop( ring, &sample ) );
+    mu_assert_int_eq( 6, sample.trial_id );
+}
+
+MU_TEST( ring_wait_none )
+{
+    gac_ring_sample_t sample = sample_make( 0 );
+
+    mu_check( !gac_ring_wait( ring, 0 ) );
+    gac_ring_push( ring, &sample );
+    mu_check( gac_ring_wait( ring, 0 ) );
+}
+
+MU_TEST_SUITE( ring_suite )
+{
+    MU_SUITE_CONFIGURE( &ring_setup, &ring_teardown );
+    MU_RUN_TEST( ring_push_pop );
+    MU_RUN_TEST( ring_overflow );
+    MU_RUN_TEST( ring_wait_none );
+}
+
+void* ring_producer( void* data )
+{
+    uint32_t i;
+    gac_ring_sample_t sample;
+
+    for( i = 0; i < THREAD_SAMPLE_COUNT; )
+    {
+        sample = sample_make( i );
+        if( gac_ring_push( ring, &sample ) )
+        {
+            i++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void ring_consume( gac_ring_wait_mode_t mode )
+{
+    uint32_t i = 0;
+    bool in_order = true;
+    pthread_t thread;
+    gac_ring_sample_t sample;
+    gac_ring_stats_t stats;
+
+    ring = gac_ring_create( 64, mode );
+    pthread_create( &thread, NULL, ring_producer, NULL );
+    while( i < THREAD_SAMPLE_COUNT )
+    {
+        gac_ring_wait( ring, 0 );
+        while( gac_ring_pop( ring, &sample ) )
+        {
+            in_order &= sample.trial_id == i && sample.timestamp == i;
+            i++;
+        }
+    }
+    pthread_join( thread, NULL );
+    mu_check( in_order );
+    mu_assert_int_eq( THREAD_SAMPLE_COUNT, i );
+    gac_ring_get_stats( ring, &stats );
+    mu_assert_int_eq( THREAD_SAMPLE_COUNT, stats.pop_count );
+    mu_assert_int_eq( THREAD_SAMPLE_COUNT, stats.push_count );
+    mu_assert_int_eq( 0, stats.count );
+}
+
+MU_TEST( ring_thread_spin )
+{
+    ring_consume( GAC_RING_WAIT_SPIN );
+}
+
+MU_TEST( ring_thread_block )
+{
+    ring_consume( GAC_RING_WAIT_BLOCK );
+}
+
+MU_TEST( ring_wait_timeout )
+{
+    ring = gac_ring_create( 4, GAC_RING_WAIT_BLOCK );
+    mu_check( !gac_ring_wait( ring, 10 ) );
+    mu_assert_int_eq( 0, ring->waiting );
+}
+
+MU_TEST_SUITE( ring_thread_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &ring_teardown );
+    MU_RUN_TEST( ring_thread_spin );
+    MU_RUN_TEST( ring_thread_block );
+    MU_RUN_TEST( ring_wait_timeout );
+}
+
+int main()
+{
+    MU_RUN_SUITE( ring_init_suite );
+    MU_RUN_SUITE( ring_suite );
+    MU_RUN_SUITE( ring_thread_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,240 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+#include "gac_sample_file.h"
+#include <math.h>
+#include <string.h>
+
+#define HEADER "sx,sy,px,py,pz,ox,oy,oz,timestamp,trial_id,label,svalid," \
+    "pvalid,ovalid\n"
+#define SAMPLE_COUNT 1000
+#define BLOCK_LENGTH 64
+
+static gac_sample_file_t file_stack;
+static gac_sample_file_t* file_heap;
+static gac_sample_file_t* file;
+static gac_label_table_t labels;
+static FILE* fp;
+
+double sample_timestamp( uint32_t i )
+{
+    return 2709.466 + i * 16.667;
+}
+
+void fp_setup()
+{
+    uint32_t i;
+    char line[256];
+    const char* label;
+    FILE* fp_csv;
+    gac_csv_reader_t reader;
+    gac_label_table_t csv_labels;
+
+    // trials of 250 samples, the second half of each trial is labelled
+    fp_csv = tmpfile();
+    fputs( HEADER, fp_csv );
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        label = ( i % 250 ) < 125 ? "" : ( i < 500 ? "a" : "b" );
+        sprintf( line, "%f,%f,%d,%d,%d,%d,%d,%d,%.3f,%d,%s,%s,True,True\n",
+                i / 1000.0, 1 - i / 1000.0, i, i + 1, i + 2, -i, -i - 1,
+                -i - 2, sample_timestamp( i ), 10 + i / 250, label,
+                i == 5 ? "False" : "True" );
+        fputs( line, fp_csv );
+    }
+    rewind( fp_csv );
+    gac_label_table_init( &csv_labels );
+    gac_csv_reader_init( &reader, fp_csv, &csv_labels, BLOCK_LENGTH );
+    fp = tmpfile();
+    gac_sample_file_convert( &reader, fp, 0 );
+    gac_csv_reader_destroy( &reader );
+    gac_label_table_destroy( &csv_labels );
+    fclose( fp_csv );
+
+    // the labels are interned in a different order than in the CSV file
+    gac_label_table_init( &labels );
+    gac_label_table_intern( &labels, "b", &i );
+}
+
+void file_setup()
+{
+    fp_setup();
+    gac_sample_file_init( &file_stack, fp, &labels );
+    file = &file_stack;
+}
+
+void file_teardown()
+{
+    gac_sample_file_destroy( file );
+    gac_label_table_destroy( &labels );
+    fclose( fp );
+}
+
+MU_TEST( file_init_stack )
+{
+    mu_check( gac_sample_file_init( &file_stack, fp, &labels ) );
+    file = &file_stack;
+    mu_assert_int_eq( SAMPLE_COUNT - 1, file->header->sample_count );
+    mu_assert_int_eq( BLOCK_LENGTH, file->header->block_length );
+    mu_assert_int_eq( 2, file->header->label_count );
+    mu_check( file->header->flags & GAC_SAMPLE_FILE_FLAG_SCREEN );
+}
+
+MU_TEST( file_init_heap )
+{
+    FILE* fp_invalid;
+
+    file_heap = gac_sample_file_create( fp, NULL );
+    file = file_heap;
+    mu_check( file != NULL );
+
+    fp_invalid = tmpfile();
+    fputs( "not a sample file, not a sample file, not a sample file, "
+            "not a sample file", fp_invalid );
+    fflush( fp_invalid );
+    mu_check( gac_sample_file_create( fp_invalid, NULL ) == NULL );
+    mu_check( gac_sample_file_create( NULL, NULL ) == NULL );
+    fclose( fp_invalid );
+}
+
+MU_TEST( file_convert_error )
+{
+    FILE* fp_csv;
+    FILE* fp_out;
+    gac_csv_reader_t reader;
+
+    // a failed read of the CSV file is not taken for the end of the file
+    fp_csv = fopen( "/dev/null", "w" );
+    fp_out = tmpfile();
+    mu_check( fp_csv != NULL );
+    mu_check( gac_csv_reader_init( &reader, fp_csv, NULL, BLOCK_LENGTH ) );
+    mu_check( !gac_sample_file_convert( &reader, fp_out, 0 ) );
+    mu_check( reader.is_error );
+    gac_csv_reader_destroy( &reader );
+    fclose( fp_out );
+    fclose( fp_csv );
+    file = NULL;
+}
+
+MU_TEST_SUITE( file_init_suite )
+{
+    MU_SUITE_CONFIGURE( &fp_setup, &file_teardown );
+    MU_RUN_TEST( file_init_stack );
+    MU_RUN_TEST( file_init_heap );
+    MU_RUN_TEST( file_convert_error );
+}
+
+MU_TEST( file_read )
+{
+    uint32_t i;
+    uint32_t idx;
+    uint32_t count = 0;
+    uint32_t batch_count = 0;
+    gac_sample_batch_t batch;
+
+    while( gac_sample_file_read( file, &batch ) )
+    {
+        mu_check( batch.count <= BLOCK_LENGTH );
+        for( i = 0; i < batch.count; i++ )
+        {
+            // the invalid sample 5 is not part of the file
+            idx = count < 5 ? count : count + 1;
+            mu_check( batch.point_x[i] == idx );
+            mu_check( batch.origin_z[i] == -( float )idx - 2 );
+            mu_check( batch.screen_x[i] == ( float )( idx / 1000.0 ) );
+            mu_check( batch.timestamp[i]
+                    == round( sample_timestamp( idx ) * 1000 ) / 1000 );
+            mu_assert_int_eq( 10 + idx / 250, batch.trial_id[i] );
+            if( idx % 250 < 125 )
+            {
+                mu_assert_int_eq( GAC_LABEL_ID_NONE, batch.label_id[i] );
+            }
+            else
+            {
+                mu_assert_string_eq( idx < 500 ? "a" : "b",
+                        gac_label_table_get( &labels, batch.label_id[i] ) );
+            }
+            count++;
+        }
+        batch_count++;
+    }
+    mu_assert_int_eq( SAMPLE_COUNT - 1, count );
+    mu_assert_int_eq( 16, batch_count );
+    mu_assert_string_eq( "b", gac_label_table_get( &labels, 1 ) );
+    mu_assert_string_eq( "a", gac_label_table_get( &labels, 2 ) );
+}
+
+MU_TEST( file_seek )
+{
+    gac_sample_batch_t batch;
+
+    mu_check( gac_sample_file_seek_trial( file, 12 ) );
+    mu_assert_int_eq( 499, file->pos );
+    mu_check( gac_sample_file_read( file, &batch ) );
+    mu_assert_int_eq( 512 - 499, batch.count );
+    mu_check( batch.point_x[0] == 500 );
+    mu_check( batch.timestamp[0]
+            == round( sample_timestamp( 500 ) * 1000 ) / 1000 );
+    mu_assert_int_eq( 12, batch.trial_id[0] );
+    mu_assert_int_eq( GAC_LABEL_ID_NONE, batch.label_id[0] );
+
+    mu_check( gac_sample_file_seek( file, 998 ) );
+    mu_check( gac_sample_file_read( file, &batch ) );
+    mu_assert_int_eq( 1, batch.count );
+    mu_check( batch.point_x[0] == 999 );
+    mu_assert_int_eq( 13, batch.trial_id[0] );
+    mu_check( !gac_sample_file_read( file, &batch ) );
+
+    mu_check( !gac_sample_file_seek_trial( file, 14 ) );
+    mu_check( !gac_sample_file_seek( file, SAMPLE_COUNT ) );
+}
+
+MU_TEST( file_update_batch )
+{
+    uint32_t i;
+    uint32_t count = 0;
+    uint32_t fixation_count;
+    uint32_t saccade_count;
+    gac_t h;
+    gac_sample_batch_t batch;
+    gac_fixation_t fixations[8];
+    gac_saccade_t saccades[8];
+
+    gac_init( &h, NULL );
+    while( gac_sample_file_read( file, &batch ) )
+    {
+        count += gac_sample_window_update_batch( &h, &batch, fixations, 8,
+                &fixation_count, saccades, 8, &saccade_count );
+        for( i = 0; i < fixation_count; i++ )
+        {
+            gac_fixation_destroy( &fixations[i] );
+        }
+        for( i = 0; i < saccade_count; i++ )
+        {
+            gac_saccade_destroy( &saccades[i] );
+        }
+    }
+    mu_assert_int_eq( SAMPLE_COUNT - 1, count );
+    gac_destroy( &h );
+}
+
+MU_TEST_SUITE( file_suite )
+{
+    MU_SUITE_CONFIGURE( &file_setup, &file_teardown );
+    MU_RUN_TEST( file_read );
+    MU_RUN_TEST( file_seek );
+    MU_RUN_TEST( file_update_batch );
+}
+
+int main()
+{
+    MU_RUN_SUITE( file_init_suite );
+    MU_RUN_SUITE( file_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,160 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "minunit.h"
+#include "gac.h"
+
+#define SAMPLE_COUNT 10
+
+static gac_sample_pool_t pool_stack;
+static gac_sample_pool_t* pool_heap;
+static gac_sample_pool_t* pool;
+static gac_sample_t* samples[SAMPLE_COUNT];
+
+static float s[2] = { 0.1, 0.2 };
+static float o[3] = { 0.3, 0.4, 0.5 };
+static float p[3] = { 0.6, 0.7, 0.8 };
+
+void pool_setup()
+{
+    gac_sample_pool_init( &pool_stack, 4 );
+    pool = &pool_stack;
+}
+
+void pool_teardown()
+{
+    gac_sample_pool_destroy( pool );
+}
+
+MU_TEST( pool_init_stack )
+{
+    pool_setup();
+    mu_assert_int_eq( 4, pool->slab_size );
+    mu_assert_int_eq( 0, pool->stats.capacity );
+}
+
+MU_TEST( pool_init_heap )
+{
+    pool_heap = gac_sample_pool_create( 0 );
+    pool = pool_heap;
+    mu_assert_int_eq( GAC_SAMPLE_POOL_SLAB_SIZE, pool->slab_size );
+    mu_assert_int_eq( 0, pool->stats.capacity );
+}
+
+MU_TEST_SUITE( pool_init_suite )
+{
+    MU_SUITE_CONFIGURE( NULL, &pool_teardown );
+    MU_RUN_TEST( pool_init_stack );
+    MU_RUN_TEST( pool_init_heap );
+}
+
+MU_TEST( pool_acquire_1 )
+{
+    gac_sample_t* sample = gac_sample_create_pooled( pool, &s, &o, &p, 1.5,
+            2, 3 );
+    mu_check( sample != NULL );
+    mu_check( sample->pool == pool );
+    mu_assert_double_eq( 1.5, sample->timestamp );
+    mu_assert_int_eq( 2, sample->trial_id );
+    mu_assert_int_eq( 3, sample->label_id );
+    mu_assert_int_eq( 4, pool->stats.capacity );
+    mu_assert_int_eq( 1, pool->stats.in_use );
+    mu_assert_int_eq( 1, pool->stats.slab_count );
+    gac_sample_destroy( sample );
+    mu_assert_int_eq( 0, pool->stats.in_use );
+    mu_assert_int_eq( 1, pool->stats.release_count );
+}
+
+MU_TEST( pool_acquire_n )
+{
+    int i;
+    gac_sample_pool_stats_t stats;
+
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        samples[i] = gac_sample_create_pooled( pool, &s, &o, &p, i, 0,
+                GAC_LABEL_ID_NONE );
+    }
+    gac_sample_pool_get_stats( pool, &stats );
+    mu_assert_int_eq( 12, stats.capacity );
+    mu_assert_int_eq( SAMPLE_COUNT, stats.in_use );
+    mu_assert_int_eq( 3, stats.slab_count );
+
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        mu_assert_double_eq( i, samples[i]->timestamp );
+        gac_sample_destroy( samples[i] );
+    }
+
+    // recycled samples must not trigger new slabs
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        samples[i] = gac_sample_create_pooled( pool, &s, &o, &p, i, 0,
+                GAC_LABEL_ID_NONE );
+    }
+    for( i = 0; i < SAMPLE_COUNT; i++ )
+    {
+        gac_sample_destroy( samples[i] );
+    }
+    gac_sample_pool_get_stats( pool, &stats );
+    mu_assert_int_eq( 12, stats.capacity );
+    mu_assert_int_eq( 0, stats.in_use );
+    mu_assert_int_eq( SAMPLE_COUNT, stats.peak_in_use );
+    mu_assert_int_eq( 3, stats.slab_count );
+    mu_assert_int_eq( 2 * SAMPLE_COUNT, stats.acquire_count );
+}
+
+MU_TEST( pool_none )
+{
+    gac_sample_t* sample = gac_sample_create_pooled( NULL, &s, &o, &p, 1.5,
+            2, GAC_LABEL_ID_NONE );
+    mu_check( sample != NULL );
+    mu_check( sample->pool == NULL );
+    mu_check( sample->_me == sample );
+    gac_sample_destroy( sample );
+}
+
+MU_TEST( pool_gaze )
+{
+    int i;
+    gac_t h;
+    gac_sample_pool_stats_t stats;
+    uint32_t slab_count = 0;
+
+    gac_init( &h, NULL );
+    for( i = 0; i < 1000; i++ )
+    {
+        gac_sample_window_update( &h, 0, 0, 0, 0, 0, 500, i * 1000.0 / 60, 0,
+                NULL );
+        gac_sample_window_cleanup( &h );
+        if( i == 100 )
+        {
+            gac_get_sample_pool_stats( &h, &stats );
+            slab_count = stats.slab_count;
+        }
+    }
+    gac_get_sample_pool_stats( &h, &stats );
+    mu_check( stats.acquire_count > 1000 );
+    mu_assert_int_eq( slab_count, stats.slab_count );
+    gac_destroy( &h );
+}
+
+MU_TEST_SUITE( pool_suite )
+{
+    MU_SUITE_CONFIGURE( &pool_setup, &pool_teardown );
+    MU_RUN_TEST( pool_acquire_1 );
+    MU_RUN_TEST( pool_acquire_n );
+    MU_RUN_TEST( pool_none );
+    MU_RUN_TEST( pool_gaze );
+}
+
+int main()
+{
+    MU_RUN_SUITE( pool_init_suite );
+    MU_RUN_SUITE( pool_suite );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}